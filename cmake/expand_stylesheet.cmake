@@ -0,0 +1,40 @@
+# 构建期展开样式表模板
+#
+# 用法：cmake -DTEMPLATE=<style.qss> -DPALETTE=<name.palette> -DOUTPUT=<out.qss> -P expand_stylesheet.cmake
+#
+# 调色板每行为 "名称 颜色 [// 注释]"，模板中的 ${名称} 被替换为对应颜色。
+# 模板中残留未定义的占位符时构建失败，避免运行期出现无效的 QSS。
+
+foreach(arg TEMPLATE PALETTE OUTPUT)
+    if(NOT DEFINED ${arg})
+        message(FATAL_ERROR "expand_stylesheet.cmake: ${arg} is required")
+    endif()
+endforeach()
+
+file(READ "${TEMPLATE}" style)
+file(STRINGS "${PALETTE}" palette_lines ENCODING UTF-8)
+
+set(color_count 0)
+foreach(line IN LISTS palette_lines)
+    if(line MATCHES "^[ \t]*([A-Za-z][A-Za-z0-9_]*)[ \t]+(#[0-9A-Fa-f]+)")
+        string(REPLACE "\${${CMAKE_MATCH_1}}" "${CMAKE_MATCH_2}" style "${style}")
+        math(EXPR color_count "${color_count} + 1")
+    endif()
+endforeach()
+
+string(REGEX MATCHALL "\\$\\{[A-Za-z][A-Za-z0-9_]*\\}" unresolved "${style}")
+if(unresolved)
+    list(REMOVE_DUPLICATES unresolved)
+    message(FATAL_ERROR "${PALETTE}: undefined colors ${unresolved}")
+endif()
+
+# 内容未变时不改写，避免 rcc 和链接被无谓触发（规则的输出是调用方另行更新的 stamp 文件）
+set(previous "")
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" previous)
+endif()
+if(NOT previous STREQUAL style)
+    file(WRITE "${OUTPUT}" "${style}")
+endif()
+
+message(STATUS "Expanded ${color_count} colors from ${PALETTE}")
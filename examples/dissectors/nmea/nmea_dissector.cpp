@@ -0,0 +1,100 @@
+/**
+ * @file nmea_dissector.cpp
+ * @brief 协议解析插件示例：NMEA 0183
+ *
+ * 展示 IDissectorFactory / IDissector 的最小实现：按行分帧，校验 "*hh" 校验和，
+ * 对 GGA、RMC 给出字段名，其余语句按序号列出字段。
+ * 构建：cmake -DSCOM_BUILD_DISSECTOR_EXAMPLES=ON，插件输出到 bin/plugins/dissectors。
+ */
+
+#include <QObject>
+#include <QStringList>
+#include "../../../include/dissector_interface.h"
+
+namespace {
+
+const QStringList kGgaFields = {
+    "UTC 时间", "纬度", "N/S", "经度", "E/W", "定位质量", "卫星数", "HDOP",
+    "海拔", "单位", "大地水准面差距", "单位", "差分龄期", "差分站 ID"
+};
+
+const QStringList kRmcFields = {
+    "UTC 时间", "状态", "纬度", "N/S", "经度", "E/W", "地速(节)", "航向",
+    "日期", "磁偏角", "E/W", "模式"
+};
+
+class NmeaDissector : public IDissector
+{
+public:
+    Framing framing() const override { return Framing::Lines; }
+
+    void dissect(const QByteArray &frame, qint64 timestampMs, QList<DissectedRecord> *out) override
+    {
+        const int start = frame.indexOf('$') >= 0 ? frame.indexOf('$') : frame.indexOf('!');
+        if (start < 0)
+        {
+            return;  // 不是 NMEA 语句（如设备的其他调试输出），忽略
+        }
+
+        DissectedRecord record;
+        record.timestampMs = timestampMs;
+
+        QByteArray body = frame.mid(start + 1);
+        const int star = body.lastIndexOf('*');
+        if (star >= 0)
+        {
+            bool ok = false;
+            const int expected = body.mid(star + 1, 2).toInt(&ok, 16);
+            body.truncate(star);
+            quint8 actual = 0;
+            for (char c : body)
+            {
+                actual ^= quint8(c);
+            }
+            record.error = !ok || actual != expected;
+            record.fields.append({"校验和", QString("%1").arg(actual, 2, 16, QChar('0')).toUpper(),
+                                  start + 1 + star, 3});
+        }
+
+        const QList<QByteArray> parts = body.split(',');
+        const QString address = QString::fromLatin1(parts.first());
+        const QString sentence = address.size() >= 5 ? address.right(3) : address;
+        record.fields.prepend({"语句", sentence, start + 1, int(parts.first().size())});
+        if (address.size() >= 5)
+        {
+            record.fields.prepend({"发送方", address.left(address.size() - 3), start + 1, 2});
+        }
+
+        const QStringList *names = sentence == "GGA" ? &kGgaFields : sentence == "RMC" ? &kRmcFields : nullptr;
+        int offset = start + 1 + int(parts.first().size()) + 1;
+        for (int i = 1; i < parts.size(); ++i)
+        {
+            const QString name = names && i - 1 < names->size() ? names->at(i - 1) : QString("字段 %1").arg(i);
+            record.fields.append({name, QString::fromLatin1(parts.at(i)), offset, int(parts.at(i).size())});
+            offset += int(parts.at(i).size()) + 1;
+        }
+
+        record.summary = QString::fromLatin1(body);
+        if (record.error)
+        {
+            record.summary = "校验和错误: " + record.summary;
+        }
+        out->append(record);
+    }
+};
+
+} // namespace
+
+class NmeaDissectorFactory : public QObject, public IDissectorFactory
+{
+    Q_OBJECT
+    Q_PLUGIN_METADATA(IID "com.scom-x.IDissectorFactory/1.0")  // 须与 SCOM_DISSECTOR_FACTORY_IID 一致
+    Q_INTERFACES(IDissectorFactory)
+
+public:
+    QString name() const override { return "NMEA 0183"; }
+    QString description() const override { return "GPS/北斗等接收机输出的 NMEA 0183 语句"; }
+    IDissector *create() override { return new NmeaDissector; }
+};
+
+#include "nmea_dissector.moc"
@@ -0,0 +1,156 @@
+#ifndef ASYNC_LOG_WRITER_H
+#define ASYNC_LOG_WRITER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QDateTime>
+#include <atomic>
+#include <memory>
+
+class QFile;
+class QThread;
+
+/**
+ * @class AsyncLogWriter
+ * @brief 异步批量日志写入器
+ *
+ * 单例。日志调用方把已格式化的记录压入无锁 MPSC 队列后立即返回，
+ * 后台写线程按刷新间隔（或积压达到阈值时）批量取出，按文件分组写入。
+ * 每个日志文件只打开一次并保持打开状态，避免每条日志 open/append/close。
+ *
+ * 退出时 shutdown() 同步落盘；installCrashHandlers() 在崩溃信号和
+ * std::terminate 时尽力同步刷出队列中的剩余记录。
+ *
+ * 写入前按 RotationPolicy 检查文件大小和分段年龄，超限时在写线程上关闭、
+ * 重命名并重新打开活动文件（只在记录边界轮转），旧分段的压缩和超额清理
+ * 投递到全局线程池，不阻塞写线程。
+ */
+class AsyncLogWriter
+{
+public:
+    static AsyncLogWriter &instance();
+
+    /**
+     * @brief 追加一条记录（线程安全、无锁、不阻塞）
+     * @param filePath 目标日志文件
+     * @param record 已编码的记录内容（调用方负责换行）
+     */
+    void append(const QString &filePath, QByteArray record);
+
+    /**
+     * @brief 同步刷出队列中的全部记录并 flush 所有文件
+     */
+    void flush();
+
+    /**
+     * @brief 刷出队列后截断指定文件
+     */
+    bool truncate(const QString &filePath);
+
+    /**
+     * @brief 设置后台刷新间隔（毫秒）
+     */
+    void setFlushInterval(int ms);
+    int flushInterval() const;
+
+    /**
+     * @brief 日志轮转策略（对所有日志文件生效）
+     */
+    struct RotationPolicy
+    {
+        qint64 maxFileSize = 10 * 1024 * 1024;  ///< 活动文件超过该大小时轮转，<= 0 不限
+        qint64 maxAgeSecs = 7 * 24 * 3600;      ///< 分段存在超过该时长时轮转，<= 0 不限
+        int retention = 5;                      ///< 保留的已轮转分段数
+    };
+
+    void setRotationPolicy(const RotationPolicy &policy);
+    RotationPolicy rotationPolicy() const;
+
+    /**
+     * @brief 累计轮转次数（读取方据此区分"轮转"与"被清空"）
+     */
+    quint64 rotationCount() const;
+
+    /**
+     * @brief 活动文件当前大小（轮转后从零计），写线程尚未打开该文件时返回 -1
+     *
+     * 每批写入后更新，不访问磁盘，也不等待正在进行的写入。
+     */
+    qint64 fileSize(const QString &filePath) const;
+
+    /**
+     * @brief 停止写线程并同步落盘，可重复调用
+     */
+    void shutdown();
+
+    /**
+     * @brief 在限定时间内尝试同步刷出（崩溃路径使用，拿不到锁则放弃）
+     * @return 成功刷出返回 true
+     */
+    bool tryFlush(int timeoutMs);
+
+    /**
+     * @brief 安装崩溃信号与 terminate 处理器，崩溃前同步刷出日志
+     */
+    static void installCrashHandlers();
+
+private:
+    AsyncLogWriter();
+    ~AsyncLogWriter();
+
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+    struct Node
+    {
+        std::atomic<Node*> next{nullptr};
+        QString filePath;
+        QByteArray data;
+    };
+
+    void push(Node *node);
+    Node *pop();
+    void run();
+    void drainLocked();
+    struct Sink
+    {
+        QFile *file = nullptr;
+        qint64 size = 0;
+        QDateTime startedAt;  ///< 当前分段开始时间，用于按年龄轮转
+    };
+
+    Sink *sinkFor(const QString &filePath);
+    bool shouldRotateLocked(const Sink &sink, qint64 incoming) const;
+    void rotateLocked(const QString &filePath, Sink &sink);
+    void scheduleMaintenance(const QString &filePath, int retention);
+    void closeSinksLocked();
+    void publishSizesLocked();
+
+    // Vyukov 无锁 MPSC 队列：生产者只做一次原子交换
+    std::atomic<Node*> m_head;
+    Node *m_tail;
+    Node m_stub;
+
+    std::atomic<int> m_pending{0};
+    std::atomic<int> m_flushIntervalMs{200};
+    std::atomic<bool> m_running{false};
+
+    mutable QMutex m_consumerMutex;  ///< 仅在消费者（写线程 / flush）之间互斥
+    QMutex m_wakeMutex;
+    QWaitCondition m_wakeCondition;
+    std::unique_ptr<QThread> m_thread;
+
+    QHash<QString, Sink> m_sinks;    ///< 受 m_consumerMutex 保护
+    RotationPolicy m_rotationPolicy; ///< 受 m_consumerMutex 保护
+    std::atomic<quint64> m_rotationCount{0};
+
+    mutable QMutex m_sizeMutex;          ///< 只保护 m_fileSizes，读取方不必等待写入
+    QHash<QString, qint64> m_fileSizes;  ///< 各活动文件大小的快照
+
+    static constexpr int kWakeThreshold = 256;  ///< 积压达到该条数时提前唤醒写线程
+};
+
+#endif // ASYNC_LOG_WRITER_H
@@ -0,0 +1,70 @@
+#ifndef AT_CAMPAIGN_DIALOG_H
+#define AT_CAMPAIGN_DIALOG_H
+
+#include <QDialog>
+#include <QListWidget>
+#include <QTableWidget>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QComboBox>
+#include <QLabel>
+#include <QHash>
+#include <QPair>
+
+#include "at_campaign_runner.h"
+
+/**
+ * @class ATCampaignDialog
+ * @brief 多设备 AT 批量执行对话框
+ *
+ * 勾选若干串口后在每个串口上并发执行同一脚本，实时显示各设备进度，
+ * 结束后给出包含每台设备通过/失败、每条命令延迟与总耗时的报告。
+ */
+class ATCampaignDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    /**
+     * @param busyPort 主窗口已打开的串口，不可选
+     */
+    ATCampaignDialog(const ATScriptRunner::Script &script, const QString &busyPort, QWidget *parent = nullptr);
+    ~ATCampaignDialog() override;
+
+protected:
+    void closeEvent(QCloseEvent *event) override;
+
+private slots:
+    void onRefreshPortsClicked();
+    void onStartClicked();
+    void onStopClicked();
+    void onSaveReportClicked();
+    void onDeviceCommandFinished(const QString &portName, const ATCommandResult &result);
+    void onDeviceFinished(const ATCampaignDeviceReport &report);
+    void onCampaignFinished(const ATCampaignReport &report);
+
+private:
+    void setupUI();
+    void setRunning(bool running);
+    void updatePortList(const QStringList &ports);
+
+    enum Column { PortColumn, StatusColumn, PassedColumn, FailedColumn, TimeColumn, ColumnCount };
+
+    ATScriptRunner::Script script;
+    QString busyPort;
+    ATCampaignRunner *campaignRunner;
+
+    QListWidget *portList;
+    QComboBox *baudRateCombo;
+    QPushButton *refreshButton;
+    QPushButton *startButton;
+    QPushButton *stopButton;
+    QPushButton *saveReportButton;
+    QTableWidget *deviceTable;
+    QPlainTextEdit *reportView;
+    QLabel *summaryLabel;
+
+    QHash<QString, int> deviceRows;  // 串口名 -> 表格行
+    QHash<QString, QPair<int, int>> deviceCounts;  // 串口名 -> (通过, 失败)
+};
+
+#endif // AT_CAMPAIGN_DIALOG_H
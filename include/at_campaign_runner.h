@@ -0,0 +1,157 @@
+#ifndef AT_CAMPAIGN_RUNNER_H
+#define AT_CAMPAIGN_RUNNER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QHash>
+#include <QElapsedTimer>
+#include <QMetaType>
+#include <memory>
+
+#include "at_script_runner.h"
+
+class QThread;
+class SerialPort;
+
+/**
+ * @brief 单台设备的执行报告
+ */
+struct ATCampaignDeviceReport
+{
+    QString portName;
+    bool opened = false;            ///< 串口是否成功打开
+    QString error;                  ///< 打开失败或中途断开的原因
+    int passed = 0;
+    int failed = 0;
+    bool aborted = false;
+    qint64 wallMs = 0;              ///< 从打开串口到脚本结束的耗时
+    QList<ATCommandResult> results;
+
+    bool ok() const { return opened && failed == 0 && !aborted; }
+};
+
+/**
+ * @brief 一次批量执行的汇总报告
+ */
+struct ATCampaignReport
+{
+    /**
+     * @brief 单条命令在所有设备上的统计
+     */
+    struct CommandStats
+    {
+        QString command;
+        int passed = 0;
+        int failed = 0;
+        int responded = 0;          ///< 收到结果码的次数；超时和写入失败只计入 failed，不参与延迟统计
+        qint64 minLatencyMs = -1;
+        qint64 maxLatencyMs = 0;
+        qint64 totalLatencyMs = 0;
+
+        qint64 averageLatencyMs() const { return responded > 0 ? totalLatencyMs / responded : 0; }
+    };
+
+    QString scriptName;
+    qint64 wallMs = 0;              ///< 第一台设备开始到最后一台结束
+    QList<ATCampaignDeviceReport> devices;
+    QList<CommandStats> commands;   ///< 按脚本顺序
+
+    int passedDevices() const;
+    QString toText() const;
+};
+
+Q_DECLARE_METATYPE(ATCommandResult)
+Q_DECLARE_METATYPE(ATCampaignDeviceReport)
+
+/**
+ * @class ATCampaignWorker
+ * @brief 单台设备的执行者，运行在独立的 I/O 线程
+ *
+ * SerialPort 和 ATScriptRunner 都在工作线程内创建和销毁，
+ * 收发、超时和应答匹配全部在该线程的事件循环中完成，互不阻塞。
+ */
+class ATCampaignWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    ATCampaignWorker(const QString &portName, qint32 baudRate, const ATScriptRunner::Script &script);
+    ~ATCampaignWorker() override;
+
+public slots:
+    void run();
+    void stop();
+
+    /**
+     * @brief 立即中止并同步释放串口（销毁执行器前调用）
+     */
+    void abort();
+
+signals:
+    void commandFinished(const QString &portName, const ATCommandResult &result);
+    void finished(const ATCampaignDeviceReport &report);
+
+private:
+    void cleanup();
+
+    QString m_portName;
+    qint32 m_baudRate;
+    ATScriptRunner::Script m_script;
+
+    std::unique_ptr<SerialPort> m_port;
+    ATScriptRunner *m_runner = nullptr;
+    ATCampaignDeviceReport m_report;
+    QElapsedTimer m_clock;
+    bool m_done = false;
+};
+
+/**
+ * @class ATCampaignRunner
+ * @brief 在多个串口上并发执行同一 AT 脚本
+ *
+ * 每个串口一个 QThread + ATCampaignWorker，吞吐随串口数量线性增长；
+ * GUI 线程只接收结果信号并汇总成 ATCampaignReport。
+ */
+class ATCampaignRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ATCampaignRunner(QObject *parent = nullptr);
+    ~ATCampaignRunner() override;
+
+    /**
+     * @brief 开始批量执行，已在执行或串口列表为空时返回 false
+     */
+    bool start(const ATScriptRunner::Script &script, const QStringList &portNames, qint32 baudRate);
+
+    /**
+     * @brief 中止所有设备；各设备以 aborted 结束后仍会发出 finished
+     */
+    void stop();
+
+    bool isRunning() const { return m_running; }
+
+signals:
+    void deviceCommandFinished(const QString &portName, const ATCommandResult &result);
+    void deviceFinished(const ATCampaignDeviceReport &report);
+    void finished(const ATCampaignReport &report);
+
+private slots:
+    void onDeviceFinished(const ATCampaignDeviceReport &report);
+
+private:
+    void shutdownThreads();
+
+    ATScriptRunner::Script m_script;
+    QStringList m_portNames;
+    QList<QThread *> m_threads;
+    QList<ATCampaignWorker *> m_workers;
+    QHash<QString, ATCampaignDeviceReport> m_reports;
+    QElapsedTimer m_clock;
+    bool m_running = false;
+};
+
+#endif // AT_CAMPAIGN_RUNNER_H
@@ -6,14 +6,23 @@
 #include <QLineEdit>
 #include <QRadioButton>
 #include <QLabel>
+#include <QPushButton>
+#include <QPlainTextEdit>
+#include <QTimer>
+#include <QTextDocument>
+#include <QDateTime>
 #include <memory>
 #include <vector>
 
+#include "at_script_runner.h"
+
 namespace Ui {
     class ATCommandPage;
 }
 
 class ConfigManager;
+class SerialPort;
+class QFileSystemWatcher;
 
 class ClickableLineEdit : public QLineEdit {
     Q_OBJECT
@@ -32,7 +41,12 @@ protected:
  * @brief AT Command File Editor Page
  * 
  * Provides interface for editing multiple AT command JSON files
- * with path selection and file management capabilities
+ * with path selection and file management capabilities.
+ * The edited script can be run against the open serial port
+ * through ATScriptRunner. Parsing and validation run debounced on
+ * a worker thread; errors are marked in the editor.
+ * Each of the 16 slots keeps its own document and parsed script;
+ * slots are only re-read when their backing file changes.
  */
 class ATCommandPage : public QWidget {
     Q_OBJECT
@@ -40,6 +54,12 @@ class ATCommandPage : public QWidget {
 public:
     explicit ATCommandPage(ConfigManager *configManager, QWidget *parent = nullptr);
     ~ATCommandPage();
+    
+    // Serial port used to run scripts (nullptr disables running)
+    void setSerialPort(SerialPort *port);
+    
+    // Script parsed by the last validation of a slot, nullptr if stale or invalid
+    std::shared_ptr<const ATScriptRunner::Script> cachedScript(int slot) const;
 
 private slots:
     // File operations
@@ -54,6 +74,14 @@ private slots:
     
     // Text editing
     void onTextChanged();
+    
+    // Script execution
+    void onRunClicked();
+    void onStopClicked();
+    void onCampaignClicked();
+    
+    // File watching
+    void onWatchedFileChanged(const QString &filePath);
 
 private:
     // Initialize UI components
@@ -61,6 +89,9 @@ private:
     void setupConnections();
     void loadPathConfigs();
     void loadATCommandFile(int pathIndex);
+    void readSlotFile(int slot);
+    void showSlotDocument(int slot);
+    void unwatchIfUnused(const QString &filePath);
     void saveATCommandFile();
     
     // File handling
@@ -70,6 +101,22 @@ private:
     // UI updates
     void updateFileStatus();
     void setPathRadioButtonChecked(int index);
+    void showStatus(const QString &text, bool ok);
+    
+    // Background validation
+    struct ValidationResult {
+        bool ok = false;
+        QString message;
+        int line = -1;      // 0-based error line
+        int column = -1;    // 0-based error column (characters)
+        QString formatted;  // indented JSON when formatting was requested
+        std::shared_ptr<const ATScriptRunner::Script> script;  // set when the JSON is a runnable script
+    };
+    static ValidationResult validateText(const QString &text, bool format);
+    void startValidation(bool format);
+    void onValidationFinished(quint64 generation, int slot, int revision, const QString &text,
+                              bool format, const ValidationResult &result);
+    void appendRunOutput(const QString &line);
 
     std::unique_ptr<Ui::ATCommandPage> ui;
     ConfigManager *configManager;
@@ -80,8 +127,40 @@ private:
     std::vector<ClickableLineEdit*> pathInputs;
     int currentPathIndex = 0;
     
+    // Per-slot document cache
+    struct SlotCache {
+        QTextDocument *document = nullptr;  // owned by the page, swapped into commandTextEdit
+        QString filePath;                   // file the document was read from
+        QDateTime lastModified;
+        qint64 fileSize = -1;
+        bool stale = false;                 // file changed on disk, re-read on next switch
+        std::shared_ptr<const ATScriptRunner::Script> script;
+        int scriptRevision = -1;            // document revision the script was parsed from
+    };
+    std::vector<SlotCache> slotCache = std::vector<SlotCache>(16);
+    QFileSystemWatcher *fileWatcher = nullptr;
+    QMetaObject::Connection blockCountConnection;
+    
     // Status tracking
     bool textModified = false;
+    QLabel *statusLabel = nullptr;
+    QLabel *statusIconLabel = nullptr;
+    QLabel *lineCountLabel = nullptr;
+    
+    // Background validation
+    static constexpr int kValidateDelayMs = 400;
+    QTimer *validateTimer = nullptr;
+    quint64 validateGeneration = 0;
+    QString lastValidatedText;
+    int lastValidatedSlot = -1;
+    bool validationValid = false;
+    
+    // Script execution
+    SerialPort *serialPort = nullptr;
+    ATScriptRunner *scriptRunner = nullptr;
+    QPushButton *runButton = nullptr;
+    QPushButton *stopButton = nullptr;
+    QPlainTextEdit *runOutput = nullptr;
 };
 
 #endif // AT_COMMAND_PAGE_H
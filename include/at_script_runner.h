@@ -0,0 +1,213 @@
+#ifndef AT_SCRIPT_RUNNER_H
+#define AT_SCRIPT_RUNNER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QElapsedTimer>
+#include <deque>
+
+#include "urc_matcher.h"
+
+class QTimer;
+class QJsonDocument;
+class SerialPort;
+
+/**
+ * @brief 单条 AT 命令的执行结果
+ */
+struct ATCommandResult
+{
+    enum class Status
+    {
+        Ok,         ///< 得到期望的结果
+        Error,      ///< 收到 ERROR / +CME ERROR / +CMS ERROR 而期望的是 OK
+        Mismatch,   ///< 结果码与期望不符，或正则未匹配任何响应行
+        Timeout,    ///< 超时未收到结果码
+        WriteError  ///< 串口写入失败
+    };
+
+    int index = 0;              ///< 命令在脚本中的序号
+    QString command;            ///< 实际发送的文本（变量已替换）
+    Status status = Status::Ok;
+    QStringList response;       ///< 结果码之前的响应行（不含回显）
+    QString finalResult;        ///< 结果码行，超时时为空
+    int attempts = 0;           ///< 发送次数（含重试）
+    qint64 latencyMs = 0;       ///< 最后一次发送到收到结果码的耗时
+
+    bool ok() const { return status == Status::Ok; }
+    static QString statusName(Status status);
+};
+
+/**
+ * @class ATScriptRunner
+ * @brief AT 命令脚本执行器
+ *
+ * 脚本为 ATCommandPage 管理的 JSON 文件：
+ * @code
+ * {
+ *   "window": 4,  "timeoutMs": 1000,  "retries": 0,  "stopOnError": true,
+ *   "variables": { "apn": "internet" },
+ *   "commands": [
+ *     "AT",
+ *     { "send": "AT+CGMR", "capture": { "fw": "^(\\S+)$" } },
+ *     { "send": "AT+CGDCONT=1,\"IP\",\"${apn}\"", "timeoutMs": 3000, "retries": 2 },
+ *     { "send": "AT+CPIN?", "expect": "regex:\\+CPIN: READY" },
+ *     { "send": "AT+XYZ", "expect": "ERROR" }
+ *   ]
+ * }
+ * @endcode
+ * expect 取值 OK（默认）/ ERROR / any / none（不等待响应）/ regex:&lt;pattern&gt;。
+ *
+ * 模块按顺序处理命令并按顺序应答，因此最多 window 条命令可以同时在途：
+ * 响应行总是归属队首命令，收到结果码后队首出队。引用了在途命令尚未捕获的
+ * 变量、标记 "sync": true 或正在重试的命令会等待在途队列清空后再发送。
+ * 队首超时后其后的在途命令无法确定响应归属，会重新排队，并在短暂静默期后重发。
+ *
+ * 非结果码的行先交给 URC 匹配器（默认注册标准模式，可通过 urcMatcher() 增补）：
+ * 命中的行只经 urcReceived 发出，不计入队首命令的响应，也不参与 capture / regex 判定；
+ * 只有与队首命令同名的查询应答（如 AT+CREG? 之后的 +CREG: 0,1）仍归入响应。
+ */
+class ATScriptRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Expect
+    {
+        Ok,
+        Error,
+        Any,
+        None,
+        Regex
+    };
+
+    struct Command
+    {
+        QString send;
+        Expect expect = Expect::Ok;
+        QString pattern;                            ///< Expect::Regex 时的正则（可含变量）
+        int timeoutMs = 1000;
+        int retries = 0;
+        bool sync = false;
+        QList<QPair<QString, QString>> captures;    ///< 变量名 -> 正则（取第一个分组，无分组取整个匹配）
+    };
+
+    struct Script
+    {
+        QString name;
+        int window = 1;
+        bool stopOnError = true;
+        QByteArray lineEnding = "\r\n";
+        QHash<QString, QString> variables;
+        QList<Command> commands;
+    };
+
+    explicit ATScriptRunner(SerialPort *port, QObject *parent = nullptr);
+    ~ATScriptRunner() override;
+
+    /**
+     * @brief 解析 JSON 脚本（对象形式或直接的命令数组）
+     * @return 格式错误时返回 false 并给出原因
+     */
+    static bool parse(const QByteArray &json, Script *script, QString *error);
+    static bool parse(const QJsonDocument &doc, Script *script, QString *error);
+
+    /**
+     * @brief 开始执行脚本，串口未打开或已在执行时返回 false
+     */
+    bool start(const Script &script);
+
+    /**
+     * @brief 中止执行，在途命令不再等待
+     */
+    void stop();
+
+    bool isRunning() const { return m_running; }
+    QHash<QString, QString> variables() const { return m_variables; }
+
+    /**
+     * @brief 用于区分主动上报的匹配器，调用方可注册额外的模式
+     */
+    UrcMatcher *urcMatcher() const { return m_urcMatcher; }
+
+    static constexpr int kMaxWindow = 16;
+    static constexpr int kResyncQuietMs = 200;  ///< 超时后丢弃迟到响应的静默期
+
+signals:
+    void commandSent(int index, const QString &command, int attempt);
+    void commandFinished(const ATCommandResult &result);
+    void variableCaptured(const QString &name, const QString &value);
+
+    /**
+     * @brief 执行期间收到的主动上报，已从命令响应中剔除
+     */
+    void urcReceived(const UrcEvent &event);
+
+    /**
+     * @param aborted 被 stop() 中止、串口断开或因 stopOnError 提前结束
+     */
+    void finished(int passed, int failed, bool aborted);
+
+private slots:
+    void onRawDataReceived(const QByteArray &data);
+    void onConnectionStatusChanged(bool isOpen);
+    void onTimeout();
+    void onResyncFinished();
+
+private:
+    struct Pending
+    {
+        int index = 0;
+        int attempt = 1;
+        QString text;
+        QStringList response;
+        qint64 sentAt = 0;
+    };
+
+    struct Queued
+    {
+        int index = 0;
+        int attempt = 1;
+        bool mustDrain = false;  ///< 重试或重发时需等待在途队列清空
+    };
+
+    void pump();
+    bool canSend(const Queued &queued) const;
+    void handleLine(const QString &line);
+    void completeHead(ATCommandResult::Status status, const QString &finalResult);
+    void finishCommand(const Pending &pending, ATCommandResult::Status status, const QString &finalResult);
+    void applyCaptures(const Command &command, const QStringList &lines);
+    void armTimeout();
+    void finish(bool aborted);
+    QString substitute(const QString &text) const;
+
+    static bool isFinalResult(const QString &line, bool *isError);
+    static bool isQueryResponse(const QString &command, const QString &line);
+
+    SerialPort *m_port;
+    Script m_script;
+    QHash<QString, QString> m_variables;
+
+    std::deque<Queued> m_queue;        ///< 尚未发送的命令
+    std::deque<Pending> m_outstanding; ///< 已发送、等待结果码的命令（按发送顺序）
+    QByteArray m_lineBuffer;
+
+    UrcMatcher *m_urcMatcher = nullptr;
+    QTimer *m_timeoutTimer = nullptr;
+    QTimer *m_resyncTimer = nullptr;
+    QElapsedTimer m_clock;
+    qint64 m_headSince = 0;            ///< 当前队首开始等待的时间
+
+    bool m_running = false;
+    bool m_resyncing = false;
+    bool m_stopping = false;           ///< stopOnError 触发后只等待在途命令
+    int m_passed = 0;
+    int m_failed = 0;
+};
+
+#endif // AT_SCRIPT_RUNNER_H
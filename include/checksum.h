@@ -0,0 +1,83 @@
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+
+/**
+ * @class Checksum
+ * @brief 串口协议常用的 CRC / 校验和计算
+ *
+ * 所有查表均在编译期生成（constexpr），运行时没有初始化开销：
+ * - CRC8 / CRC16 使用逐字节查表
+ * - CRC32 / CRC32C 使用 slice-by-8（每次处理 8 字节）
+ * - CRC32C 在支持 SSE4.2（x86-64，运行时检测）或 ARMv8 CRC 扩展（编译期）时使用硬件指令
+ *
+ * 校验值按各协议的惯例字节序追加到帧尾，见 Algorithm 各项说明。
+ */
+class Checksum
+{
+public:
+    enum class Algorithm
+    {
+        None,
+        Sum8,           ///< 字节累加和取低 8 位
+        Xor8,           ///< 字节异或
+        Crc8,           ///< poly 0x07, init 0x00（CRC-8/SMBUS）
+        Crc16Modbus,    ///< poly 0x8005 反射, init 0xFFFF，低字节在前
+        Crc16Ccitt,     ///< poly 0x1021, init 0xFFFF（CRC-16/CCITT-FALSE），高字节在前
+        Crc32,          ///< poly 0x04C11DB7 反射（以太网 / zlib），低字节在前
+        Crc32C          ///< poly 0x1EDC6F41 反射（Castagnoli），低字节在前
+    };
+
+    /**
+     * @brief 计算校验值（数值形式）
+     */
+    static quint32 compute(Algorithm algorithm, const char *data, qsizetype size);
+    static quint32 compute(Algorithm algorithm, const QByteArray &data)
+    {
+        return compute(algorithm, data.constData(), data.size());
+    }
+
+    /**
+     * @brief 校验值占用的字节数，None 为 0
+     */
+    static int width(Algorithm algorithm);
+
+    /**
+     * @brief 按协议字节序编码的校验值
+     */
+    static QByteArray encode(Algorithm algorithm, quint32 value);
+
+    /**
+     * @brief 在数据末尾追加校验值
+     */
+    static QByteArray append(Algorithm algorithm, const QByteArray &data);
+
+    /**
+     * @brief 检查帧尾的校验值是否与前面的数据匹配
+     * @return 帧长度不足或校验不符时返回 false；None 总是返回 true
+     */
+    static bool verify(Algorithm algorithm, const QByteArray &frame);
+
+    static QString name(Algorithm algorithm);
+    static Algorithm fromName(const QString &name);  // 未知名称返回 None
+    static QStringList names();  // 全部算法名称（含 None），用于下拉框
+
+    // 各算法的直接入口，crc 参数用于分块续算（传入上一块的返回值）
+    static quint8 crc8(const char *data, qsizetype size, quint8 crc = 0x00);
+    static quint16 crc16Modbus(const char *data, qsizetype size, quint16 crc = 0xFFFF);
+    static quint16 crc16Ccitt(const char *data, qsizetype size, quint16 crc = 0xFFFF);
+    static quint32 crc32(const char *data, qsizetype size, quint32 crc = 0);
+    static quint32 crc32c(const char *data, qsizetype size, quint32 crc = 0);
+    static quint32 crc32cSoftware(const char *data, qsizetype size, quint32 crc = 0);  // 始终使用查表实现，供与硬件结果对照
+
+    /**
+     * @brief 当前 CPU 是否使用硬件 CRC32C
+     */
+    static bool hasHardwareCrc32c();
+};
+
+#endif // CHECKSUM_H
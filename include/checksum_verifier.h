@@ -0,0 +1,61 @@
+#ifndef CHECKSUM_VERIFIER_H
+#define CHECKSUM_VERIFIER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QTimer>
+
+#include "checksum.h"
+
+/**
+ * @class ChecksumVerifier
+ * @brief 接收数据的分帧与校验
+ *
+ * 二进制协议没有行结束符，按空闲间隔分帧：连续 idleGapMs 毫秒没有新数据即认为一帧结束，
+ * 然后检查帧尾的校验值并累计正确/错误帧数。单帧超过 kMaxFrameSize 时立即截断校验。
+ */
+class ChecksumVerifier : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ChecksumVerifier(QObject *parent = nullptr);
+
+    void setAlgorithm(Checksum::Algorithm algorithm);
+    Checksum::Algorithm algorithm() const { return m_algorithm; }
+
+    /**
+     * @brief 帧间空闲间隔；USB 转串口驱动通常按 1~16 ms 批量上报，不宜设得过小
+     */
+    void setIdleGapMs(int ms);
+    int idleGapMs() const { return m_idleGapMs; }
+
+    void feed(const QByteArray &data);
+
+    /**
+     * @brief 丢弃未完成的帧（断开或切换算法时调用）
+     */
+    void resetStream();
+    void resetCounters();
+
+    quint64 okCount() const { return m_okCount; }
+    quint64 errorCount() const { return m_errorCount; }
+
+    static constexpr int kDefaultIdleGapMs = 20;
+    static constexpr int kMaxFrameSize = 4096;
+
+signals:
+    void frameVerified(const QByteArray &frame, bool ok);
+
+private:
+    void finishFrame();
+
+    Checksum::Algorithm m_algorithm = Checksum::Algorithm::None;
+    int m_idleGapMs = kDefaultIdleGapMs;
+    QByteArray m_frame;
+    QTimer m_idleTimer;
+    quint64 m_okCount = 0;
+    quint64 m_errorCount = 0;
+};
+
+#endif // CHECKSUM_VERIFIER_H
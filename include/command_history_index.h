@@ -0,0 +1,122 @@
+#ifndef COMMAND_HISTORY_INDEX_H
+#define COMMAND_HISTORY_INDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+/**
+ * @class CommandHistoryIndex
+ * @brief 终端命令历史索引
+ *
+ * 为终端输入提供即时的前缀/模糊（子串）匹配：
+ * - 按小写键排序的 id 数组，前缀查找为二分；区间较大时（如 AT 终端里输入 "AT"）
+ *   改为同时按使用次数、最近使用时间从高到低遍历，得分上界低于当前第 limit 名即停止
+ * - 字符二元组（bigram）倒排表，子串查找只校验最短的候选集合
+ * - 结果按使用频率和最近使用时间（frecency）排序
+ *
+ * 10 万条记录下单次查询保持在亚毫秒级。
+ */
+class CommandHistoryIndex
+{
+public:
+    /**
+     * @brief 查询结果
+     */
+    struct Match
+    {
+        QString command;   ///< 原始命令文本
+        int count = 0;     ///< 使用次数
+        double score = 0;  ///< 排序得分（越大越靠前）
+    };
+
+    /**
+     * @brief 构造函数
+     * @param capacity 最多保留的条目数，超出时淘汰最久未使用的条目
+     */
+    explicit CommandHistoryIndex(int capacity = 100000);
+
+    /**
+     * @brief 清空索引
+     */
+    void clear();
+
+    /**
+     * @brief 批量加载历史记录
+     * @param mostRecentFirst 按最近使用排序的命令（第 0 项最新）
+     * @param counts 与命令一一对应的使用次数，缺省视为 1
+     */
+    void load(const QStringList &mostRecentFirst, const QList<int> &counts = {});
+
+    /**
+     * @brief 记录一次命令使用（新增或提升已有条目）
+     */
+    void record(const QString &command);
+
+    /**
+     * @brief 判断命令是否已在历史中
+     */
+    bool contains(const QString &command) const;
+
+    /**
+     * @brief 当前条目数
+     */
+    int size() const;
+
+    /**
+     * @brief 获取最近使用的命令（第 0 项最新）
+     */
+    QStringList mostRecent(int limit) const;
+
+    /**
+     * @brief 获取命令的使用次数（不存在返回 0）
+     */
+    int countOf(const QString &command) const;
+
+    /**
+     * @brief 前缀 + 模糊匹配查询
+     * @param query 用户输入（大小写不敏感）
+     * @param limit 最多返回的条目数
+     * @return 按得分从高到低排序的匹配结果，前缀匹配总是排在子串匹配之前
+     */
+    QVector<Match> search(const QString &query, int limit) const;
+
+private:
+    struct Entry
+    {
+        QString text;
+        QString key;           ///< 小写键
+        quint32 count = 0;
+        quint64 lastUsed = 0;  ///< 逻辑时钟
+        bool alive = false;
+    };
+
+    int insertEntry(const QString &command, quint32 count, quint64 lastUsed);
+    void evictOldest();
+    void rebuild();
+    double scoreOf(const Entry &entry) const;
+    double recencyScore(quint64 lastUsed) const;
+    static double frequencyScore(quint32 count);
+
+    static quint32 bigramKey(QChar a, QChar b);
+    static std::vector<quint32> bigramsOf(const QString &key);
+
+    int m_capacity;
+    quint64 m_clock = 0;
+    int m_aliveCount = 0;
+
+    std::vector<Entry> m_entries;                    ///< 按 id 存放，只追加
+    QHash<QString, int> m_idByText;                  ///< 原文 -> id
+    std::vector<int> m_sortedIds;                    ///< 按小写键排序的 id
+    std::map<quint64, int> m_recency;                ///< lastUsed -> id
+    std::set<std::pair<quint32, int>> m_byCount;     ///< (count, id)，按使用次数排序
+    QHash<quint32, std::vector<int>> m_bigramPostings; ///< bigram -> 升序 id 列表
+};
+
+#endif // COMMAND_HISTORY_INDEX_H
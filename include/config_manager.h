@@ -18,6 +18,10 @@ public:
     ConfigManager();
     ~ConfigManager();
 
+    // 支持在工作线程加载后整体移交给 GUI 线程使用的实例
+    ConfigManager(ConfigManager &&other) noexcept;
+    ConfigManager &operator=(ConfigManager &&other) noexcept;
+
     // 初始化配置文件
     bool initialize(const QString &configPath = "");
 
@@ -37,10 +41,19 @@ public:
     int getWindowWidth() const;
     int getWindowHeight() const;
     int getLineEndIndex() const;
+    QString getTheme() const;  // 主题名，对应 resources/themes/<主题名>.palette
+    QString getChecksum() const;  // HEX 发送/接收校验算法名，见 Checksum::names()
 
     // 获取/设置终端历史记录
     QStringList getTerminalHistory() const;
     void setTerminalHistory(const QStringList &history);
+    QList<int> getTerminalHistoryCounts() const;  // 与历史记录一一对应的使用次数
+    void setTerminalHistoryCounts(const QList<int> &counts);
+
+    // 终端历史保存在配置文件旁的独立文件中（条目可达历史索引容量，不随每次保存配置重写）；
+    // 独立文件不存在时读取旧版配置中的 terminalHistory 字段
+    void readTerminalHistory(QStringList *history, QList<int> *counts) const;
+    bool writeTerminalHistory(const QStringList &history, const QList<int> &counts);
 
     // 设置配置值
     void setSerialPort(const QString &port);
@@ -57,6 +70,30 @@ public:
     void setHexMode(bool enabled);
     void setWindowSize(int width, int height);
     void setLineEndIndex(int index);
+    void setTheme(const QString &theme);
+    void setChecksum(const QString &name);
+
+    // 日志配置
+    int getLogFlushInterval() const;  // 异步日志刷新间隔（毫秒）
+    void setLogFlushInterval(int ms);
+    QString getLogLevel() const;  // 运行期最低日志级别：debug/info/warning/critical
+    void setLogLevel(const QString &level);
+    int getLogMaxFileSizeMB() const;  // 日志分段大小上限（MB），0 表示不按大小轮转
+    void setLogMaxFileSizeMB(int megabytes);
+    int getLogMaxAgeDays() const;  // 日志分段最长天数，0 表示不按时间轮转
+    void setLogMaxAgeDays(int days);
+    int getLogRetention() const;  // 保留的已轮转分段数
+    void setLogRetention(int count);
+    bool getDataAuditEnabled() const;  // 收发数据审计日志开关
+    void setDataAuditEnabled(bool enabled);
+    int getDataAuditSampleEvery(bool transmit) const;  // 每 N 块记录一条明细，0 表示只汇总
+    void setDataAuditSampleEvery(bool transmit, int every);
+    int getDataAuditMaxRecordsPerSec(bool transmit) const;  // 每秒明细记录上限，0 表示不限
+    void setDataAuditMaxRecordsPerSec(bool transmit, int count);
+    int getDataAuditPreviewBytes() const;  // 明细中十六进制预览的字节数
+    void setDataAuditPreviewBytes(int bytes);
+    int getDataAuditSummaryIntervalMs() const;  // 汇总记录间隔（毫秒），0 表示不写汇总
+    void setDataAuditSummaryIntervalMs(int ms);
 
     // 保存配置到文件
     bool saveConfig();
@@ -65,6 +102,8 @@ public:
     bool loadConfig();
 
 private:
+    QString terminalHistoryPath() const;
+
     QString configPath;
     QJsonObject configData;
 
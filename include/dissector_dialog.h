@@ -0,0 +1,64 @@
+#ifndef DISSECTOR_DIALOG_H
+#define DISSECTOR_DIALOG_H
+
+#include <QDialog>
+#include <QTableView>
+#include <QTreeWidget>
+#include <QListWidget>
+#include <QCheckBox>
+#include <QLabel>
+#include <QTimer>
+#include <QByteArray>
+#include <QList>
+
+#include "dissector_interface.h"
+
+class DissectorHost;
+class DissectorRecordModel;
+
+/**
+ * @class DissectorDialog
+ * @brief 协议解析插件窗口
+ *
+ * 持有 DissectorHost，启动时从 DissectorHost::defaultPluginDirectory() 加载插件；
+ * 勾选的解析器保存在 QSettings 中，窗口关闭后仍持续解析接收数据。
+ * 记录表只保留最近 DissectorRecordModel::kMaxRecords 条，选中记录时在右侧显示字段。
+ */
+class DissectorDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit DissectorDialog(QWidget *parent = nullptr);
+    ~DissectorDialog() override;
+
+    DissectorHost *dissectorHost() const { return host; }
+
+public slots:
+    void feed(const QByteArray &data);
+    void resetStream();
+
+private slots:
+    void onRecordsReady(const QString &dissector, const QList<DissectedRecord> &records);
+    void onDissectorItemChanged(QListWidgetItem *item);
+    void onCurrentRecordChanged();
+    void onClearClicked();
+    void updateStats();
+
+private:
+    void setupUI();
+    void populateDissectors();
+    void saveEnabled();
+
+    DissectorHost *host = nullptr;
+    DissectorRecordModel *model = nullptr;
+
+    QListWidget *dissectorList = nullptr;
+    QLabel *pluginLabel = nullptr;
+    QTableView *recordView = nullptr;
+    QTreeWidget *fieldTree = nullptr;
+    QCheckBox *pauseCheck = nullptr;
+    QLabel *statsLabel = nullptr;
+    QTimer statsTimer;
+};
+
+#endif // DISSECTOR_DIALOG_H
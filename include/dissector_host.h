@@ -0,0 +1,91 @@
+#ifndef DISSECTOR_HOST_H
+#define DISSECTOR_HOST_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QMap>
+#include <QVector>
+
+#include "dissector_interface.h"
+
+/**
+ * @brief 一个启用中的解析器的运行统计
+ */
+struct DissectorStats
+{
+    QString name;
+    qint64 queuedBytes = 0;     ///< 已投递、工作线程尚未处理的字节数
+    quint64 droppedChunks = 0;  ///< 队列满时丢弃的数据块
+    quint64 records = 0;
+};
+
+/**
+ * @class DissectorHost
+ * @brief 加载协议解析插件，并在各自的工作线程中并行运行启用的解析器
+ *
+ * 每个启用的解析器一个工作线程和一个有界队列（kQueueCapacityBytes）。
+ * feed() 在 GUI 线程只记录时间戳并投递数据；某个解析器处理不过来时，
+ * 它的队列满后新数据块被丢弃并计数，下一块到达前先 reset() 该解析器，
+ * 接收和其他解析器都不受影响。解析结果按批次回到 GUI 线程。
+ */
+class DissectorHost : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DissectorHost(QObject *parent = nullptr);
+    ~DissectorHost() override;
+
+    /**
+     * @brief 可执行文件旁的 plugins/dissectors 目录
+     */
+    static QString defaultPluginDirectory();
+
+    /**
+     * @brief 加载目录中的全部插件，返回成功加载的个数；失败原因见 loadErrors()
+     */
+    int loadPlugins(const QString &directory);
+    QStringList loadErrors() const { return m_loadErrors; }
+
+    /**
+     * @brief 注册内置（非插件）的解析器工厂，不转移所有权
+     */
+    bool registerFactory(IDissectorFactory *factory);
+
+    QStringList availableDissectors() const { return m_factories.keys(); }
+    QString description(const QString &name) const;
+
+    void setEnabled(const QString &name, bool enabled);
+    bool isEnabled(const QString &name) const { return m_workers.contains(name); }
+    QStringList enabledDissectors() const { return m_workers.keys(); }
+
+    void feed(const QByteArray &data);
+
+    /**
+     * @brief 数据流不连续（断开、重连）时调用，所有解析器丢弃未完成的帧
+     */
+    void reset();
+
+    QVector<DissectorStats> stats() const;
+
+    static constexpr qint64 kQueueCapacityBytes = 4 * 1024 * 1024;
+    static constexpr int kMaxLineLength = 4096;  ///< Lines 分帧时单行上限，超长的行整行丢弃
+
+signals:
+    void recordsReady(const QString &dissector, const QList<DissectedRecord> &records);
+
+private:
+    struct Worker;
+
+    void process(Worker *worker, const QByteArray &data, qint64 timestampMs, bool resync);  // 在工作线程中执行
+    void deliver(Worker *worker, QList<DissectedRecord> records);                           // 在工作线程中执行
+
+    QMap<QString, IDissectorFactory *> m_factories;
+    QMap<QString, Worker *> m_workers;
+    QStringList m_loadErrors;
+};
+
+#endif // DISSECTOR_HOST_H
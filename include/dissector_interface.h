@@ -0,0 +1,92 @@
+#ifndef DISSECTOR_INTERFACE_H
+#define DISSECTOR_INTERFACE_H
+
+#include <QtPlugin>
+#include <QByteArray>
+#include <QString>
+#include <QVariant>
+#include <QList>
+
+/**
+ * @file dissector_interface.h
+ * @brief 协议解析插件 API
+ *
+ * 插件只依赖本头文件和 Qt6::Core：实现 IDissectorFactory（QObject + Q_PLUGIN_METADATA），
+ * 编译为动态库放进 plugins/dissectors 目录，由 DissectorHost 通过 QPluginLoader 加载。
+ * 参考 examples/dissectors/nmea_dissector。
+ *
+ * 线程模型：每个启用的解析器实例只在自己的工作线程中调用，实现无需加锁；
+ * 同一工厂可能为多个数据流各创建一个实例。
+ */
+
+/**
+ * @brief 解析出的一个字段
+ */
+struct DissectorField
+{
+    QString name;
+    QVariant value;
+    int offset = -1;    ///< 在帧中的字节偏移，-1 表示不适用
+    int length = 0;
+};
+
+/**
+ * @brief 解析出的一条记录（通常对应一帧）
+ */
+struct DissectedRecord
+{
+    qint64 timestampMs = 0;     ///< 帧所在数据块的接收时间（毫秒时间戳）
+    QString summary;            ///< 单行摘要，显示在记录列表中
+    QList<DissectorField> fields;
+    bool error = false;         ///< 校验失败、格式错误等
+};
+
+/**
+ * @class IDissector
+ * @brief 一个数据流上的解析器实例
+ */
+class IDissector
+{
+public:
+    /**
+     * @brief 宿主在调用 dissect() 前如何对接收数据分帧
+     */
+    enum class Framing
+    {
+        Lines,  ///< 按 '\n' 分行（去掉行尾 '\r'），每次 dissect() 一行
+        Raw     ///< 原样传入接收到的数据块，由解析器自行分帧
+    };
+
+    virtual ~IDissector() = default;
+
+    virtual Framing framing() const { return Framing::Lines; }
+
+    /**
+     * @brief 解析一帧（或一个原始数据块），把完成的记录追加到 out
+     */
+    virtual void dissect(const QByteArray &frame, qint64 timestampMs, QList<DissectedRecord> *out) = 0;
+
+    /**
+     * @brief 数据流不连续（断开、队列溢出丢弃数据）时调用，应丢弃未完成的帧
+     */
+    virtual void reset() {}
+};
+
+/**
+ * @class IDissectorFactory
+ * @brief 插件入口
+ */
+class IDissectorFactory
+{
+public:
+    virtual ~IDissectorFactory() = default;
+
+    virtual QString name() const = 0;           ///< 唯一名称，如 "NMEA 0183"
+    virtual QString description() const = 0;
+    virtual IDissector *create() = 0;           ///< 新实例，所有权交给调用方
+};
+
+#define SCOM_DISSECTOR_FACTORY_IID "com.scom-x.IDissectorFactory/1.0"
+Q_DECLARE_INTERFACE(IDissectorFactory, SCOM_DISSECTOR_FACTORY_IID)
+
+#endif // DISSECTOR_INTERFACE_H
@@ -0,0 +1,60 @@
+#ifndef LAZY_PAGE_H
+#define LAZY_PAGE_H
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+/**
+ * @class LazyPage
+ * @brief 按需构建的页面/对话框持有者
+ *
+ * 只保存工厂函数，第一次 get() 时才构建实例；布尔转换和 peek()
+ * 只反映是否已构建，不会触发构建，因此"已创建才隐藏"之类的代码
+ * 可以照常写 if (page) page->hide()。
+ */
+template <typename T>
+class LazyPage
+{
+public:
+    using Factory = std::function<std::unique_ptr<T>()>;
+
+    LazyPage() = default;
+    explicit LazyPage(Factory factory)
+        : m_factory(std::move(factory))
+    {
+    }
+
+    void setFactory(Factory factory)
+    {
+        m_factory = std::move(factory);
+    }
+
+    /**
+     * @brief 获取实例，首次调用时构建（工厂返回空时下次再试）
+     */
+    T *get()
+    {
+        if (!m_instance && m_factory)
+        {
+            m_instance = m_factory();
+        }
+        return m_instance.get();
+    }
+
+    /**
+     * @brief 获取已构建的实例，未构建返回 nullptr
+     */
+    T *peek() const { return m_instance.get(); }
+
+    bool isCreated() const { return m_instance != nullptr; }
+    explicit operator bool() const { return isCreated(); }
+
+    void reset() { m_instance.reset(); }
+
+private:
+    Factory m_factory;
+    std::unique_ptr<T> m_instance;
+};
+
+#endif // LAZY_PAGE_H
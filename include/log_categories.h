@@ -0,0 +1,20 @@
+#ifndef LOG_CATEGORIES_H
+#define LOG_CATEGORIES_H
+
+#include <QLoggingCategory>
+
+/**
+ * @file log_categories.h
+ * @brief 应用日志分类
+ *
+ * 使用 qCDebug/qCInfo/qCWarning(lcXxx) 记录日志。分类被禁用的级别在
+ * 调用点直接短路，不会格式化参数；运行期级别由 LogManager::setMinimumLevel 控制。
+ */
+
+Q_DECLARE_LOGGING_CATEGORY(lcMain)     ///< scom.main   启动与生命周期
+Q_DECLARE_LOGGING_CATEGORY(lcUi)       ///< scom.ui     界面与页面
+Q_DECLARE_LOGGING_CATEGORY(lcSerial)   ///< scom.serial 串口
+Q_DECLARE_LOGGING_CATEGORY(lcConfig)   ///< scom.config 配置
+Q_DECLARE_LOGGING_CATEGORY(lcLog)      ///< scom.log    日志系统自身
+
+#endif // LOG_CATEGORIES_H
@@ -0,0 +1,99 @@
+#ifndef LOG_FILE_VIEW_H
+#define LOG_FILE_VIEW_H
+
+#include <QAbstractScrollArea>
+#include <QFile>
+#include <QString>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class QThread;
+
+/**
+ * @class LogFileView
+ * @brief 大日志文件只读视图
+ *
+ * 文件以 QFile::map 内存映射，后台线程用普通分块读取建立稀疏行索引
+ * （每 64 行记录一次起始偏移，2 GB / 2000 万行约 2.5 MB），绘制时只解码
+ * 可见的几十行。打开即可滚动，索引边建边扩展滚动范围；只有真正显示过的
+ * 页面会被映射进内存，常驻内存与文件大小无关。
+ *
+ * 仍在写入的活动日志（live）不做映射：文件随时可能被截断，映射页落在文件末尾
+ * 之后时访问会触发 SIGBUS（Windows 上映射还会让截断失败）。这种文件在绘制时
+ * 按可见区域用 QFile::read 读取一个有上限的窗口。
+ */
+class LogFileView : public QAbstractScrollArea {
+    Q_OBJECT
+
+public:
+    explicit LogFileView(QWidget *parent = nullptr);
+    ~LogFileView() override;
+
+    /**
+     * @param live 文件仍在被写入（可能被截断），不做内存映射
+     */
+    bool openFile(const QString &filePath, bool live = false);
+    void closeFile();
+
+    // 文件追加后重新映射并从上次索引的位置继续；文件被截断或替换时重新打开
+    void reload();
+
+    QString filePath() const { return path; }
+    QString errorString() const { return lastError; }
+    qint64 fileSize() const { return fileBytes; }
+    qint64 lineCount() const;
+    bool isIndexing() const { return indexing; }
+
+    void scrollToLine(qint64 line);
+    void setFollowTail(bool follow);
+
+signals:
+    void indexProgress(qint64 indexedBytes, qint64 totalBytes, qint64 lineCount);
+    void indexFinished(qint64 lineCount);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    bool mapFile();
+    void unmapFile();
+    void startIndexing();
+    void stopIndexing();
+    void onIndexBatch(quint64 generation, const std::vector<qint64> &sparse,
+                      qint64 lines, qint64 lastLineEnd, bool done);
+    const char *window(qint64 from, qint64 *available);
+    void updateScrollBars();
+
+    static constexpr int kSparseStep = 64;       // 每隔多少行记录一次偏移
+    static constexpr int kMaxLineBytes = 4096;   // 单行最多解码的字节数
+    static constexpr qint64 kLiveWindowBytes = 1024 * 1024;  // live 文件每次绘制最多读取的字节数
+
+    QString path;
+    QString lastError;
+    QFile file;
+    bool live = false;
+    const uchar *mapped = nullptr;
+    qint64 fileBytes = 0;       // 打开或上次 reload 时的文件大小，索引和绘制都不超过它
+    QByteArray fileHead;
+
+    // live 文件最近一次读取的窗口，滚动时在窗口内则复用
+    QByteArray liveWindow;
+    qint64 liveWindowStart = 0;
+
+    // 稀疏行索引：sparseOffsets[k] 为第 k*kSparseStep 行的起始偏移
+    std::vector<qint64> sparseOffsets;
+    qint64 completeLines = 0;   // 已索引的完整行数（以换行符结尾）
+    qint64 indexedEnd = 0;      // 最后一个已索引换行符之后的偏移
+
+    std::unique_ptr<QThread> indexThread;
+    std::shared_ptr<std::atomic<bool>> indexCancelled;
+    quint64 indexGeneration = 0;
+    bool indexing = false;
+
+    bool followTail = false;
+    int maxLineWidth = 0;
+};
+
+#endif // LOG_FILE_VIEW_H
@@ -0,0 +1,47 @@
+#ifndef LOG_FILTER_BAR_H
+#define LOG_FILTER_BAR_H
+
+#include <QWidget>
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDateTimeEdit>
+#include <QTimer>
+
+#include "log_search.h"
+
+/**
+ * @class LogFilterBar
+ * @brief 日志过滤条件输入栏
+ *
+ * 关键词 / 正则、最低级别、时间范围。输入变化经防抖后发出 queryChanged，
+ * 由使用方交给 LogSearchEngine 在后台执行。
+ */
+class LogFilterBar : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit LogFilterBar(QWidget *parent = nullptr);
+
+    LogSearchQuery query() const;
+
+    void setPlaceholderText(const QString &text);
+    QLineEdit *lineEdit() const { return searchLineEdit; }
+
+signals:
+    // 过滤条件变化（已防抖）
+    void queryChanged();
+
+private:
+    void scheduleQueryChanged();
+
+    QLineEdit *searchLineEdit = nullptr;
+    QCheckBox *regexCheckBox = nullptr;
+    QComboBox *levelComboBox = nullptr;
+    QCheckBox *timeRangeCheckBox = nullptr;
+    QDateTimeEdit *fromDateTimeEdit = nullptr;
+    QDateTimeEdit *toDateTimeEdit = nullptr;
+    QTimer debounceTimer;
+};
+
+#endif // LOG_FILTER_BAR_H
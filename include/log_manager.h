@@ -2,15 +2,22 @@
 #define LOG_MANAGER_H
 
 #include <QString>
+#include <QStringList>
 #include <QVector>
 #include <QMutex>
 #include <QDateTime>
+#include <QtGlobal>
+#include <atomic>
+
+class QLoggingCategory;
 
 /**
  * @class LogManager
  * @brief 全局日志管理器
  * 
- * 单例模式，用于管理应用的日志记录
+ * 单例模式，用于管理应用的日志记录。
+ * initialize() 安装 Qt 消息处理器，所有 qDebug/qCInfo 等输出统一格式化为
+ * "[时间] [级别] [分类] 消息"（UTF-8），经 AsyncLogWriter 批量写入 application.log。
  */
 class LogManager {
 public:
@@ -18,19 +25,41 @@ public:
     
     void initialize();
     
-    // 日志统计结构
+    // 运行期最低日志级别（低于该级别的分类日志在调用点即被短路）
+    void setMinimumLevel(QtMsgType level);
+    QtMsgType minimumLevel() const;
+    
+    // "debug" / "info" / "warning" / "critical" 与 QtMsgType 互转
+    static QtMsgType levelFromString(const QString &name);
+    static QString levelName(QtMsgType type);
+    
+    // 日志统计结构（写入时以原子计数增量维护，读取不访问磁盘）
     struct LogStats {
-        int debugCount = 0;
-        int infoCount = 0;
-        int warningCount = 0;
-        int criticalCount = 0;
-        int fileSize = 0;
+        qint64 debugCount = 0;
+        qint64 infoCount = 0;
+        qint64 warningCount = 0;
+        qint64 criticalCount = 0;
+        qint64 fatalCount = 0;
+        qint64 totalCount = 0;
+        qint64 bytesWritten = 0;      // 本次运行写入的字节数
+        qint64 fileSize = 0;          // 活动日志文件的当前大小（轮转后从零计，不含已轮转分段）
+        qint64 entriesPerMinute = 0;  // 最近 60 秒的条数
+        qint64 bytesPerMinute = 0;    // 最近 60 秒的字节数
+        
+        QString summary() const;
     };
     
     LogStats getStats() const;
     
+    // 内存环形缓冲中的最近日志（不访问磁盘）
+    // afterSequence 之后的条目，最多 maxCount 条；lastSequence 返回最新序号
+    QStringList getRecentEntries(int maxCount, quint64 afterSequence = 0, quint64 *lastSequence = nullptr) const;
+    
     QString getLastLogs(int lineCount) const;
     
+    // 从文件末尾按块向前读取最后 lineCount 个非空行，耗时只与读取的行数成正比
+    static QString readLastLines(const QString &filePath, int lineCount);
+    
     bool exportLogs(const QString &filePath) const;
     
     QString getLogFilePath() const;
@@ -46,12 +75,34 @@ private:
     void createLogDirectory();
     void createLogFile();
     
+    static void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg);
+    static void categoryFilter(QLoggingCategory *category);
+    static int severityOf(QtMsgType type);
+    
+    void recordEntry(QtMsgType type, const QString &line, qint64 bytes);
+    
+    // 每秒一个桶，滚动统计最近 60 秒的速率
+    struct RateBucket {
+        std::atomic<qint64> second{-1};
+        std::atomic<qint64> count{0};
+        std::atomic<qint64> bytes{0};
+    };
+    static const int RATE_BUCKETS = 60;
+    
     QString logDirPath;
     QString logFilePath;
     QString configFilePath;
     
+    std::atomic<int> minimumSeverity{0};
+    
+    std::atomic<qint64> levelCounts[5] = {};
+    std::atomic<qint64> bytesWritten{0};
+    qint64 initialFileSize = 0;
+    RateBucket rateBuckets[RATE_BUCKETS];
+    
     mutable QMutex mutex;
-    mutable QVector<QString> memoryBuffer;
+    mutable QVector<QString> memoryBuffer;   // 环形缓冲，按 memorySequence 取模定位
+    quint64 memorySequence = 0;              // 已写入环形缓冲的总条数
     static const int MAX_MEMORY_LINES = 10000;
 };
 
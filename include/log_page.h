@@ -6,6 +6,11 @@
 #include <QPushButton>
 #include <QLineEdit>
 #include <QLabel>
+#include <QTimer>
+
+#include "log_search.h"
+
+class LogFilterBar;
 
 /**
  * @class LogPage
@@ -27,22 +32,42 @@ private slots:
     void onRefreshButtonClicked();
     void onClearLogsButtonClicked();
     void onExportButtonClicked();
-    void onSearchTextChanged(const QString &text);
+    void onSearchQueryChanged();
+    void onSearchResults(quint64 generation, const QStringList &lines);
+    void onSearchFinished(quint64 generation, int matchCount, bool truncated);
+    void onStatsTimerTimeout();
 
 private:
     void setupUI();
     void connectSignals();
 
     // UI 组件
-    QLineEdit *searchLineEdit = nullptr;
+    LogFilterBar *filterBar = nullptr;
     QPushButton *refreshButton = nullptr;
     QPushButton *clearButton = nullptr;
     QPushButton *exportButton = nullptr;
     QPlainTextEdit *logDisplay = nullptr;
     QLabel *statsLabel = nullptr;
 
-    // 完整的日志内容（用于搜索和过滤）
-    QString fullLogContent;
+    // 最近的日志行（环形，最多 kMaxLoadedLines 行；清除过滤时据此恢复视图）
+    QStringList logLines;
+    
+    // 实时统计与增量追加（数据来自 LogManager 内存环形缓冲）
+    QTimer statsTimer;
+    QLabel *liveStatsLabel = nullptr;
+    quint64 lastSequence = 0;
+    
+    // 后台搜索（全文件范围，结果流式追加到视图）
+    LogSearchEngine *searchEngine = nullptr;
+    LogLineMatcher activeMatcher;       // 用于过滤搜索完成后实时追加的新行
+    bool searchActive = false;
+    quint64 searchGeneration = 0;
+    int searchMatchCount = 0;
+    QStringList entriesDuringSearch;    // 搜索进行中到达的新行，完成后再追加
+
+    static constexpr int kMaxLoadedLines = 10000;
+    // 视图行数上限（不小于搜索结果上限），超出后丢弃最早的行
+    static constexpr int kMaxDisplayLines = 100000;
 };
 
 #endif // LOG_PAGE_H
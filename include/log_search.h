@@ -0,0 +1,232 @@
+#ifndef LOG_SEARCH_H
+#define LOG_SEARCH_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QByteArrayMatcher>
+#include <QDateTime>
+#include <QRegularExpression>
+#include <QThreadPool>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QVector>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 日志搜索条件
+ */
+struct LogSearchQuery
+{
+    QString text;               ///< 关键词或正则表达式，空表示不按内容过滤
+    bool useRegex = false;
+    bool caseSensitive = false;
+    int minSeverity = 0;        ///< 0=DEBUG 1=INFO 2=WARN 3=ERROR 4=FATAL
+    QDateTime from;             ///< 无效表示不限
+    QDateTime to;
+    int maxResults = 50000;     ///< 结果条数上限，达到后停止搜索
+
+    /**
+     * @brief 没有任何过滤条件
+     */
+    bool isEmpty() const;
+};
+
+/**
+ * @class LogLineMatcher
+ * @brief 编译后的单行匹配器
+ *
+ * 日志行格式为 "[yyyy-MM-dd hh:mm:ss.zzz] [LEVEL] ..."（应用日志与操作日志相同）。
+ * 时间范围按固定宽度时间戳做字节比较，级别只解析第二个方括号，不做完整的日期解析。
+ * 纯 ASCII 关键词走 QByteArrayMatcher 字节匹配，其余情况回退到 QString 比较。
+ */
+class LogLineMatcher
+{
+public:
+    explicit LogLineMatcher(const LogSearchQuery &query = LogSearchQuery());
+
+    bool isValid() const;
+    QString errorString() const;
+
+    /**
+     * @brief 判断单行是否匹配（GUI 线程上过滤实时追加的少量新行）
+     */
+    bool matches(const QString &line) const;
+
+    /**
+     * @brief 对 UTF-8 原始行做匹配
+     * @param line 原始行（不含换行符）
+     * @param lowered 同一行的 ASCII 小写副本，仅大小写不敏感时使用
+     */
+    bool matchesUtf8(const char *line, const char *lowered, int length) const;
+
+    /**
+     * @brief 解析行首的时间戳与级别
+     * @param timestamp 输出 23 字节时间戳的起始位置
+     * @param severity 输出级别（非标准级别如 SEND/CMD 视为 INFO）
+     * @return 行首不是标准格式时返回 false
+     */
+    static bool parseHeader(const char *line, int length, const char **timestamp, int *severity);
+
+    static void toLowerAscii(const char *src, char *dst, qsizetype length);
+
+    bool hasHeaderFilter() const { return m_hasTimeFilter || m_minSeverity > 0; }
+    bool needsLowered() const { return m_byteLiteral && !m_caseSensitive; }
+
+    const LogSearchQuery &query() const { return m_query; }
+
+    /**
+     * @brief 用于索引剪枝的小写 ASCII 字面量（正则或非 ASCII 关键词时为空）
+     */
+    const QByteArray &indexLiteral() const { return m_indexLiteral; }
+    const QByteArray &fromKey() const { return m_fromKey; }
+    const QByteArray &toKey() const { return m_toKey; }
+    bool hasTimeFilter() const { return m_hasTimeFilter; }
+    int minSeverity() const { return m_minSeverity; }
+
+    static constexpr int kTimestampLength = 23;
+
+private:
+    LogSearchQuery m_query;
+    bool m_valid = true;
+    bool m_caseSensitive = false;
+    bool m_byteLiteral = false;
+    bool m_hasTimeFilter = false;
+    int m_minSeverity = 0;
+    QByteArrayMatcher m_literalMatcher;
+    QRegularExpression m_regex;
+    QByteArray m_fromKey;
+    QByteArray m_toKey;
+    QByteArray m_indexLiteral;
+};
+
+/**
+ * @brief 搜索的一个数据源
+ */
+struct LogSearchSource
+{
+    QString filePath;
+    qint64 endOffset = -1;  ///< 只搜索 [0, endOffset)，-1 表示开始搜索时的文件大小
+};
+
+/**
+ * @class LogSearchEngine
+ * @brief 后台分块日志搜索
+ *
+ * 文件按 1 MiB 切块（块边界对齐到换行符），每块一个任务投递到线程池。
+ * 新的 start() 使旧搜索作废：排队中的任务被移除，运行中的任务定期检查取消标志。
+ * 各块结果在 GUI 线程按文件顺序重排后经 resultsReady 流式发出。
+ *
+ * 可选的块索引（默认开启）在首次完整扫描某块时顺带建立：时间戳最小/最大值、
+ * 出现过的级别集合、小写三元组位图。之后的查询据此整块跳过不可能命中的数据，
+ * 多 GB 日志上按时间/级别/关键词收窄的搜索只需读取少数块。索引只记录已完整
+ * 写入的块，文件被截断或轮转（文件头变化）时整体失效。
+ *
+ * 数据源可以是 LogSegments::allSegments() 给出的全部分段：已压缩的分段
+ * 整体解压后作为一个块扫描，其索引建立后后续查询多数情况下无需再解压。
+ */
+class LogSearchEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LogSearchEngine(QObject *parent = nullptr);
+    ~LogSearchEngine() override;
+
+    /**
+     * @brief 开始新的搜索（自动取消正在进行的搜索）
+     * @return 本次搜索的代号；查询无效（正则错误）时返回 0
+     */
+    quint64 start(const QVector<LogSearchSource> &sources, const LogSearchQuery &query);
+
+    void cancel();
+    bool isRunning() const;
+    quint64 currentGeneration() const { return m_generation; }
+
+    void setIndexEnabled(bool enabled);
+    bool indexEnabled() const;
+    void clearIndex();
+
+    static constexpr qint64 kChunkSize = 1024 * 1024;
+
+signals:
+    /**
+     * @brief 按文件顺序流式发出的匹配行
+     */
+    void resultsReady(quint64 generation, const QStringList &lines);
+
+    /**
+     * @brief 搜索结束
+     * @param truncated 匹配多于 maxResults，超出的部分被丢弃（恰好等于上限不算）
+     */
+    void finished(quint64 generation, int matchCount, bool truncated);
+
+private:
+    struct ChunkIndex
+    {
+        QByteArray minTime;
+        QByteArray maxTime;
+        quint8 severityMask = 0;
+        std::vector<quint64> trigramBits;
+    };
+
+    struct FileIndex
+    {
+        QByteArray head;  ///< 文件开头若干字节，用于识别轮转 / 重建
+        qint64 size = 0;  ///< 上次搜索时的文件大小，变小说明被截断
+        QHash<qint64, std::shared_ptr<const ChunkIndex>> chunks;
+    };
+
+    struct IndexStore
+    {
+        QMutex mutex;
+        QHash<QString, FileIndex> files;
+    };
+
+    struct Job
+    {
+        quint64 generation = 0;
+        std::atomic<bool> cancelled{false};
+        LogLineMatcher matcher;
+        std::shared_ptr<IndexStore> index;  ///< 为空表示不使用索引
+    };
+
+    struct ChunkTask
+    {
+        QString filePath;
+        qint64 chunkNumber = 0;
+        qint64 endOffset = 0;
+        int sequence = 0;
+        bool compressed = false;  ///< 压缩分段整体解压为一个块
+    };
+
+    static void searchChunk(LogSearchEngine *engine, const std::shared_ptr<Job> &job, const ChunkTask &task);
+    static bool readChunk(const ChunkTask &task, QByteArray *buffer, qsizetype *begin, bool *complete);
+    static bool canSkip(const ChunkIndex &index, const LogLineMatcher &matcher);
+    static quint32 trigramHash(uchar a, uchar b, uchar c);
+    static QByteArray readFileHead(const QString &filePath);
+
+    void onChunkFinished(quint64 generation, int sequence, const QStringList &lines);
+    void finish(bool truncated);
+
+    QThreadPool m_pool;
+    std::shared_ptr<Job> m_job;
+    std::shared_ptr<IndexStore> m_index;
+    bool m_indexEnabled = true;
+
+    quint64 m_generation = 0;
+    int m_totalChunks = 0;
+    int m_nextSequence = 0;
+    int m_matchCount = 0;
+    bool m_running = false;
+    QMap<int, QStringList> m_pendingResults;  ///< 乱序完成的块，等待前序块
+
+    static constexpr int kHeadLength = 64;
+    static constexpr int kTrigramBits = 65536;
+};
+
+#endif // LOG_SEARCH_H
@@ -0,0 +1,66 @@
+#ifndef LOG_SEGMENTS_H
+#define LOG_SEGMENTS_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QDateTime>
+
+/**
+ * @class LogSegments
+ * @brief 日志分段（轮转）文件的命名、枚举、压缩与清理
+ *
+ * 活动文件 application.log 轮转后重命名为 application.20261019-101500-123.log，
+ * 随后在后台压缩为 application.20261019-101500-123.log.qz（qCompress 格式）。
+ * 时间戳定宽，按文件名排序即为时间顺序。读取方通过 allSegments() 得到
+ * 从旧到新的完整列表，用 readAll() 透明读取压缩或未压缩的分段。
+ */
+class LogSegments
+{
+public:
+    /**
+     * @brief 生成轮转后的分段文件名（与活动文件同目录）
+     */
+    static QString rotatedPath(const QString &activePath, const QDateTime &time);
+
+    /**
+     * @brief 已轮转的分段（压缩和未压缩），从旧到新，不含活动文件
+     */
+    static QStringList rotatedSegments(const QString &activePath);
+
+    /**
+     * @brief 已轮转的分段 + 活动文件，从旧到新
+     */
+    static QStringList allSegments(const QString &activePath);
+
+    static bool isCompressed(const QString &segmentPath);
+
+    /**
+     * @brief 读取分段全部内容，压缩分段自动解压
+     */
+    static QByteArray readAll(const QString &segmentPath);
+
+    /**
+     * @brief 压缩一个已轮转的分段，成功后删除原文件
+     *
+     * 先写入临时文件再重命名，中途退出不会留下损坏的 .qz。
+     */
+    static bool compress(const QString &segmentPath);
+
+    /**
+     * @brief 压缩所有未压缩的已轮转分段，并只保留最新的 retention 个
+     *
+     * 可在任意线程调用（轮转后由写入器投递到后台线程池）。
+     */
+    static void compressAndPrune(const QString &activePath, int retention);
+
+    /**
+     * @brief 删除全部已轮转分段
+     * @return 删除的文件数
+     */
+    static int removeRotated(const QString &activePath);
+
+    static const char *const kCompressedSuffix;
+};
+
+#endif // LOG_SEGMENTS_H
@@ -9,6 +9,12 @@
 #include <QCheckBox>
 #include <QTimer>
 #include <QTabWidget>
+#include <QFileSystemWatcher>
+#include <QByteArray>
+
+#include "log_search.h"
+
+class LogFilterBar;
 
 class LogViewerDialog : public QDialog {
     Q_OBJECT
@@ -25,41 +31,88 @@ private slots:
     void onRefreshClicked();
     void onClearClicked();
     void onExportClicked();
+    void onLargeFileModeClicked();
     void onSearchChanged();
     void onAutoScrollToggled(bool checked);
-    void onLogMessageAdded(const QString &message);
+    void onLogFileChanged(const QString &path);
     void updateLogDisplay();
+    void updateLogStats();
+
+protected:
+    void showEvent(QShowEvent *event) override;
 
 private:
+    /**
+     * @brief 单个日志文件的增量跟踪状态
+     */
+    struct LogTail {
+        QString filePath;
+        qint64 offset = 0;          // 已读取到的文件偏移
+        QByteArray head;            // 文件开头若干字节，变化说明文件被轮转或替换
+        quint64 rotationsSeen = 0;  // 上次读取时写入器的累计轮转次数
+        QByteArray partialLine;     // 尚未读到换行符的行尾
+        bool skipToLineStart = false; // 从文件中间开始读取时丢弃第一个不完整的行
+        QString content;            // 最近读取的内容，最多 kRetainedChars 字符（导出 / 清除过滤时恢复）
+        QPlainTextEdit *display = nullptr;
+        LogFilterBar *filterBar = nullptr;
+        
+        // 后台搜索：范围截止到开始搜索时已读取的偏移，之后的新行由增量读取按 matcher 过滤
+        LogSearchEngine *searchEngine = nullptr;
+        LogLineMatcher matcher;
+        bool searchActive = false;
+        quint64 searchGeneration = 0;
+        int searchMatchCount = 0;
+        QStringList heldLines;      // 搜索进行中读到的新匹配行，搜索完成后再追加
+    };
+
     void setupUI();
     void loadLogsFromFile();
     void applySearchFilter();
+    void resetTail(LogTail &tail);
+    bool readAppended(LogTail &tail);
+    void consumeBytes(LogTail &tail, QByteArray chunk);
+    void applyTailFilter(LogTail &tail);
+    void appendTailLines(LogTail &tail, const QStringList &lines);
+    void connectSearchEngine(LogTail &tail);
+    void watchLogFiles();
+    void scrollToEnd(QPlainTextEdit *display);
 
     // 标签页
     QTabWidget *tabWidget;
     
     // 调试日志标签页
     QPlainTextEdit *debugLogDisplay;
-    QLineEdit *debugSearchLineEdit;
+    LogFilterBar *debugFilterBar;
     
     // 操作日志标签页
     QPlainTextEdit *operationLogDisplay;
-    QLineEdit *operationSearchLineEdit;
+    LogFilterBar *operationFilterBar;
     QCheckBox *operationAutoScrollCheckBox;
     
     // 通用控件
     QPushButton *refreshButton;
     QPushButton *clearButton;
     QPushButton *exportButton;
+    QPushButton *largeFileButton;
     QPushButton *closeButton;
     QCheckBox *autoScrollCheckBox;
     QLabel *statusLabel;
-    QTimer refreshTimer;
+    QLabel *logStatsLabel;
+    QTimer refreshTimer;        // 兜底轮询（部分平台文件追加不触发通知）
+    QTimer changeDebounceTimer; // 合并短时间内的多次文件变化通知
+    QTimer statsTimer;
+    QFileSystemWatcher fileWatcher;
+
+    static constexpr int kTailHeadLength = 64;
+    // 超过该大小的文件只加载末尾部分，完整内容通过大文件模式查看
+    static constexpr qint64 kFullLoadLimit = 32 * 1024 * 1024;
+    static constexpr qint64 kPartialLoadBytes = 4 * 1024 * 1024;
+    // 持续追加时内存中保留的内容与显示行数上限，超出后丢弃最早的行
+    static constexpr int kRetainedChars = int(kPartialLoadBytes);
+    static constexpr int kMaxDisplayLines = 100000;
 
-    QString allDebugLogsContent;
-    QString allOperationLogsContent;
-    QString debugLogFilePath;
-    QString operationLogFilePath;
+    LogTail debugTail;
+    LogTail operationTail;
 };
 
 #endif // LOG_VIEWER_DIALOG_H
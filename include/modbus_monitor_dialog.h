@@ -0,0 +1,62 @@
+#ifndef MODBUS_MONITOR_DIALOG_H
+#define MODBUS_MONITOR_DIALOG_H
+
+#include <QDialog>
+#include <QTableView>
+#include <QCheckBox>
+#include <QLabel>
+#include <QByteArray>
+#include <QVector>
+#include <QSerialPort>
+
+#include "modbus_rtu.h"
+
+class ModbusRtuDecoder;
+class ModbusFrameModel;
+
+/**
+ * @class ModbusMonitorDialog
+ * @brief Modbus RTU 帧监视窗口
+ *
+ * 持有 ModbusRtuDecoder，创建后即使窗口关闭也持续解码接收数据；
+ * 表格只保留最近 ModbusFrameModel::kMaxFrames 帧，解码描述在显示时才生成。
+ */
+class ModbusMonitorDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit ModbusMonitorDialog(QWidget *parent = nullptr);
+    ~ModbusMonitorDialog() override;
+
+    void setLineParameters(qint32 baudRate,
+                           QSerialPort::DataBits dataBits,
+                           QSerialPort::Parity parity,
+                           QSerialPort::StopBits stopBits);
+
+public slots:
+    void feed(const QByteArray &data);
+    void resetStream();
+
+private slots:
+    void onFramesDecoded(const QVector<ModbusFrame> &frames);
+    void onClearClicked();
+
+private:
+    void setupUI();
+    void updateStats();
+
+    ModbusRtuDecoder *decoder = nullptr;
+    ModbusFrameModel *model = nullptr;
+
+    QTableView *frameView = nullptr;
+    QCheckBox *pauseCheck = nullptr;
+    QCheckBox *errorsOnlyCheck = nullptr;
+    QLabel *statsLabel = nullptr;
+    QLabel *timingLabel = nullptr;
+
+    quint64 frameCount = 0;
+    quint64 crcErrorCount = 0;
+    quint64 exceptionCount = 0;
+};
+
+#endif // MODBUS_MONITOR_DIALOG_H
@@ -0,0 +1,158 @@
+#ifndef MODBUS_POLLER_H
+#define MODBUS_POLLER_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QByteArray>
+#include <QTimer>
+#include <QElapsedTimer>
+
+class SerialPort;
+
+/**
+ * @brief 一个轮询点：某从站某功能码下的一段连续寄存器（或线圈）
+ */
+struct ModbusPollPoint
+{
+    QString name;
+    quint8 slave = 1;
+    quint8 function = 3;        ///< 1/2 读位，3/4 读寄存器
+    quint16 address = 0;
+    quint16 count = 1;
+    int periodMs = 1000;
+
+    // 运行状态
+    QVector<quint16> values;    ///< 寄存器值；位点每个元素为 0/1
+    qint64 updatedMs = -1;      ///< 最近一次成功更新的时刻（ModbusPoller::nowMs()），-1 表示从未更新
+    double latencyMs = -1;      ///< 最近一次成功请求的往返延迟
+    quint64 updates = 0;
+    quint64 errors = 0;         ///< 超时、CRC 错误与异常响应
+};
+
+/**
+ * @brief 合并后的一个读请求，覆盖若干轮询点
+ */
+struct ModbusPollBlock
+{
+    quint8 slave = 1;
+    quint8 function = 3;
+    quint16 address = 0;
+    quint16 count = 0;
+    int periodMs = 1000;        ///< 所含点的最短周期
+    QVector<int> points;        ///< ModbusPoller::points() 中的下标
+    QByteArray request;         ///< 含 CRC 的请求帧
+
+    qint64 nextDueMs = 0;
+    quint64 sent = 0;
+    quint64 timeouts = 0;
+    quint64 exceptions = 0;
+    double avgLatencyMs = 0;    ///< 成功请求延迟的指数平均
+};
+
+/**
+ * @class ModbusPoller
+ * @brief Modbus RTU 主站轮询调度
+ *
+ * 同一从站、同一功能码的点按地址排序后合并成块：两块合并后的每秒总线字符数
+ * （请求 + 响应 + 帧间静默，按合并后的最短周期计）不多于分开轮询时才合并。
+ * 周期相同的相邻/重叠点总会合并；有间隙或周期不同时，按多读的字节与省下的请求开销权衡。
+ *
+ * 总线同一时刻只有一个未完成请求。每当总线空闲（收到响应或超时，再等待帧间延迟），
+ * 立即发送截止时间最早的块（EDF）；过载时各块按截止时间轮流，不会饿死慢速块。
+ *
+ * 响应按预期长度从 SerialPort::rawDataReceived 组帧，自动去掉 RS485 适配器回显的请求。
+ */
+class ModbusPoller : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ModbusPoller(SerialPort *serialPort, QObject *parent = nullptr);
+    ~ModbusPoller() override;
+
+    /**
+     * @brief 解析轮询点定义，每行 "名称 从站 功能码 地址 [数量] 周期ms"，# 开头为注释
+     */
+    static bool parsePoints(const QString &text, QVector<ModbusPollPoint> *points, QString *error);
+
+    /**
+     * @brief 把轮询点合并成请求块（同一从站、功能码内按地址合并）
+     */
+    static QVector<ModbusPollBlock> plan(const QVector<ModbusPollPoint> &points);
+
+    /**
+     * @brief 设置轮询点并重新规划；运行中调用会先停止
+     */
+    void setPoints(const QVector<ModbusPollPoint> &points);
+    const QVector<ModbusPollPoint> &points() const { return m_points; }
+    const QVector<ModbusPollBlock> &blocks() const { return m_blocks; }
+
+    void setResponseTimeoutMs(int ms) { m_responseTimeoutMs = qMax(1, ms); }
+    /**
+     * @brief 收到响应后到发送下一请求的间隔；实际间隔不短于当前串口参数下的 t3.5
+     */
+    void setInterFrameDelayMs(int ms) { m_interFrameDelayMs = qMax(0, ms); }
+    int interFrameDelayMs() const;
+
+    void start();
+    void stop();
+    bool isRunning() const { return m_running; }
+
+    /**
+     * @brief 单调时钟（毫秒），与 ModbusPollPoint::updatedMs 可比
+     */
+    qint64 nowMs() const { return m_clock.elapsed(); }
+
+    /**
+     * @brief 超过 kStaleFactor 个周期没有更新的点视为过期
+     */
+    bool isStale(const ModbusPollPoint &point) const;
+
+    quint64 requestCount() const { return m_requestCount; }
+    quint64 timeoutCount() const { return m_timeoutCount; }
+    quint64 errorCount() const { return m_errorCount; }
+
+    static constexpr int kRequestOverheadChars = 24;  ///< 请求 8 + 响应头尾 5 + 两次 t3.5 + 从站应答时间的估计
+    static constexpr int kMaxRegistersPerRequest = 125;
+    static constexpr int kMaxBitsPerRequest = 2000;
+    static constexpr int kStaleFactor = 3;
+
+signals:
+    void runningChanged(bool running);
+    void blockCompleted(int blockIndex, bool ok);
+
+private slots:
+    void onDataReceived(const QByteArray &data);
+    void onResponseTimeout();
+
+private:
+    void scheduleNext();
+    void sendBlock(int index);
+    void completeBlock(bool ok, bool exception, const QByteArray &frame);
+
+    SerialPort *m_serialPort;
+    QVector<ModbusPollPoint> m_points;
+    QVector<ModbusPollBlock> m_blocks;
+
+    bool m_running = false;
+    int m_outstanding = -1;         ///< 等待响应的块
+    qint64 m_sentAtNs = 0;
+    qint64 m_busFreeAtMs = 0;       ///< 帧间延迟结束的时刻
+    QByteArray m_rxBuffer;
+    bool m_echoChecked = false;     ///< 已判断响应开头是否为请求回显
+
+    int m_responseTimeoutMs = 200;
+    int m_interFrameDelayMs = 5;
+    qint64 m_silentUs = 1750;       ///< 当前串口参数下的 t3.5，start() 时计算
+
+    QElapsedTimer m_clock;
+    QTimer m_sendTimer;
+    QTimer m_timeoutTimer;
+
+    quint64 m_requestCount = 0;
+    quint64 m_timeoutCount = 0;
+    quint64 m_errorCount = 0;
+};
+
+#endif // MODBUS_POLLER_H
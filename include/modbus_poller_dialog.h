@@ -0,0 +1,55 @@
+#ifndef MODBUS_POLLER_DIALOG_H
+#define MODBUS_POLLER_DIALOG_H
+
+#include <QDialog>
+#include <QPlainTextEdit>
+#include <QTableWidget>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QLabel>
+#include <QTimer>
+
+class SerialPort;
+class ModbusPoller;
+
+/**
+ * @class ModbusPollerDialog
+ * @brief Modbus 主站轮询窗口：编辑轮询点、查看合并后的请求与各点的值、过期状态和延迟
+ */
+class ModbusPollerDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit ModbusPollerDialog(SerialPort *serialPort, QWidget *parent = nullptr);
+    ~ModbusPollerDialog() override;
+
+private slots:
+    void onApplyClicked();
+    void onStartStopClicked();
+    void onRunningChanged(bool running);
+    void refreshTable();
+
+private:
+    void setupUI();
+    bool applyPoints();
+    void rebuildTable();
+
+    static constexpr int kRefreshIntervalMs = 200;
+
+    ModbusPoller *poller = nullptr;
+
+    QPlainTextEdit *pointsEdit = nullptr;
+    QLabel *errorLabel = nullptr;
+    QLabel *planLabel = nullptr;
+    QSpinBox *timeoutSpin = nullptr;
+    QSpinBox *delaySpin = nullptr;
+    QPushButton *startStopButton = nullptr;
+    QTableWidget *pointTable = nullptr;
+    QLabel *statsLabel = nullptr;
+    QTimer refreshTimer;
+
+    quint64 lastRequestCount = 0;
+    qint64 lastRefreshMs = 0;
+};
+
+#endif // MODBUS_POLLER_DIALOG_H
@@ -0,0 +1,120 @@
+#ifndef MODBUS_RTU_H
+#define MODBUS_RTU_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @brief 一个 Modbus RTU 帧及其解码结果
+ */
+struct ModbusFrame
+{
+    enum class Kind
+    {
+        Request,    ///< 主站请求
+        Response,   ///< 从站正常响应
+        Exception,  ///< 从站异常响应（功能码最高位置 1）
+        Unknown     ///< 功能码不认识或长度不符，只保留原始字节
+    };
+
+    qint64 timestampMs = 0;     ///< 帧首字节所在数据块的接收时间（毫秒时间戳）
+    QByteArray bytes;           ///< 含 CRC 的完整帧
+    bool crcOk = false;
+    Kind kind = Kind::Unknown;
+    quint8 slave = 0;
+    quint8 function = 0;        ///< 去掉异常标志位后的功能码
+    quint8 exceptionCode = 0;
+    quint16 address = 0;        ///< 请求中的起始地址 / 写单个时的地址
+    quint16 quantity = 0;       ///< 请求中的数量；读响应中为数据项数
+    QVector<quint16> registers; ///< 读/写寄存器的值（03/04 响应、06、16 请求）
+    QByteArray data;            ///< 01/02 响应、15 请求的位数据，以及无法细分的负载
+
+    /**
+     * @brief 单行可读描述，如 "读保持寄存器 响应 2 个: 0x0001 0x00FF"
+     */
+    QString describe() const;
+};
+
+/**
+ * @class ModbusRtu
+ * @brief Modbus RTU 功能码、异常码的名称与帧解码
+ */
+class ModbusRtu
+{
+public:
+    static QString functionName(quint8 function);
+    static QString exceptionName(quint8 code);
+    static QString kindName(ModbusFrame::Kind kind);
+
+    /**
+     * @brief 根据帧头推算可能的帧长（请求和响应各一种），数据不足以判断时返回空
+     */
+    static QVector<int> expectedLengths(const uchar *data, int size);
+
+    /**
+     * @brief 解码一个完整帧（bytes 与 crcOk 由调用方填入）
+     */
+    static void decode(ModbusFrame *frame);
+
+    /**
+     * @brief 3.5 字符静默时间（微秒）；波特率高于 19200 时按规范固定为 1750 µs
+     * @param bitsPerChar 起始位 + 数据位 + 校验位 + 停止位
+     */
+    static qint64 silentIntervalUs(qint32 baudRate, double bitsPerChar);
+};
+
+/**
+ * @class ModbusRtuFramer
+ * @brief 按 3.5 字符静默时间对接收字节流分帧
+ *
+ * 数据块带有接收时刻（单调时钟），块首字节的到达时间按块长和字符时间反推，
+ * 与上一块末字节的间隔超过 t3.5 即为帧边界。
+ *
+ * USB 转串口驱动会把一帧拆成几块（间隔可达十几毫秒），也会把紧挨的几帧合成一块，
+ * 所以边界只作为候选：CRC 不通过时按功能码推算的帧长在块内切分，
+ * 仍不完整的前缀暂存，等待后续数据，超过 kMaxReassemblyGapUs 仍不完整才作为错误帧输出。
+ *
+ * 非线程安全，由 ModbusRtuDecoder 在工作线程中使用。
+ */
+class ModbusRtuFramer
+{
+public:
+    void setLineTiming(qint64 charTimeUs, qint64 silentIntervalUs);
+    qint64 silentIntervalUs() const { return m_silentUs; }
+
+    /**
+     * @param timeUs 数据块的接收时刻（单调时钟，微秒）
+     * @param epochMs 同一时刻的墙钟时间，用于帧时间戳
+     */
+    void feed(const char *data, int size, qint64 timeUs, qint64 epochMs, QVector<ModbusFrame> *out);
+
+    /**
+     * @brief 距最后一个字节已超过静默时间时结束当前帧
+     */
+    void flush(qint64 nowUs, QVector<ModbusFrame> *out);
+
+    /**
+     * @brief 下一次需要调用 flush() 的时刻，没有未结束的数据时返回 -1
+     */
+    qint64 nextDeadlineUs() const;
+
+    void reset();
+
+    static constexpr qint64 kMaxReassemblyGapUs = 20000;
+    static constexpr int kMaxFrameSize = 256;
+
+private:
+    void finish(bool final, QVector<ModbusFrame> *out);
+    void emitFrame(int offset, int length, bool crcOk, QVector<ModbusFrame> *out);
+
+    QByteArray m_buffer;
+    qint64 m_lastUs = 0;
+    qint64 m_frameEpochMs = 0;
+    bool m_waitingForRest = false;  ///< 缓冲区是一帧的前半部分，等待后续数据
+    qint64 m_charUs = 87;           ///< 115200 8N1
+    qint64 m_silentUs = 1750;
+};
+
+#endif // MODBUS_RTU_H
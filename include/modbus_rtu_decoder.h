@@ -0,0 +1,77 @@
+#ifndef MODBUS_RTU_DECODER_H
+#define MODBUS_RTU_DECODER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QVector>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QSerialPort>
+
+#include "modbus_rtu.h"
+
+class QThread;
+class QTimer;
+
+/**
+ * @class ModbusRtuDecoder
+ * @brief 在独立线程中对接收数据做 Modbus RTU 分帧与解码
+ *
+ * feed() 在调用线程（串口所在的 GUI 线程）只记录接收时刻并投递数据，
+ * 分帧、CRC 校验和解码都在工作线程完成；解码结果合并成批次回到 GUI 线程，
+ * 每批发出一次 framesDecoded()，每秒上千帧时 GUI 线程也只处理少量事件。
+ */
+class ModbusRtuDecoder : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ModbusRtuDecoder(QObject *parent = nullptr);
+    ~ModbusRtuDecoder() override;
+
+    /**
+     * @brief 按串口参数计算字符时间与 3.5 字符静默时间
+     */
+    void setLineParameters(qint32 baudRate,
+                           QSerialPort::DataBits dataBits,
+                           QSerialPort::Parity parity,
+                           QSerialPort::StopBits stopBits);
+
+    /**
+     * @brief 每字符位数：起始位 + 数据位 + 校验位 + 停止位
+     */
+    static double bitsPerChar(QSerialPort::DataBits dataBits,
+                              QSerialPort::Parity parity,
+                              QSerialPort::StopBits stopBits);
+
+    void feed(const QByteArray &data);
+
+    /**
+     * @brief 丢弃未完成的帧（断开或重新配置时调用）
+     */
+    void reset();
+
+    qint64 silentIntervalUs() const { return m_silentUs; }
+
+signals:
+    void framesDecoded(const QVector<ModbusFrame> &frames);
+
+private:
+    void setupWorker();     // 在工作线程中执行
+    void scheduleFlush();   // 在工作线程中执行
+    void deliver(QVector<ModbusFrame> frames);  // 在工作线程中执行
+
+    QThread *m_workerThread = nullptr;
+    QObject *m_workerContext = nullptr;  ///< 工作线程中的定时器与投递目标
+    QTimer *m_flushTimer = nullptr;      ///< 属于工作线程
+    ModbusRtuFramer m_framer;            ///< 只在工作线程中访问
+    QElapsedTimer m_clock;
+
+    qint64 m_silentUs = 1750;
+
+    QMutex m_pendingMutex;
+    QVector<ModbusFrame> m_pending;
+    bool m_deliveryScheduled = false;
+};
+
+#endif // MODBUS_RTU_DECODER_H
@@ -3,10 +3,21 @@
 
 #include <QString>
 #include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <atomic>
 #include <memory>
 
+class QTimer;
+
 /**
  * @brief 操作日志记录器 - 记录用户所有操作
+ *
+ * 日志记录经 AsyncLogWriter 异步批量写入，调用方只承担格式化和入队开销
+ *
+ * 收发数据审计（logDataSent/logDataReceived）按方向独立采样与限流：每块数据
+ * 只做几次原子计数，只有被采样且未超过每秒上限的块才格式化十六进制预览并入队；
+ * 其余块计入周期性汇总记录（"N 字节 / M 块 / T ms"），审计默认关闭。
  */
 class OperationLogger : public QObject {
     Q_OBJECT
@@ -20,8 +31,8 @@ public:
     // 记录各种操作日志
     void logSerialConnect(const QString &port, int baudRate);
     void logSerialDisconnect();
-    void logDataSent(const QString &data, int bytes);
-    void logDataReceived(const QString &data, int bytes);
+    void logDataSent(const QByteArray &data);
+    void logDataReceived(const QByteArray &data);
     void logCommandExecuted(const QString &command);
     void logPageSwitch(const QString &pageName);
     void logSettingChanged(const QString &settingName, const QString &oldValue, const QString &newValue);
@@ -31,6 +42,31 @@ public:
     
     // 获取日志文件路径
     QString getLogFilePath() const { return logFilePath; }
+    
+    // 后台批量写入的刷新间隔（毫秒）
+    void setFlushInterval(int ms);
+    
+    // 同步刷出尚未落盘的日志
+    void flush();
+    
+    // 单方向的数据审计策略
+    struct DataAuditDirection {
+        int sampleEvery = 100;      // 每 N 块记录一条明细，0 表示只汇总
+        int maxRecordsPerSec = 10;  // 每秒明细记录上限，0 表示不限
+    };
+    
+    // 收发数据审计策略
+    struct DataAuditPolicy {
+        bool enabled = false;
+        DataAuditDirection tx;
+        DataAuditDirection rx;
+        int previewBytes = 32;        // 明细中十六进制预览的最大字节数
+        int summaryIntervalMs = 5000; // 汇总记录间隔，0 表示不写汇总
+    };
+    
+    // 需在 GUI 线程调用（汇总定时器归属 GUI 线程）
+    void setDataAuditPolicy(const DataAuditPolicy &policy);
+    DataAuditPolicy dataAuditPolicy() const;
 
 signals:
     void logMessageAdded(const QString &message);
@@ -39,10 +75,35 @@ private:
     OperationLogger();
     ~OperationLogger();
     
+    // 单方向的审计计数，数据路径上只做原子操作
+    struct DataAuditState {
+        std::atomic<int> sampleEvery{100};
+        std::atomic<int> maxRecordsPerSec{10};
+        std::atomic<quint64> chunkCounter{0};     // 采样计数
+        std::atomic<qint64> rateWindowSec{-1};    // 限流窗口所在的秒
+        std::atomic<int> rateWindowRecords{0};    // 本秒已写的明细条数
+        std::atomic<quint64> windowBytes{0};      // 以下为当前汇总窗口的累计
+        std::atomic<quint64> windowChunks{0};
+        std::atomic<quint64> windowRecords{0};
+        std::atomic<quint64> windowDropped{0};    // 被采样命中但因限流丢弃
+    };
+    
     void writeLog(const QString &level, const QString &message);
     QString formatTimestamp();
+    void auditData(DataAuditState &state, const char *level, const char *direction, const QByteArray &data);
+    void writeDataSummary(DataAuditState &state, const char *direction, qint64 elapsedMs);
+    void writeDataSummaries();
     
     QString logFilePath;
+    
+    std::atomic<bool> auditEnabled{false};
+    std::atomic<int> auditPreviewBytes{32};
+    int auditSummaryIntervalMs = 5000;
+    DataAuditState txAudit;
+    DataAuditState rxAudit;
+    QElapsedTimer auditClock;
+    qint64 summaryWindowStart = 0;
+    QTimer *summaryTimer = nullptr;
 };
 
 #endif // OPERATION_LOGGER_H
@@ -0,0 +1,57 @@
+#ifndef RECEIVE_HEX_VIEW_H
+#define RECEIVE_HEX_VIEW_H
+
+#include <QAbstractScrollArea>
+#include <QVector>
+
+#include "receive_search.h"
+
+class ReceiveStore;
+
+/**
+ * @class ReceiveHexView
+ * @brief 原始接收数据的十六进制视图
+ *
+ * 每行 16 字节（偏移 / 十六进制 / ASCII），绘制时只从 ReceiveStore 读取可见的几十行。
+ * 匹配列表按偏移有序，高亮时二分查找落在可见范围内的匹配，不遍历全部结果，
+ * 百万级匹配也只影响搜索本身。
+ */
+class ReceiveHexView : public QAbstractScrollArea {
+    Q_OBJECT
+
+public:
+    explicit ReceiveHexView(const ReceiveStore *store, QWidget *parent = nullptr);
+
+    /**
+     * @brief 匹配列表由调用方持有，内容变化后调用 viewport()->update()
+     */
+    void setMatches(const QVector<ReceiveMatch> *matches);
+    void setCurrentMatch(int index);
+
+    void scrollToOffset(qint64 offset);
+
+    /**
+     * @brief 存储追加或丢弃数据后更新滚动范围，保持当前显示的位置不动
+     */
+    void refresh();
+
+    static constexpr int kBytesPerRow = 16;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    qint64 firstRow() const;
+    qint64 rowCount() const;
+    void updateScrollBars();
+
+    static constexpr int kMaxBacktrack = 256;  // 向前查找跨入可见范围的匹配时最多回退的条数
+
+    const ReceiveStore *store;
+    const QVector<ReceiveMatch> *matches = nullptr;
+    int currentMatch = -1;
+    qint64 topRow = 0;      ///< 绝对行号（偏移 / 16），存储丢弃旧数据时保持不变
+};
+
+#endif // RECEIVE_HEX_VIEW_H
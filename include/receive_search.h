@@ -0,0 +1,147 @@
+#ifndef RECEIVE_SEARCH_H
+#define RECEIVE_SEARCH_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QThreadPool>
+#include <QMap>
+#include <QVector>
+#include <atomic>
+#include <memory>
+
+#include "receive_store.h"
+
+/**
+ * @brief 接收数据搜索条件
+ */
+struct ReceiveSearchQuery
+{
+    enum class Mode
+    {
+        Text,   ///< UTF-8 字节序列；不区分大小写时只折叠 ASCII 字母
+        Hex,    ///< 十六进制字节，"??" 匹配任意字节，如 "AA 55 ?? 01"
+        Regex   ///< 正则表达式，按字节匹配（每个字节视为一个 Latin-1 字符），多行模式
+    };
+
+    Mode mode = Mode::Text;
+    QString pattern;
+    bool caseSensitive = false;
+    int maxResults = 1000000;   ///< 结果个数上限，达到后停止搜索
+};
+
+/**
+ * @brief 一个匹配：会话内的绝对偏移与长度
+ */
+struct ReceiveMatch
+{
+    qint64 offset = 0;
+    int length = 0;
+};
+
+/**
+ * @class BytePattern
+ * @brief 带通配符的字节模式，Boyer-Moore-Horspool 扫描
+ *
+ * 跳转表只由最后一个通配符之后的字节决定，通配符越靠后跳得越短；
+ * 单字节模式直接用 memchr。
+ */
+class BytePattern
+{
+public:
+    BytePattern() = default;
+    BytePattern(const QByteArray &bytes, const QByteArray &wildcards, bool caseSensitive);
+
+    /**
+     * @brief 解析十六进制模式，允许空格、逗号和 0x 前缀
+     * @param wildcards 输出与 bytes 等长的掩码，非 0 表示该位置为通配符
+     */
+    static bool parseHex(const QString &text, QByteArray *bytes, QByteArray *wildcards, QString *error);
+
+    int length() const { return int(m_bytes.size()); }
+
+    /**
+     * @brief 在 [from, size) 中查找第一个完整落在范围内的匹配，找不到返回 -1
+     */
+    qsizetype indexIn(const char *data, qsizetype size, qsizetype from) const;
+
+private:
+    QByteArray m_bytes;         ///< 已按大小写折叠
+    QByteArray m_wildcards;
+    bool m_hasWildcards = false;
+    bool m_caseSensitive = true;
+    uchar m_fold[256] = {};
+    int m_shift[256] = {};
+};
+
+/**
+ * @class ReceiveSearchEngine
+ * @brief 在 ReceiveStore 快照上的后台搜索
+ *
+ * 与 LogSearchEngine 相同的结构：快照的每个块一个任务投递到线程池，
+ * 新的 start() 使旧搜索作废，各块结果在 GUI 线程按偏移顺序重排后经 resultsReady 流式发出。
+ * 跨块边界的匹配由前一个块负责：字节模式额外检查块尾与下一块开头拼成的小缓冲区，
+ * 正则向下一块多看 kRegexOverlap 字节。
+ */
+class ReceiveSearchEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ReceiveSearchEngine(QObject *parent = nullptr);
+    ~ReceiveSearchEngine() override;
+
+    /**
+     * @brief 开始新的搜索（自动取消正在进行的搜索）
+     * @return 本次搜索的代号；模式无效时返回 0，原因写入 error
+     */
+    quint64 start(const ReceiveStore::Snapshot &snapshot, const ReceiveSearchQuery &query, QString *error = nullptr);
+
+    void cancel();
+    bool isRunning() const { return m_running; }
+    quint64 currentGeneration() const { return m_generation; }
+
+    static constexpr int kMaxPatternLength = 4096;
+    static constexpr int kRegexOverlap = 4096;
+
+signals:
+    void resultsReady(quint64 generation, const QVector<ReceiveMatch> &matches);
+
+    /**
+     * @param truncated 匹配多于 maxResults，超出的部分被丢弃（恰好等于上限不算）
+     */
+    void finished(quint64 generation, int matchCount, bool truncated, qint64 elapsedMs);
+
+private:
+    struct Job
+    {
+        quint64 generation = 0;
+        std::atomic<bool> cancelled{false};
+        ReceiveSearchQuery query;
+        BytePattern pattern;
+        QRegularExpression regex;
+        ReceiveStore::Snapshot snapshot;
+    };
+
+    static void searchBlock(ReceiveSearchEngine *engine, const std::shared_ptr<Job> &job, int blockIndex);
+    static void searchBytes(const Job &job, int blockIndex, QVector<ReceiveMatch> *matches);
+    static void searchRegex(const Job &job, int blockIndex, QVector<ReceiveMatch> *matches);
+
+    void onBlockFinished(quint64 generation, int sequence, const QVector<ReceiveMatch> &matches);
+    void finish(bool truncated);
+
+    QThreadPool m_pool;
+    std::shared_ptr<Job> m_job;
+    QElapsedTimer m_clock;
+
+    quint64 m_generation = 0;
+    int m_totalBlocks = 0;
+    int m_nextSequence = 0;
+    int m_matchCount = 0;
+    bool m_running = false;
+    QMap<int, QVector<ReceiveMatch>> m_pendingResults;  ///< 乱序完成的块，等待前序块
+};
+
+#endif // RECEIVE_SEARCH_H
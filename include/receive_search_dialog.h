@@ -0,0 +1,68 @@
+#ifndef RECEIVE_SEARCH_DIALOG_H
+#define RECEIVE_SEARCH_DIALOG_H
+
+#include <QDialog>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QTimer>
+#include <QVector>
+
+#include "receive_search.h"
+
+class ReceiveStore;
+class ReceiveHexView;
+
+/**
+ * @class ReceiveSearchDialog
+ * @brief 在原始接收数据中搜索文本、十六进制（支持 ?? 通配）或正则
+ *
+ * 搜索在 ReceiveStore 的快照上后台进行，结果边搜边到；F3 / Shift+F3 在匹配间跳转，
+ * 十六进制视图只高亮可见范围内的匹配。搜索开始后新收到的数据不在结果中，需重新搜索。
+ */
+class ReceiveSearchDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit ReceiveSearchDialog(const ReceiveStore *store, QWidget *parent = nullptr);
+    ~ReceiveSearchDialog() override;
+
+public slots:
+    /**
+     * @brief 接收存储被清空时调用，丢弃已有结果
+     */
+    void resetResults();
+
+private slots:
+    void onSearchClicked();
+    void onNextClicked();
+    void onPreviousClicked();
+    void onResultsReady(quint64 generation, const QVector<ReceiveMatch> &results);
+    void onSearchFinished(quint64 generation, int matchCount, bool truncated, qint64 elapsedMs);
+
+private:
+    void setupUI();
+    void goToMatch(int index);
+    void updateMatchLabel();
+
+    const ReceiveStore *store;
+    ReceiveSearchEngine *engine = nullptr;
+    quint64 generation = 0;
+    QVector<ReceiveMatch> matches;
+    int currentIndex = -1;
+
+    QComboBox *modeComboBox = nullptr;
+    QLineEdit *patternEdit = nullptr;
+    QCheckBox *caseCheck = nullptr;
+    QPushButton *searchButton = nullptr;
+    QPushButton *previousButton = nullptr;
+    QPushButton *nextButton = nullptr;
+    QLabel *statusLabel = nullptr;
+    QLabel *matchLabel = nullptr;
+    ReceiveHexView *hexView = nullptr;
+    QTimer refreshTimer;
+};
+
+#endif // RECEIVE_SEARCH_DIALOG_H
@@ -0,0 +1,91 @@
+#ifndef RECEIVE_STORE_H
+#define RECEIVE_STORE_H
+
+#include <QByteArray>
+#include <QVector>
+#include <memory>
+#include <vector>
+
+/**
+ * @class ReceiveStore
+ * @brief 原始接收数据的内存存储
+ *
+ * 接收字节按到达顺序追加，写满 kBlockSize 的块封存为只读的共享块，
+ * snapshot() 只复制块指针和未封存的尾部，后台搜索可以在快照上运行而不阻塞接收。
+ * 偏移是会话内的绝对字节位置：超出容量时整块丢弃最旧的数据，firstOffset() 随之增长，
+ * 已有偏移依然有效。另外每隔至少 kTimeIndexIntervalMs 记录一次（偏移, 时间），
+ * 用于显示匹配位置的大致接收时间。
+ *
+ * 只在 GUI 线程中使用；快照可以交给任意线程。
+ */
+class ReceiveStore
+{
+public:
+    struct Block
+    {
+        qint64 offset = 0;
+        std::shared_ptr<const QByteArray> data;
+    };
+
+    /**
+     * @brief 某一时刻的存储内容，块按偏移递增、首尾相接
+     */
+    struct Snapshot
+    {
+        std::vector<Block> blocks;
+        qint64 firstOffset = 0;
+        qint64 endOffset = 0;
+    };
+
+    explicit ReceiveStore(qint64 capacityBytes = kDefaultCapacityBytes);
+
+    void append(const QByteArray &data, qint64 timestampMs);
+    void clear();
+
+    /**
+     * @brief 容量至少为一个块；缩小时立即丢弃最旧的块
+     */
+    void setCapacity(qint64 capacityBytes);
+    qint64 capacity() const { return m_capacity; }
+
+    qint64 firstOffset() const { return m_firstOffset; }
+    qint64 endOffset() const { return m_endOffset; }
+    qint64 size() const { return m_endOffset - m_firstOffset; }
+
+    /**
+     * @brief 读取 [offset, offset + length) 与当前存储的交集
+     */
+    QByteArray read(qint64 offset, qint64 length) const;
+
+    /**
+     * @brief 包含 offset 的数据的接收时间（毫秒时间戳），未知时返回 -1
+     */
+    qint64 timeAt(qint64 offset) const;
+
+    Snapshot snapshot() const;
+
+    static constexpr qint64 kBlockSize = 1024 * 1024;
+    static constexpr qint64 kDefaultCapacityBytes = qint64(1024) * 1024 * 1024;
+    static constexpr qint64 kTimeIndexIntervalMs = 100;
+
+private:
+    struct TimePoint
+    {
+        qint64 offset;
+        qint64 timestampMs;
+    };
+
+    void sealTail();
+    void trim();
+
+    std::vector<Block> m_blocks;    ///< 已封存的块
+    QByteArray m_tail;              ///< 正在写入的块
+    qint64 m_tailOffset = 0;
+    qint64 m_firstOffset = 0;
+    qint64 m_endOffset = 0;
+    qint64 m_capacity;
+    QVector<TimePoint> m_timeIndex;
+    int m_timeIndexStart = 0;       ///< m_timeIndex 中已被丢弃的前缀，攒够一批再压缩
+};
+
+#endif // RECEIVE_STORE_H
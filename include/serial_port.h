@@ -8,6 +8,8 @@
 #include <QByteArray>
 #include <memory>
 
+#include "checksum.h"
+
 /**
  * @class SerialPort
  * @brief 串口通信管理类
@@ -42,13 +44,13 @@ public:
     ~SerialPort() override;
 
     /**
-     * @brief 扫描可用的串口
+     * @brief 扫描可用的串口（读取 SerialPortRegistry 缓存）
      * @return 可用串口列表
      */
     static QStringList scanAvailablePorts();
 
     /**
-     * @brief 获取串口信息
+     * @brief 获取串口信息（缓存查询，不重新枚举）
      * @param portName 串口名称
      * @return 串口信息
      */
@@ -85,11 +87,18 @@ public:
     /**
      * @brief 发送数据
      * @param data 要发送的数据
-     * @param format 数据格式
+     * @param format 数据格式（HEX 格式会追加 setTxChecksum 设置的校验）
      * @return 发送的字节数，失败返回-1
      */
     qint64 write(const QString &data, DataFormat format = DataFormat::ASCII);
 
+    /**
+     * @brief 设置 HEX 发送时自动追加的校验
+     * @param algorithm Checksum::Algorithm::None 表示不追加
+     */
+    void setTxChecksum(Checksum::Algorithm algorithm) { m_txChecksum = algorithm; }
+    Checksum::Algorithm txChecksum() const { return m_txChecksum; }
+
     /**
      * @brief 发送原始数据
      * @param data 要发送的原始数据
@@ -140,6 +149,13 @@ public:
      */
     qint32 baudRate() const;
 
+    /**
+     * @brief 获取当前数据位、校验位与停止位（用于计算字符时间）
+     */
+    QSerialPort::DataBits dataBits() const;
+    QSerialPort::Parity parity() const;
+    QSerialPort::StopBits stopBits() const;
+
     /**
      * @brief 获取错误信息
      * @return 错误描述
@@ -168,6 +184,12 @@ signals:
      */
     void dataReceived(const QString &data, DataFormat format);
 
+    /**
+     * @brief 原始数据接收信号（未按显示格式转换，供脚本执行等协议层使用）
+     * @param data 本次读到的原始字节
+     */
+    void rawDataReceived(const QByteArray &data);
+
     /**
      * @brief 数据发送信号
      * @param data 发送的数据
@@ -201,6 +223,7 @@ private slots:
 private:
     std::unique_ptr<QSerialPort> m_serialPort;  ///< 串口对象
     DataFormat m_dataFormat = DataFormat::ASCII; ///< 数据格式
+    Checksum::Algorithm m_txChecksum = Checksum::Algorithm::None; ///< HEX 发送追加的校验
 };
 
 #endif // SERIAL_PORT_H
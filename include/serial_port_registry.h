@@ -0,0 +1,87 @@
+#ifndef SERIAL_PORT_REGISTRY_H
+#define SERIAL_PORT_REGISTRY_H
+
+#include <QObject>
+#include <QSerialPortInfo>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QMutex>
+
+class QThread;
+
+/**
+ * @class SerialPortRegistry
+ * @brief 串口列表缓存与热插拔监视
+ *
+ * 只在启动和设备插拔时调用 QSerialPortInfo::availablePorts() 枚举，
+ * 其余查询（串口列表、按名称取 VID/PID/序列号等信息）都直接读缓存。
+ *
+ * 监视在独立线程进行：Linux 上订阅内核 uevent（NETLINK_KOBJECT_UEVENT），
+ * 收到 tty 子系统的 add/remove 事件后短暂去抖再重新枚举（等 udev 建好设备节点）；
+ * 其他平台或 netlink 不可用时退化为定时轮询。列表变化时发出 portsChanged()。
+ *
+ * 单例需先在 GUI 线程上取得（startMonitoring()），查询和 rescan() 可在任意线程调用。
+ */
+class SerialPortRegistry : public QObject
+{
+    Q_OBJECT
+
+public:
+    static SerialPortRegistry &instance();
+
+    /**
+     * @brief 启动热插拔监视（幂等），应用退出时自动停止
+     */
+    void startMonitoring();
+    void stopMonitoring();
+
+    /**
+     * @brief 立即重新枚举并更新缓存，返回串口名列表（枚举顺序）
+     */
+    QStringList rescan();
+
+    /**
+     * @brief 缓存中的串口名；尚未枚举过时先同步枚举一次
+     */
+    QStringList portNames();
+
+    bool contains(const QString &portName) const;
+
+    /**
+     * @brief 按名称查询串口信息，不存在时返回空的 QSerialPortInfo
+     */
+    QSerialPortInfo portInfo(const QString &portName) const;
+
+    /**
+     * @brief 供界面显示的描述（描述、厂商、VID:PID、序列号）
+     */
+    QString describe(const QString &portName) const;
+
+    static constexpr int kHotplugSettleMs = 300;  ///< uevent 到达后等待设备节点就绪的时间
+    static constexpr int kPollIntervalMs = 2000;  ///< 无 netlink 时的轮询间隔
+
+signals:
+    /**
+     * @brief 串口列表相对上一次枚举发生变化（首次枚举不发出）
+     */
+    void portsChanged(const QStringList &added, const QStringList &removed);
+
+private:
+    SerialPortRegistry();
+    ~SerialPortRegistry() override;
+
+    void setupMonitor();  // 在监视线程中执行
+
+    QMutex m_rescanMutex;   ///< 串行化整次 rescan()：枚举、比较、提交与通知按调用顺序完成
+    mutable QMutex m_mutex; ///< 保护缓存
+    QHash<QString, QSerialPortInfo> m_ports;
+    QStringList m_order;
+    bool m_populated = false;
+
+    QThread *m_monitorThread = nullptr;
+    QObject *m_monitorContext = nullptr;  ///< 监视线程中的定时器/通知器的父对象
+    int m_netlinkFd = -1;
+};
+
+#endif // SERIAL_PORT_REGISTRY_H
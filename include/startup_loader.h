@@ -0,0 +1,88 @@
+#ifndef STARTUP_LOADER_H
+#define STARTUP_LOADER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QElapsedTimer>
+#include <memory>
+
+class ConfigManager;
+class CommandHistoryIndex;
+
+/**
+ * @class StartupLoader
+ * @brief 分阶段启动：配置、历史记录与串口扫描在后台并发完成
+ *
+ * start() 后立即返回，主窗口可以先以默认值显示；两条后台任务
+ * （配置 -> 历史记录、串口扫描）全部结束后在 GUI 线程发出 finished()，
+ * 由主窗口取走结果并应用。每个阶段（含 GUI 线程上的阶段）都记录
+ * 相对启动时刻的开始时间和耗时，logSummary() 输出到调试日志。
+ */
+class StartupLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stage
+    {
+        QString name;
+        qint64 startMs = 0;     ///< 相对 StartupLoader 创建时刻
+        qint64 durationMs = 0;
+        bool background = false;
+    };
+
+    explicit StartupLoader(QObject *parent = nullptr);
+    ~StartupLoader() override;
+
+    /**
+     * @brief 提交后台阶段，需在设置应用名之后调用（配置路径依赖它）
+     */
+    void start();
+
+    bool isFinished() const { return m_finished; }
+
+    /**
+     * @brief 自创建以来经过的毫秒数，用于 GUI 线程阶段计时
+     */
+    qint64 elapsed() const { return m_clock.elapsed(); }
+
+    /**
+     * @brief 记录一个 GUI 线程阶段，耗时为 startMs 到当前时刻
+     */
+    void recordStage(const QString &name, qint64 startMs);
+
+    /**
+     * @brief 取走后台结果，只能在 finished() 之后调用一次
+     */
+    std::unique_ptr<ConfigManager> takeConfig();
+    std::unique_ptr<CommandHistoryIndex> takeHistory();
+    QStringList ports() const;
+
+    QList<Stage> stages() const { return m_stages; }
+
+    /**
+     * @brief 按开始时间输出各阶段耗时和总耗时
+     */
+    void logSummary() const;
+
+signals:
+    void stageFinished(const QString &name, qint64 durationMs);
+    void finished();
+
+private:
+    struct Results;
+
+    void addStage(const Stage &stage);
+    void onTaskFinished();
+
+    QElapsedTimer m_clock;
+    QList<Stage> m_stages;
+    std::shared_ptr<Results> m_results;  ///< 后台任务各写各的字段，全部结束后才在 GUI 线程读取
+
+    int m_pendingTasks = 0;
+    bool m_finished = false;
+};
+
+#endif // STARTUP_LOADER_H
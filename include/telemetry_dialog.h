@@ -0,0 +1,57 @@
+#ifndef TELEMETRY_DIALOG_H
+#define TELEMETRY_DIALOG_H
+
+#include <QDialog>
+#include <QListWidget>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QLabel>
+#include <QTimer>
+#include <QByteArray>
+#include <memory>
+
+class TelemetryStore;
+class TelemetryExtractor;
+class TelemetryPlotWidget;
+
+/**
+ * @class TelemetryDialog
+ * @brief 遥测曲线窗口
+ *
+ * 持有数据存储与提取器，创建后即使窗口关闭也持续记录接收数据中的数值，
+ * 再次打开时可以回看全部历史。
+ */
+class TelemetryDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit TelemetryDialog(QWidget *parent = nullptr);
+    ~TelemetryDialog() override;
+
+public slots:
+    void feed(const QByteArray &data);
+    void resetStream();
+
+private slots:
+    void onApplyRulesClicked();
+    void onClearClicked();
+    void onChannelAdded(const QString &name);
+    void onChannelItemChanged(QListWidgetItem *item);
+    void updateStats();
+
+private:
+    void setupUI();
+
+    std::unique_ptr<TelemetryStore> store;
+    TelemetryExtractor *extractor = nullptr;
+
+    TelemetryPlotWidget *plotWidget = nullptr;
+    QListWidget *channelList = nullptr;
+    QPlainTextEdit *rulesEdit = nullptr;
+    QLabel *rulesStatusLabel = nullptr;
+    QPushButton *followButton = nullptr;
+    QLabel *statsLabel = nullptr;
+    QTimer statsTimer;
+};
+
+#endif // TELEMETRY_DIALOG_H
@@ -0,0 +1,67 @@
+#ifndef TELEMETRY_EXTRACTOR_H
+#define TELEMETRY_EXTRACTOR_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QRegularExpression>
+
+class TelemetryStore;
+
+/**
+ * @class TelemetryExtractor
+ * @brief 从接收数据流中按行提取数值样本写入 TelemetryStore
+ *
+ * 原始字节按换行分帧，每个完整行用同一时间戳（收到该块数据的时刻）。
+ * 未配置规则时自动识别 "key=value" / "key: value" 形式的数值，
+ * 例如 "temp=41.2 v=3.31" 得到 temp 与 v 两个通道；
+ * 配置规则后只使用规则，每条规则为 "通道名=正则"，取第一个分组（无分组取整个匹配）。
+ */
+class TelemetryExtractor : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TelemetryExtractor(TelemetryStore *store, QObject *parent = nullptr);
+
+    /**
+     * @brief 设置提取规则，每行一条 "通道名=正则"，空文本表示自动识别
+     * @return 规则无效时返回 false 并保持原规则
+     */
+    bool setRules(const QString &text, QString *error);
+    bool isAutomatic() const { return m_rules.isEmpty(); }
+
+    void feed(const QByteArray &data);
+
+    /**
+     * @brief 丢弃未成行的残余数据（断开或清空时调用）
+     */
+    void resetStream();
+
+    qint64 sampleCount() const { return m_sampleCount; }
+
+    static constexpr int kMaxLineLength = 4096;  ///< 单行上限，超长的行整行丢弃
+
+signals:
+    void channelAdded(const QString &name);
+
+private:
+    struct Rule
+    {
+        QString channel;
+        QRegularExpression pattern;
+    };
+
+    void processLine(const QByteArray &line, qint64 timeUs);
+    void extractAutomatic(const QByteArray &line, qint64 timeUs);
+    void addSample(const QString &channel, double value, qint64 timeUs);
+
+    TelemetryStore *m_store;
+    QList<Rule> m_rules;
+    QByteArray m_lineBuffer;
+    bool m_skippingLongLine = false;  ///< 正在丢弃超长行，直到下一个换行
+    qint64 m_sampleCount = 0;
+};
+
+#endif // TELEMETRY_EXTRACTOR_H
@@ -0,0 +1,75 @@
+#ifndef TELEMETRY_PLOT_WIDGET_H
+#define TELEMETRY_PLOT_WIDGET_H
+
+#include <QWidget>
+#include <QTimer>
+#include <QSet>
+#include <QHash>
+#include <QColor>
+
+class TelemetryStore;
+
+/**
+ * @class TelemetryPlotWidget
+ * @brief 多通道遥测曲线视图
+ *
+ * 每帧按绘图区宽度向 TelemetryChannel 请求逐列 min/max（样本稀疏时为原始点），
+ * 绘制代价只与像素宽度有关，与可见时间范围内的样本数无关。
+ * 滚轮缩放（以光标处为中心），拖动平移，双击回到实时跟随。
+ */
+class TelemetryPlotWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit TelemetryPlotWidget(QWidget *parent = nullptr);
+
+    void setStore(TelemetryStore *store);
+    void setChannelVisible(const QString &name, bool visible);
+    QColor channelColor(const QString &name);
+
+    // 实时跟随：视图右端始终对齐最新样本
+    void setFollowLive(bool follow);
+    bool isFollowingLive() const { return followLive; }
+
+    // 显示全部已缓存的数据（停止跟随）
+    void fitAll();
+
+    // 新数据到达后调用，下一次刷新时重绘
+    void markDirty() { dirty = true; }
+
+signals:
+    void followLiveChanged(bool follow);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+private:
+    QRect plotRect() const;
+    qint64 viewEnd() const;
+
+    static constexpr int kRefreshIntervalMs = 33;
+    static constexpr qint64 kDefaultSpanUs = 10 * 1000 * 1000;
+    static constexpr qint64 kMinSpanUs = 1000;
+
+    TelemetryStore *store = nullptr;
+    QSet<QString> hiddenChannels;
+    QHash<QString, QColor> colors;
+
+    bool followLive = true;
+    qint64 spanUs = kDefaultSpanUs;
+    qint64 endUs = 0;               // 停止跟随时视图右端的时间
+
+    bool dragging = false;
+    int dragStartX = 0;
+    qint64 dragStartEndUs = 0;
+
+    bool dirty = false;
+    QTimer refreshTimer;
+};
+
+#endif // TELEMETRY_PLOT_WIDGET_H
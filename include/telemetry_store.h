@@ -0,0 +1,130 @@
+#ifndef TELEMETRY_STORE_H
+#define TELEMETRY_STORE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QElapsedTimer>
+#include <memory>
+#include <vector>
+
+/**
+ * @class TelemetryChannel
+ * @brief 单个遥测通道的环形样本缓冲与 min/max 金字塔
+ *
+ * 原始样本（时间戳 + 数值）存放在容量为 2 的幂的环形缓冲中，
+ * 同时维护 kLevels 级 min/max 桶（每级桶宽为上一级的 16 倍）。
+ * 查询任意区间的最小/最大值只需合并 O(级数 x 16) 个桶，
+ * 因此绘制时每个像素列的代价与区间内的原始样本数无关。
+ * 存储按需增长，达到容量后覆盖最旧的样本。
+ */
+class TelemetryChannel
+{
+public:
+    static constexpr int kLevels = 5;           ///< 桶宽 16、256、4096、65536、1048576
+    static constexpr int kLevelShift = 4;       ///< 每级桶宽放大 2^4 倍
+
+    /**
+     * @brief 一个像素列的取值范围
+     */
+    struct Column
+    {
+        float min = 0;
+        float max = 0;
+        bool valid = false;
+    };
+
+    /**
+     * @brief 区间抽取结果：样本足够稀疏时给出原始点，否则给出逐列 min/max
+     */
+    struct Extract
+    {
+        bool raw = true;
+        QVector<qint64> rawTimes;       ///< 微秒
+        QVector<float> rawValues;
+        QVector<Column> columns;        ///< raw 为 false 时有效，列数等于请求的 columns
+        float min = 0;                  ///< 区间内的整体范围，用于自动缩放
+        float max = 0;
+        bool empty = true;
+    };
+
+    TelemetryChannel(const QString &name, int capacityLog2);
+
+    QString name() const { return m_name; }
+
+    void append(qint64 timeUs, float value);
+    void clear();
+
+    qint64 size() const { return qint64(m_next - oldest()); }
+    bool isEmpty() const { return m_next == oldest(); }
+    qint64 firstTimeUs() const;
+    qint64 lastTimeUs() const;
+    float lastValue() const;
+
+    /**
+     * @brief 抽取 [t0Us, t1Us] 区间，columns 为绘制宽度（像素列数）
+     *
+     * 区间内样本数不超过 2 x columns 时返回原始点（含区间两侧各一个点以便连线），
+     * 否则每列给出该列时间范围内的 min/max。
+     */
+    void extract(qint64 t0Us, qint64 t1Us, int columns, Extract *out) const;
+
+private:
+    struct Bucket
+    {
+        float min;
+        float max;
+    };
+
+    quint64 oldest() const { return m_next > m_capacity ? m_next - m_capacity : 0; }
+    qint64 timeAt(quint64 seq) const { return m_time[seq & m_mask]; }
+    float valueAt(quint64 seq) const { return m_value[seq & m_mask]; }
+    quint64 lowerBound(qint64 timeUs) const;  ///< 第一个时间 >= timeUs 的序号
+    void minMax(quint64 from, quint64 to, float *min, float *max) const;
+
+    QString m_name;
+    quint64 m_capacity;
+    quint64 m_mask;
+    quint64 m_next = 0;                 ///< 下一个样本的绝对序号
+    std::vector<qint64> m_time;
+    std::vector<float> m_value;
+    std::vector<Bucket> m_levels[kLevels];
+};
+
+/**
+ * @class TelemetryStore
+ * @brief 按名称管理遥测通道，时间戳相对于存储创建（或清空）时刻
+ */
+class TelemetryStore
+{
+public:
+    static constexpr int kDefaultCapacityLog2 = 23;  ///< 每通道约 840 万点，1 kHz 下约 2.3 小时
+    static constexpr int kMaxChannels = 16;
+
+    explicit TelemetryStore(int capacityLog2 = kDefaultCapacityLog2);
+
+    /**
+     * @brief 取得通道，不存在时创建；通道数达到上限时返回 nullptr
+     */
+    TelemetryChannel *channel(const QString &name);
+    TelemetryChannel *find(const QString &name) const;
+
+    QStringList channelNames() const { return m_order; }
+    qint64 nowUs() const { return m_clock.nsecsElapsed() / 1000; }
+    void clear();
+
+    /**
+     * @brief 所有通道中最新样本的时间，无数据时返回 0
+     */
+    qint64 lastTimeUs() const;
+    qint64 firstTimeUs() const;
+
+private:
+    int m_capacityLog2;
+    QElapsedTimer m_clock;
+    QHash<QString, std::shared_ptr<TelemetryChannel>> m_channels;
+    QStringList m_order;
+};
+
+#endif // TELEMETRY_STORE_H
@@ -0,0 +1,41 @@
+#ifndef THEME_MANAGER_H
+#define THEME_MANAGER_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+
+/**
+ * @class ThemeManager
+ * @brief 应用主题（全局样式表）管理
+ *
+ * 调色板在构建期已展开进样式表（resources/themes/<主题名>.palette ->
+ * :/themes/<主题名>.qss），运行期不再做占位符替换。每个主题的样式表
+ * 只从资源读取一次并缓存；应用与当前相同的主题时直接返回，
+ * 不会触发 setStyleSheet 带来的全局 re-polish。
+ */
+class ThemeManager {
+public:
+    static ThemeManager& instance();
+
+    static constexpr const char *kDefaultTheme = "light";
+
+    // 资源中可用的主题名
+    QStringList availableThemes() const;
+
+    // 应用主题，主题不存在时返回 false 且保持当前样式
+    bool applyTheme(const QString &name);
+
+    QString currentTheme() const { return current; }
+
+private:
+    ThemeManager() = default;
+
+    // 读取（并缓存）展开后的样式表，不存在返回空字符串
+    QString styleSheet(const QString &name);
+
+    QHash<QString, QString> cache;
+    QString current;
+};
+
+#endif // THEME_MANAGER_H
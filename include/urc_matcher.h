@@ -0,0 +1,126 @@
+#ifndef URC_MATCHER_H
+#define URC_MATCHER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QRegularExpression>
+#include <array>
+#include <vector>
+
+/**
+ * @brief 一次 URC（主动上报结果码）匹配事件
+ */
+struct UrcEvent
+{
+    int patternId = -1;     ///< addLiteral/addRegex 返回的编号
+    QString type;           ///< 注册时给定的事件类型
+    QString line;           ///< 完整的上报行（不含换行符）
+    QStringList captures;   ///< 正则模式的捕获分组，字面量模式为空
+    qint64 timestampMs = 0; ///< 行结束所在数据块的接收时间（毫秒时间戳）
+};
+
+/**
+ * @class UrcMatcher
+ * @brief 接收数据流上的多模式 URC 匹配器
+ *
+ * 所有模式编译进一个 Aho-Corasick 自动机（字节等价类压缩 + 完整转移表），
+ * 每个输入字节只做一次查表，与注册的模式数量无关：
+ * - 字面量模式（如 "RING"）默认要求整行相同，也可以匹配行内任意位置
+ * - 正则模式取其开头必然出现的字面量前缀放入自动机，只有前缀命中的行才执行正则
+ *   （以 ^ 开头时前缀须在行首）；顶层含 | 或开头即为可选部分的正则没有前缀，
+ *   退化为对每一行执行，代价较高，应尽量避免
+ *
+ * 数据可以按任意边界分块输入，跨块的行会被拼接。只有命中候选的行才会解码成 QString。
+ */
+class UrcMatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit UrcMatcher(QObject *parent = nullptr);
+
+    /**
+     * @brief 注册字面量模式
+     * @param anchored true 表示整行等于字面量，false 表示在行内任意位置出现即可
+     * @return 模式编号；字面量为空时返回 -1
+     */
+    int addLiteral(const QString &type, const QString &literal, bool anchored = true);
+
+    /**
+     * @brief 注册正则模式（建议以 ^ 和字面量开头，便于只对候选行执行）
+     * @return 模式编号；正则无效时返回 -1
+     */
+    int addRegex(const QString &type, const QString &pattern);
+
+    /**
+     * @brief 注册常见 3GPP / 模组厂商的 URC（网络注册、来电、短信、SIM 状态、Socket 事件等）
+     */
+    void addStandardPatterns();
+
+    void clear();
+    int patternCount() const { return static_cast<int>(m_patterns.size()); }
+
+    /**
+     * @brief 输入一块原始接收数据
+     * @param timestampMs 这块数据的接收时间，作为其中结束的行的事件时间
+     */
+    void feed(const QByteArray &data, qint64 timestampMs);
+
+    /**
+     * @brief 丢弃未结束的半行（串口重新打开时调用）
+     */
+    void resetStream();
+
+    /**
+     * @brief 对一整行（不含换行符）执行匹配，命中的模式照常发出 urcMatched
+     *
+     * 供已经自行分行的调用方使用，不读写 feed() 的流状态，两者可以交替调用。
+     * @return 是否有模式命中
+     */
+    bool matchLine(const QString &line, qint64 timestampMs);
+
+    quint64 matchCount() const { return m_matchCount; }
+
+    static constexpr int kMaxLineLength = 1024;  ///< 单行保留的最大字节数，超出部分不进入事件
+
+signals:
+    void urcMatched(const UrcEvent &event);
+
+private:
+    struct Pattern
+    {
+        QString type;
+        QByteArray literal;  ///< 字面量本身，或正则的字面量前缀
+        bool anchored = true;
+        bool isRegex = false;
+        QRegularExpression regex;
+    };
+
+    void compile();
+    void endLine(qint64 timestampMs);
+    void dispatch(int patternId, const QString &line, qint64 timestampMs);
+
+    static QByteArray literalPrefix(const QString &pattern);
+
+    std::vector<Pattern> m_patterns;
+    std::vector<int> m_fallbackRegexes;  ///< 没有字面量前缀、需逐行执行的正则
+
+    // 自动机：m_delta[state * m_classCount + m_byteClass[byte]]
+    bool m_dirty = true;
+    std::array<quint16, 256> m_byteClass{};
+    int m_classCount = 1;
+    std::vector<qint32> m_delta;
+    std::vector<qint32> m_outputBegin;   ///< 状态 s 的输出为 m_outputIds[m_outputBegin[s], m_outputBegin[s + 1])
+    std::vector<qint32> m_outputIds;
+
+    // 流状态
+    qint32 m_state = 0;
+    qint64 m_linePosition = 0;           ///< 当前行已读入的字节数（可超过 kMaxLineLength）
+    QByteArray m_line;
+    std::vector<int> m_candidates;       ///< 当前行命中的模式
+    quint64 m_matchCount = 0;
+};
+
+#endif // URC_MATCHER_H
@@ -0,0 +1,361 @@
+#include "async_log_writer.h"
+#include "log_segments.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QThread>
+#include <QThreadPool>
+#include <QVarLengthArray>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <utility>
+
+namespace {
+
+std::terminate_handler previousTerminateHandler = nullptr;
+
+void onTerminate()
+{
+    AsyncLogWriter::instance().tryFlush(200);
+    if (previousTerminateHandler) {
+        previousTerminateHandler();
+    }
+    std::abort();
+}
+
+extern "C" void onCrashSignal(int signal)
+{
+    // 非异步信号安全，但进程即将终止，尽力而为即可
+    AsyncLogWriter::instance().tryFlush(200);
+    std::signal(signal, SIG_DFL);
+    std::raise(signal);
+}
+
+} // namespace
+
+AsyncLogWriter &AsyncLogWriter::instance()
+{
+    static AsyncLogWriter writer;
+    return writer;
+}
+
+AsyncLogWriter::AsyncLogWriter()
+    : m_head(&m_stub),
+      m_tail(&m_stub)
+{
+    m_running.store(true, std::memory_order_release);
+    m_thread.reset(QThread::create([this]() { run(); }));
+    m_thread->setObjectName("AsyncLogWriter");
+    m_thread->start(QThread::LowPriority);
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    shutdown();
+}
+
+void AsyncLogWriter::append(const QString &filePath, QByteArray record)
+{
+    Node *node = new Node;
+    node->filePath = filePath;
+    node->data = std::move(record);
+    push(node);
+
+    if (!m_running.load(std::memory_order_acquire)) {
+        // 写线程已停止（退出阶段），直接同步写入
+        flush();
+        return;
+    }
+
+    if (m_pending.fetch_add(1, std::memory_order_relaxed) + 1 == kWakeThreshold) {
+        m_wakeCondition.wakeOne();
+    }
+}
+
+void AsyncLogWriter::flush()
+{
+    QMutexLocker locker(&m_consumerMutex);
+    drainLocked();
+}
+
+bool AsyncLogWriter::tryFlush(int timeoutMs)
+{
+    if (!m_consumerMutex.tryLock(timeoutMs)) {
+        return false;
+    }
+    drainLocked();
+    m_consumerMutex.unlock();
+    return true;
+}
+
+bool AsyncLogWriter::truncate(const QString &filePath)
+{
+    QMutexLocker locker(&m_consumerMutex);
+    drainLocked();
+
+    auto found = m_sinks.find(filePath);
+    if (found != m_sinks.end()) {
+        found->size = 0;
+        found->startedAt = QDateTime::currentDateTime();
+        publishSizesLocked();
+        return found->file->resize(0);
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    file.close();
+    return true;
+}
+
+void AsyncLogWriter::setFlushInterval(int ms)
+{
+    m_flushIntervalMs.store(qMax(10, ms), std::memory_order_relaxed);
+    m_wakeCondition.wakeOne();
+}
+
+int AsyncLogWriter::flushInterval() const
+{
+    return m_flushIntervalMs.load(std::memory_order_relaxed);
+}
+
+void AsyncLogWriter::setRotationPolicy(const RotationPolicy &policy)
+{
+    QMutexLocker locker(&m_consumerMutex);
+    m_rotationPolicy = policy;
+    m_rotationPolicy.retention = qMax(0, policy.retention);
+
+    // 保留数量可能变小，对已打开的文件立即整理一次
+    for (auto it = m_sinks.cbegin(); it != m_sinks.cend(); ++it) {
+        scheduleMaintenance(it.key(), m_rotationPolicy.retention);
+    }
+}
+
+AsyncLogWriter::RotationPolicy AsyncLogWriter::rotationPolicy() const
+{
+    QMutexLocker locker(&m_consumerMutex);
+    return m_rotationPolicy;
+}
+
+quint64 AsyncLogWriter::rotationCount() const
+{
+    return m_rotationCount.load(std::memory_order_acquire);
+}
+
+void AsyncLogWriter::shutdown()
+{
+    if (m_running.exchange(false, std::memory_order_acq_rel)) {
+        m_wakeCondition.wakeAll();
+        m_thread->wait();
+    }
+
+    QMutexLocker locker(&m_consumerMutex);
+    drainLocked();
+    closeSinksLocked();
+}
+
+void AsyncLogWriter::installCrashHandlers()
+{
+    // 确保单例在崩溃前已构造，避免在信号处理器中首次初始化
+    instance();
+
+    previousTerminateHandler = std::set_terminate(onTerminate);
+    std::signal(SIGSEGV, onCrashSignal);
+    std::signal(SIGABRT, onCrashSignal);
+    std::signal(SIGFPE, onCrashSignal);
+    std::signal(SIGILL, onCrashSignal);
+}
+
+void AsyncLogWriter::push(Node *node)
+{
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node *prev = m_head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+}
+
+AsyncLogWriter::Node *AsyncLogWriter::pop()
+{
+    Node *tail = m_tail;
+    Node *next = tail->next.load(std::memory_order_acquire);
+
+    if (tail == &m_stub) {
+        if (!next) {
+            return nullptr;
+        }
+        m_tail = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next) {
+        m_tail = next;
+        return tail;
+    }
+
+    // 生产者正在入队（已交换 head 但尚未链接 next），稍后再取
+    if (tail != m_head.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    push(&m_stub);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+        m_tail = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+void AsyncLogWriter::run()
+{
+    while (m_running.load(std::memory_order_acquire)) {
+        m_wakeMutex.lock();
+        if (m_running.load(std::memory_order_acquire)
+            && m_pending.load(std::memory_order_relaxed) < kWakeThreshold) {
+            m_wakeCondition.wait(&m_wakeMutex,
+                                 static_cast<unsigned long>(m_flushIntervalMs.load(std::memory_order_relaxed)));
+        }
+        m_wakeMutex.unlock();
+
+        QMutexLocker locker(&m_consumerMutex);
+        drainLocked();
+    }
+}
+
+void AsyncLogWriter::drainLocked()
+{
+    QVarLengthArray<QFile*, 4> touched;
+    int drained = 0;
+
+    while (Node *node = pop()) {
+        if (Sink *sink = sinkFor(node->filePath)) {
+            if (shouldRotateLocked(*sink, node->data.size())) {
+                // 轮转会关闭旧文件，先把它从待 flush 列表中移除
+                touched.removeAll(sink->file);
+                rotateLocked(node->filePath, *sink);
+            }
+            const qint64 written = sink->file->write(node->data);
+            if (written > 0) {
+                sink->size += written;
+            }
+            if (!touched.contains(sink->file)) {
+                touched.append(sink->file);
+            }
+        }
+        delete node;
+        ++drained;
+    }
+
+    if (drained > 0) {
+        m_pending.fetch_sub(drained, std::memory_order_relaxed);
+        publishSizesLocked();
+    }
+
+    for (QFile *file : touched) {
+        file->flush();
+    }
+}
+
+AsyncLogWriter::Sink *AsyncLogWriter::sinkFor(const QString &filePath)
+{
+    auto found = m_sinks.find(filePath);
+    if (found != m_sinks.end()) {
+        return &found.value();
+    }
+
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+    QFile *file = new QFile(filePath);
+    if (!file->open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Append)) {
+        // 不能走 qWarning：消息处理器可能再次进入日志写入器
+        std::fprintf(stderr, "[AsyncLogWriter] Failed to open %s\n", qPrintable(filePath));
+        delete file;
+        return nullptr;
+    }
+
+    const QFileInfo info(filePath);
+    Sink sink;
+    sink.file = file;
+    sink.size = file->size();
+    // 无法取得创建时间的文件系统上，从本次打开开始计算年龄
+    sink.startedAt = info.birthTime().isValid() ? info.birthTime() : QDateTime::currentDateTime();
+
+    // 首次打开时整理上次运行遗留的未压缩分段
+    scheduleMaintenance(filePath, m_rotationPolicy.retention);
+
+    return &m_sinks.insert(filePath, sink).value();
+}
+
+void AsyncLogWriter::publishSizesLocked()
+{
+    QMutexLocker locker(&m_sizeMutex);
+    for (auto it = m_sinks.cbegin(); it != m_sinks.cend(); ++it) {
+        m_fileSizes.insert(it.key(), it->size);
+    }
+}
+
+qint64 AsyncLogWriter::fileSize(const QString &filePath) const
+{
+    QMutexLocker locker(&m_sizeMutex);
+    return m_fileSizes.value(filePath, -1);
+}
+
+bool AsyncLogWriter::shouldRotateLocked(const Sink &sink, qint64 incoming) const
+{
+    if (sink.size <= 0) {
+        return false;
+    }
+    if (m_rotationPolicy.maxFileSize > 0 && sink.size + incoming > m_rotationPolicy.maxFileSize) {
+        return true;
+    }
+    return m_rotationPolicy.maxAgeSecs > 0
+           && sink.startedAt.secsTo(QDateTime::currentDateTime()) > m_rotationPolicy.maxAgeSecs;
+}
+
+void AsyncLogWriter::rotateLocked(const QString &filePath, Sink &sink)
+{
+    const QDateTime now = QDateTime::currentDateTime();
+    sink.file->close();
+
+    const QString rotatedPath = LogSegments::rotatedPath(filePath, now);
+    const bool rotated = QFile::rename(filePath, rotatedPath);
+    if (!rotated) {
+        std::fprintf(stderr, "[AsyncLogWriter] Failed to rotate %s\n", qPrintable(filePath));
+    }
+
+    if (!sink.file->open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Append)) {
+        std::fprintf(stderr, "[AsyncLogWriter] Failed to reopen %s\n", qPrintable(filePath));
+    }
+    // 重命名失败（如 Windows 上文件被其他进程占用）时继续追加到原文件，
+    // 计数从零开始，再写满一个分段或再过一个周期后重试，而不是每条记录都重试
+    sink.size = 0;
+    sink.startedAt = now;
+
+    if (rotated) {
+        m_rotationCount.fetch_add(1, std::memory_order_acq_rel);
+        scheduleMaintenance(filePath, m_rotationPolicy.retention);
+    }
+}
+
+void AsyncLogWriter::scheduleMaintenance(const QString &filePath, int retention)
+{
+    // 进程退出的静态析构阶段全局线程池可能已销毁，此时跳过，下次启动再整理
+    if (QThreadPool *pool = QThreadPool::globalInstance()) {
+        pool->start([filePath, retention]() {
+            LogSegments::compressAndPrune(filePath, retention);
+        });
+    }
+}
+
+void AsyncLogWriter::closeSinksLocked()
+{
+    for (const Sink &sink : std::as_const(m_sinks)) {
+        sink.file->close();
+        delete sink.file;
+    }
+    m_sinks.clear();
+}
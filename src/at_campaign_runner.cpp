@@ -0,0 +1,297 @@
+#include "at_campaign_runner.h"
+#include "serial_port.h"
+#include "log_categories.h"
+
+#include <QThread>
+#include <QDebug>
+
+// ========== ATCampaignReport ==========
+
+int ATCampaignReport::passedDevices() const
+{
+    int count = 0;
+    for (const ATCampaignDeviceReport &device : devices)
+    {
+        if (device.ok())
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+QString ATCampaignReport::toText() const
+{
+    QStringList lines;
+    lines << QString("AT 批量执行报告: %1").arg(scriptName.isEmpty() ? QString("(未命名脚本)") : scriptName);
+    lines << QString("总耗时: %1 ms | 设备: %2 台，通过 %3 台").arg(wallMs).arg(devices.size()).arg(passedDevices());
+    lines << QString();
+
+    lines << "设备:";
+    for (const ATCampaignDeviceReport &device : devices)
+    {
+        QString line = QString("  %1  %2  通过 %3 / 失败 %4  %5 ms")
+            .arg(device.portName, -12)
+            .arg(device.ok() ? "PASS" : "FAIL")
+            .arg(device.passed)
+            .arg(device.failed)
+            .arg(device.wallMs);
+        if (device.aborted)
+        {
+            line += "  (提前结束)";
+        }
+        if (!device.error.isEmpty())
+        {
+            line += "  " + device.error;
+        }
+        lines << line;
+    }
+    lines << QString();
+
+    lines << "命令:";
+    for (int i = 0; i < commands.size(); ++i)
+    {
+        const CommandStats &stats = commands.at(i);
+        QString line = QString("  [%1] %2  通过 %3 / 失败 %4")
+            .arg(i + 1)
+            .arg(stats.command)
+            .arg(stats.passed)
+            .arg(stats.failed);
+        if (stats.responded > 0)
+        {
+            line += QString("  延迟 min/avg/max %1/%2/%3 ms")
+                .arg(stats.minLatencyMs)
+                .arg(stats.averageLatencyMs())
+                .arg(stats.maxLatencyMs);
+        }
+        lines << line;
+    }
+    return lines.join('\n') + '\n';
+}
+
+// ========== ATCampaignWorker ==========
+
+ATCampaignWorker::ATCampaignWorker(const QString &portName, qint32 baudRate, const ATScriptRunner::Script &script)
+    : m_portName(portName)
+    , m_baudRate(baudRate)
+    , m_script(script)
+{
+    m_report.portName = portName;
+}
+
+ATCampaignWorker::~ATCampaignWorker() = default;
+
+void ATCampaignWorker::run()
+{
+    m_clock.start();
+    m_port = std::make_unique<SerialPort>();
+    connect(m_port.get(), &SerialPort::errorOccurred, this, [this](const QString &error) {
+        m_report.error = error;
+    });
+
+    if (!m_port->open(m_portName, m_baudRate))
+    {
+        if (m_report.error.isEmpty())
+        {
+            m_report.error = m_port->errorString();
+        }
+        cleanup();
+        return;
+    }
+    m_report.opened = true;
+
+    m_runner = new ATScriptRunner(m_port.get(), this);
+    connect(m_runner, &ATScriptRunner::commandFinished, this, [this](const ATCommandResult &result) {
+        m_report.results.append(result);
+        emit commandFinished(m_portName, result);
+    });
+    connect(m_runner, &ATScriptRunner::finished, this, [this](int passed, int failed, bool aborted) {
+        m_report.passed = passed;
+        m_report.failed = failed;
+        m_report.aborted = aborted;
+        // 不在执行器自己的信号里销毁它
+        QMetaObject::invokeMethod(this, &ATCampaignWorker::cleanup, Qt::QueuedConnection);
+    });
+
+    if (!m_runner->start(m_script))
+    {
+        m_report.error = "脚本无法启动";
+        m_report.aborted = true;
+        cleanup();
+    }
+}
+
+void ATCampaignWorker::stop()
+{
+    if (m_runner && m_runner->isRunning())
+    {
+        m_runner->stop();
+    }
+}
+
+void ATCampaignWorker::abort()
+{
+    stop();
+    cleanup();
+}
+
+void ATCampaignWorker::cleanup()
+{
+    if (m_done)
+    {
+        return;
+    }
+    m_done = true;
+    m_report.wallMs = m_clock.elapsed();
+
+    // 串口和执行器必须在所属的工作线程里销毁
+    delete m_runner;
+    m_runner = nullptr;
+    if (m_port)
+    {
+        m_port->close();
+        m_port.reset();
+    }
+
+    emit finished(m_report);
+}
+
+// ========== ATCampaignRunner ==========
+
+ATCampaignRunner::ATCampaignRunner(QObject *parent)
+    : QObject(parent)
+{
+    qRegisterMetaType<ATCommandResult>();
+    qRegisterMetaType<ATCampaignDeviceReport>();
+}
+
+ATCampaignRunner::~ATCampaignRunner()
+{
+    // 同步地让每个工作线程释放自己的串口，再结束线程
+    for (ATCampaignWorker *worker : std::as_const(m_workers))
+    {
+        if (worker->thread()->isRunning())
+        {
+            QMetaObject::invokeMethod(worker, &ATCampaignWorker::abort, Qt::BlockingQueuedConnection);
+        }
+    }
+    shutdownThreads();
+}
+
+bool ATCampaignRunner::start(const ATScriptRunner::Script &script, const QStringList &portNames, qint32 baudRate)
+{
+    QStringList ports = portNames;
+    ports.removeDuplicates();
+    if (m_running || ports.isEmpty() || script.commands.isEmpty())
+    {
+        return false;
+    }
+
+    m_script = script;
+    m_portNames = ports;
+    m_reports.clear();
+    m_running = true;
+    m_clock.start();
+
+    for (const QString &portName : std::as_const(m_portNames))
+    {
+        QThread *thread = new QThread();
+        thread->setObjectName("ATCampaign-" + portName);
+
+        ATCampaignWorker *worker = new ATCampaignWorker(portName, baudRate, m_script);
+        worker->moveToThread(thread);
+        connect(thread, &QThread::started, worker, &ATCampaignWorker::run);
+        connect(worker, &ATCampaignWorker::commandFinished, this, &ATCampaignRunner::deviceCommandFinished);
+        connect(worker, &ATCampaignWorker::finished, this, &ATCampaignRunner::onDeviceFinished);
+
+        m_threads.append(thread);
+        m_workers.append(worker);
+        thread->start();
+    }
+
+    qCInfo(lcSerial) << "[ATCampaignRunner] 开始批量执行" << m_script.name << "设备数:" << m_portNames.size();
+    return true;
+}
+
+void ATCampaignRunner::stop()
+{
+    for (ATCampaignWorker *worker : std::as_const(m_workers))
+    {
+        QMetaObject::invokeMethod(worker, &ATCampaignWorker::stop, Qt::QueuedConnection);
+    }
+}
+
+void ATCampaignRunner::onDeviceFinished(const ATCampaignDeviceReport &report)
+{
+    if (!m_running)
+    {
+        return;
+    }
+
+    m_reports.insert(report.portName, report);
+    emit deviceFinished(report);
+    if (m_reports.size() < m_portNames.size())
+    {
+        return;
+    }
+
+    ATCampaignReport campaign;
+    campaign.scriptName = m_script.name;
+    campaign.wallMs = m_clock.elapsed();
+    for (const QString &portName : std::as_const(m_portNames))
+    {
+        campaign.devices.append(m_reports.value(portName));
+    }
+
+    // 按脚本顺序汇总每条命令在所有设备上的结果与延迟
+    for (const ATScriptRunner::Command &command : std::as_const(m_script.commands))
+    {
+        ATCampaignReport::CommandStats stats;
+        stats.command = command.send;
+        campaign.commands.append(stats);
+    }
+    for (const ATCampaignDeviceReport &device : std::as_const(campaign.devices))
+    {
+        for (const ATCommandResult &result : device.results)
+        {
+            if (result.index < 0 || result.index >= campaign.commands.size())
+            {
+                continue;
+            }
+            ATCampaignReport::CommandStats &stats = campaign.commands[result.index];
+            result.ok() ? ++stats.passed : ++stats.failed;
+            if (result.status == ATCommandResult::Status::Timeout
+                || result.status == ATCommandResult::Status::WriteError)
+            {
+                continue;
+            }
+            ++stats.responded;
+            stats.totalLatencyMs += result.latencyMs;
+            stats.maxLatencyMs = qMax(stats.maxLatencyMs, result.latencyMs);
+            stats.minLatencyMs = stats.minLatencyMs < 0 ? result.latencyMs : qMin(stats.minLatencyMs, result.latencyMs);
+        }
+    }
+
+    m_running = false;
+    shutdownThreads();
+
+    qCInfo(lcSerial) << "[ATCampaignRunner] 批量执行结束 通过设备:" << campaign.passedDevices()
+                     << "/" << campaign.devices.size() << "总耗时(ms):" << campaign.wallMs;
+    emit finished(campaign);
+}
+
+void ATCampaignRunner::shutdownThreads()
+{
+    for (QThread *thread : std::as_const(m_threads))
+    {
+        thread->quit();
+    }
+    for (QThread *thread : std::as_const(m_threads))
+    {
+        thread->wait();
+    }
+    qDeleteAll(m_workers);
+    qDeleteAll(m_threads);
+    m_workers.clear();
+    m_threads.clear();
+}
@@ -0,0 +1,680 @@
+#include "at_script_runner.h"
+#include "serial_port.h"
+#include "operation_logger.h"
+#include "log_categories.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonParseError>
+#include <QDateTime>
+#include <QRegularExpression>
+#include <QTimer>
+#include <QDebug>
+
+namespace
+{
+
+constexpr int kMaxLineBuffer = 64 * 1024;  // 没有换行符的残留数据上限
+
+const QRegularExpression &variablePattern()
+{
+    static const QRegularExpression pattern("\\$\\{(\\w+)\\}");
+    return pattern;
+}
+
+bool parseExpect(const QString &value, ATScriptRunner::Command *command)
+{
+    if (value.startsWith("regex:"))
+    {
+        command->expect = ATScriptRunner::Expect::Regex;
+        command->pattern = value.mid(6);
+        return true;
+    }
+
+    const QString keyword = value.trimmed().toLower();
+    if (keyword.isEmpty() || keyword == "ok")
+        command->expect = ATScriptRunner::Expect::Ok;
+    else if (keyword == "error")
+        command->expect = ATScriptRunner::Expect::Error;
+    else if (keyword == "any")
+        command->expect = ATScriptRunner::Expect::Any;
+    else if (keyword == "none")
+        command->expect = ATScriptRunner::Expect::None;
+    else
+        return false;
+    return true;
+}
+
+// 不含变量的正则在解析时即校验，含变量的在运行时替换后校验
+bool checkPattern(const QString &pattern, QString *error)
+{
+    if (pattern.contains("${"))
+    {
+        return true;
+    }
+    const QRegularExpression regex(pattern);
+    if (!regex.isValid())
+    {
+        *error = QString("正则表达式无效 \"%1\": %2").arg(pattern, regex.errorString());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+QString ATCommandResult::statusName(Status status)
+{
+    switch (status)
+    {
+    case Status::Ok:
+        return "OK";
+    case Status::Error:
+        return "ERROR";
+    case Status::Mismatch:
+        return "MISMATCH";
+    case Status::Timeout:
+        return "TIMEOUT";
+    case Status::WriteError:
+        return "WRITE_ERROR";
+    }
+    return QString();
+}
+
+ATScriptRunner::ATScriptRunner(SerialPort *port, QObject *parent)
+    : QObject(parent)
+    , m_port(port)
+    , m_urcMatcher(new UrcMatcher(this))
+    , m_timeoutTimer(new QTimer(this))
+    , m_resyncTimer(new QTimer(this))
+{
+    m_timeoutTimer->setSingleShot(true);
+    m_resyncTimer->setSingleShot(true);
+    connect(m_timeoutTimer, &QTimer::timeout, this, &ATScriptRunner::onTimeout);
+    connect(m_resyncTimer, &QTimer::timeout, this, &ATScriptRunner::onResyncFinished);
+
+    m_urcMatcher->addStandardPatterns();
+    connect(m_urcMatcher, &UrcMatcher::urcMatched, this, &ATScriptRunner::urcReceived);
+
+    if (m_port)
+    {
+        connect(m_port, &SerialPort::rawDataReceived, this, &ATScriptRunner::onRawDataReceived);
+        connect(m_port, &SerialPort::connectionStatusChanged, this, &ATScriptRunner::onConnectionStatusChanged);
+    }
+}
+
+ATScriptRunner::~ATScriptRunner() = default;
+
+bool ATScriptRunner::parse(const QByteArray &json, Script *script, QString *error)
+{
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(json, &parseError);
+    if (doc.isNull())
+    {
+        *error = QString("JSON 格式错误（偏移 %1）: %2").arg(parseError.offset).arg(parseError.errorString());
+        return false;
+    }
+    return parse(doc, script, error);
+}
+
+bool ATScriptRunner::parse(const QJsonDocument &doc, Script *script, QString *error)
+{
+    *script = Script();
+    QJsonObject root;
+    QJsonArray commands;
+    if (doc.isArray())
+    {
+        commands = doc.array();
+    }
+    else
+    {
+        root = doc.object();
+        if (!root.value("commands").isArray())
+        {
+            *error = "脚本缺少 commands 数组";
+            return false;
+        }
+        commands = root.value("commands").toArray();
+    }
+
+    script->name = root.value("name").toString();
+    script->window = qBound(1, root.value("window").toInt(1), kMaxWindow);
+    script->stopOnError = root.value("stopOnError").toBool(true);
+    if (root.contains("lineEnding"))
+    {
+        script->lineEnding = root.value("lineEnding").toString().toUtf8();
+    }
+    const QJsonObject variables = root.value("variables").toObject();
+    for (auto it = variables.begin(); it != variables.end(); ++it)
+    {
+        script->variables.insert(it.key(), it.value().toVariant().toString());
+    }
+
+    const int defaultTimeout = qMax(1, root.value("timeoutMs").toInt(1000));
+    const int defaultRetries = qMax(0, root.value("retries").toInt(0));
+
+    for (int i = 0; i < commands.size(); ++i)
+    {
+        Command command;
+        command.timeoutMs = defaultTimeout;
+        command.retries = defaultRetries;
+
+        const QJsonValue value = commands.at(i);
+        if (value.isString())
+        {
+            command.send = value.toString();
+        }
+        else if (value.isObject())
+        {
+            const QJsonObject object = value.toObject();
+            if (!object.value("send").isString())
+            {
+                *error = QString("第 %1 条命令缺少 send").arg(i + 1);
+                return false;
+            }
+            command.send = object.value("send").toString();
+            if (!parseExpect(object.value("expect").toString(), &command))
+            {
+                *error = QString("第 %1 条命令的 expect 无效: %2").arg(i + 1).arg(object.value("expect").toString());
+                return false;
+            }
+            command.timeoutMs = qMax(1, object.value("timeoutMs").toInt(defaultTimeout));
+            command.retries = qMax(0, object.value("retries").toInt(defaultRetries));
+            command.sync = object.value("sync").toBool(false);
+
+            const QJsonObject captures = object.value("capture").toObject();
+            for (auto it = captures.begin(); it != captures.end(); ++it)
+            {
+                command.captures.append(qMakePair(it.key(), it.value().toString()));
+            }
+        }
+        else
+        {
+            *error = QString("第 %1 条命令既不是字符串也不是对象").arg(i + 1);
+            return false;
+        }
+
+        QString patternError;
+        if (command.expect == Expect::Regex && !checkPattern(command.pattern, &patternError))
+        {
+            *error = QString("第 %1 条命令: %2").arg(i + 1).arg(patternError);
+            return false;
+        }
+        for (const auto &capture : command.captures)
+        {
+            if (!checkPattern(capture.second, &patternError))
+            {
+                *error = QString("第 %1 条命令: %2").arg(i + 1).arg(patternError);
+                return false;
+            }
+        }
+
+        script->commands.append(command);
+    }
+
+    if (script->commands.isEmpty())
+    {
+        *error = "脚本没有命令";
+        return false;
+    }
+    return true;
+}
+
+bool ATScriptRunner::start(const Script &script)
+{
+    if (m_running || !m_port || !m_port->isOpen() || script.commands.isEmpty())
+    {
+        return false;
+    }
+
+    m_script = script;
+    m_variables = script.variables;
+    m_queue.clear();
+    m_outstanding.clear();
+    m_lineBuffer.clear();
+    for (int i = 0; i < m_script.commands.size(); ++i)
+    {
+        Queued queued;
+        queued.index = i;
+        m_queue.push_back(queued);
+    }
+
+    m_running = true;
+    m_resyncing = false;
+    m_stopping = false;
+    m_passed = 0;
+    m_failed = 0;
+    m_clock.start();
+    m_headSince = 0;
+
+    qCInfo(lcSerial) << "[ATScriptRunner] 开始执行脚本" << m_script.name
+                     << "命令数:" << m_script.commands.size() << "窗口:" << m_script.window;
+    pump();
+    return true;
+}
+
+void ATScriptRunner::stop()
+{
+    if (m_running)
+    {
+        finish(true);
+    }
+}
+
+void ATScriptRunner::pump()
+{
+    if (!m_running || m_resyncing)
+    {
+        return;
+    }
+
+    while (!m_queue.empty() && !m_stopping)
+    {
+        const Queued queued = m_queue.front();
+        if (!canSend(queued))
+        {
+            break;
+        }
+        m_queue.pop_front();
+
+        const Command &command = m_script.commands.at(queued.index);
+        Pending pending;
+        pending.index = queued.index;
+        pending.attempt = queued.attempt;
+        pending.text = substitute(command.send);
+
+        emit commandSent(pending.index, pending.text, pending.attempt);
+        OperationLogger::instance().logCommandExecuted(pending.text);
+
+        const qint64 written = m_port->writeRaw(pending.text.toUtf8() + m_script.lineEnding);
+        pending.sentAt = m_clock.elapsed();
+        if (written < 0)
+        {
+            finishCommand(pending, ATCommandResult::Status::WriteError, QString());
+            m_stopping = true;
+            break;
+        }
+
+        if (command.expect == Expect::None)
+        {
+            finishCommand(pending, ATCommandResult::Status::Ok, QString());
+        }
+        else
+        {
+            if (m_outstanding.empty())
+            {
+                m_headSince = pending.sentAt;
+            }
+            m_outstanding.push_back(pending);
+        }
+
+        // 结果信号的接收方可能调用了 stop()
+        if (!m_running)
+        {
+            return;
+        }
+    }
+
+    if (!m_running)
+    {
+        return;
+    }
+    armTimeout();
+    if (m_outstanding.empty() && (m_queue.empty() || m_stopping))
+    {
+        finish(m_stopping);
+    }
+}
+
+bool ATScriptRunner::canSend(const Queued &queued) const
+{
+    if (m_outstanding.empty())
+    {
+        return true;
+    }
+    if (static_cast<int>(m_outstanding.size()) >= m_script.window)
+    {
+        return false;
+    }
+
+    const Command &command = m_script.commands.at(queued.index);
+    if (queued.mustDrain || command.sync || command.expect == Expect::None)
+    {
+        return false;
+    }
+
+    // 依赖在途命令捕获的变量时必须等它完成
+    for (const Pending &pending : m_outstanding)
+    {
+        for (const auto &capture : m_script.commands.at(pending.index).captures)
+        {
+            const QString reference = "${" + capture.first + "}";
+            if (command.send.contains(reference) || command.pattern.contains(reference))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void ATScriptRunner::onRawDataReceived(const QByteArray &data)
+{
+    if (!m_running)
+    {
+        return;
+    }
+
+    m_lineBuffer.append(data);
+    qsizetype start = 0;
+    qsizetype newline;
+    while ((newline = m_lineBuffer.indexOf('\n', start)) >= 0)
+    {
+        qsizetype end = newline;
+        if (end > start && m_lineBuffer.at(end - 1) == '\r')
+        {
+            --end;
+        }
+        const QString line = QString::fromUtf8(m_lineBuffer.constData() + start, end - start).trimmed();
+        start = newline + 1;
+
+        if (!line.isEmpty())
+        {
+            handleLine(line);
+            if (!m_running)
+            {
+                return;
+            }
+        }
+    }
+
+    m_lineBuffer.remove(0, start);
+    if (m_lineBuffer.size() > kMaxLineBuffer)
+    {
+        m_lineBuffer.clear();
+    }
+}
+
+void ATScriptRunner::handleLine(const QString &line)
+{
+    // 静默期内的迟到响应和没有在途命令时的主动上报都丢弃
+    if (m_resyncing || m_outstanding.empty())
+    {
+        return;
+    }
+
+    // 回显
+    for (const Pending &pending : m_outstanding)
+    {
+        if (line == pending.text.trimmed())
+        {
+            return;
+        }
+    }
+
+    Pending &head = m_outstanding.front();
+    bool isError = false;
+    if (!isFinalResult(line, &isError))
+    {
+        // 主动上报不计入响应；队首命令自己的查询应答（+CREG: 等）除外
+        if (!isQueryResponse(head.text, line)
+            && m_urcMatcher->matchLine(line, QDateTime::currentMSecsSinceEpoch()))
+        {
+            return;
+        }
+        head.response.append(line);
+        return;
+    }
+
+    const Command &command = m_script.commands.at(head.index);
+    ATCommandResult::Status status = ATCommandResult::Status::Ok;
+    switch (command.expect)
+    {
+    case Expect::Ok:
+        status = isError ? ATCommandResult::Status::Error : ATCommandResult::Status::Ok;
+        break;
+    case Expect::Error:
+        status = isError ? ATCommandResult::Status::Ok : ATCommandResult::Status::Mismatch;
+        break;
+    case Expect::Any:
+    case Expect::None:
+        status = ATCommandResult::Status::Ok;
+        break;
+    case Expect::Regex:
+    {
+        if (isError)
+        {
+            status = ATCommandResult::Status::Error;
+            break;
+        }
+        const QRegularExpression regex(substitute(command.pattern));
+        bool matched = regex.isValid() && regex.match(line).hasMatch();
+        for (int i = 0; !matched && regex.isValid() && i < head.response.size(); ++i)
+        {
+            matched = regex.match(head.response.at(i)).hasMatch();
+        }
+        status = matched ? ATCommandResult::Status::Ok : ATCommandResult::Status::Mismatch;
+        break;
+    }
+    }
+
+    completeHead(status, line);
+    pump();
+}
+
+void ATScriptRunner::completeHead(ATCommandResult::Status status, const QString &finalResult)
+{
+    const Pending pending = m_outstanding.front();
+    m_outstanding.pop_front();
+    m_headSince = m_clock.elapsed();
+
+    finishCommand(pending, status, finalResult);
+    if (m_running)
+    {
+        armTimeout();
+    }
+}
+
+void ATScriptRunner::finishCommand(const Pending &pending, ATCommandResult::Status status, const QString &finalResult)
+{
+    const Command &command = m_script.commands.at(pending.index);
+
+    if (status == ATCommandResult::Status::Ok)
+    {
+        applyCaptures(command, pending.response);
+    }
+    else if (status != ATCommandResult::Status::WriteError && pending.attempt <= command.retries && !m_stopping)
+    {
+        Queued retry;
+        retry.index = pending.index;
+        retry.attempt = pending.attempt + 1;
+        retry.mustDrain = true;
+        m_queue.push_front(retry);
+        qCDebug(lcSerial) << "[ATScriptRunner] 重试" << pending.text << "第" << retry.attempt << "次"
+                          << ATCommandResult::statusName(status);
+        return;
+    }
+
+    ATCommandResult result;
+    result.index = pending.index;
+    result.command = pending.text;
+    result.status = status;
+    result.response = pending.response;
+    result.finalResult = finalResult;
+    result.attempts = pending.attempt;
+    result.latencyMs = m_clock.elapsed() - pending.sentAt;
+
+    if (result.ok())
+    {
+        ++m_passed;
+    }
+    else
+    {
+        ++m_failed;
+        if (m_script.stopOnError)
+        {
+            m_stopping = true;
+            m_queue.clear();
+        }
+    }
+
+    emit commandFinished(result);
+}
+
+void ATScriptRunner::applyCaptures(const Command &command, const QStringList &lines)
+{
+    for (const auto &capture : command.captures)
+    {
+        const QRegularExpression regex(substitute(capture.second));
+        if (!regex.isValid())
+        {
+            qCWarning(lcSerial) << "[ATScriptRunner] 捕获正则无效:" << capture.second << regex.errorString();
+            continue;
+        }
+        for (const QString &line : lines)
+        {
+            const QRegularExpressionMatch match = regex.match(line);
+            if (match.hasMatch())
+            {
+                const QString value = match.lastCapturedIndex() >= 1 ? match.captured(1) : match.captured(0);
+                m_variables.insert(capture.first, value);
+                emit variableCaptured(capture.first, value);
+                break;
+            }
+        }
+    }
+}
+
+void ATScriptRunner::armTimeout()
+{
+    if (m_outstanding.empty())
+    {
+        m_timeoutTimer->stop();
+        return;
+    }
+
+    // 模块按顺序应答，队首的超时从它开始等待结果码时算起
+    const Pending &head = m_outstanding.front();
+    const qint64 since = qMax(m_headSince, head.sentAt);
+    const qint64 deadline = since + m_script.commands.at(head.index).timeoutMs;
+    m_timeoutTimer->start(static_cast<int>(qMax<qint64>(0, deadline - m_clock.elapsed())));
+}
+
+void ATScriptRunner::onTimeout()
+{
+    if (!m_running || m_outstanding.empty())
+    {
+        return;
+    }
+
+    const Pending head = m_outstanding.front();
+    m_outstanding.pop_front();
+
+    // 其后的在途命令无法确定响应归属，按原顺序重新排队（不计入重试次数）
+    for (auto it = m_outstanding.rbegin(); it != m_outstanding.rend(); ++it)
+    {
+        Queued requeued;
+        requeued.index = it->index;
+        requeued.attempt = it->attempt;
+        m_queue.push_front(requeued);
+    }
+    m_outstanding.clear();
+
+    finishCommand(head, ATCommandResult::Status::Timeout, QString());
+    if (!m_running)
+    {
+        return;
+    }
+
+    m_resyncing = true;
+    m_lineBuffer.clear();
+    m_resyncTimer->start(kResyncQuietMs);
+}
+
+void ATScriptRunner::onResyncFinished()
+{
+    m_resyncing = false;
+    m_lineBuffer.clear();
+    pump();
+}
+
+void ATScriptRunner::onConnectionStatusChanged(bool isOpen)
+{
+    if (!isOpen && m_running)
+    {
+        qCWarning(lcSerial) << "[ATScriptRunner] 串口已断开，脚本中止";
+        finish(true);
+    }
+}
+
+void ATScriptRunner::finish(bool aborted)
+{
+    m_running = false;
+    m_resyncing = false;
+    m_timeoutTimer->stop();
+    m_resyncTimer->stop();
+    m_queue.clear();
+    m_outstanding.clear();
+    m_lineBuffer.clear();
+
+    qCInfo(lcSerial) << "[ATScriptRunner] 脚本结束 通过:" << m_passed << "失败:" << m_failed
+                     << "耗时(ms):" << m_clock.elapsed() << (aborted ? "（提前结束）" : "");
+    emit finished(m_passed, m_failed, aborted);
+}
+
+QString ATScriptRunner::substitute(const QString &text) const
+{
+    if (!text.contains("${"))
+    {
+        return text;
+    }
+
+    QString result;
+    qsizetype last = 0;
+    QRegularExpressionMatchIterator it = variablePattern().globalMatch(text);
+    while (it.hasNext())
+    {
+        const QRegularExpressionMatch match = it.next();
+        result += text.mid(last, match.capturedStart() - last);
+        const auto value = m_variables.constFind(match.captured(1));
+        result += value != m_variables.constEnd() ? value.value() : match.captured(0);
+        last = match.capturedEnd();
+    }
+    result += text.mid(last);
+    return result;
+}
+
+bool ATScriptRunner::isFinalResult(const QString &line, bool *isError)
+{
+    *isError = false;
+    if (line == "OK" || line.startsWith("CONNECT"))
+    {
+        return true;
+    }
+    if (line == "ERROR" || line.startsWith("+CME ERROR") || line.startsWith("+CMS ERROR")
+        || line == "NO CARRIER" || line == "BUSY" || line == "NO ANSWER" || line == "NO DIALTONE")
+    {
+        *isError = true;
+        return true;
+    }
+    return false;
+}
+
+bool ATScriptRunner::isQueryResponse(const QString &command, const QString &line)
+{
+    // "+CREG: 0,1" 是 AT+CREG? / AT+CREG 的应答：取冒号前的名字与命令比较
+    const qsizetype colon = line.indexOf(':');
+    if (!line.startsWith('+') || colon < 0)
+    {
+        return false;
+    }
+    QString name = command.trimmed();
+    if (name.startsWith("AT", Qt::CaseInsensitive))
+    {
+        name = name.mid(2);
+    }
+    const QStringView prefix = QStringView(line).left(colon);
+    return name.startsWith(prefix, Qt::CaseInsensitive)
+           && (name.size() == prefix.size() || !name.at(prefix.size()).isLetterOrNumber());
+}
@@ -0,0 +1,401 @@
+#include "checksum.h"
+
+#include <QtEndian>
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#  define SCOM_CRC32C_X86 1
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#    include <nmmintrin.h>
+#    define SCOM_TARGET_SSE42
+#  else
+#    include <nmmintrin.h>
+#    define SCOM_TARGET_SSE42 __attribute__((target("sse4.2")))
+#  endif
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#  define SCOM_CRC32C_ARM 1
+#  include <arm_acle.h>
+#endif
+
+namespace {
+
+using Table = std::array<quint32, 256>;
+using SliceTables = std::array<Table, 8>;
+
+/**
+ * 反射（LSB 在前）多项式的 slice-by-8 查表，tables[0] 即普通逐字节查表
+ */
+constexpr SliceTables makeReflectedTables(quint32 poly)
+{
+    SliceTables tables{};
+    for (quint32 i = 0; i < 256; ++i)
+    {
+        quint32 crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ poly : crc >> 1;
+        }
+        tables[0][i] = crc;
+    }
+    for (int slice = 1; slice < 8; ++slice)
+    {
+        for (quint32 i = 0; i < 256; ++i)
+        {
+            const quint32 previous = tables[slice - 1][i];
+            tables[slice][i] = (previous >> 8) ^ tables[0][previous & 0xFF];
+        }
+    }
+    return tables;
+}
+
+constexpr std::array<quint16, 256> makeReflected16(quint16 poly)
+{
+    std::array<quint16, 256> table{};
+    for (quint32 i = 0; i < 256; ++i)
+    {
+        quint16 crc = quint16(i);
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 1) ? quint16((crc >> 1) ^ poly) : quint16(crc >> 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr std::array<quint16, 256> makeNormal16(quint16 poly)
+{
+    std::array<quint16, 256> table{};
+    for (quint32 i = 0; i < 256; ++i)
+    {
+        quint16 crc = quint16(i << 8);
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 0x8000) ? quint16((crc << 1) ^ poly) : quint16(crc << 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr std::array<quint8, 256> makeNormal8(quint8 poly)
+{
+    std::array<quint8, 256> table{};
+    for (quint32 i = 0; i < 256; ++i)
+    {
+        quint8 crc = quint8(i);
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 0x80) ? quint8((crc << 1) ^ poly) : quint8(crc << 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr auto kCrc8Table = makeNormal8(0x07);
+constexpr auto kCrc16ModbusTable = makeReflected16(0xA001);
+constexpr auto kCrc16CcittTable = makeNormal16(0x1021);
+constexpr SliceTables kCrc32Tables = makeReflectedTables(0xEDB88320u);
+constexpr SliceTables kCrc32cTables = makeReflectedTables(0x82F63B78u);
+
+static_assert(kCrc32Tables[0][1] == 0x77073096u, "CRC32 table");
+static_assert(kCrc32cTables[0][1] == 0xF26B8303u, "CRC32C table");
+
+/**
+ * slice-by-8：每次处理 8 字节，8 次查表相互独立，可以并行执行
+ */
+quint32 sliceBy8(const SliceTables &t, quint32 crc, const uchar *p, qsizetype size)
+{
+    while (size >= 8)
+    {
+        const quint32 low = qFromLittleEndian<quint32>(p) ^ crc;
+        const quint32 high = qFromLittleEndian<quint32>(p + 4);
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24]
+            ^ t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+        p += 8;
+        size -= 8;
+    }
+    while (size-- > 0)
+    {
+        crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+    }
+    return crc;
+}
+
+#if defined(SCOM_CRC32C_X86)
+
+SCOM_TARGET_SSE42 quint32 crc32cHardware(quint32 crc, const uchar *p, qsizetype size)
+{
+    quint64 crc64 = crc;
+    while (size >= 8)
+    {
+        quint64 word;
+        std::memcpy(&word, p, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        p += 8;
+        size -= 8;
+    }
+    crc = quint32(crc64);
+    while (size-- > 0)
+    {
+        crc = _mm_crc32_u8(crc, *p++);
+    }
+    return crc;
+}
+
+bool detectHardwareCrc32c()
+{
+#  if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+#  else
+    return __builtin_cpu_supports("sse4.2");
+#  endif
+}
+
+#elif defined(SCOM_CRC32C_ARM)
+
+quint32 crc32cHardware(quint32 crc, const uchar *p, qsizetype size)
+{
+    while (size >= 8)
+    {
+        quint64 word;
+        std::memcpy(&word, p, sizeof(word));
+        crc = __crc32cd(crc, word);
+        p += 8;
+        size -= 8;
+    }
+    while (size-- > 0)
+    {
+        crc = __crc32cb(crc, *p++);
+    }
+    return crc;
+}
+
+bool detectHardwareCrc32c()
+{
+    return true;
+}
+
+#endif
+
+struct AlgorithmInfo
+{
+    Checksum::Algorithm algorithm;
+    const char *name;
+    int width;
+};
+
+constexpr AlgorithmInfo kAlgorithms[] = {
+    {Checksum::Algorithm::None, "None", 0},
+    {Checksum::Algorithm::Sum8, "SUM8", 1},
+    {Checksum::Algorithm::Xor8, "XOR8", 1},
+    {Checksum::Algorithm::Crc8, "CRC8", 1},
+    {Checksum::Algorithm::Crc16Modbus, "CRC16-MODBUS", 2},
+    {Checksum::Algorithm::Crc16Ccitt, "CRC16-CCITT", 2},
+    {Checksum::Algorithm::Crc32, "CRC32", 4},
+    {Checksum::Algorithm::Crc32C, "CRC32C", 4},
+};
+
+} // namespace
+
+quint8 Checksum::crc8(const char *data, qsizetype size, quint8 crc)
+{
+    const uchar *p = reinterpret_cast<const uchar *>(data);
+    for (qsizetype i = 0; i < size; ++i)
+    {
+        crc = kCrc8Table[crc ^ p[i]];
+    }
+    return crc;
+}
+
+quint16 Checksum::crc16Modbus(const char *data, qsizetype size, quint16 crc)
+{
+    const uchar *p = reinterpret_cast<const uchar *>(data);
+    for (qsizetype i = 0; i < size; ++i)
+    {
+        crc = quint16((crc >> 8) ^ kCrc16ModbusTable[(crc ^ p[i]) & 0xFF]);
+    }
+    return crc;
+}
+
+quint16 Checksum::crc16Ccitt(const char *data, qsizetype size, quint16 crc)
+{
+    const uchar *p = reinterpret_cast<const uchar *>(data);
+    for (qsizetype i = 0; i < size; ++i)
+    {
+        crc = quint16((crc << 8) ^ kCrc16CcittTable[((crc >> 8) ^ p[i]) & 0xFF]);
+    }
+    return crc;
+}
+
+quint32 Checksum::crc32(const char *data, qsizetype size, quint32 crc)
+{
+    return ~sliceBy8(kCrc32Tables, ~crc, reinterpret_cast<const uchar *>(data), size);
+}
+
+quint32 Checksum::crc32c(const char *data, qsizetype size, quint32 crc)
+{
+    const uchar *p = reinterpret_cast<const uchar *>(data);
+#if defined(SCOM_CRC32C_X86) || defined(SCOM_CRC32C_ARM)
+    if (hasHardwareCrc32c())
+    {
+        return ~crc32cHardware(~crc, p, size);
+    }
+#endif
+    return crc32cSoftware(data, size, crc);
+}
+
+quint32 Checksum::crc32cSoftware(const char *data, qsizetype size, quint32 crc)
+{
+    return ~sliceBy8(kCrc32cTables, ~crc, reinterpret_cast<const uchar *>(data), size);
+}
+
+bool Checksum::hasHardwareCrc32c()
+{
+#if defined(SCOM_CRC32C_X86) || defined(SCOM_CRC32C_ARM)
+    static const bool supported = detectHardwareCrc32c();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+quint32 Checksum::compute(Algorithm algorithm, const char *data, qsizetype size)
+{
+    switch (algorithm)
+    {
+    case Algorithm::None:
+        return 0;
+    case Algorithm::Sum8:
+    {
+        quint8 sum = 0;
+        for (qsizetype i = 0; i < size; ++i)
+        {
+            sum = quint8(sum + quint8(data[i]));
+        }
+        return sum;
+    }
+    case Algorithm::Xor8:
+    {
+        quint8 value = 0;
+        for (qsizetype i = 0; i < size; ++i)
+        {
+            value ^= quint8(data[i]);
+        }
+        return value;
+    }
+    case Algorithm::Crc8:
+        return crc8(data, size);
+    case Algorithm::Crc16Modbus:
+        return crc16Modbus(data, size);
+    case Algorithm::Crc16Ccitt:
+        return crc16Ccitt(data, size);
+    case Algorithm::Crc32:
+        return crc32(data, size);
+    case Algorithm::Crc32C:
+        return crc32c(data, size);
+    }
+    return 0;
+}
+
+int Checksum::width(Algorithm algorithm)
+{
+    for (const AlgorithmInfo &info : kAlgorithms)
+    {
+        if (info.algorithm == algorithm)
+        {
+            return info.width;
+        }
+    }
+    return 0;
+}
+
+QByteArray Checksum::encode(Algorithm algorithm, quint32 value)
+{
+    QByteArray bytes(width(algorithm), Qt::Uninitialized);
+    switch (algorithm)
+    {
+    case Algorithm::Crc16Ccitt:
+        qToBigEndian<quint16>(quint16(value), bytes.data());
+        break;
+    case Algorithm::Crc16Modbus:
+        qToLittleEndian<quint16>(quint16(value), bytes.data());
+        break;
+    case Algorithm::Crc32:
+    case Algorithm::Crc32C:
+        qToLittleEndian<quint32>(value, bytes.data());
+        break;
+    case Algorithm::Sum8:
+    case Algorithm::Xor8:
+    case Algorithm::Crc8:
+        bytes[0] = char(value);
+        break;
+    case Algorithm::None:
+        break;
+    }
+    return bytes;
+}
+
+QByteArray Checksum::append(Algorithm algorithm, const QByteArray &data)
+{
+    if (algorithm == Algorithm::None)
+    {
+        return data;
+    }
+    return data + encode(algorithm, compute(algorithm, data));
+}
+
+bool Checksum::verify(Algorithm algorithm, const QByteArray &frame)
+{
+    const int size = width(algorithm);
+    if (size == 0)
+    {
+        return true;
+    }
+    if (frame.size() <= size)
+    {
+        return false;
+    }
+    const qsizetype payload = frame.size() - size;
+    const QByteArray expected = encode(algorithm, compute(algorithm, frame.constData(), payload));
+    return std::memcmp(expected.constData(), frame.constData() + payload, size_t(size)) == 0;
+}
+
+QString Checksum::name(Algorithm algorithm)
+{
+    for (const AlgorithmInfo &info : kAlgorithms)
+    {
+        if (info.algorithm == algorithm)
+        {
+            return QString::fromLatin1(info.name);
+        }
+    }
+    return QStringLiteral("None");
+}
+
+Checksum::Algorithm Checksum::fromName(const QString &name)
+{
+    for (const AlgorithmInfo &info : kAlgorithms)
+    {
+        if (name.compare(QLatin1String(info.name), Qt::CaseInsensitive) == 0)
+        {
+            return info.algorithm;
+        }
+    }
+    return Algorithm::None;
+}
+
+QStringList Checksum::names()
+{
+    QStringList result;
+    for (const AlgorithmInfo &info : kAlgorithms)
+    {
+        result << QString::fromLatin1(info.name);
+    }
+    return result;
+}
@@ -0,0 +1,78 @@
+#include "checksum_verifier.h"
+
+ChecksumVerifier::ChecksumVerifier(QObject *parent)
+    : QObject(parent)
+{
+    m_idleTimer.setSingleShot(true);
+    m_idleTimer.setTimerType(Qt::PreciseTimer);
+    m_idleTimer.setInterval(m_idleGapMs);
+    connect(&m_idleTimer, &QTimer::timeout, this, &ChecksumVerifier::finishFrame);
+}
+
+void ChecksumVerifier::setAlgorithm(Checksum::Algorithm algorithm)
+{
+    if (m_algorithm == algorithm)
+    {
+        return;
+    }
+    m_algorithm = algorithm;
+    resetStream();
+    resetCounters();
+}
+
+void ChecksumVerifier::setIdleGapMs(int ms)
+{
+    m_idleGapMs = qMax(1, ms);
+    m_idleTimer.setInterval(m_idleGapMs);
+}
+
+void ChecksumVerifier::feed(const QByteArray &data)
+{
+    if (m_algorithm == Checksum::Algorithm::None || data.isEmpty())
+    {
+        return;
+    }
+
+    m_frame.append(data);
+    if (m_frame.size() >= kMaxFrameSize)
+    {
+        finishFrame();
+        return;
+    }
+    m_idleTimer.start();
+}
+
+void ChecksumVerifier::resetStream()
+{
+    m_idleTimer.stop();
+    m_frame.clear();
+}
+
+void ChecksumVerifier::resetCounters()
+{
+    m_okCount = 0;
+    m_errorCount = 0;
+}
+
+void ChecksumVerifier::finishFrame()
+{
+    m_idleTimer.stop();
+    if (m_frame.isEmpty())
+    {
+        return;
+    }
+
+    const QByteArray frame = m_frame;
+    m_frame.clear();
+
+    const bool ok = Checksum::verify(m_algorithm, frame);
+    if (ok)
+    {
+        ++m_okCount;
+    }
+    else
+    {
+        ++m_errorCount;
+    }
+    emit frameVerified(frame, ok);
+}
@@ -0,0 +1,375 @@
+#include "command_history_index.h"
+
+#include <QSet>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+// 前缀匹配的分层加成，保证前缀结果总是排在子串结果之前
+constexpr double kPrefixTierBonus = 1000.0;
+
+// 前缀区间不超过该条数时直接逐条打分，否则按得分上界提前结束
+constexpr qsizetype kDirectPrefixScan = 512;
+
+} // namespace
+
+CommandHistoryIndex::CommandHistoryIndex(int capacity)
+    : m_capacity(qMax(1, capacity))
+{
+}
+
+void CommandHistoryIndex::clear()
+{
+    m_clock = 0;
+    m_aliveCount = 0;
+    m_entries.clear();
+    m_idByText.clear();
+    m_sortedIds.clear();
+    m_recency.clear();
+    m_byCount.clear();
+    m_bigramPostings.clear();
+}
+
+void CommandHistoryIndex::load(const QStringList &mostRecentFirst, const QList<int> &counts)
+{
+    clear();
+
+    // 从最旧到最新依次推进逻辑时钟，最后一条（列表首项）最新
+    for (int i = mostRecentFirst.size() - 1; i >= 0; --i) {
+        const QString &command = mostRecentFirst.at(i);
+        if (command.isEmpty()) {
+            continue;
+        }
+        const quint32 count = static_cast<quint32>(qMax(1, i < counts.size() ? counts.at(i) : 1));
+
+        auto found = m_idByText.constFind(command);
+        if (found != m_idByText.constEnd()) {
+            Entry &entry = m_entries[*found];
+            entry.count += count;
+            entry.lastUsed = ++m_clock;
+            continue;
+        }
+
+        Entry entry;
+        entry.text = command;
+        entry.key = command.toLower();
+        entry.count = count;
+        entry.lastUsed = ++m_clock;
+        entry.alive = true;
+        m_idByText.insert(command, static_cast<int>(m_entries.size()));
+        m_entries.push_back(std::move(entry));
+        ++m_aliveCount;
+    }
+
+    // 批量建立排序数组与倒排表，避免逐条插入的 O(n^2) 搬移
+    rebuild();
+
+    while (m_aliveCount > m_capacity) {
+        evictOldest();
+    }
+}
+
+void CommandHistoryIndex::record(const QString &command)
+{
+    if (command.isEmpty()) {
+        return;
+    }
+
+    auto found = m_idByText.constFind(command);
+    if (found != m_idByText.constEnd()) {
+        Entry &entry = m_entries[*found];
+        m_recency.erase(entry.lastUsed);
+        m_byCount.erase({entry.count, *found});
+        entry.lastUsed = ++m_clock;
+        entry.count++;
+        m_recency.emplace(entry.lastUsed, *found);
+        m_byCount.emplace(entry.count, *found);
+        return;
+    }
+
+    insertEntry(command, 1, ++m_clock);
+
+    while (m_aliveCount > m_capacity) {
+        evictOldest();
+    }
+}
+
+bool CommandHistoryIndex::contains(const QString &command) const
+{
+    return m_idByText.contains(command);
+}
+
+int CommandHistoryIndex::size() const
+{
+    return m_aliveCount;
+}
+
+QStringList CommandHistoryIndex::mostRecent(int limit) const
+{
+    QStringList result;
+    for (auto it = m_recency.crbegin(); it != m_recency.crend() && result.size() < limit; ++it) {
+        result.append(m_entries[it->second].text);
+    }
+    return result;
+}
+
+int CommandHistoryIndex::countOf(const QString &command) const
+{
+    auto found = m_idByText.constFind(command);
+    return found == m_idByText.constEnd() ? 0 : static_cast<int>(m_entries[*found].count);
+}
+
+QVector<CommandHistoryIndex::Match> CommandHistoryIndex::search(const QString &query, int limit) const
+{
+    QVector<Match> result;
+    if (limit <= 0) {
+        return result;
+    }
+
+    if (query.isEmpty()) {
+        for (const QString &command : mostRecent(limit)) {
+            const Entry &entry = m_entries[m_idByText.value(command)];
+            result.append({entry.text, static_cast<int>(entry.count), scoreOf(entry)});
+        }
+        return result;
+    }
+
+    const QString needle = query.toLower();
+
+    // 小顶堆保存当前得分最高的 limit 个结果
+    using Scored = std::pair<double, int>;
+    std::vector<Scored> heap;
+    heap.reserve(static_cast<size_t>(limit) + 1);
+    auto offer = [&heap, limit](double score, int id) {
+        if (static_cast<int>(heap.size()) < limit) {
+            heap.emplace_back(score, id);
+            std::push_heap(heap.begin(), heap.end(), std::greater<Scored>());
+        } else if (score > heap.front().first) {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<Scored>());
+            heap.back() = {score, id};
+            std::push_heap(heap.begin(), heap.end(), std::greater<Scored>());
+        }
+    };
+
+    // ---- 前缀匹配：二分定位连续区间 ----
+    auto keyLess = [this](int id, const QString &key) { return m_entries[id].key < key; };
+    const auto first = std::lower_bound(m_sortedIds.cbegin(), m_sortedIds.cend(), needle, keyLess);
+    const auto last = std::partition_point(first, m_sortedIds.cend(),
+                                           [this, &needle](int id) { return m_entries[id].key.startsWith(needle); });
+    if (last - first <= kDirectPrefixScan) {
+        for (auto it = first; it != last; ++it) {
+            offer(kPrefixTierBonus + scoreOf(m_entries[*it]), *it);
+        }
+    } else {
+        // 得分 = 次数分 + 最近使用分，两项分别从高到低遍历（阈值算法）：
+        // 未访问条目的得分不超过两个游标处的分量之和，第 limit 名已不低于它时停止
+        QSet<int> visited;
+        auto visit = [&](int id) {
+            if (!visited.contains(id)) {
+                visited.insert(id);
+                const Entry &entry = m_entries[id];
+                if (entry.key.startsWith(needle)) {
+                    offer(kPrefixTierBonus + scoreOf(entry), id);
+                }
+            }
+        };
+        auto byRecency = m_recency.crbegin();
+        auto byCount = m_byCount.crbegin();
+        while (byRecency != m_recency.crend() && byCount != m_byCount.crend()) {
+            visit(byRecency->second);
+            visit(byCount->second);
+            ++byRecency;
+            ++byCount;
+            if (byRecency == m_recency.crend() || byCount == m_byCount.crend()) {
+                break;
+            }
+            const double bound = frequencyScore(byCount->first) + recencyScore(byRecency->first);
+            if (static_cast<int>(heap.size()) == limit && heap.front().first >= kPrefixTierBonus + bound) {
+                break;
+            }
+        }
+    }
+
+    // ---- 子串匹配：取最短的 bigram 倒排表求交后逐条校验 ----
+    // 前缀结果已填满时子串结果不可能入选（分层加成），跳过
+    if (needle.size() >= 2 && static_cast<int>(heap.size()) < limit) {
+        const std::vector<quint32> grams = bigramsOf(needle);
+        std::vector<const std::vector<int> *> lists;
+        lists.reserve(grams.size());
+        bool missing = false;
+        for (quint32 gram : grams) {
+            auto found = m_bigramPostings.constFind(gram);
+            if (found == m_bigramPostings.constEnd()) {
+                missing = true;
+                break;
+            }
+            lists.push_back(&found.value());
+        }
+
+        if (!missing && !lists.empty()) {
+            std::sort(lists.begin(), lists.end(),
+                      [](const std::vector<int> *a, const std::vector<int> *b) { return a->size() < b->size(); });
+
+            std::vector<int> intersected;
+            const std::vector<int> *candidates = lists.front();
+            if (lists.size() > 1) {
+                std::set_intersection(lists[0]->cbegin(), lists[0]->cend(),
+                                      lists[1]->cbegin(), lists[1]->cend(),
+                                      std::back_inserter(intersected));
+                candidates = &intersected;
+            }
+
+            for (int id : *candidates) {
+                const Entry &entry = m_entries[id];
+                if (!entry.alive || entry.key.startsWith(needle) || !entry.key.contains(needle)) {
+                    continue;
+                }
+                offer(scoreOf(entry), id);
+            }
+        }
+    }
+
+    std::sort_heap(heap.begin(), heap.end(), std::greater<Scored>());
+    result.reserve(static_cast<int>(heap.size()));
+    for (const Scored &scored : heap) {
+        const Entry &entry = m_entries[scored.second];
+        result.append({entry.text, static_cast<int>(entry.count), scored.first});
+    }
+    return result;
+}
+
+int CommandHistoryIndex::insertEntry(const QString &command, quint32 count, quint64 lastUsed)
+{
+    const int id = static_cast<int>(m_entries.size());
+
+    Entry entry;
+    entry.text = command;
+    entry.key = command.toLower();
+    entry.count = count;
+    entry.lastUsed = lastUsed;
+    entry.alive = true;
+
+    auto keyLess = [this](int lhs, const QString &key) { return m_entries[lhs].key < key; };
+    auto pos = std::lower_bound(m_sortedIds.begin(), m_sortedIds.end(), entry.key, keyLess);
+
+    // id 单调递增，直接追加即可保持倒排表有序
+    for (quint32 gram : bigramsOf(entry.key)) {
+        m_bigramPostings[gram].push_back(id);
+    }
+
+    m_entries.push_back(std::move(entry));
+    m_sortedIds.insert(pos, id);
+    m_idByText.insert(command, id);
+    m_recency.emplace(lastUsed, id);
+    m_byCount.emplace(count, id);
+    ++m_aliveCount;
+    return id;
+}
+
+void CommandHistoryIndex::evictOldest()
+{
+    if (m_recency.empty()) {
+        return;
+    }
+
+    const int id = m_recency.begin()->second;
+    m_recency.erase(m_recency.begin());
+
+    Entry &entry = m_entries[id];
+    entry.alive = false;
+    m_idByText.remove(entry.text);
+    m_byCount.erase({entry.count, id});
+
+    auto keyLess = [this](int lhs, const QString &key) { return m_entries[lhs].key < key; };
+    auto it = std::lower_bound(m_sortedIds.begin(), m_sortedIds.end(), entry.key, keyLess);
+    while (it != m_sortedIds.end() && *it != id) {
+        ++it;
+    }
+    if (it != m_sortedIds.end()) {
+        m_sortedIds.erase(it);
+    }
+    --m_aliveCount;
+
+    // 倒排表中的失效 id 惰性跳过，累积过多时整体压缩
+    const size_t dead = m_entries.size() - static_cast<size_t>(m_aliveCount);
+    if (dead > 1024 && dead > static_cast<size_t>(m_aliveCount) / 4) {
+        rebuild();
+    }
+}
+
+void CommandHistoryIndex::rebuild()
+{
+    std::vector<Entry> alive;
+    alive.reserve(static_cast<size_t>(m_aliveCount));
+    for (Entry &entry : m_entries) {
+        if (entry.alive) {
+            alive.push_back(std::move(entry));
+        }
+    }
+    m_entries.swap(alive);
+
+    m_idByText.clear();
+    m_recency.clear();
+    m_byCount.clear();
+    m_bigramPostings.clear();
+    m_sortedIds.resize(m_entries.size());
+
+    for (int id = 0; id < static_cast<int>(m_entries.size()); ++id) {
+        const Entry &entry = m_entries[id];
+        m_sortedIds[id] = id;
+        m_idByText.insert(entry.text, id);
+        m_recency.emplace(entry.lastUsed, id);
+        m_byCount.emplace(entry.count, id);
+        for (quint32 gram : bigramsOf(entry.key)) {
+            m_bigramPostings[gram].push_back(id);
+        }
+    }
+
+    std::sort(m_sortedIds.begin(), m_sortedIds.end(), [this](int lhs, int rhs) {
+        return m_entries[lhs].key < m_entries[rhs].key;
+    });
+    m_aliveCount = static_cast<int>(m_entries.size());
+}
+
+double CommandHistoryIndex::scoreOf(const Entry &entry) const
+{
+    return frequencyScore(entry.count) + recencyScore(entry.lastUsed);
+}
+
+double CommandHistoryIndex::frequencyScore(quint32 count)
+{
+    // 频率取对数避免高频命令永远压制新命令
+    return std::log2(1.0 + count);
+}
+
+double CommandHistoryIndex::recencyScore(quint64 lastUsed) const
+{
+    // 最近 32 次内使用的命令获得明显加成
+    const double age = static_cast<double>(m_clock - lastUsed);
+    return 4.0 / (1.0 + age / 32.0);
+}
+
+quint32 CommandHistoryIndex::bigramKey(QChar a, QChar b)
+{
+    return (static_cast<quint32>(a.unicode()) << 16) | b.unicode();
+}
+
+std::vector<quint32> CommandHistoryIndex::bigramsOf(const QString &key)
+{
+    std::vector<quint32> grams;
+    if (key.size() < 2) {
+        return grams;
+    }
+    grams.reserve(static_cast<size_t>(key.size() - 1));
+    for (int i = 0; i + 1 < key.size(); ++i) {
+        grams.push_back(bigramKey(key.at(i), key.at(i + 1)));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
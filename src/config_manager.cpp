@@ -1,8 +1,12 @@
 #include "config_manager.h"
+#include "log_categories.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDataStream>
 #include <QStandardPaths>
 #include <QDir>
 #include <QDebug>
@@ -12,8 +16,24 @@ ConfigManager::ConfigManager() : configPath("") {
 }
 
 ConfigManager::~ConfigManager() {
-    // 析构时自动保存配置
-    saveConfig();
+    // 析构时自动保存配置（尚未初始化或已被移走的实例不写盘）
+    if (!configPath.isEmpty()) {
+        saveConfig();
+    }
+}
+
+ConfigManager::ConfigManager(ConfigManager &&other) noexcept
+    : configPath(std::move(other.configPath)), configData(std::move(other.configData)) {
+    other.configPath.clear();
+}
+
+ConfigManager &ConfigManager::operator=(ConfigManager &&other) noexcept {
+    if (this != &other) {
+        configPath = std::move(other.configPath);
+        configData = std::move(other.configData);
+        other.configPath.clear();
+    }
+    return *this;
 }
 
 bool ConfigManager::initialize(const QString &path) {
@@ -28,7 +48,7 @@ bool ConfigManager::initialize(const QString &path) {
         QDir().mkpath(QFileInfo(path).absolutePath());
     }
 
-    qDebug() << "[ConfigManager] Configuration path:" << configPath;
+    qCDebug(lcConfig) << "[ConfigManager] Configuration path:" << configPath;
 
     // 尝试加载现有配置
     if (QFile::exists(configPath)) {
@@ -43,7 +63,7 @@ bool ConfigManager::initialize(const QString &path) {
 bool ConfigManager::loadConfig() {
     QFile file(configPath);
     if (!file.open(QIODevice::ReadOnly)) {
-        qWarning() << "[ConfigManager] Failed to open config file:" << configPath;
+        qCWarning(lcConfig) << "[ConfigManager] Failed to open config file:" << configPath;
         initializeDefaults();
         return false;
     }
@@ -52,19 +72,19 @@ bool ConfigManager::loadConfig() {
     file.close();
 
     if (!doc.isObject()) {
-        qWarning() << "[ConfigManager] Invalid JSON config file";
+        qCWarning(lcConfig) << "[ConfigManager] Invalid JSON config file";
         initializeDefaults();
         return false;
     }
 
     configData = doc.object();
-    qDebug() << "[ConfigManager] Config loaded successfully";
+    qCDebug(lcConfig) << "[ConfigManager] Config loaded successfully";
     return true;
 }
 
 bool ConfigManager::saveConfig() {
     if (configPath.isEmpty()) {
-        qWarning() << "[ConfigManager] Config path not initialized";
+        qCWarning(lcConfig) << "[ConfigManager] Config path not initialized";
         return false;
     }
 
@@ -76,14 +96,14 @@ bool ConfigManager::saveConfig() {
     QFile file(configPath);
 
     if (!file.open(QIODevice::WriteOnly)) {
-        qWarning() << "[ConfigManager] Failed to write config file:" << configPath;
+        qCWarning(lcConfig) << "[ConfigManager] Failed to write config file:" << configPath;
         return false;
     }
 
     file.write(doc.toJson());
     file.close();
 
-    qDebug() << "[ConfigManager] Config saved successfully";
+    qCDebug(lcConfig) << "[ConfigManager] Config saved successfully";
     return true;
 }
 
@@ -110,9 +130,27 @@ void ConfigManager::initializeDefaults() {
     uiConfig["windowWidth"] = 1200;
     uiConfig["windowHeight"] = 800;
     uiConfig["lineEndIndex"] = 0;  // 默认 0D0A (CRLF)
-    uiConfig["terminalHistory"] = QJsonArray();  // 空的终端历史
+    uiConfig["theme"] = "light";
+    uiConfig["checksum"] = "None";
 
     configData["ui"] = uiConfig;
+
+    // 默认日志配置
+    QJsonObject logConfig;
+    logConfig["flushIntervalMs"] = 200;  // 异步日志批量刷新间隔
+    logConfig["level"] = "debug";        // 运行期最低日志级别
+    logConfig["maxFileSizeMB"] = 10;     // 单个日志分段上限，超过后轮转
+    logConfig["maxAgeDays"] = 7;         // 单个日志分段最长使用天数
+    logConfig["retention"] = 5;          // 保留的历史分段数（压缩存放）
+    logConfig["dataAudit"] = false;      // 收发数据审计（采样 + 限流 + 汇总）
+    logConfig["dataAuditTxSampleEvery"] = 100;
+    logConfig["dataAuditRxSampleEvery"] = 100;
+    logConfig["dataAuditTxMaxPerSec"] = 10;
+    logConfig["dataAuditRxMaxPerSec"] = 10;
+    logConfig["dataAuditPreviewBytes"] = 32;
+    logConfig["dataAuditSummaryMs"] = 5000;
+
+    configData["log"] = logConfig;
 }
 
 // Getters - 串口配置
@@ -169,6 +207,14 @@ int ConfigManager::getLineEndIndex() const {
     return configData["ui"].toObject()["lineEndIndex"].toInt(0);  // 默认 0 (0D0A)
 }
 
+QString ConfigManager::getTheme() const {
+    return configData["ui"].toObject()["theme"].toString("light");
+}
+
+QString ConfigManager::getChecksum() const {
+    return configData["ui"].toObject()["checksum"].toString("None");
+}
+
 QStringList ConfigManager::getTerminalHistory() const {
     QJsonArray historyArray = configData["ui"].toObject()["terminalHistory"].toArray();
     QStringList history;
@@ -191,6 +237,87 @@ void ConfigManager::setTerminalHistory(const QStringList &history) {
     configData["ui"] = ui;
 }
 
+QList<int> ConfigManager::getTerminalHistoryCounts() const {
+    QJsonArray countsArray = configData["ui"].toObject()["terminalHistoryCounts"].toArray();
+    QList<int> counts;
+
+    for (const QJsonValue &value : countsArray) {
+        counts.append(value.toInt(1));
+    }
+
+    return counts;
+}
+
+void ConfigManager::setTerminalHistoryCounts(const QList<int> &counts) {
+    QJsonArray countsArray;
+    for (int count : counts) {
+        countsArray.append(count);
+    }
+
+    QJsonObject ui = configData["ui"].toObject();
+    ui["terminalHistoryCounts"] = countsArray;
+    configData["ui"] = ui;
+}
+
+namespace {
+constexpr quint32 kTerminalHistoryMagic = 0x53585448;  // "SXTH"
+constexpr quint32 kTerminalHistoryVersion = 1;
+}
+
+QString ConfigManager::terminalHistoryPath() const {
+    return QFileInfo(configPath).absolutePath() + "/terminal_history.dat";
+}
+
+void ConfigManager::readTerminalHistory(QStringList *history, QList<int> *counts) const {
+    QFile file(terminalHistoryPath());
+    if (!configPath.isEmpty() && file.open(QIODevice::ReadOnly)) {
+        QDataStream in(&file);
+        in.setVersion(QDataStream::Qt_6_0);
+        quint32 magic = 0;
+        quint32 version = 0;
+        in >> magic >> version;
+        if (magic == kTerminalHistoryMagic && version == kTerminalHistoryVersion) {
+            in >> *history >> *counts;
+            if (in.status() == QDataStream::Ok) {
+                return;
+            }
+        }
+        qCWarning(lcConfig) << "[ConfigManager] Invalid terminal history file:" << file.fileName();
+    }
+
+    *history = getTerminalHistory();
+    *counts = getTerminalHistoryCounts();
+}
+
+bool ConfigManager::writeTerminalHistory(const QStringList &history, const QList<int> &counts) {
+    if (configPath.isEmpty()) {
+        return false;
+    }
+
+    QSaveFile file(terminalHistoryPath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(lcConfig) << "[ConfigManager] Failed to write terminal history:" << file.fileName();
+        return false;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << kTerminalHistoryMagic << kTerminalHistoryVersion << history << counts;
+    if (!file.commit()) {
+        qCWarning(lcConfig) << "[ConfigManager] Failed to write terminal history:" << file.errorString();
+        return false;
+    }
+
+    // 已迁移到独立文件，配置中的旧字段不再保留
+    QJsonObject ui = configData["ui"].toObject();
+    if (ui.contains("terminalHistory") || ui.contains("terminalHistoryCounts")) {
+        ui.remove("terminalHistory");
+        ui.remove("terminalHistoryCounts");
+        configData["ui"] = ui;
+        saveConfig();
+    }
+    return true;
+}
+
 // Setters - 串口配置
 void ConfigManager::setSerialPort(const QString &port) {
     QJsonObject serial = configData["serial"].toObject();
@@ -266,6 +393,119 @@ void ConfigManager::setLineEndIndex(int index) {
     configData["ui"] = ui;
 }
 
+void ConfigManager::setTheme(const QString &theme) {
+    QJsonObject ui = configData["ui"].toObject();
+    ui["theme"] = theme;
+    configData["ui"] = ui;
+}
+
+void ConfigManager::setChecksum(const QString &name) {
+    QJsonObject ui = configData["ui"].toObject();
+    ui["checksum"] = name;
+    configData["ui"] = ui;
+}
+
+// 日志配置
+int ConfigManager::getLogFlushInterval() const {
+    return configData["log"].toObject()["flushIntervalMs"].toInt(200);
+}
+
+void ConfigManager::setLogFlushInterval(int ms) {
+    QJsonObject log = configData["log"].toObject();
+    log["flushIntervalMs"] = ms;
+    configData["log"] = log;
+}
+
+QString ConfigManager::getLogLevel() const {
+    return configData["log"].toObject()["level"].toString("debug");
+}
+
+void ConfigManager::setLogLevel(const QString &level) {
+    QJsonObject log = configData["log"].toObject();
+    log["level"] = level;
+    configData["log"] = log;
+}
+
+int ConfigManager::getLogMaxFileSizeMB() const {
+    return configData["log"].toObject()["maxFileSizeMB"].toInt(10);
+}
+
+void ConfigManager::setLogMaxFileSizeMB(int megabytes) {
+    QJsonObject log = configData["log"].toObject();
+    log["maxFileSizeMB"] = megabytes;
+    configData["log"] = log;
+}
+
+int ConfigManager::getLogMaxAgeDays() const {
+    return configData["log"].toObject()["maxAgeDays"].toInt(7);
+}
+
+void ConfigManager::setLogMaxAgeDays(int days) {
+    QJsonObject log = configData["log"].toObject();
+    log["maxAgeDays"] = days;
+    configData["log"] = log;
+}
+
+int ConfigManager::getLogRetention() const {
+    return configData["log"].toObject()["retention"].toInt(5);
+}
+
+void ConfigManager::setLogRetention(int count) {
+    QJsonObject log = configData["log"].toObject();
+    log["retention"] = count;
+    configData["log"] = log;
+}
+
+bool ConfigManager::getDataAuditEnabled() const {
+    return configData["log"].toObject()["dataAudit"].toBool(false);
+}
+
+void ConfigManager::setDataAuditEnabled(bool enabled) {
+    QJsonObject log = configData["log"].toObject();
+    log["dataAudit"] = enabled;
+    configData["log"] = log;
+}
+
+int ConfigManager::getDataAuditSampleEvery(bool transmit) const {
+    return configData["log"].toObject()[transmit ? "dataAuditTxSampleEvery" : "dataAuditRxSampleEvery"].toInt(100);
+}
+
+void ConfigManager::setDataAuditSampleEvery(bool transmit, int every) {
+    QJsonObject log = configData["log"].toObject();
+    log[transmit ? "dataAuditTxSampleEvery" : "dataAuditRxSampleEvery"] = every;
+    configData["log"] = log;
+}
+
+int ConfigManager::getDataAuditMaxRecordsPerSec(bool transmit) const {
+    return configData["log"].toObject()[transmit ? "dataAuditTxMaxPerSec" : "dataAuditRxMaxPerSec"].toInt(10);
+}
+
+void ConfigManager::setDataAuditMaxRecordsPerSec(bool transmit, int count) {
+    QJsonObject log = configData["log"].toObject();
+    log[transmit ? "dataAuditTxMaxPerSec" : "dataAuditRxMaxPerSec"] = count;
+    configData["log"] = log;
+}
+
+int ConfigManager::getDataAuditPreviewBytes() const {
+    return configData["log"].toObject()["dataAuditPreviewBytes"].toInt(32);
+}
+
+void ConfigManager::setDataAuditPreviewBytes(int bytes) {
+    QJsonObject log = configData["log"].toObject();
+    log["dataAuditPreviewBytes"] = bytes;
+    configData["log"] = log;
+}
+
+int ConfigManager::getDataAuditSummaryIntervalMs() const {
+    return configData["log"].toObject()["dataAuditSummaryMs"].toInt(5000);
+}
+
+void ConfigManager::setDataAuditSummaryIntervalMs(int ms) {
+    QJsonObject log = configData["log"].toObject();
+    log["dataAuditSummaryMs"] = ms;
+    configData["log"] = log;
+}
+
 // Private helpers
 QJsonObject ConfigManager::getSerialConfig() const {
     return configData["serial"].toObject();
@@ -0,0 +1,320 @@
+#include "dissector_host.h"
+#include "log_categories.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QLibrary>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPluginLoader>
+#include <QThread>
+#include <atomic>
+#include <memory>
+
+struct DissectorHost::Worker
+{
+    QString name;
+    QThread *thread = nullptr;
+    QObject *context = nullptr;     ///< 工作线程中的投递目标
+    QObject *receiver = nullptr;    ///< GUI 线程中的投递目标，随 Worker 删除以丢弃未送达的批次
+
+    // 只在工作线程中访问
+    std::unique_ptr<IDissector> dissector;
+    IDissector::Framing framing = IDissector::Framing::Lines;
+    QByteArray lineBuffer;
+    bool skippingLongLine = false;
+
+    // 只在 GUI 线程中访问
+    bool resyncPending = false;
+    quint64 droppedChunks = 0;
+    quint64 records = 0;
+
+    std::atomic<qint64> queuedBytes{0};
+
+    QMutex pendingMutex;
+    QList<DissectedRecord> pending;
+    bool deliveryScheduled = false;
+};
+
+DissectorHost::DissectorHost(QObject *parent)
+    : QObject(parent)
+{
+}
+
+DissectorHost::~DissectorHost()
+{
+    const QStringList names = m_workers.keys();
+    for (const QString &name : names)
+    {
+        setEnabled(name, false);
+    }
+}
+
+QString DissectorHost::defaultPluginDirectory()
+{
+    return QCoreApplication::applicationDirPath() + "/plugins/dissectors";
+}
+
+int DissectorHost::loadPlugins(const QString &directory)
+{
+    QDir dir(directory);
+    if (!dir.exists())
+    {
+        qCDebug(lcMain) << "解析插件目录不存在:" << directory;
+        return 0;
+    }
+
+    int loaded = 0;
+    const QStringList files = dir.entryList(QDir::Files, QDir::Name);
+    for (const QString &file : files)
+    {
+        if (!QLibrary::isLibrary(file))
+        {
+            continue;
+        }
+
+        // 加载器不删除：插件实例在其生命周期内有效，程序退出时随进程卸载
+        auto *loader = new QPluginLoader(dir.absoluteFilePath(file), this);
+        QObject *instance = loader->instance();
+        if (!instance)
+        {
+            m_loadErrors << QString("%1: %2").arg(file, loader->errorString());
+            delete loader;
+            continue;
+        }
+
+        auto *factory = qobject_cast<IDissectorFactory *>(instance);
+        if (!factory)
+        {
+            m_loadErrors << QString("%1: 未实现 %2").arg(file, SCOM_DISSECTOR_FACTORY_IID);
+            loader->unload();
+            delete loader;
+            continue;
+        }
+
+        if (!registerFactory(factory))
+        {
+            m_loadErrors << QString("%1: 解析器名称 \"%2\" 重复").arg(file, factory->name());
+            loader->unload();
+            delete loader;
+            continue;
+        }
+        qCInfo(lcMain) << "已加载解析插件" << factory->name() << "from" << file;
+        ++loaded;
+    }
+
+    for (const QString &error : std::as_const(m_loadErrors))
+    {
+        qCWarning(lcMain) << "解析插件加载失败:" << error;
+    }
+    return loaded;
+}
+
+bool DissectorHost::registerFactory(IDissectorFactory *factory)
+{
+    if (!factory || factory->name().isEmpty() || m_factories.contains(factory->name()))
+    {
+        return false;
+    }
+    m_factories.insert(factory->name(), factory);
+    return true;
+}
+
+QString DissectorHost::description(const QString &name) const
+{
+    IDissectorFactory *factory = m_factories.value(name);
+    return factory ? factory->description() : QString();
+}
+
+void DissectorHost::setEnabled(const QString &name, bool enabled)
+{
+    if (enabled == m_workers.contains(name))
+    {
+        return;
+    }
+
+    if (!enabled)
+    {
+        Worker *worker = m_workers.take(name);
+        worker->thread->quit();
+        worker->thread->wait();
+        delete worker->thread;
+        delete worker->receiver;
+        delete worker;  // 工作线程已结束，可以在这里析构解析器实例
+        return;
+    }
+
+    IDissectorFactory *factory = m_factories.value(name);
+    if (!factory)
+    {
+        return;
+    }
+    IDissector *dissector = factory->create();
+    if (!dissector)
+    {
+        qCWarning(lcMain) << "解析器创建失败:" << name;
+        return;
+    }
+
+    auto *worker = new Worker;
+    worker->name = name;
+    worker->dissector.reset(dissector);
+    worker->framing = dissector->framing();
+    worker->receiver = new QObject();
+
+    worker->thread = new QThread();
+    worker->thread->setObjectName("Dissector:" + name);
+    worker->context = new QObject();
+    worker->context->moveToThread(worker->thread);
+    connect(worker->thread, &QThread::finished, worker->context, &QObject::deleteLater);
+    worker->thread->start();
+
+    m_workers.insert(name, worker);
+}
+
+void DissectorHost::feed(const QByteArray &data)
+{
+    if (data.isEmpty() || m_workers.isEmpty())
+    {
+        return;
+    }
+
+    const qint64 timestampMs = QDateTime::currentMSecsSinceEpoch();
+    const qint64 size = data.size();
+    for (Worker *worker : std::as_const(m_workers))
+    {
+        if (worker->queuedBytes.load(std::memory_order_relaxed) + size > kQueueCapacityBytes)
+        {
+            ++worker->droppedChunks;
+            worker->resyncPending = true;
+            continue;
+        }
+
+        // 丢弃过数据后的第一块带上 resync 标记，之前已排队的数据仍按原样解析
+        const bool resync = worker->resyncPending;
+        worker->resyncPending = false;
+        worker->queuedBytes.fetch_add(size, std::memory_order_relaxed);
+        QMetaObject::invokeMethod(worker->context, [this, worker, data, timestampMs, resync]() {
+            process(worker, data, timestampMs, resync);
+            worker->queuedBytes.fetch_sub(data.size(), std::memory_order_relaxed);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void DissectorHost::reset()
+{
+    for (Worker *worker : std::as_const(m_workers))
+    {
+        worker->resyncPending = false;
+        QMetaObject::invokeMethod(worker->context, [worker]() {
+            worker->dissector->reset();
+            worker->lineBuffer.clear();
+            worker->skippingLongLine = false;
+        }, Qt::QueuedConnection);
+    }
+}
+
+QVector<DissectorStats> DissectorHost::stats() const
+{
+    QVector<DissectorStats> result;
+    result.reserve(m_workers.size());
+    for (const Worker *worker : m_workers)
+    {
+        DissectorStats stats;
+        stats.name = worker->name;
+        stats.queuedBytes = worker->queuedBytes.load(std::memory_order_relaxed);
+        stats.droppedChunks = worker->droppedChunks;
+        stats.records = worker->records;
+        result.append(stats);
+    }
+    return result;
+}
+
+void DissectorHost::process(Worker *worker, const QByteArray &data, qint64 timestampMs, bool resync)
+{
+    IDissector *dissector = worker->dissector.get();
+    if (resync)
+    {
+        dissector->reset();
+        worker->lineBuffer.clear();
+        worker->skippingLongLine = false;
+    }
+
+    QList<DissectedRecord> records;
+    if (worker->framing == IDissector::Framing::Raw)
+    {
+        dissector->dissect(data, timestampMs, &records);
+        deliver(worker, std::move(records));
+        return;
+    }
+
+    int start = 0;
+    while (start < data.size())
+    {
+        const int newline = data.indexOf('\n', start);
+        const int end = newline < 0 ? int(data.size()) : newline;
+
+        if (!worker->skippingLongLine)
+        {
+            worker->lineBuffer.append(data.constData() + start, end - start);
+            if (worker->lineBuffer.size() > kMaxLineLength)
+            {
+                // 不像文本协议的数据：丢掉这一行，避免缓冲区无限增长
+                worker->lineBuffer.clear();
+                worker->skippingLongLine = true;
+            }
+        }
+
+        if (newline < 0)
+        {
+            break;
+        }
+
+        if (!worker->skippingLongLine)
+        {
+            QByteArray &line = worker->lineBuffer;
+            if (line.endsWith('\r'))
+            {
+                line.chop(1);
+            }
+            if (!line.isEmpty())
+            {
+                dissector->dissect(line, timestampMs, &records);
+            }
+        }
+        worker->lineBuffer.clear();
+        worker->skippingLongLine = false;
+        start = newline + 1;
+    }
+
+    deliver(worker, std::move(records));
+}
+
+void DissectorHost::deliver(Worker *worker, QList<DissectedRecord> records)
+{
+    if (records.isEmpty())
+    {
+        return;
+    }
+
+    QMutexLocker locker(&worker->pendingMutex);
+    worker->pending += records;
+    if (worker->deliveryScheduled)
+    {
+        return;  // 上一批尚未被 GUI 线程取走，合并到同一批
+    }
+    worker->deliveryScheduled = true;
+    locker.unlock();
+
+    QMetaObject::invokeMethod(worker->receiver, [this, worker]() {
+        QList<DissectedRecord> batch;
+        {
+            QMutexLocker locker(&worker->pendingMutex);
+            batch.swap(worker->pending);
+            worker->deliveryScheduled = false;
+        }
+        worker->records += quint64(batch.size());
+        emit recordsReady(worker->name, batch);
+    }, Qt::QueuedConnection);
+}
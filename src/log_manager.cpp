@@ -1,4 +1,7 @@
 #include "log_manager.h"
+#include "log_categories.h"
+#include "async_log_writer.h"
+#include "log_segments.h"
 
 #include <QStandardPaths>
 #include <QDir>
@@ -8,6 +11,25 @@
 #include <QDebug>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QLoggingCategory>
+#include <QFileInfo>
+#include <QLocale>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+Q_LOGGING_CATEGORY(lcMain, "scom.main")
+Q_LOGGING_CATEGORY(lcUi, "scom.ui")
+Q_LOGGING_CATEGORY(lcSerial, "scom.serial")
+Q_LOGGING_CATEGORY(lcConfig, "scom.config")
+Q_LOGGING_CATEGORY(lcLog, "scom.log")
+
+namespace {
+
+QtMessageHandler previousMessageHandler = nullptr;
+QLoggingCategory::CategoryFilter previousCategoryFilter = nullptr;
+
+} // namespace
 
 LogManager& LogManager::instance()
 {
@@ -27,6 +49,125 @@ void LogManager::initialize()
 {
     createLogDirectory();
     createLogFile();
+    initialFileSize = QFileInfo(logFilePath).size();
+    
+    // 所有 Qt 日志统一走同一条管线
+    previousMessageHandler = qInstallMessageHandler(&LogManager::messageHandler);
+    previousCategoryFilter = QLoggingCategory::installFilter(&LogManager::categoryFilter);
+}
+
+void LogManager::setMinimumLevel(QtMsgType level)
+{
+    minimumSeverity.store(severityOf(level), std::memory_order_relaxed);
+    
+    // 重新安装过滤器会对所有已注册分类重新求值
+    QLoggingCategory::installFilter(&LogManager::categoryFilter);
+}
+
+QtMsgType LogManager::minimumLevel() const
+{
+    switch (minimumSeverity.load(std::memory_order_relaxed)) {
+    case 0: return QtDebugMsg;
+    case 1: return QtInfoMsg;
+    case 2: return QtWarningMsg;
+    case 3: return QtCriticalMsg;
+    default: return QtFatalMsg;
+    }
+}
+
+QtMsgType LogManager::levelFromString(const QString &name)
+{
+    const QString level = name.trimmed().toLower();
+    if (level == "info") {
+        return QtInfoMsg;
+    }
+    if (level == "warning" || level == "warn") {
+        return QtWarningMsg;
+    }
+    if (level == "critical" || level == "error") {
+        return QtCriticalMsg;
+    }
+    return QtDebugMsg;
+}
+
+QString LogManager::levelName(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg: return "DEBUG";
+    case QtInfoMsg: return "INFO";
+    case QtWarningMsg: return "WARN";
+    case QtCriticalMsg: return "ERROR";
+    case QtFatalMsg: return "FATAL";
+    }
+    return "DEBUG";
+}
+
+int LogManager::severityOf(QtMsgType type)
+{
+    // QtMsgType 的枚举值并非按严重程度排列（QtInfoMsg = 4）
+    switch (type) {
+    case QtDebugMsg: return 0;
+    case QtInfoMsg: return 1;
+    case QtWarningMsg: return 2;
+    case QtCriticalMsg: return 3;
+    case QtFatalMsg: return 4;
+    }
+    return 0;
+}
+
+void LogManager::categoryFilter(QLoggingCategory *category)
+{
+    if (previousCategoryFilter) {
+        previousCategoryFilter(category);
+    }
+    
+    // 在分类上直接关闭低级别输出，qCDebug 等宏在调用点即短路
+    const int minimum = instance().minimumSeverity.load(std::memory_order_relaxed);
+    if (minimum > 0) {
+        category->setEnabled(QtDebugMsg, false);
+    }
+    if (minimum > 1) {
+        category->setEnabled(QtInfoMsg, false);
+    }
+    if (minimum > 2) {
+        category->setEnabled(QtWarningMsg, false);
+    }
+}
+
+void LogManager::messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
+{
+    LogManager &manager = instance();
+    if (severityOf(type) < manager.minimumSeverity.load(std::memory_order_relaxed) && type != QtFatalMsg) {
+        return;
+    }
+    
+    const QString line = QString("[%1] [%2] [%3] %4\n")
+        .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz"),
+             levelName(type),
+             QLatin1String(context.category ? context.category : "default"),
+             msg);
+    QByteArray record = line.toUtf8();
+    
+#ifdef QT_DEBUG
+    // 调试构建同时输出到控制台
+    std::fwrite(record.constData(), 1, static_cast<size_t>(record.size()), stderr);
+#endif
+    
+    if (manager.logFilePath.isEmpty()) {
+        // 尚未初始化日志目录：交回默认处理器
+        if (previousMessageHandler) {
+            previousMessageHandler(type, context, msg);
+        }
+        return;
+    }
+    
+    manager.recordEntry(type, line.chopped(1), record.size());
+    AsyncLogWriter::instance().append(manager.logFilePath, std::move(record));
+    
+    if (type == QtFatalMsg) {
+        AsyncLogWriter::instance().shutdown();
+        std::abort();
+    }
 }
 
 void LogManager::createLogDirectory()
@@ -58,55 +199,212 @@ void LogManager::createLogFile()
     }
 }
 
-LogManager::LogStats LogManager::getStats() const
+void LogManager::recordEntry(QtMsgType type, const QString &line, qint64 bytes)
 {
+    levelCounts[severityOf(type)].fetch_add(1, std::memory_order_relaxed);
+    bytesWritten.fetch_add(bytes, std::memory_order_relaxed);
+    
+    // 速率桶：跨秒时由抢到 CAS 的线程重置（统计值允许极小误差）
+    const qint64 now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    RateBucket &bucket = rateBuckets[now % RATE_BUCKETS];
+    qint64 stamp = bucket.second.load(std::memory_order_acquire);
+    if (stamp != now && bucket.second.compare_exchange_strong(stamp, now, std::memory_order_acq_rel)) {
+        bucket.count.store(1, std::memory_order_relaxed);
+        bucket.bytes.store(bytes, std::memory_order_relaxed);
+    } else {
+        bucket.count.fetch_add(1, std::memory_order_relaxed);
+        bucket.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+    
     QMutexLocker locker(&mutex);
+    if (memoryBuffer.size() < MAX_MEMORY_LINES) {
+        memoryBuffer.append(line);
+    } else {
+        memoryBuffer[static_cast<int>(memorySequence % MAX_MEMORY_LINES)] = line;
+    }
+    ++memorySequence;
+}
+
+LogManager::LogStats LogManager::getStats() const
+{
     LogStats stats;
-    // 这里可以从日志文件中统计
+    stats.debugCount = levelCounts[0].load(std::memory_order_relaxed);
+    stats.infoCount = levelCounts[1].load(std::memory_order_relaxed);
+    stats.warningCount = levelCounts[2].load(std::memory_order_relaxed);
+    stats.criticalCount = levelCounts[3].load(std::memory_order_relaxed);
+    stats.fatalCount = levelCounts[4].load(std::memory_order_relaxed);
+    stats.totalCount = stats.debugCount + stats.infoCount + stats.warningCount
+                     + stats.criticalCount + stats.fatalCount;
+    stats.bytesWritten = bytesWritten.load(std::memory_order_relaxed);
+    // 轮转后活动文件从零开始，以写入器维护的当前大小为准；写入器尚未打开文件时不会发生过轮转
+    stats.fileSize = AsyncLogWriter::instance().fileSize(logFilePath);
+    if (stats.fileSize < 0) {
+        stats.fileSize = initialFileSize + stats.bytesWritten;
+    }
+    
+    const qint64 now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    for (const RateBucket &bucket : rateBuckets) {
+        const qint64 stamp = bucket.second.load(std::memory_order_acquire);
+        if (stamp >= 0 && now - stamp < RATE_BUCKETS) {
+            stats.entriesPerMinute += bucket.count.load(std::memory_order_relaxed);
+            stats.bytesPerMinute += bucket.bytes.load(std::memory_order_relaxed);
+        }
+    }
     return stats;
 }
 
-QString LogManager::getLastLogs(int lineCount) const
+QString LogManager::LogStats::summary() const
+{
+    QLocale locale;
+    return QString("DEBUG %1 | INFO %2 | WARN %3 | ERROR %4 | %5 条/分钟 | 文件 %6")
+        .arg(debugCount)
+        .arg(infoCount)
+        .arg(warningCount)
+        .arg(criticalCount + fatalCount)
+        .arg(entriesPerMinute)
+        .arg(locale.formattedDataSize(fileSize));
+}
+
+QStringList LogManager::getRecentEntries(int maxCount, quint64 afterSequence, quint64 *lastSequence) const
 {
     QMutexLocker locker(&mutex);
     
-    QFile file(logFilePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    if (lastSequence) {
+        *lastSequence = memorySequence;
+    }
+    
+    const quint64 oldest = memorySequence > static_cast<quint64>(memoryBuffer.size())
+        ? memorySequence - static_cast<quint64>(memoryBuffer.size()) : 0;
+    quint64 begin = qMax(afterSequence, oldest);
+    if (maxCount >= 0 && memorySequence - begin > static_cast<quint64>(maxCount)) {
+        begin = memorySequence - static_cast<quint64>(maxCount);
+    }
+    
+    QStringList entries;
+    for (quint64 seq = begin; seq < memorySequence; ++seq) {
+        entries.append(memoryBuffer.at(static_cast<int>(seq % MAX_MEMORY_LINES)));
+    }
+    return entries;
+}
+
+QString LogManager::getLastLogs(int lineCount) const
+{
+    // 先让尚在队列中的记录落盘，读取本身不需要持锁
+    AsyncLogWriter::instance().flush();
+    
+    // 活动文件不够时继续向前读取已轮转的分段（从新到旧）
+    const QStringList segments = LogSegments::allSegments(logFilePath);
+    QStringList parts;
+    int remaining = lineCount;
+    for (int i = segments.size() - 1; i >= 0 && remaining > 0; --i) {
+        const QString &segment = segments.at(i);
+        QString text;
+        if (LogSegments::isCompressed(segment)) {
+            // 压缩分段受轮转大小限制，整体解压后取尾部
+            QStringList lines = QString::fromUtf8(LogSegments::readAll(segment)).split('\n', Qt::SkipEmptyParts);
+            for (QString &line : lines) {
+                if (line.endsWith('\r')) {
+                    line.chop(1);
+                }
+            }
+            lines.removeAll(QString());
+            text = lines.mid(qMax(0, static_cast<int>(lines.size()) - remaining)).join("\n");
+        } else {
+            text = readLastLines(segment, remaining);
+        }
+        if (text.isEmpty()) {
+            continue;
+        }
+        remaining -= static_cast<int>(text.count('\n')) + 1;
+        parts.prepend(text);
+    }
+    
+    return parts.join("\n");
+}
+
+QString LogManager::readLastLines(const QString &filePath, int lineCount)
+{
+    if (lineCount <= 0) {
         return QString();
     }
     
-    QTextStream stream(&file);
-    QString content = stream.readAll();
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+    
+    constexpr qint64 kBlockSize = 64 * 1024;
+    
+    QList<QByteArray> blocks;  // 按文件顺序排列
+    qint64 pos = file.size();
+    int lines = 0;
+    bool lineHasContent = false;
+    
+    while (pos > 0 && lines < lineCount) {
+        const qint64 readSize = qMin(kBlockSize, pos);
+        pos -= readSize;
+        if (!file.seek(pos)) {
+            break;
+        }
+        QByteArray block = file.read(readSize);
+        
+        // 自块尾向前扫描：遇到换行时，若其后的行非空则计为一行
+        qsizetype cut = -1;
+        for (qsizetype i = block.size() - 1; i >= 0; --i) {
+            const char c = block.at(i);
+            if (c == '\n') {
+                if (lineHasContent) {
+                    lineHasContent = false;
+                    if (++lines == lineCount) {
+                        cut = i + 1;
+                        break;
+                    }
+                }
+            } else if (c != '\r') {
+                lineHasContent = true;
+            }
+        }
+        
+        blocks.prepend(cut >= 0 ? block.mid(cut) : block);
+    }
     file.close();
     
-    QStringList lines = content.split("\n", Qt::SkipEmptyParts);
+    QByteArray tail;
+    for (const QByteArray &block : blocks) {
+        tail.append(block);
+    }
     
-    int startLine = qMax(0, lines.size() - lineCount);
-    QString result = lines.mid(startLine).join("\n");
+    QStringList result = QString::fromUtf8(tail).split('\n', Qt::SkipEmptyParts);
+    for (QString &line : result) {
+        if (line.endsWith('\r')) {
+            line.chop(1);
+        }
+    }
+    result.removeAll(QString());
     
-    return result;
+    return result.join("\n");
 }
 
 bool LogManager::exportLogs(const QString &filePath) const
 {
-    QMutexLocker locker(&mutex);
+    AsyncLogWriter::instance().flush();
     
-    QFile sourceFile(logFilePath);
-    if (!sourceFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    if (!QFile::exists(logFilePath)) {
         return false;
     }
     
     QFile destFile(filePath);
-    if (!destFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        sourceFile.close();
+    if (!destFile.open(QIODevice::WriteOnly)) {
         return false;
     }
     
-    QTextStream inStream(&sourceFile);
-    QTextStream outStream(&destFile);
-    outStream << inStream.readAll();
+    // 按时间顺序拼接所有分段（压缩分段透明解压），逐段写出避免整体驻留内存
+    for (const QString &segment : LogSegments::allSegments(logFilePath)) {
+        destFile.write(LogSegments::readAll(segment));
+    }
     
-    sourceFile.close();
     destFile.close();
     
     return true;
@@ -0,0 +1,586 @@
+#include "log_search.h"
+#include "log_segments.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QThread>
+#include <cstring>
+
+namespace {
+
+const char *const kTimestampFormat = "yyyy-MM-dd hh:mm:ss.zzz";
+
+// 每处理这么多行检查一次取消标志
+constexpr int kCancelCheckMask = 0xFFF;
+
+// 块末尾跨越名义边界时，每次向后多读的字节数
+constexpr qint64 kAlignReadStep = 64 * 1024;
+
+int severityOfLevel(const char *name, int length)
+{
+    auto is = [name, length](const char *level) {
+        const int levelLength = static_cast<int>(std::strlen(level));
+        return levelLength == length && std::memcmp(name, level, static_cast<size_t>(length)) == 0;
+    };
+
+    if (is("DEBUG")) {
+        return 0;
+    }
+    if (is("WARN") || is("WARNING")) {
+        return 2;
+    }
+    if (is("ERROR") || is("CRITICAL")) {
+        return 3;
+    }
+    if (is("FATAL")) {
+        return 4;
+    }
+    // INFO 以及操作日志中的 SEND/RECV/CMD 等类型
+    return 1;
+}
+
+} // namespace
+
+// ==================== LogSearchQuery ====================
+
+bool LogSearchQuery::isEmpty() const
+{
+    return text.isEmpty() && minSeverity <= 0 && !from.isValid() && !to.isValid();
+}
+
+// ==================== LogLineMatcher ====================
+
+LogLineMatcher::LogLineMatcher(const LogSearchQuery &query)
+    : m_query(query),
+      m_caseSensitive(query.caseSensitive),
+      m_minSeverity(qBound(0, query.minSeverity, 4))
+{
+    if (query.from.isValid()) {
+        m_fromKey = query.from.toString(kTimestampFormat).toLatin1();
+    }
+    if (query.to.isValid()) {
+        m_toKey = query.to.toString(kTimestampFormat).toLatin1();
+    }
+    m_hasTimeFilter = !m_fromKey.isEmpty() || !m_toKey.isEmpty();
+
+    if (query.text.isEmpty()) {
+        return;
+    }
+
+    if (query.useRegex) {
+        m_regex.setPattern(query.text);
+        m_regex.setPatternOptions(m_caseSensitive ? QRegularExpression::NoPatternOption
+                                                  : QRegularExpression::CaseInsensitiveOption);
+        m_valid = m_regex.isValid();
+        if (m_valid) {
+            m_regex.optimize();
+        }
+        return;
+    }
+
+    const QByteArray utf8 = query.text.toUtf8();
+    bool ascii = true;
+    for (char c : utf8) {
+        if (static_cast<uchar>(c) >= 0x80) {
+            ascii = false;
+            break;
+        }
+    }
+
+    QByteArray lowered(utf8.size(), Qt::Uninitialized);
+    toLowerAscii(utf8.constData(), lowered.data(), utf8.size());
+
+    // 非 ASCII 关键词的大小写折叠需要 Unicode 规则，只能逐行转 QString 比较
+    m_byteLiteral = m_caseSensitive || ascii;
+    if (m_byteLiteral) {
+        m_literalMatcher.setPattern(m_caseSensitive ? utf8 : lowered);
+        m_indexLiteral = lowered;
+    }
+}
+
+bool LogLineMatcher::isValid() const
+{
+    return m_valid;
+}
+
+QString LogLineMatcher::errorString() const
+{
+    return m_valid ? QString() : m_regex.errorString();
+}
+
+bool LogLineMatcher::matches(const QString &line) const
+{
+    const QByteArray utf8 = line.toUtf8();
+    QByteArray lowered;
+    if (needsLowered()) {
+        lowered.resize(utf8.size());
+        toLowerAscii(utf8.constData(), lowered.data(), utf8.size());
+    }
+    return matchesUtf8(utf8.constData(), lowered.constData(), static_cast<int>(utf8.size()));
+}
+
+bool LogLineMatcher::matchesUtf8(const char *line, const char *lowered, int length) const
+{
+    if (!m_valid) {
+        return false;
+    }
+
+    if (hasHeaderFilter()) {
+        const char *timestamp = nullptr;
+        int severity = 0;
+        if (!parseHeader(line, length, &timestamp, &severity)) {
+            return false;
+        }
+        if (severity < m_minSeverity) {
+            return false;
+        }
+        if (!m_fromKey.isEmpty() && std::memcmp(timestamp, m_fromKey.constData(), kTimestampLength) < 0) {
+            return false;
+        }
+        if (!m_toKey.isEmpty() && std::memcmp(timestamp, m_toKey.constData(), kTimestampLength) > 0) {
+            return false;
+        }
+    }
+
+    if (m_query.text.isEmpty()) {
+        return true;
+    }
+
+    if (m_byteLiteral) {
+        return m_literalMatcher.indexIn(m_caseSensitive ? line : lowered, length) >= 0;
+    }
+
+    const QString text = QString::fromUtf8(line, length);
+    if (m_query.useRegex) {
+        return m_regex.match(text).hasMatch();
+    }
+    return text.contains(m_query.text, Qt::CaseInsensitive);
+}
+
+bool LogLineMatcher::parseHeader(const char *line, int length, const char **timestamp, int *severity)
+{
+    // "[yyyy-MM-dd hh:mm:ss.zzz] [LEVEL] ..."
+    if (length < kTimestampLength + 5
+        || line[0] != '['
+        || line[kTimestampLength + 1] != ']'
+        || line[kTimestampLength + 2] != ' '
+        || line[kTimestampLength + 3] != '[') {
+        return false;
+    }
+
+    const char *levelStart = line + kTimestampLength + 4;
+    const int searchLength = qMin(length - (kTimestampLength + 4), 16);
+    const char *levelEnd = static_cast<const char *>(std::memchr(levelStart, ']', static_cast<size_t>(searchLength)));
+    if (!levelEnd) {
+        return false;
+    }
+
+    *timestamp = line + 1;
+    *severity = severityOfLevel(levelStart, static_cast<int>(levelEnd - levelStart));
+    return true;
+}
+
+void LogLineMatcher::toLowerAscii(const char *src, char *dst, qsizetype length)
+{
+    for (qsizetype i = 0; i < length; ++i) {
+        const char c = src[i];
+        dst[i] = (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+    }
+}
+
+// ==================== LogSearchEngine ====================
+
+LogSearchEngine::LogSearchEngine(QObject *parent)
+    : QObject(parent),
+      m_index(std::make_shared<IndexStore>())
+{
+    m_pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+}
+
+LogSearchEngine::~LogSearchEngine()
+{
+    cancel();
+    m_pool.waitForDone();
+}
+
+quint64 LogSearchEngine::start(const QVector<LogSearchSource> &sources, const LogSearchQuery &query)
+{
+    cancel();
+
+    auto job = std::make_shared<Job>();
+    job->matcher = LogLineMatcher(query);
+    if (!job->matcher.isValid()) {
+        return 0;
+    }
+    job->generation = ++m_generation;
+    job->index = m_indexEnabled ? m_index : nullptr;
+
+    m_job = job;
+    m_running = true;
+    m_totalChunks = 0;
+    m_nextSequence = 0;
+    m_matchCount = 0;
+    m_pendingResults.clear();
+
+    QVector<ChunkTask> tasks;
+    for (const LogSearchSource &source : sources) {
+        const QFileInfo info(source.filePath);
+        if (!info.exists()) {
+            continue;
+        }
+        const qint64 fileSize = info.size();
+        const qint64 endOffset = source.endOffset < 0 ? fileSize : qMin(source.endOffset, fileSize);
+        if (endOffset <= 0) {
+            continue;
+        }
+
+        if (job->index) {
+            const QByteArray head = readFileHead(source.filePath);
+            QMutexLocker locker(&job->index->mutex);
+            FileIndex &fileIndex = job->index->files[source.filePath];
+            if (fileIndex.head != head || fileSize < fileIndex.size) {
+                // 文件被截断、轮转或重建，旧索引全部作废
+                fileIndex.head = head;
+                fileIndex.chunks.clear();
+            }
+            fileIndex.size = fileSize;
+        }
+
+        const bool compressed = LogSegments::isCompressed(source.filePath);
+        const qint64 chunkCount = compressed ? 1 : (endOffset + kChunkSize - 1) / kChunkSize;
+        for (qint64 chunk = 0; chunk < chunkCount; ++chunk) {
+            ChunkTask task;
+            task.filePath = source.filePath;
+            task.chunkNumber = chunk;
+            task.endOffset = endOffset;
+            task.sequence = static_cast<int>(tasks.size());
+            task.compressed = compressed;
+            tasks.append(task);
+        }
+    }
+
+    m_totalChunks = static_cast<int>(tasks.size());
+    const quint64 generation = job->generation;
+
+    if (tasks.isEmpty()) {
+        // 始终异步结束，调用方可以先记录代号再接收信号
+        QMetaObject::invokeMethod(this, [this, generation]() {
+            if (m_running && generation == m_generation) {
+                finish(false);
+            }
+        }, Qt::QueuedConnection);
+        return generation;
+    }
+
+    for (const ChunkTask &task : std::as_const(tasks)) {
+        m_pool.start([this, job, task]() {
+            searchChunk(this, job, task);
+        });
+    }
+    return generation;
+}
+
+void LogSearchEngine::cancel()
+{
+    if (m_job) {
+        m_job->cancelled.store(true, std::memory_order_relaxed);
+    }
+    m_pool.clear();
+    m_running = false;
+    m_pendingResults.clear();
+}
+
+bool LogSearchEngine::isRunning() const
+{
+    return m_running;
+}
+
+void LogSearchEngine::setIndexEnabled(bool enabled)
+{
+    m_indexEnabled = enabled;
+}
+
+bool LogSearchEngine::indexEnabled() const
+{
+    return m_indexEnabled;
+}
+
+void LogSearchEngine::clearIndex()
+{
+    QMutexLocker locker(&m_index->mutex);
+    m_index->files.clear();
+}
+
+void LogSearchEngine::searchChunk(LogSearchEngine *engine, const std::shared_ptr<Job> &job, const ChunkTask &task)
+{
+    QStringList matches;
+    auto post = [engine, &job, &task, &matches]() {
+        const quint64 generation = job->generation;
+        const int sequence = task.sequence;
+        QMetaObject::invokeMethod(engine, [engine, generation, sequence, matches]() {
+            engine->onChunkFinished(generation, sequence, matches);
+        }, Qt::QueuedConnection);
+    };
+
+    if (job->cancelled.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // ---- 索引剪枝：整块不可能命中时不读文件 ----
+    bool buildIndex = false;
+    if (job->index) {
+        QMutexLocker locker(&job->index->mutex);
+        const FileIndex &fileIndex = job->index->files[task.filePath];
+        const std::shared_ptr<const ChunkIndex> chunkIndex = fileIndex.chunks.value(task.chunkNumber);
+        if (chunkIndex) {
+            if (canSkip(*chunkIndex, job->matcher)) {
+                locker.unlock();
+                post();
+                return;
+            }
+        } else {
+            buildIndex = true;
+        }
+    }
+
+    QByteArray buffer;
+    qsizetype begin = 0;
+    bool complete = false;  // 块尾落在完整的行边界上，内容今后不会再变化
+    if (!readChunk(task, &buffer, &begin, &complete)) {
+        post();
+        return;
+    }
+
+    const char *data = buffer.constData() + begin;
+    const qsizetype size = buffer.size() - begin;
+
+    QByteArray lowered;
+    if (job->matcher.needsLowered() || buildIndex) {
+        lowered.resize(size);
+        LogLineMatcher::toLowerAscii(data, lowered.data(), size);
+    }
+
+    buildIndex = buildIndex && complete;
+    ChunkIndex built;
+    if (buildIndex) {
+        built.trigramBits.assign(kTrigramBits / 64, 0);
+        const uchar *bytes = reinterpret_cast<const uchar *>(lowered.constData());
+        for (qsizetype i = 0; i + 2 < size; ++i) {
+            const quint32 hash = trigramHash(bytes[i], bytes[i + 1], bytes[i + 2]);
+            built.trigramBits[hash >> 6] |= quint64(1) << (hash & 63);
+        }
+    }
+
+    // ---- 逐行匹配 ----
+    const int maxResults = job->matcher.query().maxResults;
+    int lineCounter = 0;
+    qsizetype position = 0;
+    while (position < size) {
+        const char *newline = static_cast<const char *>(std::memchr(data + position, '\n', static_cast<size_t>(size - position)));
+        const qsizetype lineEnd = newline ? newline - data : size;
+        int length = static_cast<int>(lineEnd - position);
+        if (length > 0 && data[position + length - 1] == '\r') {
+            --length;
+        }
+
+        const char *line = data + position;
+        if (buildIndex) {
+            const char *timestamp = nullptr;
+            int severity = 0;
+            if (LogLineMatcher::parseHeader(line, length, &timestamp, &severity)) {
+                const QByteArray key = QByteArray::fromRawData(timestamp, LogLineMatcher::kTimestampLength);
+                if (built.minTime.isEmpty() || key < built.minTime) {
+                    built.minTime = QByteArray(timestamp, LogLineMatcher::kTimestampLength);
+                }
+                if (built.maxTime.isEmpty() || key > built.maxTime) {
+                    built.maxTime = QByteArray(timestamp, LogLineMatcher::kTimestampLength);
+                }
+                built.severityMask |= static_cast<quint8>(1u << severity);
+            }
+        }
+
+        if (job->matcher.matchesUtf8(line, lowered.isEmpty() ? nullptr : lowered.constData() + position, length)) {
+            matches.append(QString::fromUtf8(line, length));
+            if (maxResults > 0 && matches.size() > maxResults) {
+                // 结果已够（多收集一个用于判断是否截断），本块剩余部分不再扫描，索引也就不完整
+                buildIndex = false;
+                break;
+            }
+        }
+
+        position = lineEnd + 1;
+        if ((++lineCounter & kCancelCheckMask) == 0 && job->cancelled.load(std::memory_order_relaxed)) {
+            return;
+        }
+    }
+
+    if (buildIndex && !job->cancelled.load(std::memory_order_relaxed)) {
+        QMutexLocker locker(&job->index->mutex);
+        job->index->files[task.filePath].chunks.insert(task.chunkNumber,
+                                                       std::make_shared<const ChunkIndex>(std::move(built)));
+    }
+
+    post();
+}
+
+bool LogSearchEngine::readChunk(const ChunkTask &task, QByteArray *buffer, qsizetype *begin, bool *complete)
+{
+    if (task.compressed) {
+        // 已轮转的压缩分段不再变化，整体解压后作为一个块处理
+        *buffer = LogSegments::readAll(task.filePath);
+        *begin = 0;
+        *complete = true;
+        return !buffer->isEmpty();
+    }
+
+    QFile file(task.filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    // ---- 读取并对齐到行边界 ----
+    // 块 k 拥有起始位置落在 [k*C, (k+1)*C) 内的所有行；从 k*C-1 开始读以判断 k*C 是否恰为行首
+    const qint64 nominalStart = task.chunkNumber * kChunkSize;
+    const qint64 nominalEnd = qMin(nominalStart + kChunkSize, task.endOffset);
+    const qint64 readFrom = qMax<qint64>(0, nominalStart - 1);
+    if (!file.seek(readFrom)) {
+        return false;
+    }
+    *buffer = file.read(nominalEnd - readFrom);
+
+    *complete = false;
+    if (nominalEnd < task.endOffset) {
+        if (!buffer->isEmpty() && buffer->back() == '\n') {
+            *complete = true;
+        } else {
+            qint64 position = nominalEnd;
+            while (position < task.endOffset) {
+                const QByteArray more = file.read(qMin(kAlignReadStep, task.endOffset - position));
+                if (more.isEmpty()) {
+                    break;
+                }
+                const qsizetype newline = more.indexOf('\n');
+                if (newline >= 0) {
+                    buffer->append(more.constData(), newline + 1);
+                    *complete = true;
+                    break;
+                }
+                buffer->append(more);
+                position += more.size();
+            }
+        }
+    }
+
+    *begin = 0;
+    if (nominalStart > 0) {
+        const qsizetype newline = buffer->indexOf('\n');
+        if (newline < 0 || newline + 1 >= nominalEnd - readFrom) {
+            // 没有行起始于本块（超长行跨越整块）
+            return false;
+        }
+        *begin = newline + 1;
+    }
+    return true;
+}
+
+bool LogSearchEngine::canSkip(const ChunkIndex &index, const LogLineMatcher &matcher)
+{
+    if (matcher.hasTimeFilter()) {
+        if (index.minTime.isEmpty()) {
+            return true;
+        }
+        if (!matcher.fromKey().isEmpty() && index.maxTime < matcher.fromKey()) {
+            return true;
+        }
+        if (!matcher.toKey().isEmpty() && index.minTime > matcher.toKey()) {
+            return true;
+        }
+    }
+
+    if (matcher.minSeverity() > 0) {
+        const quint8 wanted = static_cast<quint8>(0xFFu << matcher.minSeverity());
+        if ((index.severityMask & wanted) == 0) {
+            return true;
+        }
+    }
+
+    // 关键词的任一三元组不在位图中，则整块都不可能包含该关键词
+    const QByteArray &literal = matcher.indexLiteral();
+    const uchar *bytes = reinterpret_cast<const uchar *>(literal.constData());
+    for (qsizetype i = 0; i + 2 < literal.size(); ++i) {
+        const quint32 hash = trigramHash(bytes[i], bytes[i + 1], bytes[i + 2]);
+        if ((index.trigramBits[hash >> 6] & (quint64(1) << (hash & 63))) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+quint32 LogSearchEngine::trigramHash(uchar a, uchar b, uchar c)
+{
+    const quint32 packed = (quint32(a) << 16) | (quint32(b) << 8) | c;
+    return (packed * 2654435761u) >> 16;
+}
+
+QByteArray LogSearchEngine::readFileHead(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.read(kHeadLength);
+}
+
+void LogSearchEngine::onChunkFinished(quint64 generation, int sequence, const QStringList &lines)
+{
+    if (!m_running || generation != m_generation) {
+        return;
+    }
+
+    m_pendingResults.insert(sequence, lines);
+
+    // 按块顺序发出，保证结果与文件顺序一致
+    while (!m_pendingResults.isEmpty() && m_pendingResults.firstKey() == m_nextSequence) {
+        QStringList batch = m_pendingResults.take(m_nextSequence);
+        ++m_nextSequence;
+        if (batch.isEmpty()) {
+            continue;
+        }
+
+        const int maxResults = m_job->matcher.query().maxResults;
+        bool truncated = false;
+        // 恰好达到上限不算截断，只有确实丢弃了匹配才报告
+        if (maxResults > 0 && m_matchCount + batch.size() > maxResults) {
+            batch = batch.mid(0, maxResults - m_matchCount);
+            truncated = true;
+        }
+        m_matchCount += static_cast<int>(batch.size());
+
+        if (!batch.isEmpty()) {
+            emit resultsReady(generation, batch);
+            if (!m_running || generation != m_generation) {
+                // 接收方在槽函数中发起了新的搜索
+                return;
+            }
+        }
+
+        if (truncated) {
+            m_job->cancelled.store(true, std::memory_order_relaxed);
+            m_pool.clear();
+            finish(true);
+            return;
+        }
+    }
+
+    if (m_nextSequence == m_totalChunks) {
+        finish(false);
+    }
+}
+
+void LogSearchEngine::finish(bool truncated)
+{
+    m_running = false;
+    m_pendingResults.clear();
+    emit finished(m_generation, m_matchCount, truncated);
+}
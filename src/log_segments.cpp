@@ -0,0 +1,148 @@
+#include "log_segments.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <cstdio>
+
+const char *const LogSegments::kCompressedSuffix = ".qz";
+
+namespace {
+
+const char *const kRotationTimeFormat = "yyyyMMdd-hhmmss-zzz";
+const char *const kTempSuffix = ".tmp";
+
+// 同一分段不允许被两个后台任务同时压缩
+QMutex &maintenanceMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+} // namespace
+
+QString LogSegments::rotatedPath(const QString &activePath, const QDateTime &time)
+{
+    const QFileInfo info(activePath);
+    const QString stem = info.absolutePath() + "/" + info.completeBaseName() + "."
+                         + time.toString(kRotationTimeFormat);
+    const QString suffix = "." + info.suffix();
+
+    QString path = stem + suffix;
+    for (int i = 1; QFile::exists(path) || QFile::exists(path + kCompressedSuffix); ++i) {
+        path = QString("%1-%2%3").arg(stem).arg(i).arg(suffix);
+    }
+    return path;
+}
+
+QStringList LogSegments::rotatedSegments(const QString &activePath)
+{
+    const QFileInfo info(activePath);
+    const QString prefix = info.completeBaseName() + ".*." + info.suffix();
+
+    QDir dir(info.absolutePath());
+    const QStringList names = dir.entryList({prefix, prefix + kCompressedSuffix},
+                                            QDir::Files, QDir::Name);
+
+    QStringList segments;
+    segments.reserve(names.size());
+    for (const QString &name : names) {
+        segments.append(dir.absoluteFilePath(name));
+    }
+    return segments;
+}
+
+QStringList LogSegments::allSegments(const QString &activePath)
+{
+    QStringList segments = rotatedSegments(activePath);
+    segments.append(QFileInfo(activePath).absoluteFilePath());
+    return segments;
+}
+
+bool LogSegments::isCompressed(const QString &segmentPath)
+{
+    return segmentPath.endsWith(kCompressedSuffix);
+}
+
+QByteArray LogSegments::readAll(const QString &segmentPath)
+{
+    QFile file(segmentPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    const QByteArray data = file.readAll();
+    return isCompressed(segmentPath) ? qUncompress(data) : data;
+}
+
+bool LogSegments::compress(const QString &segmentPath)
+{
+    QFile source(segmentPath);
+    if (!source.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray compressed = qCompress(source.readAll(), 6);
+    source.close();
+
+    const QString targetPath = segmentPath + kCompressedSuffix;
+    const QString tempPath = targetPath + kTempSuffix;
+    QFile temp(tempPath);
+    if (!temp.open(QIODevice::WriteOnly | QIODevice::Truncate)
+        || temp.write(compressed) != compressed.size()) {
+        temp.remove();
+        return false;
+    }
+    temp.close();
+
+    QFile::remove(targetPath);
+    if (!QFile::rename(tempPath, targetPath)) {
+        QFile::remove(tempPath);
+        return false;
+    }
+    return QFile::remove(segmentPath);
+}
+
+void LogSegments::compressAndPrune(const QString &activePath, int retention)
+{
+    QMutexLocker locker(&maintenanceMutex());
+
+    // 清理上次异常退出留下的临时文件
+    const QFileInfo info(activePath);
+    QDir dir(info.absolutePath());
+    const QString tempPattern = info.completeBaseName() + ".*" + kCompressedSuffix + kTempSuffix;
+    for (const QString &name : dir.entryList({tempPattern}, QDir::Files)) {
+        dir.remove(name);
+    }
+
+    QStringList segments = rotatedSegments(activePath);
+
+    // 先删除超出保留数量的最旧分段，避免压缩马上就要删除的文件
+    const int excess = segments.size() - qMax(0, retention);
+    for (int i = 0; i < excess; ++i) {
+        QFile::remove(segments.at(i));
+    }
+    if (excess > 0) {
+        segments = segments.mid(excess);
+    }
+
+    for (const QString &segment : std::as_const(segments)) {
+        if (!isCompressed(segment) && !compress(segment)) {
+            // 写入器线程之外也不能走 qWarning：消息处理器会再次写入正在维护的日志
+            std::fprintf(stderr, "[LogSegments] Failed to compress %s\n", qPrintable(segment));
+        }
+    }
+}
+
+int LogSegments::removeRotated(const QString &activePath)
+{
+    QMutexLocker locker(&maintenanceMutex());
+
+    int removed = 0;
+    for (const QString &segment : rotatedSegments(activePath)) {
+        if (QFile::remove(segment)) {
+            ++removed;
+        }
+    }
+    return removed;
+}
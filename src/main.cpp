@@ -1,47 +1,27 @@
 #include <QApplication>
 #include <QSplashScreen>
 #include <QPixmap>
-#include <QThread>
 #include <QDateTime>
 #include <QDebug>
-#include <QFile>
-#include <QDir>
 #include "main_window.h"
 #include "splash_screen.h"
-#include "palette.h"
+#include "theme_manager.h"
+#include "async_log_writer.h"
+#include "log_manager.h"
+#include "log_categories.h"
+#include "startup_loader.h"
+#include "serial_port_registry.h"
 
 // ========== 启动画面配置 ==========
 // 设置为 1 启用启动画面和加载动画，设置为 0 禁用
 #define ENABLE_SPLASH_SCREEN 0
 
-// 日志文件
-QFile *logFile = nullptr;
-
-void setupLogging()
-{
-    QString logPath = QDir::homePath() + "/.config/SCOM-X/debug.log";
-    QDir().mkpath(QDir::homePath() + "/.config/SCOM-X");
-    logFile = new QFile(logPath);
-    if (logFile->open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Append)) {
-        logFile->write(QString("\n========== 应用启动 %1 ==========\n").arg(QDateTime::currentDateTime().toString()).toLatin1());
-        logFile->flush();
-    }
-}
-
-void debugLog(const QString &msg)
-{
-    if (logFile && logFile->isOpen()) {
-        logFile->write(msg.toLatin1());
-        logFile->write("\n");
-        logFile->flush();
-    }
-    qDebug() << msg;
-}
-
 int main(int argc, char *argv[])
 {
-    setupLogging();
-    debugLog("[MAIN] 应用启动中...");
+    // 统一日志管线：Qt 消息处理器 -> 异步批量写入
+    LogManager::instance().initialize();
+    AsyncLogWriter::installCrashHandlers();
+    qCInfo(lcMain).noquote() << QString("========== 应用启动 %1 ==========").arg(QDateTime::currentDateTime().toString());
     
     QApplication app(argc, argv);
 
@@ -50,85 +30,58 @@ int main(int argc, char *argv[])
     app.setApplicationVersion("1.0.0");
     app.setApplicationDisplayName("SCOM-X");
 
+    // 串口注册表须在 GUI 线程创建；此后列表随热插拔自动更新
+    SerialPortRegistry::instance().startMonitoring();
+
+    // 配置、历史记录与串口扫描在后台并发进行，不阻塞窗口显示
+    StartupLoader startupLoader;
+    startupLoader.start();
+
 #if ENABLE_SPLASH_SCREEN
     SplashScreen splash;
     splash.show();
+    QObject::connect(&startupLoader, &StartupLoader::stageFinished, &splash, [&splash](const QString &name) {
+        splash.showLoadingMessage(name + " 完成");
+    });
     app.processEvents();
 #endif
 
-    // ========== 加载步骤 1: 初始化应用程序 ==========
-#if ENABLE_SPLASH_SCREEN
-    splash.showLoadingMessage("初始化应用程序...", 10);
-#endif
-    debugLog("[MAIN] 初始化应用程序...");
-    QThread::msleep(100);
-
-    // ========== 加载步骤 2: 加载配置文件 ==========
-#if ENABLE_SPLASH_SCREEN
-    splash.showLoadingMessage("加载配置文件...", 25);
-#endif
-    debugLog("[MAIN] 加载配置文件...");
-    QFile configDir(QString("%1/.config/SCOM-X").arg(QDir::homePath()));
-    QThread::msleep(200);
-
-    // ========== 加载步骤 3: 加载样式表 ==========
-#if ENABLE_SPLASH_SCREEN
-    splash.showLoadingMessage("加载样式表...", 40);
-#endif
-    debugLog("[MAIN] 加载样式表...");
-    loadFlatStyle();  // 使用颜色调色板加载样式
-    app.processEvents();  // 确保样式应用生效
-    QThread::msleep(100);
-
-    // ========== 加载步骤 4: 初始化串口 ==========
-#if ENABLE_SPLASH_SCREEN
-    splash.showLoadingMessage("初始化串口模块...", 55);
-#endif
-    debugLog("[MAIN] 初始化串口模块...");
-    QThread::msleep(150);
-
-    // ========== 加载步骤 5: 建立信号连接 ==========
-#if ENABLE_SPLASH_SCREEN
-    splash.showLoadingMessage("建立信号连接...", 70);
-#endif
-    debugLog("[MAIN] 建立信号连接...");
-    QThread::msleep(100);
-
-    // ========== 加载步骤 6: 加载用户设置 ==========
-#if ENABLE_SPLASH_SCREEN
-    splash.showLoadingMessage("加载用户设置...", 85);
-#endif
-    debugLog("[MAIN] 加载用户设置...");
-    QThread::msleep(150);
-
-    // ========== 加载步骤 7: 准备完毕 ==========
-#if ENABLE_SPLASH_SCREEN
-    splash.showLoadingMessage("准备完毕!", 100);
-    QThread::msleep(200);
-#endif
+    qint64 stageStart = startupLoader.elapsed();
+    // 样式表只在这里设置一次；配置中的主题不同才会在加载完成后切换
+    ThemeManager::instance().applyTheme(ThemeManager::kDefaultTheme);
+    startupLoader.recordStage("加载样式表", stageStart);
 
     // 创建并显示主窗口
-    debugLog("[MAIN] 开始创建 MainWindow...");
+    qCInfo(lcMain) << "开始创建 MainWindow...";
     try {
+        stageStart = startupLoader.elapsed();
         MainWindow window;
-        debugLog("[MAIN] MainWindow 创建成功");
+        startupLoader.recordStage("创建主窗口", stageStart);
+        qCInfo(lcMain) << "MainWindow 创建成功";
 #if ENABLE_SPLASH_SCREEN
         splash.finish(&window);  // 关闭启动画面并指定主窗口
 #endif
-        debugLog("[MAIN] 准备显示主窗口...");
+        qCInfo(lcMain) << "准备显示主窗口...";
+        stageStart = startupLoader.elapsed();
         window.show();
-        debugLog("[MAIN] window.show() 完成");
-        debugLog("[MAIN] 进入事件循环");
-        if (logFile) logFile->close();
-        return app.exec();
+        startupLoader.recordStage("显示主窗口", stageStart);
+        qCInfo(lcMain) << "window.show() 完成，距启动" << startupLoader.elapsed() << "ms";
+
+        // 后台阶段完成后由主窗口应用配置并输出启动耗时汇总
+        window.attachStartup(&startupLoader);
+        qCInfo(lcMain) << "进入事件循环";
+        int exitCode = app.exec();
+        // 退出前同步落盘所有异步日志
+        AsyncLogWriter::instance().shutdown();
+        return exitCode;
     } catch (const std::exception &e) {
-        QString errMsg = QString("[CRITICAL] 创建 MainWindow 时异常: %1").arg(e.what());
-        debugLog(errMsg);
-        if (logFile) logFile->close();
+        QString errMsg = QString("创建 MainWindow 时异常: %1").arg(e.what());
+        qCCritical(lcMain).noquote() << errMsg;
+        AsyncLogWriter::instance().shutdown();
         return -1;
     } catch (...) {
-        debugLog("[CRITICAL] 创建 MainWindow 时发生未知异常");
-        if (logFile) logFile->close();
+        qCCritical(lcMain) << "创建 MainWindow 时发生未知异常";
+        AsyncLogWriter::instance().shutdown();
         return -1;
     }
 }
@@ -0,0 +1,455 @@
+#include "modbus_poller.h"
+#include "serial_port.h"
+#include "modbus_rtu_decoder.h"
+#include "checksum.h"
+#include "log_categories.h"
+
+#include <QStringList>
+#include <QMap>
+#include <algorithm>
+
+namespace {
+
+bool isBitFunction(quint8 function)
+{
+    return function == 1 || function == 2;
+}
+
+int dataBytes(quint8 function, int count)
+{
+    return isBitFunction(function) ? (count + 7) / 8 : count * 2;
+}
+
+/**
+ * 按周期轮询一段地址时每秒占用的总线字符数
+ */
+double busLoad(quint8 function, int count, int periodMs)
+{
+    return double(ModbusPoller::kRequestOverheadChars + dataBytes(function, count)) * 1000.0 / periodMs;
+}
+
+QByteArray buildRequest(const ModbusPollBlock &block)
+{
+    QByteArray request;
+    request.append(char(block.slave));
+    request.append(char(block.function));
+    request.append(char(block.address >> 8));
+    request.append(char(block.address & 0xFF));
+    request.append(char(block.count >> 8));
+    request.append(char(block.count & 0xFF));
+    return Checksum::append(Checksum::Algorithm::Crc16Modbus, request);
+}
+
+} // namespace
+
+ModbusPoller::ModbusPoller(SerialPort *serialPort, QObject *parent)
+    : QObject(parent)
+    , m_serialPort(serialPort)
+{
+    m_clock.start();
+
+    m_sendTimer.setSingleShot(true);
+    m_sendTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_sendTimer, &QTimer::timeout, this, &ModbusPoller::scheduleNext);
+
+    m_timeoutTimer.setSingleShot(true);
+    m_timeoutTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timeoutTimer, &QTimer::timeout, this, &ModbusPoller::onResponseTimeout);
+
+    connect(m_serialPort, &SerialPort::rawDataReceived, this, &ModbusPoller::onDataReceived);
+    connect(m_serialPort, &SerialPort::connectionStatusChanged, this, [this](bool connected) {
+        if (!connected)
+        {
+            stop();
+        }
+    });
+}
+
+ModbusPoller::~ModbusPoller()
+{
+}
+
+bool ModbusPoller::parsePoints(const QString &text, QVector<ModbusPollPoint> *points, QString *error)
+{
+    QVector<ModbusPollPoint> parsed;
+    const QStringList lines = text.split('\n');
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        const QString line = lines.at(i).section('#', 0, 0).trimmed();
+        if (line.isEmpty())
+        {
+            continue;
+        }
+
+        const QStringList fields = line.split(' ', Qt::SkipEmptyParts);
+        if (fields.size() != 5 && fields.size() != 6)
+        {
+            if (error)
+            {
+                *error = QString("第 %1 行：格式应为 名称 从站 功能码 地址 [数量] 周期ms").arg(i + 1);
+            }
+            return false;
+        }
+
+        bool ok[5] = {false, false, false, false, false};
+        ModbusPollPoint point;
+        point.name = fields.at(0);
+        const uint slave = fields.at(1).toUInt(&ok[0], 0);
+        const uint function = fields.at(2).toUInt(&ok[1], 0);
+        point.slave = quint8(slave);
+        point.function = quint8(function);
+        point.address = fields.at(3).toUShort(&ok[2], 0);
+        point.count = fields.size() == 6 ? fields.at(4).toUShort(&ok[3], 0) : 1;
+        ok[3] = fields.size() == 6 ? ok[3] : true;
+        point.periodMs = fields.last().toInt(&ok[4]);
+
+        const int maxCount = isBitFunction(point.function) ? kMaxBitsPerRequest : kMaxRegistersPerRequest;
+        QString problem;
+        if (!std::all_of(std::begin(ok), std::end(ok), [](bool value) { return value; }))
+        {
+            problem = "数值格式错误";
+        }
+        else if (slave < 1 || slave > 247)
+        {
+            problem = "从站地址应为 1~247";
+        }
+        else if (function < 1 || function > 4)
+        {
+            problem = "只支持功能码 1~4";
+        }
+        else if (point.count < 1 || point.count > maxCount || int(point.address) + point.count > 0x10000)
+        {
+            problem = QString("数量应为 1~%1 且不超出地址范围").arg(maxCount);
+        }
+        else if (point.periodMs < 10)
+        {
+            problem = "周期至少 10 ms";
+        }
+        if (!problem.isEmpty())
+        {
+            if (error)
+            {
+                *error = QString("第 %1 行：%2").arg(i + 1).arg(problem);
+            }
+            return false;
+        }
+        parsed.append(point);
+    }
+
+    *points = parsed;
+    return true;
+}
+
+QVector<ModbusPollBlock> ModbusPoller::plan(const QVector<ModbusPollPoint> &points)
+{
+    // 按 (从站, 功能码) 分组，组内按起始地址排序
+    QMap<int, QVector<int>> groups;
+    for (int i = 0; i < points.size(); ++i)
+    {
+        groups[(points.at(i).slave << 8) | points.at(i).function].append(i);
+    }
+
+    QVector<ModbusPollBlock> blocks;
+    for (auto it = groups.begin(); it != groups.end(); ++it)
+    {
+        QVector<int> &members = it.value();
+        std::sort(members.begin(), members.end(), [&points](int a, int b) {
+            return points.at(a).address < points.at(b).address;
+        });
+
+        QVector<ModbusPollBlock> group;
+        for (int index : members)
+        {
+            const ModbusPollPoint &point = points.at(index);
+            ModbusPollBlock block;
+            block.slave = point.slave;
+            block.function = point.function;
+            block.address = point.address;
+            block.count = point.count;
+            block.periodMs = point.periodMs;
+            block.points.append(index);
+            group.append(block);
+        }
+
+        // 反复合并地址相邻的两块，直到任何合并都不再降低总线负载
+        const quint8 function = group.first().function;
+        const int maxCount = isBitFunction(function) ? kMaxBitsPerRequest : kMaxRegistersPerRequest;
+        bool merged = true;
+        while (merged)
+        {
+            merged = false;
+            for (int i = 0; i + 1 < group.size(); ++i)
+            {
+                const ModbusPollBlock &a = group.at(i);
+                const ModbusPollBlock &b = group.at(i + 1);
+                const int end = qMax(int(a.address) + a.count, int(b.address) + b.count);
+                const int count = end - a.address;
+                const int period = qMin(a.periodMs, b.periodMs);
+                if (count > maxCount)
+                {
+                    continue;
+                }
+                if (busLoad(function, count, period)
+                    > busLoad(function, a.count, a.periodMs) + busLoad(function, b.count, b.periodMs))
+                {
+                    continue;
+                }
+
+                ModbusPollBlock combined = a;
+                combined.count = quint16(count);
+                combined.periodMs = period;
+                combined.points += b.points;
+                group[i] = combined;
+                group.remove(i + 1);
+                merged = true;
+                --i;
+            }
+        }
+        blocks += group;
+    }
+
+    for (ModbusPollBlock &block : blocks)
+    {
+        block.request = buildRequest(block);
+    }
+    return blocks;
+}
+
+void ModbusPoller::setPoints(const QVector<ModbusPollPoint> &points)
+{
+    stop();
+    m_points = points;
+    m_blocks = plan(m_points);
+    m_requestCount = 0;
+    m_timeoutCount = 0;
+    m_errorCount = 0;
+
+    qCInfo(lcSerial).noquote() << QString("[ModbusPoller] %1 个点合并为 %2 个请求")
+        .arg(m_points.size()).arg(m_blocks.size());
+}
+
+void ModbusPoller::start()
+{
+    if (m_running || m_blocks.isEmpty())
+    {
+        return;
+    }
+    if (!m_serialPort->isOpen())
+    {
+        qCWarning(lcSerial) << "[ModbusPoller] Serial port is not open";
+        return;
+    }
+
+    m_silentUs = ModbusRtu::silentIntervalUs(m_serialPort->baudRate(),
+                                             ModbusRtuDecoder::bitsPerChar(m_serialPort->dataBits(),
+                                                                           m_serialPort->parity(),
+                                                                           m_serialPort->stopBits()));
+
+    const qint64 now = nowMs();
+    for (ModbusPollBlock &block : m_blocks)
+    {
+        block.nextDueMs = now;
+    }
+    m_busFreeAtMs = now;
+    m_running = true;
+    emit runningChanged(true);
+    scheduleNext();
+}
+
+void ModbusPoller::stop()
+{
+    if (!m_running)
+    {
+        return;
+    }
+    m_running = false;
+    m_outstanding = -1;
+    m_rxBuffer.clear();
+    m_sendTimer.stop();
+    m_timeoutTimer.stop();
+    emit runningChanged(false);
+}
+
+int ModbusPoller::interFrameDelayMs() const
+{
+    // 按整毫秒调度，向上取整保证不短于 t3.5
+    return qMax(m_interFrameDelayMs, int((m_silentUs + 999) / 1000));
+}
+
+bool ModbusPoller::isStale(const ModbusPollPoint &point) const
+{
+    return point.updatedMs < 0 || nowMs() - point.updatedMs > qint64(point.periodMs) * kStaleFactor;
+}
+
+void ModbusPoller::scheduleNext()
+{
+    if (!m_running || m_outstanding >= 0)
+    {
+        return;
+    }
+
+    // EDF：截止时间最早的块优先，相同时周期短的优先
+    int next = -1;
+    for (int i = 0; i < m_blocks.size(); ++i)
+    {
+        if (next < 0
+            || m_blocks.at(i).nextDueMs < m_blocks.at(next).nextDueMs
+            || (m_blocks.at(i).nextDueMs == m_blocks.at(next).nextDueMs
+                && m_blocks.at(i).periodMs < m_blocks.at(next).periodMs))
+        {
+            next = i;
+        }
+    }
+    if (next < 0)
+    {
+        return;
+    }
+
+    const qint64 now = nowMs();
+    const qint64 sendAt = qMax(m_blocks.at(next).nextDueMs, m_busFreeAtMs);
+    if (sendAt > now)
+    {
+        m_sendTimer.start(int(sendAt - now));
+        return;
+    }
+    sendBlock(next);
+}
+
+void ModbusPoller::sendBlock(int index)
+{
+    ModbusPollBlock &block = m_blocks[index];
+    m_outstanding = index;
+    m_rxBuffer.clear();
+    m_echoChecked = false;
+
+    // 截止时间按周期推进；过载时落后的块从当前时刻重新排队
+    const qint64 now = nowMs();
+    block.nextDueMs = qMax(block.nextDueMs + block.periodMs, now);
+    ++block.sent;
+    ++m_requestCount;
+
+    m_sentAtNs = m_clock.nsecsElapsed();
+    if (m_serialPort->writeRaw(block.request) < 0)
+    {
+        qCWarning(lcSerial) << "[ModbusPoller] Failed to send request, polling stopped";
+        stop();
+        return;
+    }
+    m_timeoutTimer.start(m_responseTimeoutMs);
+}
+
+void ModbusPoller::onDataReceived(const QByteArray &data)
+{
+    if (m_outstanding < 0)
+    {
+        return;
+    }
+    const ModbusPollBlock &block = m_blocks.at(m_outstanding);
+    m_rxBuffer.append(data);
+
+    // 部分 RS485 适配器会回显发出的请求；回显可能分几次到达，凑齐前先等待
+    if (!m_echoChecked)
+    {
+        if (m_rxBuffer.size() < block.request.size() && block.request.startsWith(m_rxBuffer))
+        {
+            return;
+        }
+        if (m_rxBuffer.startsWith(block.request))
+        {
+            m_rxBuffer.remove(0, block.request.size());
+        }
+        m_echoChecked = true;
+    }
+
+    // 丢弃帧头之前的杂散字节
+    while (m_rxBuffer.size() >= 2)
+    {
+        const quint8 slave = quint8(m_rxBuffer.at(0));
+        const quint8 function = quint8(m_rxBuffer.at(1));
+        if (slave == block.slave && (function & 0x7F) == block.function)
+        {
+            break;
+        }
+        m_rxBuffer.remove(0, 1);
+    }
+    if (m_rxBuffer.size() < 3)
+    {
+        return;
+    }
+
+    const bool exception = quint8(m_rxBuffer.at(1)) & 0x80;
+    const int expected = exception ? 5 : 5 + dataBytes(block.function, block.count);
+    if (m_rxBuffer.size() < expected)
+    {
+        return;
+    }
+
+    const QByteArray frame = m_rxBuffer.left(expected);
+    const bool crcOk = Checksum::verify(Checksum::Algorithm::Crc16Modbus, frame);
+    const bool countOk = exception || quint8(frame.at(2)) == dataBytes(block.function, block.count);
+    completeBlock(crcOk && countOk && !exception, crcOk && exception, frame);
+}
+
+void ModbusPoller::onResponseTimeout()
+{
+    if (m_outstanding < 0)
+    {
+        return;
+    }
+    ++m_blocks[m_outstanding].timeouts;
+    ++m_timeoutCount;
+    completeBlock(false, false, QByteArray());
+}
+
+void ModbusPoller::completeBlock(bool ok, bool exception, const QByteArray &frame)
+{
+    m_timeoutTimer.stop();
+    const int index = m_outstanding;
+    m_outstanding = -1;
+    m_rxBuffer.clear();
+
+    ModbusPollBlock &block = m_blocks[index];
+    const qint64 now = nowMs();
+    const double latencyMs = (m_clock.nsecsElapsed() - m_sentAtNs) / 1e6;
+
+    if (ok)
+    {
+        block.avgLatencyMs = block.avgLatencyMs <= 0 ? latencyMs : block.avgLatencyMs * 0.9 + latencyMs * 0.1;
+        const uchar *payload = reinterpret_cast<const uchar *>(frame.constData()) + 3;
+        for (int pointIndex : std::as_const(block.points))
+        {
+            ModbusPollPoint &point = m_points[pointIndex];
+            const int offset = point.address - block.address;
+            point.values.resize(point.count);
+            for (int i = 0; i < point.count; ++i)
+            {
+                const int item = offset + i;
+                point.values[i] = isBitFunction(block.function)
+                    ? quint16((payload[item / 8] >> (item % 8)) & 1)
+                    : quint16((payload[item * 2] << 8) | payload[item * 2 + 1]);
+            }
+            point.updatedMs = now;
+            point.latencyMs = latencyMs;
+            ++point.updates;
+        }
+    }
+    else
+    {
+        if (exception)
+        {
+            ++block.exceptions;
+            qCWarning(lcSerial).noquote() << QString("[ModbusPoller] 从站 %1 功能码 %2 地址 %3 异常响应 %4")
+                .arg(block.slave).arg(block.function).arg(block.address).arg(quint8(frame.at(2)));
+        }
+        ++m_errorCount;
+        for (int pointIndex : std::as_const(block.points))
+        {
+            ++m_points[pointIndex].errors;
+        }
+    }
+
+    // 帧间延迟结束前不发送下一请求（部分从站需要比 t3.5 更长的切换时间）
+    m_busFreeAtMs = now + interFrameDelayMs();
+    emit blockCompleted(index, ok);
+    scheduleNext();
+}
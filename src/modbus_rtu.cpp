@@ -0,0 +1,460 @@
+#include "modbus_rtu.h"
+#include "checksum.h"
+
+#include <QStringList>
+#include <cmath>
+
+namespace {
+
+constexpr int kDescribeMaxValues = 16;  // 描述中最多列出的寄存器值个数
+
+quint16 readU16(const QByteArray &bytes, int index)
+{
+    return quint16((uchar(bytes.at(index)) << 8) | uchar(bytes.at(index + 1)));
+}
+
+bool crcMatches(const char *data, int length)
+{
+    if (length < 4)
+    {
+        return false;
+    }
+    const quint16 crc = Checksum::crc16Modbus(data, length - 2);
+    return uchar(data[length - 2]) == (crc & 0xFF) && uchar(data[length - 1]) == (crc >> 8);
+}
+
+QString hexBytes(const QByteArray &data)
+{
+    return QString::fromLatin1(data.toHex(' ').toUpper());
+}
+
+} // namespace
+
+// ========== ModbusFrame ==========
+
+QString ModbusFrame::describe() const
+{
+    if (!crcOk)
+    {
+        return QString("CRC 错误: %1").arg(hexBytes(bytes));
+    }
+
+    const QString head = QString("%1 %2").arg(ModbusRtu::functionName(function), ModbusRtu::kindName(kind));
+    switch (kind)
+    {
+    case Kind::Exception:
+        return QString("%1 %2 (%3)").arg(head)
+            .arg(exceptionCode, 2, 16, QChar('0'))
+            .arg(ModbusRtu::exceptionName(exceptionCode));
+    case Kind::Unknown:
+        return QString("%1 %2").arg(head, hexBytes(data));
+    case Kind::Request:
+    case Kind::Response:
+        break;
+    }
+
+    QString text = head;
+    const bool readResponse = kind == Kind::Response && function >= 1 && function <= 4;
+    if (!readResponse)
+    {
+        text += QString(" 地址 0x%1").arg(address, 4, 16, QChar('0'));
+        if (function != 5 && function != 6)
+        {
+            text += QString(" 数量 %1").arg(quantity);
+        }
+    }
+
+    if (!registers.isEmpty())
+    {
+        QStringList values;
+        for (int i = 0; i < registers.size() && i < kDescribeMaxValues; ++i)
+        {
+            values << QString("0x%1").arg(registers.at(i), 4, 16, QChar('0'));
+        }
+        if (registers.size() > kDescribeMaxValues)
+        {
+            values << QString("…(%1)").arg(registers.size());
+        }
+        text += (readResponse ? QString(" %1 个: ").arg(registers.size()) : QString(" 值: ")) + values.join(' ');
+    }
+    else if (!data.isEmpty())
+    {
+        text += QString(" 数据: %1").arg(hexBytes(data));
+    }
+    return text;
+}
+
+// ========== ModbusRtu ==========
+
+QString ModbusRtu::functionName(quint8 function)
+{
+    switch (function)
+    {
+    case 1:  return "读线圈";
+    case 2:  return "读离散输入";
+    case 3:  return "读保持寄存器";
+    case 4:  return "读输入寄存器";
+    case 5:  return "写单个线圈";
+    case 6:  return "写单个寄存器";
+    case 7:  return "读异常状态";
+    case 8:  return "诊断";
+    case 11: return "通信事件计数";
+    case 15: return "写多个线圈";
+    case 16: return "写多个寄存器";
+    case 17: return "报告从站 ID";
+    case 22: return "掩码写寄存器";
+    case 23: return "读写多个寄存器";
+    case 43: return "读设备标识";
+    default: return QString("功能码 0x%1").arg(function, 2, 16, QChar('0'));
+    }
+}
+
+QString ModbusRtu::exceptionName(quint8 code)
+{
+    switch (code)
+    {
+    case 0x01: return "非法功能";
+    case 0x02: return "非法数据地址";
+    case 0x03: return "非法数据值";
+    case 0x04: return "从站设备故障";
+    case 0x05: return "确认";
+    case 0x06: return "从站设备忙";
+    case 0x08: return "存储奇偶性差错";
+    case 0x0A: return "网关路径不可用";
+    case 0x0B: return "网关目标设备响应失败";
+    default:   return "未知异常";
+    }
+}
+
+QString ModbusRtu::kindName(ModbusFrame::Kind kind)
+{
+    switch (kind)
+    {
+    case ModbusFrame::Kind::Request:   return "请求";
+    case ModbusFrame::Kind::Response:  return "响应";
+    case ModbusFrame::Kind::Exception: return "异常";
+    case ModbusFrame::Kind::Unknown:   break;
+    }
+    return "未知";
+}
+
+QVector<int> ModbusRtu::expectedLengths(const uchar *data, int size)
+{
+    QVector<int> lengths;
+    if (size < 2)
+    {
+        return lengths;
+    }
+
+    const quint8 function = data[1];
+    if (function & 0x80)
+    {
+        lengths << 5;
+        return lengths;
+    }
+
+    switch (function)
+    {
+    case 1: case 2: case 3: case 4:
+        lengths << 8;
+        if (size >= 3)
+        {
+            lengths << (5 + data[2]);
+        }
+        break;
+    case 5: case 6: case 8:
+        lengths << 8;
+        break;
+    case 7:
+        lengths << 4 << 5;
+        break;
+    case 11:
+        lengths << 4 << 8;
+        break;
+    case 12: case 17:
+        lengths << 4;
+        if (size >= 3)
+        {
+            lengths << (5 + data[2]);
+        }
+        break;
+    case 15: case 16:
+        lengths << 8;
+        if (size >= 7)
+        {
+            lengths << (9 + data[6]);
+        }
+        break;
+    case 22:
+        lengths << 10;
+        break;
+    case 23:
+        if (size >= 3)
+        {
+            lengths << (5 + data[2]);
+        }
+        if (size >= 11)
+        {
+            lengths << (13 + data[10]);
+        }
+        break;
+    default:
+        break;
+    }
+    return lengths;
+}
+
+void ModbusRtu::decode(ModbusFrame *frame)
+{
+    const QByteArray &bytes = frame->bytes;
+    const int size = bytes.size();
+    frame->kind = ModbusFrame::Kind::Unknown;
+    if (size < 2)
+    {
+        return;
+    }
+
+    frame->slave = uchar(bytes.at(0));
+    const quint8 rawFunction = uchar(bytes.at(1));
+    frame->function = rawFunction & 0x7F;
+    if (!frame->crcOk || size < 4)
+    {
+        return;
+    }
+
+    if (rawFunction & 0x80)
+    {
+        if (size == 5)
+        {
+            frame->kind = ModbusFrame::Kind::Exception;
+            frame->exceptionCode = uchar(bytes.at(2));
+        }
+        return;
+    }
+
+    switch (frame->function)
+    {
+    case 1: case 2: case 3: case 4:
+    {
+        // 读请求固定 8 字节；字节计数恰好为 3 的读响应也是 8 字节，此时按请求解释
+        const int byteCount = uchar(bytes.at(2));
+        if (size == 5 + byteCount && size != 8)
+        {
+            frame->kind = ModbusFrame::Kind::Response;
+            frame->data = bytes.mid(3, byteCount);
+            if (frame->function >= 3)
+            {
+                frame->quantity = quint16(byteCount / 2);
+                for (int i = 0; i + 1 < byteCount; i += 2)
+                {
+                    frame->registers.append(readU16(bytes, 3 + i));
+                }
+                frame->data.clear();
+            }
+            else
+            {
+                frame->quantity = quint16(byteCount * 8);
+            }
+        }
+        else if (size == 8)
+        {
+            frame->kind = ModbusFrame::Kind::Request;
+            frame->address = readU16(bytes, 2);
+            frame->quantity = readU16(bytes, 4);
+        }
+        break;
+    }
+    case 5: case 6:
+        // 写单个的请求与正常响应完全相同
+        if (size == 8)
+        {
+            frame->kind = ModbusFrame::Kind::Request;
+            frame->address = readU16(bytes, 2);
+            frame->registers.append(readU16(bytes, 4));
+        }
+        break;
+    case 15: case 16:
+        if (size == 8)
+        {
+            frame->kind = ModbusFrame::Kind::Response;
+            frame->address = readU16(bytes, 2);
+            frame->quantity = readU16(bytes, 4);
+        }
+        else if (size >= 9 && size == 9 + uchar(bytes.at(6)))
+        {
+            frame->kind = ModbusFrame::Kind::Request;
+            frame->address = readU16(bytes, 2);
+            frame->quantity = readU16(bytes, 4);
+            const int byteCount = uchar(bytes.at(6));
+            if (frame->function == 16)
+            {
+                for (int i = 0; i + 1 < byteCount; i += 2)
+                {
+                    frame->registers.append(readU16(bytes, 7 + i));
+                }
+            }
+            else
+            {
+                frame->data = bytes.mid(7, byteCount);
+            }
+        }
+        break;
+    default:
+        break;
+    }
+
+    if (frame->kind == ModbusFrame::Kind::Unknown)
+    {
+        frame->data = bytes.mid(2, size - 4);
+    }
+}
+
+qint64 ModbusRtu::silentIntervalUs(qint32 baudRate, double bitsPerChar)
+{
+    if (baudRate <= 0)
+    {
+        return 1750;
+    }
+    if (baudRate > 19200)
+    {
+        return 1750;
+    }
+    return qint64(std::ceil(3.5 * bitsPerChar * 1e6 / baudRate));
+}
+
+// ========== ModbusRtuFramer ==========
+
+void ModbusRtuFramer::setLineTiming(qint64 charTimeUs, qint64 silentIntervalUs)
+{
+    m_charUs = qMax<qint64>(1, charTimeUs);
+    m_silentUs = qMax<qint64>(1, silentIntervalUs);
+}
+
+void ModbusRtuFramer::feed(const char *data, int size, qint64 timeUs, qint64 epochMs, QVector<ModbusFrame> *out)
+{
+    if (size <= 0)
+    {
+        return;
+    }
+
+    if (!m_buffer.isEmpty())
+    {
+        // 块的接收时刻是末字节到达的时间，反推首字节的到达时间
+        const qint64 firstByteUs = timeUs - qint64(size) * m_charUs;
+        const qint64 gapUs = firstByteUs - m_lastUs;
+        if (gapUs > m_silentUs)
+        {
+            finish(gapUs > kMaxReassemblyGapUs, out);
+        }
+    }
+
+    if (m_buffer.isEmpty())
+    {
+        m_frameEpochMs = epochMs;
+    }
+    m_buffer.append(data, size);
+    m_lastUs = timeUs;
+
+    // 持续不断的数据流中没有静默间隔，积累过多时先切出其中完整的帧
+    if (m_buffer.size() > 2 * kMaxFrameSize)
+    {
+        finish(false, out);
+    }
+}
+
+void ModbusRtuFramer::flush(qint64 nowUs, QVector<ModbusFrame> *out)
+{
+    if (m_buffer.isEmpty())
+    {
+        return;
+    }
+    const qint64 gapUs = nowUs - m_lastUs;
+    if (gapUs > m_silentUs)
+    {
+        finish(gapUs > kMaxReassemblyGapUs, out);
+    }
+}
+
+qint64 ModbusRtuFramer::nextDeadlineUs() const
+{
+    if (m_buffer.isEmpty())
+    {
+        return -1;
+    }
+    return m_lastUs + (m_waitingForRest ? kMaxReassemblyGapUs : m_silentUs) + 1;
+}
+
+void ModbusRtuFramer::reset()
+{
+    m_buffer.clear();
+    m_waitingForRest = false;
+}
+
+void ModbusRtuFramer::finish(bool final, QVector<ModbusFrame> *out)
+{
+    const char *data = m_buffer.constData();
+    const int size = m_buffer.size();
+    int pos = 0;
+
+    while (pos < size)
+    {
+        const int remaining = size - pos;
+        if (remaining <= kMaxFrameSize && crcMatches(data + pos, remaining))
+        {
+            emitFrame(pos, remaining, true, out);
+            pos = size;
+            break;
+        }
+
+        // 边界内有多帧（或帧后跟着下一帧的开头）：按功能码推算的帧长切分
+        bool matched = false;
+        bool couldGrow = remaining < 4;
+        const QVector<int> lengths = ModbusRtu::expectedLengths(reinterpret_cast<const uchar *>(data + pos), remaining);
+        for (int length : lengths)
+        {
+            if (length < 4 || length > kMaxFrameSize)
+            {
+                continue;
+            }
+            if (length > remaining)
+            {
+                couldGrow = true;
+            }
+            else if (crcMatches(data + pos, length))
+            {
+                emitFrame(pos, length, true, out);
+                pos += length;
+                matched = true;
+                break;
+            }
+        }
+        if (matched)
+        {
+            continue;
+        }
+
+        // 只收到一帧的前半部分：保留，等待驱动送来其余字节
+        if (!final && couldGrow)
+        {
+            m_buffer.remove(0, pos);
+            m_waitingForRest = true;
+            return;
+        }
+
+        emitFrame(pos, remaining, false, out);
+        pos = size;
+    }
+
+    m_buffer.clear();
+    m_waitingForRest = false;
+}
+
+void ModbusRtuFramer::emitFrame(int offset, int length, bool crcOk, QVector<ModbusFrame> *out)
+{
+    ModbusFrame frame;
+    frame.timestampMs = m_frameEpochMs;
+    frame.bytes = m_buffer.mid(offset, length);
+    frame.crcOk = crcOk;
+    ModbusRtu::decode(&frame);
+    out->append(frame);
+}
@@ -0,0 +1,145 @@
+#include "modbus_rtu_decoder.h"
+
+#include <QThread>
+#include <QTimer>
+#include <QDateTime>
+#include <QMutexLocker>
+#include <cmath>
+
+ModbusRtuDecoder::ModbusRtuDecoder(QObject *parent)
+    : QObject(parent)
+{
+    m_clock.start();
+
+    m_workerThread = new QThread();
+    m_workerThread->setObjectName("ModbusRtuDecoder");
+    m_workerContext = new QObject();
+    m_workerContext->moveToThread(m_workerThread);
+    connect(m_workerThread, &QThread::finished, m_workerContext, &QObject::deleteLater);
+    m_workerThread->start();
+
+    QMetaObject::invokeMethod(m_workerContext, [this]() { setupWorker(); }, Qt::QueuedConnection);
+}
+
+ModbusRtuDecoder::~ModbusRtuDecoder()
+{
+    m_workerThread->quit();
+    m_workerThread->wait();
+    delete m_workerThread;
+}
+
+void ModbusRtuDecoder::setupWorker()
+{
+    m_flushTimer = new QTimer(m_workerContext);
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_flushTimer, &QTimer::timeout, m_workerContext, [this]() {
+        QVector<ModbusFrame> frames;
+        m_framer.flush(m_clock.nsecsElapsed() / 1000, &frames);
+        deliver(std::move(frames));
+        scheduleFlush();
+    });
+}
+
+double ModbusRtuDecoder::bitsPerChar(QSerialPort::DataBits dataBits,
+                                     QSerialPort::Parity parity,
+                                     QSerialPort::StopBits stopBits)
+{
+    double bits = 1 + int(dataBits);
+    if (parity != QSerialPort::NoParity)
+    {
+        bits += 1;
+    }
+    switch (stopBits)
+    {
+    case QSerialPort::TwoStop:
+        bits += 2;
+        break;
+    case QSerialPort::OneAndHalfStop:
+        bits += 1.5;
+        break;
+    default:
+        bits += 1;
+        break;
+    }
+    return bits;
+}
+
+void ModbusRtuDecoder::setLineParameters(qint32 baudRate,
+                                         QSerialPort::DataBits dataBits,
+                                         QSerialPort::Parity parity,
+                                         QSerialPort::StopBits stopBits)
+{
+    const double bits = bitsPerChar(dataBits, parity, stopBits);
+    const qint64 charUs = baudRate > 0 ? qint64(std::ceil(bits * 1e6 / baudRate)) : 87;
+    const qint64 silentUs = ModbusRtu::silentIntervalUs(baudRate, bits);
+    m_silentUs = silentUs;
+
+    QMetaObject::invokeMethod(m_workerContext, [this, charUs, silentUs]() {
+        m_framer.setLineTiming(charUs, silentUs);
+        m_framer.reset();
+    }, Qt::QueuedConnection);
+}
+
+void ModbusRtuDecoder::feed(const QByteArray &data)
+{
+    // 接收时刻在串口所在线程记录，排队延迟不影响分帧
+    const qint64 timeUs = m_clock.nsecsElapsed() / 1000;
+    const qint64 epochMs = QDateTime::currentMSecsSinceEpoch();
+
+    QMetaObject::invokeMethod(m_workerContext, [this, data, timeUs, epochMs]() {
+        QVector<ModbusFrame> frames;
+        m_framer.feed(data.constData(), int(data.size()), timeUs, epochMs, &frames);
+        deliver(std::move(frames));
+        scheduleFlush();
+    }, Qt::QueuedConnection);
+}
+
+void ModbusRtuDecoder::reset()
+{
+    QMetaObject::invokeMethod(m_workerContext, [this]() {
+        m_framer.reset();
+        if (m_flushTimer)
+        {
+            m_flushTimer->stop();
+        }
+    }, Qt::QueuedConnection);
+}
+
+void ModbusRtuDecoder::scheduleFlush()
+{
+    const qint64 deadlineUs = m_framer.nextDeadlineUs();
+    if (deadlineUs < 0 || !m_flushTimer)
+    {
+        return;
+    }
+    const qint64 waitUs = deadlineUs - m_clock.nsecsElapsed() / 1000;
+    m_flushTimer->start(int(qMax<qint64>(1, (waitUs + 999) / 1000)));
+}
+
+void ModbusRtuDecoder::deliver(QVector<ModbusFrame> frames)
+{
+    if (frames.isEmpty())
+    {
+        return;
+    }
+
+    QMutexLocker locker(&m_pendingMutex);
+    m_pending += frames;
+    if (m_deliveryScheduled)
+    {
+        return;  // 上一批尚未被 GUI 线程取走，合并到同一批
+    }
+    m_deliveryScheduled = true;
+    locker.unlock();
+
+    QMetaObject::invokeMethod(this, [this]() {
+        QVector<ModbusFrame> batch;
+        {
+            QMutexLocker locker(&m_pendingMutex);
+            batch.swap(m_pending);
+            m_deliveryScheduled = false;
+        }
+        emit framesDecoded(batch);
+    }, Qt::QueuedConnection);
+}
@@ -1,13 +1,12 @@
 #include "operation_logger.h"
+#include "async_log_writer.h"
 
 #include <QFile>
 #include <QDir>
 #include <QDateTime>
 #include <QTextStream>
 #include <QStandardPaths>
-#include <QMutex>
-
-static QMutex logMutex;
+#include <QTimer>
 
 OperationLogger &OperationLogger::instance()
 {
@@ -17,6 +16,7 @@ OperationLogger &OperationLogger::instance()
 
 OperationLogger::OperationLogger()
 {
+    auditClock.start();
 }
 
 OperationLogger::~OperationLogger()
@@ -53,23 +53,27 @@ QString OperationLogger::formatTimestamp()
     return QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
 }
 
+void OperationLogger::setFlushInterval(int ms)
+{
+    AsyncLogWriter::instance().setFlushInterval(ms);
+}
+
+void OperationLogger::flush()
+{
+    AsyncLogWriter::instance().flush();
+}
+
 void OperationLogger::writeLog(const QString &level, const QString &message)
 {
-    QMutexLocker locker(&logMutex);
-    
     QString logMessage = QString("[%1] [%2] %3")
         .arg(formatTimestamp())
         .arg(level)
         .arg(message);
     
-    // 写入文件
-    QFile file(logFilePath);
-    if (file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Append)) {
-        QTextStream out(&file);
-        out.setEncoding(QStringConverter::Utf8);
-        out << logMessage << "\n";
-        file.close();
-    }
+    // 压入异步写入队列，由后台线程批量落盘
+    QByteArray record = logMessage.toUtf8();
+    record.append('\n');
+    AsyncLogWriter::instance().append(logFilePath, std::move(record));
     
     // 发射信号
     emit logMessageAdded(logMessage);
@@ -86,16 +90,131 @@ void OperationLogger::logSerialDisconnect()
     writeLog("DISCONNECT", "串口已断开");
 }
 
-void OperationLogger::logDataSent(const QString &data, int bytes)
+void OperationLogger::logDataSent(const QByteArray &data)
+{
+    auditData(txAudit, "SEND", "TX", data);
+}
+
+void OperationLogger::logDataReceived(const QByteArray &data)
+{
+    auditData(rxAudit, "RECV", "RX", data);
+}
+
+void OperationLogger::setDataAuditPolicy(const DataAuditPolicy &policy)
+{
+    const bool wasEnabled = auditEnabled.load(std::memory_order_relaxed);
+    if (wasEnabled) {
+        // 策略变化前先把当前窗口写成汇总，避免新旧策略的计数混在一起
+        writeDataSummaries();
+    }
+
+    txAudit.sampleEvery.store(qMax(0, policy.tx.sampleEvery), std::memory_order_relaxed);
+    txAudit.maxRecordsPerSec.store(qMax(0, policy.tx.maxRecordsPerSec), std::memory_order_relaxed);
+    rxAudit.sampleEvery.store(qMax(0, policy.rx.sampleEvery), std::memory_order_relaxed);
+    rxAudit.maxRecordsPerSec.store(qMax(0, policy.rx.maxRecordsPerSec), std::memory_order_relaxed);
+    auditPreviewBytes.store(qMax(0, policy.previewBytes), std::memory_order_relaxed);
+    auditSummaryIntervalMs = qMax(0, policy.summaryIntervalMs);
+    summaryWindowStart = auditClock.elapsed();
+    auditEnabled.store(policy.enabled, std::memory_order_relaxed);
+
+    if (!summaryTimer) {
+        summaryTimer = new QTimer(this);
+        connect(summaryTimer, &QTimer::timeout, this, &OperationLogger::writeDataSummaries);
+    }
+    if (policy.enabled && auditSummaryIntervalMs > 0) {
+        summaryTimer->start(auditSummaryIntervalMs);
+    } else {
+        summaryTimer->stop();
+    }
+}
+
+OperationLogger::DataAuditPolicy OperationLogger::dataAuditPolicy() const
 {
-    QString msg = QString("发送数据: %1 字节 | 内容: %2").arg(bytes).arg(data.left(100));
-    writeLog("SEND", msg);
+    DataAuditPolicy policy;
+    policy.enabled = auditEnabled.load(std::memory_order_relaxed);
+    policy.tx.sampleEvery = txAudit.sampleEvery.load(std::memory_order_relaxed);
+    policy.tx.maxRecordsPerSec = txAudit.maxRecordsPerSec.load(std::memory_order_relaxed);
+    policy.rx.sampleEvery = rxAudit.sampleEvery.load(std::memory_order_relaxed);
+    policy.rx.maxRecordsPerSec = rxAudit.maxRecordsPerSec.load(std::memory_order_relaxed);
+    policy.previewBytes = auditPreviewBytes.load(std::memory_order_relaxed);
+    policy.summaryIntervalMs = auditSummaryIntervalMs;
+    return policy;
 }
 
-void OperationLogger::logDataReceived(const QString &data, int bytes)
+void OperationLogger::auditData(DataAuditState &state, const char *level, const char *direction, const QByteArray &data)
 {
-    QString msg = QString("接收数据: %1 字节 | 内容: %2").arg(bytes).arg(data.left(100));
-    writeLog("RECV", msg);
+    if (!auditEnabled.load(std::memory_order_relaxed) || data.isEmpty()) {
+        return;
+    }
+
+    // 所有数据块都计入汇总
+    state.windowBytes.fetch_add(static_cast<quint64>(data.size()), std::memory_order_relaxed);
+    state.windowChunks.fetch_add(1, std::memory_order_relaxed);
+
+    const int sampleEvery = state.sampleEvery.load(std::memory_order_relaxed);
+    if (sampleEvery <= 0
+        || state.chunkCounter.fetch_add(1, std::memory_order_relaxed) % static_cast<quint64>(sampleEvery) != 0) {
+        return;
+    }
+
+    // 每秒明细上限：固定一秒的窗口，换秒时由先到的调用方清零
+    const int maxRecordsPerSec = state.maxRecordsPerSec.load(std::memory_order_relaxed);
+    if (maxRecordsPerSec > 0) {
+        const qint64 second = auditClock.elapsed() / 1000;
+        qint64 window = state.rateWindowSec.load(std::memory_order_relaxed);
+        if (window != second
+            && state.rateWindowSec.compare_exchange_strong(window, second, std::memory_order_relaxed)) {
+            state.rateWindowRecords.store(0, std::memory_order_relaxed);
+        }
+        if (state.rateWindowRecords.fetch_add(1, std::memory_order_relaxed) >= maxRecordsPerSec) {
+            state.windowDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    state.windowRecords.fetch_add(1, std::memory_order_relaxed);
+
+    // 只有写出的明细才格式化，预览截断到 previewBytes
+    const int previewBytes = auditPreviewBytes.load(std::memory_order_relaxed);
+    QString msg = QString("%1 %2 字节 | %3")
+        .arg(QLatin1String(direction))
+        .arg(data.size())
+        .arg(QString::fromLatin1(data.left(previewBytes).toHex(' ').toUpper()));
+    if (data.size() > previewBytes) {
+        msg += QString(" ... (+%1 字节)").arg(data.size() - previewBytes);
+    }
+    writeLog(QLatin1String(level), msg);
+}
+
+void OperationLogger::writeDataSummaries()
+{
+    const qint64 now = auditClock.elapsed();
+    const qint64 elapsedMs = now - summaryWindowStart;
+    summaryWindowStart = now;
+
+    writeDataSummary(txAudit, "TX", elapsedMs);
+    writeDataSummary(rxAudit, "RX", elapsedMs);
+}
+
+void OperationLogger::writeDataSummary(DataAuditState &state, const char *direction, qint64 elapsedMs)
+{
+    const quint64 bytes = state.windowBytes.exchange(0, std::memory_order_relaxed);
+    const quint64 chunks = state.windowChunks.exchange(0, std::memory_order_relaxed);
+    const quint64 records = state.windowRecords.exchange(0, std::memory_order_relaxed);
+    const quint64 dropped = state.windowDropped.exchange(0, std::memory_order_relaxed);
+    if (chunks == 0) {
+        return;
+    }
+
+    QString msg = QString("%1 汇总: %2 字节 / %3 块 / %4 ms | 明细 %5 条")
+        .arg(QLatin1String(direction))
+        .arg(bytes)
+        .arg(chunks)
+        .arg(elapsedMs)
+        .arg(records);
+    if (dropped > 0) {
+        msg += QString("，限流丢弃 %1 条").arg(dropped);
+    }
+    writeLog("DATA", msg);
 }
 
 void OperationLogger::logCommandExecuted(const QString &command)
@@ -1,4 +1,5 @@
 #include "preferences_dialog.h"
+#include "log_categories.h"
 #include "config_manager.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -97,7 +98,7 @@ void PreferencesDialog::setupUI() {
 
 void PreferencesDialog::loadSettings() {
     if (!configManager) {
-        qWarning() << "[PreferencesDialog] ConfigManager not provided";
+        qCWarning(lcUi) << "[PreferencesDialog] ConfigManager not provided";
         return;
     }
 
@@ -109,7 +110,7 @@ void PreferencesDialog::loadSettings() {
     rtsCheckBox->setChecked(configManager->getRTS());
     flowControlComboBox->setCurrentText(configManager->getFlowControl());
 
-    qDebug() << "[PreferencesDialog] Settings loaded from config";
+    qCDebug(lcUi) << "[PreferencesDialog] Settings loaded from config";
 }
 
 void PreferencesDialog::applySettings() {
@@ -127,10 +128,10 @@ void PreferencesDialog::applySettings() {
 
     // 保存配置到文件
     if (configManager->saveConfig()) {
-        qDebug() << "[PreferencesDialog] Settings applied and saved";
+        qCDebug(lcUi) << "[PreferencesDialog] Settings applied and saved";
         settingsApplied = true;
     } else {
-        qWarning() << "[PreferencesDialog] Failed to save settings";
+        qCWarning(lcUi) << "[PreferencesDialog] Failed to save settings";
     }
 }
 
@@ -0,0 +1,418 @@
+#include "receive_search.h"
+
+#include <QThread>
+#include <cstring>
+
+namespace {
+
+// 每检查这么多个候选位置查看一次取消标志
+constexpr int kCancelCheckMask = 0xFFF;
+
+int hexDigit(QChar c)
+{
+    const ushort u = c.unicode();
+    if (u >= '0' && u <= '9') {
+        return u - '0';
+    }
+    if (u >= 'a' && u <= 'f') {
+        return u - 'a' + 10;
+    }
+    if (u >= 'A' && u <= 'F') {
+        return u - 'A' + 10;
+    }
+    return -1;
+}
+
+} // namespace
+
+// ==================== BytePattern ====================
+
+BytePattern::BytePattern(const QByteArray &bytes, const QByteArray &wildcards, bool caseSensitive)
+    : m_bytes(bytes),
+      m_wildcards(wildcards),
+      m_caseSensitive(caseSensitive)
+{
+    for (int c = 0; c < 256; ++c) {
+        m_fold[c] = (!caseSensitive && c >= 'A' && c <= 'Z') ? uchar(c + ('a' - 'A')) : uchar(c);
+    }
+
+    const int m = length();
+    if (m_wildcards.size() != m) {
+        m_wildcards = QByteArray(m, '\0');
+    }
+    int lastWildcard = -1;  // [0, m-2] 中最后一个通配符
+    for (int i = 0; i < m; ++i) {
+        m_bytes[i] = char(m_fold[uchar(m_bytes.at(i))]);
+        if (m_wildcards.at(i)) {
+            m_hasWildcards = true;
+            if (i < m - 1) {
+                lastWildcard = i;
+            }
+        }
+    }
+
+    // 文本末字节与模式第 i 位对齐时可跳 m-1-i；通配符能对齐任何字节，跳转不能越过它
+    const int maxShift = m - 1 - lastWildcard;
+    for (int c = 0; c < 256; ++c) {
+        m_shift[c] = maxShift;
+    }
+    for (int i = lastWildcard + 1; i < m - 1; ++i) {
+        m_shift[uchar(m_bytes.at(i))] = m - 1 - i;
+    }
+    if (!caseSensitive) {
+        for (int c = 'A'; c <= 'Z'; ++c) {
+            m_shift[c] = m_shift[c + ('a' - 'A')];
+        }
+    }
+}
+
+bool BytePattern::parseHex(const QString &text, QByteArray *bytes, QByteArray *wildcards, QString *error)
+{
+    QString digits;
+    digits.reserve(text.size());
+    for (int i = 0; i < text.size(); ++i) {
+        const QChar c = text.at(i);
+        if (c.isSpace() || c == ',') {
+            continue;
+        }
+        if (c == '0' && i + 1 < text.size() && (text.at(i + 1) == 'x' || text.at(i + 1) == 'X')) {
+            ++i;
+            continue;
+        }
+        if (c != '?' && hexDigit(c) < 0) {
+            *error = QString("无效字符 '%1'").arg(c);
+            return false;
+        }
+        digits.append(c);
+    }
+
+    if (digits.isEmpty()) {
+        *error = "模式为空";
+        return false;
+    }
+    if (digits.size() % 2 != 0) {
+        *error = "十六进制位数必须为偶数";
+        return false;
+    }
+
+    bytes->clear();
+    wildcards->clear();
+    bool anyLiteral = false;
+    for (int i = 0; i < digits.size(); i += 2) {
+        const QChar high = digits.at(i);
+        const QChar low = digits.at(i + 1);
+        if (high == '?' && low == '?') {
+            bytes->append('\0');
+            wildcards->append('\1');
+            continue;
+        }
+        if (high == '?' || low == '?') {
+            *error = "不支持半字节通配，请用 ?? 匹配整个字节";
+            return false;
+        }
+        bytes->append(char(hexDigit(high) * 16 + hexDigit(low)));
+        wildcards->append('\0');
+        anyLiteral = true;
+    }
+
+    if (!anyLiteral) {
+        *error = "模式不能全是通配符";
+        return false;
+    }
+    return true;
+}
+
+qsizetype BytePattern::indexIn(const char *data, qsizetype size, qsizetype from) const
+{
+    const int m = length();
+    if (m == 0 || from < 0 || size - from < m) {
+        return -1;
+    }
+    const uchar *text = reinterpret_cast<const uchar *>(data);
+
+    if (m == 1 && m_caseSensitive) {
+        const void *hit = std::memchr(text + from, uchar(m_bytes.at(0)), size_t(size - from));
+        return hit ? static_cast<const uchar *>(hit) - text : -1;
+    }
+
+    const uchar *pattern = reinterpret_cast<const uchar *>(m_bytes.constData());
+    const char *wild = m_wildcards.constData();
+    const uchar last = pattern[m - 1];
+    const bool lastWild = wild[m - 1] != 0;
+
+    qsizetype pos = from;
+    const qsizetype end = size - m;
+    while (pos <= end) {
+        const uchar c = m_fold[text[pos + m - 1]];
+        if (lastWild || c == last) {
+            int j = m - 2;
+            if (m_hasWildcards) {
+                while (j >= 0 && (wild[j] || m_fold[text[pos + j]] == pattern[j])) {
+                    --j;
+                }
+            } else {
+                while (j >= 0 && m_fold[text[pos + j]] == pattern[j]) {
+                    --j;
+                }
+            }
+            if (j < 0) {
+                return pos;
+            }
+        }
+        pos += m_shift[c];
+    }
+    return -1;
+}
+
+// ==================== ReceiveSearchEngine ====================
+
+ReceiveSearchEngine::ReceiveSearchEngine(QObject *parent)
+    : QObject(parent)
+{
+    m_pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+}
+
+ReceiveSearchEngine::~ReceiveSearchEngine()
+{
+    cancel();
+    m_pool.waitForDone();
+}
+
+quint64 ReceiveSearchEngine::start(const ReceiveStore::Snapshot &snapshot, const ReceiveSearchQuery &query, QString *error)
+{
+    cancel();
+
+    auto job = std::make_shared<Job>();
+    job->query = query;
+
+    QString message;
+    switch (query.mode) {
+        case ReceiveSearchQuery::Mode::Text: {
+            const QByteArray bytes = query.pattern.toUtf8();
+            if (bytes.isEmpty()) {
+                message = "模式为空";
+                break;
+            }
+            job->pattern = BytePattern(bytes, QByteArray(), query.caseSensitive);
+            break;
+        }
+        case ReceiveSearchQuery::Mode::Hex: {
+            QByteArray bytes;
+            QByteArray wildcards;
+            if (BytePattern::parseHex(query.pattern, &bytes, &wildcards, &message)) {
+                job->pattern = BytePattern(bytes, wildcards, true);
+            }
+            break;
+        }
+        case ReceiveSearchQuery::Mode::Regex:
+            if (query.pattern.isEmpty()) {
+                message = "模式为空";
+                break;
+            }
+            job->regex.setPattern(query.pattern);
+            job->regex.setPatternOptions(QRegularExpression::MultilineOption
+                                         | (query.caseSensitive ? QRegularExpression::NoPatternOption
+                                                                : QRegularExpression::CaseInsensitiveOption));
+            if (!job->regex.isValid()) {
+                message = job->regex.errorString();
+            } else {
+                job->regex.optimize();
+            }
+            break;
+    }
+    if (message.isEmpty() && job->pattern.length() > kMaxPatternLength) {
+        message = QString("模式超过 %1 字节").arg(kMaxPatternLength);
+    }
+    if (!message.isEmpty()) {
+        if (error) {
+            *error = message;
+        }
+        return 0;
+    }
+
+    job->generation = ++m_generation;
+    job->snapshot = snapshot;
+
+    m_job = job;
+    m_running = true;
+    m_totalBlocks = int(snapshot.blocks.size());
+    m_nextSequence = 0;
+    m_matchCount = 0;
+    m_pendingResults.clear();
+    m_clock.start();
+
+    const quint64 generation = job->generation;
+    if (m_totalBlocks == 0) {
+        // 始终异步结束，调用方可以先记录代号再接收信号
+        QMetaObject::invokeMethod(this, [this, generation]() {
+            if (m_running && generation == m_generation) {
+                finish(false);
+            }
+        }, Qt::QueuedConnection);
+        return generation;
+    }
+
+    for (int i = 0; i < m_totalBlocks; ++i) {
+        m_pool.start([this, job, i]() {
+            searchBlock(this, job, i);
+        });
+    }
+    return generation;
+}
+
+void ReceiveSearchEngine::cancel()
+{
+    if (m_job) {
+        m_job->cancelled.store(true, std::memory_order_relaxed);
+    }
+    m_pool.clear();
+    m_running = false;
+    m_pendingResults.clear();
+}
+
+void ReceiveSearchEngine::searchBlock(ReceiveSearchEngine *engine, const std::shared_ptr<Job> &job, int blockIndex)
+{
+    if (job->cancelled.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    QVector<ReceiveMatch> matches;
+    if (job->query.mode == ReceiveSearchQuery::Mode::Regex) {
+        searchRegex(*job, blockIndex, &matches);
+    } else {
+        searchBytes(*job, blockIndex, &matches);
+    }
+    if (job->cancelled.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const quint64 generation = job->generation;
+    QMetaObject::invokeMethod(engine, [engine, generation, blockIndex, matches]() {
+        engine->onBlockFinished(generation, blockIndex, matches);
+    }, Qt::QueuedConnection);
+}
+
+void ReceiveSearchEngine::searchBytes(const Job &job, int blockIndex, QVector<ReceiveMatch> *matches)
+{
+    const BytePattern &pattern = job.pattern;
+    const int m = pattern.length();
+    const int maxResults = job.query.maxResults;
+    const ReceiveStore::Block &block = job.snapshot.blocks[size_t(blockIndex)];
+    const char *data = block.data->constData();
+    const qsizetype size = block.data->size();
+
+    int candidates = 0;
+    qsizetype pos = 0;
+    while ((pos = pattern.indexIn(data, size, pos)) >= 0) {
+        matches->append({block.offset + pos, m});
+        // 多收集一个，合并时据此区分"恰好达到上限"和"确有匹配被丢弃"
+        if (maxResults > 0 && matches->size() > maxResults) {
+            return;
+        }
+        ++pos;
+        if ((++candidates & kCancelCheckMask) == 0 && job.cancelled.load(std::memory_order_relaxed)) {
+            return;
+        }
+    }
+
+    // 跨到下一块的匹配：块尾 m-1 字节拼上下一块开头 m-1 字节，只取起点在块尾、且块内放不下的匹配
+    if (m < 2 || size_t(blockIndex) + 1 >= job.snapshot.blocks.size()) {
+        return;
+    }
+    const QByteArray &next = *job.snapshot.blocks[size_t(blockIndex) + 1].data;
+    const qsizetype tailLength = qMin<qsizetype>(m - 1, size);
+    QByteArray junction(data + size - tailLength, tailLength);
+    junction.append(next.constData(), qMin<qsizetype>(m - 1, next.size()));
+    pos = qMax<qsizetype>(0, tailLength - m + 1);
+    while ((pos = pattern.indexIn(junction.constData(), junction.size(), pos)) >= 0 && pos < tailLength) {
+        matches->append({block.offset + size - tailLength + pos, m});
+        ++pos;
+    }
+}
+
+void ReceiveSearchEngine::searchRegex(const Job &job, int blockIndex, QVector<ReceiveMatch> *matches)
+{
+    const int maxResults = job.query.maxResults;
+    const ReceiveStore::Block &block = job.snapshot.blocks[size_t(blockIndex)];
+    const qsizetype size = block.data->size();
+
+    // 字节按 Latin-1 一一对应为字符，匹配位置就是字节偏移
+    QByteArray bytes = *block.data;
+    if (size_t(blockIndex) + 1 < job.snapshot.blocks.size()) {
+        const QByteArray &next = *job.snapshot.blocks[size_t(blockIndex) + 1].data;
+        bytes.append(next.constData(), qMin<qsizetype>(kRegexOverlap, next.size()));
+    }
+    const QString text = QString::fromLatin1(bytes);
+
+    int candidates = 0;
+    QRegularExpressionMatchIterator it = job.regex.globalMatch(text);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch match = it.next();
+        const qsizetype start = match.capturedStart();
+        if (start >= size) {
+            break;  // 起点在下一块，由下一块负责
+        }
+        if (match.capturedLength() > 0) {
+            matches->append({block.offset + start, int(match.capturedLength())});
+            if (maxResults > 0 && matches->size() > maxResults) {
+                return;
+            }
+        }
+        if ((++candidates & kCancelCheckMask) == 0 && job.cancelled.load(std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+void ReceiveSearchEngine::onBlockFinished(quint64 generation, int sequence, const QVector<ReceiveMatch> &matches)
+{
+    if (!m_running || generation != m_generation) {
+        return;
+    }
+
+    m_pendingResults.insert(sequence, matches);
+
+    // 按块顺序发出，结果按偏移递增
+    while (!m_pendingResults.isEmpty() && m_pendingResults.firstKey() == m_nextSequence) {
+        QVector<ReceiveMatch> batch = m_pendingResults.take(m_nextSequence);
+        ++m_nextSequence;
+        if (batch.isEmpty()) {
+            continue;
+        }
+
+        const int maxResults = m_job->query.maxResults;
+        bool truncated = false;
+        // 恰好达到上限不算截断，只有确实丢弃了匹配才报告
+        if (maxResults > 0 && m_matchCount + batch.size() > maxResults) {
+            batch.resize(maxResults - m_matchCount);
+            truncated = true;
+        }
+        m_matchCount += int(batch.size());
+
+        if (!batch.isEmpty()) {
+            emit resultsReady(generation, batch);
+            if (!m_running || generation != m_generation) {
+                // 接收方在槽函数中发起了新的搜索
+                return;
+            }
+        }
+
+        if (truncated) {
+            m_job->cancelled.store(true, std::memory_order_relaxed);
+            m_pool.clear();
+            finish(true);
+            return;
+        }
+    }
+
+    if (m_nextSequence == m_totalBlocks) {
+        finish(false);
+    }
+}
+
+void ReceiveSearchEngine::finish(bool truncated)
+{
+    m_running = false;
+    m_pendingResults.clear();
+    emit finished(m_generation, m_matchCount, truncated, m_clock.elapsed());
+}
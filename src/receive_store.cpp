@@ -0,0 +1,137 @@
+#include "receive_store.h"
+
+#include <algorithm>
+#include <cstring>
+
+ReceiveStore::ReceiveStore(qint64 capacityBytes)
+    : m_capacity(qMax(kBlockSize, capacityBytes))
+{
+}
+
+void ReceiveStore::append(const QByteArray &data, qint64 timestampMs)
+{
+    if (data.isEmpty()) {
+        return;
+    }
+
+    const int live = int(m_timeIndex.size()) - m_timeIndexStart;
+    if (live == 0 || timestampMs - m_timeIndex.last().timestampMs >= kTimeIndexIntervalMs) {
+        m_timeIndex.append({m_endOffset, timestampMs});
+    }
+
+    const char *bytes = data.constData();
+    qint64 remaining = data.size();
+    while (remaining > 0) {
+        if (m_tail.isEmpty()) {
+            m_tail.reserve(kBlockSize);
+            m_tailOffset = m_endOffset;
+        }
+        const qint64 take = qMin(remaining, kBlockSize - qint64(m_tail.size()));
+        m_tail.append(bytes, take);
+        bytes += take;
+        remaining -= take;
+        m_endOffset += take;
+        if (m_tail.size() >= kBlockSize) {
+            sealTail();
+        }
+    }
+    trim();
+}
+
+void ReceiveStore::clear()
+{
+    m_blocks.clear();
+    m_tail.clear();
+    m_firstOffset = m_endOffset;
+    m_tailOffset = m_endOffset;
+    m_timeIndex.clear();
+    m_timeIndexStart = 0;
+}
+
+void ReceiveStore::setCapacity(qint64 capacityBytes)
+{
+    m_capacity = qMax(kBlockSize, capacityBytes);
+    trim();
+}
+
+QByteArray ReceiveStore::read(qint64 offset, qint64 length) const
+{
+    const qint64 begin = qMax(offset, m_firstOffset);
+    const qint64 end = qMin(offset + length, m_endOffset);
+    QByteArray result;
+    if (begin >= end) {
+        return result;
+    }
+    result.reserve(end - begin);
+
+    // 块首尾相接，按偏移二分找到第一个相交的块
+    auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), begin,
+                               [](qint64 value, const Block &block) { return value < block.offset; });
+    if (it != m_blocks.begin()) {
+        --it;
+    }
+    for (; it != m_blocks.end() && it->offset < end; ++it) {
+        const qint64 blockEnd = it->offset + it->data->size();
+        const qint64 from = qMax(begin, it->offset);
+        const qint64 to = qMin(end, blockEnd);
+        if (from < to) {
+            result.append(it->data->constData() + (from - it->offset), to - from);
+        }
+    }
+    if (!m_tail.isEmpty() && end > m_tailOffset) {
+        const qint64 from = qMax(begin, m_tailOffset);
+        result.append(m_tail.constData() + (from - m_tailOffset), end - from);
+    }
+    return result;
+}
+
+qint64 ReceiveStore::timeAt(qint64 offset) const
+{
+    auto begin = m_timeIndex.cbegin() + m_timeIndexStart;
+    auto it = std::upper_bound(begin, m_timeIndex.cend(), offset,
+                               [](qint64 value, const TimePoint &point) { return value < point.offset; });
+    if (it == begin) {
+        return -1;
+    }
+    return (it - 1)->timestampMs;
+}
+
+ReceiveStore::Snapshot ReceiveStore::snapshot() const
+{
+    Snapshot result;
+    result.blocks = m_blocks;
+    if (!m_tail.isEmpty()) {
+        // 尾部复制一份，之后的追加不会影响快照
+        result.blocks.push_back({m_tailOffset, std::make_shared<const QByteArray>(m_tail.constData(), m_tail.size())});
+    }
+    result.firstOffset = m_firstOffset;
+    result.endOffset = m_endOffset;
+    return result;
+}
+
+void ReceiveStore::sealTail()
+{
+    m_blocks.push_back({m_tailOffset, std::make_shared<const QByteArray>(std::move(m_tail))});
+    m_tail = QByteArray();
+    m_tailOffset = m_endOffset;
+}
+
+void ReceiveStore::trim()
+{
+    while (!m_blocks.empty() && m_endOffset - m_blocks.front().offset > m_capacity) {
+        m_blocks.erase(m_blocks.begin());
+    }
+    m_firstOffset = m_blocks.empty() ? m_tailOffset : m_blocks.front().offset;
+    if (m_tail.isEmpty() && m_blocks.empty()) {
+        m_firstOffset = m_endOffset;
+    }
+
+    // 时间索引保留覆盖 firstOffset 的那一项
+    while (m_timeIndexStart + 1 < m_timeIndex.size() && m_timeIndex.at(m_timeIndexStart + 1).offset <= m_firstOffset) {
+        ++m_timeIndexStart;
+    }
+    if (m_timeIndexStart > 4096 && m_timeIndexStart * 2 > m_timeIndex.size()) {
+        m_timeIndex.remove(0, m_timeIndexStart);
+        m_timeIndexStart = 0;
+    }
+}
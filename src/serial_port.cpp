@@ -1,4 +1,7 @@
 #include "serial_port.h"
+#include "log_categories.h"
+#include "operation_logger.h"
+#include "serial_port_registry.h"
 #include <QDebug>
 #include <QRegularExpression>
 
@@ -23,28 +26,13 @@ SerialPort::~SerialPort()
 
 QStringList SerialPort::scanAvailablePorts()
 {
-    QStringList availablePorts;
-    const auto portInfos = QSerialPortInfo::availablePorts();
-
-    for (const auto &info : portInfos)
-    {
-        availablePorts.append(info.portName());
-    }
-
-    return availablePorts;
+    // 由 SerialPortRegistry 缓存，只在首次调用和热插拔时真正枚举设备
+    return SerialPortRegistry::instance().portNames();
 }
 
 QSerialPortInfo SerialPort::getPortInfo(const QString &portName)
 {
-    const auto portInfos = QSerialPortInfo::availablePorts();
-    for (const auto &info : portInfos)
-    {
-        if (info.portName() == portName)
-        {
-            return info;
-        }
-    }
-    return QSerialPortInfo();
+    return SerialPortRegistry::instance().portInfo(portName);
 }
 
 bool SerialPort::open(const QString &portName,
@@ -56,7 +44,7 @@ bool SerialPort::open(const QString &portName,
 {
     if (!m_serialPort)
     {
-        qWarning() << "Serial port object is null";
+        qCWarning(lcSerial) << "Serial port object is null";
         return false;
     }
 
@@ -74,12 +62,12 @@ bool SerialPort::open(const QString &portName,
 
     if (!m_serialPort->open(QIODevice::ReadWrite))
     {
-        qWarning() << "Failed to open serial port:" << m_serialPort->errorString();
+        qCWarning(lcSerial) << "Failed to open serial port:" << m_serialPort->errorString();
         emit errorOccurred(m_serialPort->errorString());
         return false;
     }
 
-    qInfo() << "Serial port opened successfully:" << portName
+    qCInfo(lcSerial) << "Serial port opened successfully:" << portName
             << "BaudRate:" << baudRate;
     emit connectionStatusChanged(true);
     return true;
@@ -90,7 +78,7 @@ void SerialPort::close()
     if (m_serialPort && m_serialPort->isOpen())
     {
         m_serialPort->close();
-        qInfo() << "Serial port closed";
+        qCInfo(lcSerial) << "Serial port closed";
         emit connectionStatusChanged(false);
     }
 }
@@ -117,9 +105,18 @@ qint64 SerialPort::write(const QString &data, DataFormat format)
         byteData = data.toUtf8();
         break;
     case DataFormat::HEX:
-        byteData = hexStringToByteArray(data);
+    {
+        const QByteArray payload = hexStringToByteArray(data);
+        if (payload.isEmpty())
+        {
+            // 无效或空的 HEX 输入：不能只发出一个孤立的校验值
+            qCWarning(lcSerial) << "Nothing to send for hex input:" << data;
+            return -1;
+        }
+        byteData = Checksum::append(m_txChecksum, payload);
         break;
     }
+    }
 
     qint64 bytesWritten = m_serialPort->write(byteData);
     if (bytesWritten == -1)
@@ -129,6 +126,7 @@ qint64 SerialPort::write(const QString &data, DataFormat format)
     }
 
     m_serialPort->waitForBytesWritten(100);
+    OperationLogger::instance().logDataSent(byteData);
     emit dataSent(data, format);
     return bytesWritten;
 }
@@ -149,6 +147,7 @@ qint64 SerialPort::writeRaw(const QByteArray &data)
     }
 
     m_serialPort->waitForBytesWritten(100);
+    OperationLogger::instance().logDataSent(data);
     return bytesWritten;
 }
 
@@ -216,6 +215,33 @@ qint32 SerialPort::baudRate() const
     return m_serialPort->baudRate();
 }
 
+QSerialPort::DataBits SerialPort::dataBits() const
+{
+    if (!m_serialPort)
+    {
+        return QSerialPort::Data8;
+    }
+    return m_serialPort->dataBits();
+}
+
+QSerialPort::Parity SerialPort::parity() const
+{
+    if (!m_serialPort)
+    {
+        return QSerialPort::NoParity;
+    }
+    return m_serialPort->parity();
+}
+
+QSerialPort::StopBits SerialPort::stopBits() const
+{
+    if (!m_serialPort)
+    {
+        return QSerialPort::OneStop;
+    }
+    return m_serialPort->stopBits();
+}
+
 QString SerialPort::errorString() const
 {
     if (!m_serialPort)
@@ -236,7 +262,7 @@ QByteArray SerialPort::hexStringToByteArray(const QString &hexString)
     QRegularExpression hexRegex("^[0-9A-F]*$");
     if (!hexRegex.match(cleanedHex).hasMatch())
     {
-        qWarning() << "Invalid hex string:" << hexString;
+        qCWarning(lcSerial) << "Invalid hex string:" << hexString;
         return result;
     }
 
@@ -281,6 +307,9 @@ void SerialPort::onDataReceived()
         return;
     }
 
+    OperationLogger::instance().logDataReceived(data);
+    emit rawDataReceived(data);
+
     QString displayData;
     switch (m_dataFormat)
     {
@@ -334,6 +363,6 @@ void SerialPort::onError(QSerialPort::SerialPortError error)
         errorMsg = "Other error";
     }
 
-    qWarning() << "Serial port error:" << errorMsg;
+    qCWarning(lcSerial) << "Serial port error:" << errorMsg;
     emit errorOccurred(errorMsg);
 }
@@ -0,0 +1,249 @@
+#include "serial_port_registry.h"
+#include "log_categories.h"
+
+#include <QCoreApplication>
+#include <QThread>
+#include <QTimer>
+#include <QMutexLocker>
+#include <QDebug>
+
+#ifdef Q_OS_LINUX
+#include <QSocketNotifier>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+SerialPortRegistry &SerialPortRegistry::instance()
+{
+    static SerialPortRegistry registry;
+    return registry;
+}
+
+SerialPortRegistry::SerialPortRegistry()
+{
+    // 信号需要在 GUI 线程的对象上发出，即使单例首先在工作线程中被取得
+    if (QCoreApplication::instance() && thread() != QCoreApplication::instance()->thread())
+    {
+        moveToThread(QCoreApplication::instance()->thread());
+    }
+}
+
+SerialPortRegistry::~SerialPortRegistry()
+{
+    stopMonitoring();
+}
+
+void SerialPortRegistry::startMonitoring()
+{
+    if (m_monitorThread)
+    {
+        return;
+    }
+
+    m_monitorThread = new QThread();
+    m_monitorThread->setObjectName("SerialPortMonitor");
+    m_monitorContext = new QObject();
+    m_monitorContext->moveToThread(m_monitorThread);
+    connect(m_monitorThread, &QThread::finished, m_monitorContext, &QObject::deleteLater);
+    m_monitorThread->start();
+
+    QMetaObject::invokeMethod(m_monitorContext, [this]() { setupMonitor(); }, Qt::QueuedConnection);
+
+    if (QCoreApplication::instance())
+    {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                this, &SerialPortRegistry::stopMonitoring, Qt::UniqueConnection);
+    }
+}
+
+void SerialPortRegistry::stopMonitoring()
+{
+    if (!m_monitorThread)
+    {
+        return;
+    }
+
+    // 监视线程中的对象随 finished() 的 deleteLater 在该线程内销毁
+    m_monitorThread->quit();
+    m_monitorThread->wait();
+    delete m_monitorThread;
+    m_monitorThread = nullptr;
+    m_monitorContext = nullptr;
+
+#ifdef Q_OS_LINUX
+    if (m_netlinkFd >= 0)
+    {
+        ::close(m_netlinkFd);
+        m_netlinkFd = -1;
+    }
+#endif
+}
+
+void SerialPortRegistry::setupMonitor()
+{
+    QTimer *settleTimer = new QTimer(m_monitorContext);
+    settleTimer->setSingleShot(true);
+    settleTimer->setInterval(kHotplugSettleMs);
+    connect(settleTimer, &QTimer::timeout, m_monitorContext, [this]() { rescan(); });
+
+#ifdef Q_OS_LINUX
+    const int fd = ::socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+    if (fd >= 0)
+    {
+        sockaddr_nl address;
+        std::memset(&address, 0, sizeof(address));
+        address.nl_family = AF_NETLINK;
+        address.nl_groups = 1;  // 内核 uevent 组
+        if (::bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0)
+        {
+            m_netlinkFd = fd;
+            QSocketNotifier *notifier = new QSocketNotifier(fd, QSocketNotifier::Read, m_monitorContext);
+            connect(notifier, &QSocketNotifier::activated, m_monitorContext, [fd, settleTimer]() {
+                // 消息格式: "ACTION@DEVPATH\0KEY=VALUE\0KEY=VALUE\0..."
+                char buffer[8192];
+                ssize_t length;
+                while ((length = ::recv(fd, buffer, sizeof(buffer) - 1, 0)) > 0)
+                {
+                    buffer[length] = '\0';
+                    bool isTty = false;
+                    bool isHotplug = false;
+                    for (ssize_t offset = 0; offset < length; offset += ssize_t(std::strlen(buffer + offset)) + 1)
+                    {
+                        const char *field = buffer + offset;
+                        if (std::strcmp(field, "SUBSYSTEM=tty") == 0)
+                        {
+                            isTty = true;
+                        }
+                        else if (std::strcmp(field, "ACTION=add") == 0 || std::strcmp(field, "ACTION=remove") == 0)
+                        {
+                            isHotplug = true;
+                        }
+                    }
+                    if (isTty && isHotplug)
+                    {
+                        settleTimer->start();  // 一次插拔会连续产生多条事件，合并为一次枚举
+                    }
+                }
+            });
+            qCDebug(lcSerial) << "[SerialPortRegistry] 通过 netlink uevent 监视串口热插拔";
+            return;
+        }
+        ::close(fd);
+    }
+    qCWarning(lcSerial) << "[SerialPortRegistry] netlink 不可用，改为轮询串口列表";
+#endif
+
+    QTimer *pollTimer = new QTimer(m_monitorContext);
+    connect(pollTimer, &QTimer::timeout, m_monitorContext, [this]() { rescan(); });
+    pollTimer->start(kPollIntervalMs);
+}
+
+QStringList SerialPortRegistry::rescan()
+{
+    // 启动加载、热插拔线程与界面刷新可能同时调用；整次枚举加锁，
+    // 避免较早的枚举结果在较新的之后提交，发布过时的列表和错误的增减
+    QMutexLocker rescanLocker(&m_rescanMutex);
+
+    const QList<QSerialPortInfo> infos = QSerialPortInfo::availablePorts();
+
+    QHash<QString, QSerialPortInfo> ports;
+    QStringList order;
+    ports.reserve(infos.size());
+    for (const QSerialPortInfo &info : infos)
+    {
+        ports.insert(info.portName(), info);
+        order.append(info.portName());
+    }
+
+    QStringList added;
+    QStringList removed;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_populated)
+        {
+            for (const QString &name : std::as_const(order))
+            {
+                if (!m_ports.contains(name))
+                {
+                    added.append(name);
+                }
+            }
+            for (const QString &name : std::as_const(m_order))
+            {
+                if (!ports.contains(name))
+                {
+                    removed.append(name);
+                }
+            }
+        }
+        // 首次枚举只建立缓存，不算插拔，不发出 portsChanged()
+        m_ports.swap(ports);
+        m_order = order;
+        m_populated = true;
+    }
+
+    if (!added.isEmpty() || !removed.isEmpty())
+    {
+        qCInfo(lcSerial) << "[SerialPortRegistry] 串口变化 新增:" << added << "移除:" << removed;
+        emit portsChanged(added, removed);
+    }
+    return order;
+}
+
+QStringList SerialPortRegistry::portNames()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_populated)
+        {
+            return m_order;
+        }
+    }
+    return rescan();
+}
+
+bool SerialPortRegistry::contains(const QString &portName) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_ports.contains(portName);
+}
+
+QSerialPortInfo SerialPortRegistry::portInfo(const QString &portName) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_ports.value(portName);
+}
+
+QString SerialPortRegistry::describe(const QString &portName) const
+{
+    const QSerialPortInfo info = portInfo(portName);
+    if (info.isNull())
+    {
+        return QString();
+    }
+
+    QStringList parts;
+    if (!info.description().isEmpty())
+    {
+        parts << info.description();
+    }
+    if (!info.manufacturer().isEmpty())
+    {
+        parts << info.manufacturer();
+    }
+    if (info.hasVendorIdentifier() && info.hasProductIdentifier())
+    {
+        parts << QString("VID:PID %1:%2")
+            .arg(info.vendorIdentifier(), 4, 16, QChar('0'))
+            .arg(info.productIdentifier(), 4, 16, QChar('0'))
+            .toUpper();
+    }
+    if (!info.serialNumber().isEmpty())
+    {
+        parts << QString("SN %1").arg(info.serialNumber());
+    }
+    parts << info.systemLocation();
+    return parts.join(" | ");
+}
@@ -0,0 +1,157 @@
+#include "startup_loader.h"
+#include "config_manager.h"
+#include "command_history_index.h"
+#include "serial_port_registry.h"
+#include "log_categories.h"
+
+#include <QThreadPool>
+#include <QCoreApplication>
+#include <QPointer>
+#include <QDebug>
+#include <algorithm>
+#include <functional>
+
+struct StartupLoader::Results
+{
+    std::unique_ptr<ConfigManager> config;
+    std::unique_ptr<CommandHistoryIndex> history;
+    QStringList ports;
+};
+
+StartupLoader::StartupLoader(QObject *parent)
+    : QObject(parent)
+    , m_results(std::make_shared<Results>())
+{
+    m_clock.start();
+}
+
+StartupLoader::~StartupLoader() = default;
+
+void StartupLoader::start()
+{
+    if (m_pendingTasks > 0 || m_finished)
+    {
+        return;
+    }
+
+    QPointer<StartupLoader> self(this);
+    const QElapsedTimer clock = m_clock;
+    std::shared_ptr<Results> results = m_results;
+
+    // 阶段记录和完成通知都投递回 GUI 线程，后台任务不触碰 StartupLoader 本身
+    auto post = [self](const Stage &stage, bool taskDone) {
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [self, stage, taskDone]() {
+            if (!self)
+            {
+                return;
+            }
+            self->addStage(stage);
+            if (taskDone)
+            {
+                self->onTaskFinished();
+            }
+        }, Qt::QueuedConnection);
+    };
+
+    auto runStage = [clock](const QString &name, const std::function<void()> &work) {
+        Stage stage;
+        stage.name = name;
+        stage.background = true;
+        stage.startMs = clock.elapsed();
+        work();
+        stage.durationMs = clock.elapsed() - stage.startMs;
+        return stage;
+    };
+
+    m_pendingTasks = 2;
+
+    // 任务 1：配置 -> 历史记录（历史文件路径由配置决定）
+    QThreadPool::globalInstance()->start([results, post, runStage]() {
+        post(runStage("加载配置", [results]() {
+            results->config = std::make_unique<ConfigManager>();
+            results->config->initialize();
+        }), false);
+        post(runStage("加载历史记录", [results]() {
+            QStringList history;
+            QList<int> counts;
+            results->config->readTerminalHistory(&history, &counts);
+            results->history = std::make_unique<CommandHistoryIndex>();
+            results->history->load(history, counts);
+        }), true);
+    });
+
+    // 任务 2：串口首次枚举，填充 SerialPortRegistry 缓存（部分平台枚举较慢，与配置加载并行）
+    QThreadPool::globalInstance()->start([results, post, runStage]() {
+        post(runStage("扫描串口", [results]() {
+            results->ports = SerialPortRegistry::instance().rescan();
+        }), true);
+    });
+}
+
+void StartupLoader::recordStage(const QString &name, qint64 startMs)
+{
+    Stage stage;
+    stage.name = name;
+    stage.startMs = startMs;
+    stage.durationMs = m_clock.elapsed() - startMs;
+    addStage(stage);
+}
+
+std::unique_ptr<ConfigManager> StartupLoader::takeConfig()
+{
+    return m_finished ? std::move(m_results->config) : nullptr;
+}
+
+std::unique_ptr<CommandHistoryIndex> StartupLoader::takeHistory()
+{
+    return m_finished ? std::move(m_results->history) : nullptr;
+}
+
+QStringList StartupLoader::ports() const
+{
+    return m_finished ? m_results->ports : QStringList();
+}
+
+void StartupLoader::logSummary() const
+{
+    QList<Stage> sorted = m_stages;
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Stage &a, const Stage &b) {
+        return a.startMs < b.startMs;
+    });
+
+    qint64 totalMs = 0;
+    qint64 backgroundMs = 0;
+    for (const Stage &stage : std::as_const(sorted))
+    {
+        qCDebug(lcMain).noquote() << QString("[Startup] %1 %2 +%3 ms 耗时 %4 ms")
+            .arg(stage.background ? "后台" : "GUI ")
+            .arg(stage.name, -8)
+            .arg(stage.startMs, 5)
+            .arg(stage.durationMs);
+        totalMs = qMax(totalMs, stage.startMs + stage.durationMs);
+        if (stage.background)
+        {
+            backgroundMs += stage.durationMs;
+        }
+    }
+
+    qCInfo(lcMain).noquote() << QString("[Startup] 启动完成，总耗时 %1 ms（后台阶段累计 %2 ms）")
+        .arg(totalMs)
+        .arg(backgroundMs);
+}
+
+void StartupLoader::addStage(const Stage &stage)
+{
+    m_stages.append(stage);
+    emit stageFinished(stage.name, stage.durationMs);
+}
+
+void StartupLoader::onTaskFinished()
+{
+    if (--m_pendingTasks > 0)
+    {
+        return;
+    }
+    m_finished = true;
+    emit finished();
+}
@@ -0,0 +1,270 @@
+#include "telemetry_extractor.h"
+#include "telemetry_store.h"
+
+#include <QStringList>
+#include <cmath>
+
+namespace {
+
+bool isKeyStart(char c)
+{
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_';
+}
+
+bool isKeyChar(char c)
+{
+    return isKeyStart(c) || (c >= '0' && c <= '9') || c == '.';
+}
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * 从 pos 开始扫描一个十进制数（可带符号、小数和指数），返回结束位置，不是数字时返回 pos
+ */
+int scanNumber(const char *text, int length, int pos)
+{
+    int i = pos;
+    if (i < length && (text[i] == '-' || text[i] == '+'))
+    {
+        ++i;
+    }
+    const int digitsStart = i;
+    while (i < length && isDigit(text[i]))
+    {
+        ++i;
+    }
+    if (i < length && text[i] == '.')
+    {
+        ++i;
+        while (i < length && isDigit(text[i]))
+        {
+            ++i;
+        }
+    }
+    if (i == digitsStart || (i == digitsStart + 1 && text[digitsStart] == '.'))
+    {
+        return pos;
+    }
+    if (i < length && (text[i] == 'e' || text[i] == 'E'))
+    {
+        int j = i + 1;
+        if (j < length && (text[j] == '-' || text[j] == '+'))
+        {
+            ++j;
+        }
+        if (j < length && isDigit(text[j]))
+        {
+            while (j < length && isDigit(text[j]))
+            {
+                ++j;
+            }
+            i = j;
+        }
+    }
+    return i;
+}
+
+} // namespace
+
+TelemetryExtractor::TelemetryExtractor(TelemetryStore *store, QObject *parent)
+    : QObject(parent)
+    , m_store(store)
+{
+}
+
+bool TelemetryExtractor::setRules(const QString &text, QString *error)
+{
+    QList<Rule> rules;
+    const QStringList lines = text.split('\n');
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        const QString line = lines.at(i).trimmed();
+        if (line.isEmpty() || line.startsWith('#'))
+        {
+            continue;
+        }
+
+        const int separator = line.indexOf('=');
+        if (separator <= 0)
+        {
+            if (error)
+            {
+                *error = QString("第 %1 行：格式应为 通道名=正则").arg(i + 1);
+            }
+            return false;
+        }
+
+        Rule rule;
+        rule.channel = line.left(separator).trimmed();
+        rule.pattern = QRegularExpression(line.mid(separator + 1).trimmed());
+        if (!rule.pattern.isValid())
+        {
+            if (error)
+            {
+                *error = QString("第 %1 行：%2").arg(i + 1).arg(rule.pattern.errorString());
+            }
+            return false;
+        }
+        rule.pattern.optimize();
+        rules.append(rule);
+    }
+
+    m_rules = rules;
+    return true;
+}
+
+void TelemetryExtractor::feed(const QByteArray &data)
+{
+    const qint64 timeUs = m_store->nowUs();
+    int start = 0;
+    for (int i = 0; i < data.size(); ++i)
+    {
+        if (data.at(i) != '\n')
+        {
+            continue;
+        }
+        if (m_skippingLongLine)
+        {
+            // 超长行的剩余部分，到换行为止整行丢弃
+            m_skippingLongLine = false;
+        }
+        else if (m_lineBuffer.isEmpty())
+        {
+            if (i - start <= kMaxLineLength)
+            {
+                processLine(QByteArray::fromRawData(data.constData() + start, i - start), timeUs);
+            }
+        }
+        else
+        {
+            m_lineBuffer.append(data.constData() + start, i - start);
+            if (m_lineBuffer.size() <= kMaxLineLength)
+            {
+                processLine(m_lineBuffer, timeUs);
+            }
+            m_lineBuffer.clear();
+        }
+        start = i + 1;
+    }
+
+    if (start < data.size() && !m_skippingLongLine)
+    {
+        m_lineBuffer.append(data.constData() + start, data.size() - start);
+        if (m_lineBuffer.size() > kMaxLineLength)
+        {
+            // 没有换行的二进制数据：不再累积，并丢弃这一行直到下一个换行，
+            // 避免把行中间的字节当作新行解析出错误的样本
+            m_lineBuffer.clear();
+            m_skippingLongLine = true;
+        }
+    }
+}
+
+void TelemetryExtractor::resetStream()
+{
+    m_lineBuffer.clear();
+    m_skippingLongLine = false;
+}
+
+void TelemetryExtractor::processLine(const QByteArray &line, qint64 timeUs)
+{
+    if (m_rules.isEmpty())
+    {
+        extractAutomatic(line, timeUs);
+        return;
+    }
+
+    const QString text = QString::fromUtf8(line).trimmed();
+    for (const Rule &rule : std::as_const(m_rules))
+    {
+        const QRegularExpressionMatch match = rule.pattern.match(text);
+        if (!match.hasMatch())
+        {
+            continue;
+        }
+        bool ok = false;
+        const double value = match.captured(rule.pattern.captureCount() > 0 ? 1 : 0).toDouble(&ok);
+        if (ok)
+        {
+            addSample(rule.channel, value, timeUs);
+        }
+    }
+}
+
+void TelemetryExtractor::extractAutomatic(const QByteArray &line, qint64 timeUs)
+{
+    const char *text = line.constData();
+    const int length = line.size();
+
+    int i = 0;
+    while (i < length)
+    {
+        // 键必须位于词首，避免把 "0x1f=..." 之类的片段当成键
+        if (!isKeyStart(text[i]) || (i > 0 && isKeyChar(text[i - 1])))
+        {
+            ++i;
+            continue;
+        }
+
+        const int keyStart = i;
+        while (i < length && isKeyChar(text[i]))
+        {
+            ++i;
+        }
+        const int keyEnd = i;
+
+        int j = i;
+        while (j < length && text[j] == ' ')
+        {
+            ++j;
+        }
+        if (j >= length || (text[j] != '=' && text[j] != ':'))
+        {
+            continue;
+        }
+        ++j;
+        while (j < length && text[j] == ' ')
+        {
+            ++j;
+        }
+
+        const int numberEnd = scanNumber(text, length, j);
+        if (numberEnd == j)
+        {
+            continue;
+        }
+
+        bool ok = false;
+        const double value = QByteArray::fromRawData(text + j, numberEnd - j).toDouble(&ok);
+        if (ok)
+        {
+            addSample(QString::fromLatin1(text + keyStart, keyEnd - keyStart), value, timeUs);
+        }
+        i = numberEnd;
+    }
+}
+
+void TelemetryExtractor::addSample(const QString &channel, double value, qint64 timeUs)
+{
+    if (!std::isfinite(value))
+    {
+        return;
+    }
+
+    const bool known = m_store->find(channel) != nullptr;
+    TelemetryChannel *target = m_store->channel(channel);
+    if (!target)
+    {
+        return;  // 通道数已达上限
+    }
+    target->append(timeUs, float(value));
+    ++m_sampleCount;
+
+    if (!known)
+    {
+        emit channelAdded(channel);
+    }
+}
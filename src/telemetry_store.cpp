@@ -0,0 +1,269 @@
+#include "telemetry_store.h"
+
+#include <limits>
+#include <algorithm>
+
+// ========== TelemetryChannel ==========
+
+TelemetryChannel::TelemetryChannel(const QString &name, int capacityLog2)
+    : m_name(name)
+    , m_capacity(quint64(1) << qBound(8, capacityLog2, 30))
+    , m_mask(m_capacity - 1)
+{
+}
+
+void TelemetryChannel::append(qint64 timeUs, float value)
+{
+    const quint64 seq = m_next;
+    if (m_time.size() < m_capacity)
+    {
+        m_time.push_back(timeUs);
+        m_value.push_back(value);
+    }
+    else
+    {
+        m_time[seq & m_mask] = timeUs;
+        m_value[seq & m_mask] = value;
+    }
+
+    for (int level = 0; level < kLevels; ++level)
+    {
+        const int shift = kLevelShift * (level + 1);
+        const quint64 bucketCount = m_capacity >> shift;
+        if (bucketCount == 0)
+        {
+            break;
+        }
+
+        std::vector<Bucket> &buckets = m_levels[level];
+        const quint64 slot = (seq >> shift) & (bucketCount - 1);
+        if ((seq & ((quint64(1) << shift) - 1)) == 0)
+        {
+            // 新桶的第一个样本
+            if (buckets.size() < bucketCount)
+            {
+                buckets.push_back({value, value});
+            }
+            else
+            {
+                buckets[slot] = {value, value};
+            }
+        }
+        else
+        {
+            Bucket &bucket = buckets[slot];
+            bucket.min = qMin(bucket.min, value);
+            bucket.max = qMax(bucket.max, value);
+        }
+    }
+
+    ++m_next;
+}
+
+void TelemetryChannel::clear()
+{
+    m_next = 0;
+    m_time.clear();
+    m_value.clear();
+    for (std::vector<Bucket> &buckets : m_levels)
+    {
+        buckets.clear();
+    }
+}
+
+qint64 TelemetryChannel::firstTimeUs() const
+{
+    return isEmpty() ? 0 : timeAt(oldest());
+}
+
+qint64 TelemetryChannel::lastTimeUs() const
+{
+    return isEmpty() ? 0 : timeAt(m_next - 1);
+}
+
+float TelemetryChannel::lastValue() const
+{
+    return isEmpty() ? 0.0f : valueAt(m_next - 1);
+}
+
+quint64 TelemetryChannel::lowerBound(qint64 timeUs) const
+{
+    quint64 low = oldest();
+    quint64 high = m_next;
+    while (low < high)
+    {
+        const quint64 mid = low + (high - low) / 2;
+        if (timeAt(mid) < timeUs)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+void TelemetryChannel::minMax(quint64 from, quint64 to, float *min, float *max) const
+{
+    float low = std::numeric_limits<float>::infinity();
+    float high = -std::numeric_limits<float>::infinity();
+
+    quint64 seq = from;
+    while (seq < to)
+    {
+        // 优先使用能完整放入剩余区间的最大对齐桶
+        bool merged = false;
+        for (int level = kLevels - 1; level >= 0; --level)
+        {
+            const int shift = kLevelShift * (level + 1);
+            const quint64 width = quint64(1) << shift;
+            const quint64 bucketCount = m_capacity >> shift;
+            if (bucketCount == 0 || (seq & (width - 1)) != 0 || seq + width > to)
+            {
+                continue;
+            }
+            const Bucket &bucket = m_levels[level][(seq >> shift) & (bucketCount - 1)];
+            low = qMin(low, bucket.min);
+            high = qMax(high, bucket.max);
+            seq += width;
+            merged = true;
+            break;
+        }
+        if (!merged)
+        {
+            const float value = valueAt(seq);
+            low = qMin(low, value);
+            high = qMax(high, value);
+            ++seq;
+        }
+    }
+
+    *min = low;
+    *max = high;
+}
+
+void TelemetryChannel::extract(qint64 t0Us, qint64 t1Us, int columns, Extract *out) const
+{
+    *out = Extract();
+    if (isEmpty() || t1Us < t0Us || columns <= 0)
+    {
+        return;
+    }
+
+    const quint64 first = lowerBound(t0Us);
+    const quint64 last = lowerBound(t1Us + 1);
+    float low = std::numeric_limits<float>::infinity();
+    float high = -std::numeric_limits<float>::infinity();
+
+    if (last - first <= quint64(columns) * 2)
+    {
+        // 稀疏：原始点，两侧各多取一个点让折线延伸到视图边缘
+        const quint64 from = first > oldest() ? first - 1 : first;
+        const quint64 to = last < m_next ? last + 1 : last;
+        out->rawTimes.reserve(int(to - from));
+        out->rawValues.reserve(int(to - from));
+        for (quint64 seq = from; seq < to; ++seq)
+        {
+            const float value = valueAt(seq);
+            out->rawTimes.append(timeAt(seq));
+            out->rawValues.append(value);
+            low = qMin(low, value);
+            high = qMax(high, value);
+        }
+    }
+    else
+    {
+        out->raw = false;
+        out->columns.resize(columns);
+        const qint64 span = t1Us - t0Us + 1;
+        quint64 begin = first;
+        for (int column = 0; column < columns; ++column)
+        {
+            const quint64 end = column == columns - 1
+                ? last
+                : std::max(begin, lowerBound(t0Us + span * (column + 1) / columns));
+            if (end > begin)
+            {
+                Column &entry = out->columns[column];
+                minMax(begin, end, &entry.min, &entry.max);
+                entry.valid = true;
+                low = qMin(low, entry.min);
+                high = qMax(high, entry.max);
+            }
+            begin = end;
+        }
+    }
+
+    out->empty = low > high;
+    if (!out->empty)
+    {
+        out->min = low;
+        out->max = high;
+    }
+}
+
+// ========== TelemetryStore ==========
+
+TelemetryStore::TelemetryStore(int capacityLog2)
+    : m_capacityLog2(capacityLog2)
+{
+    m_clock.start();
+}
+
+TelemetryChannel *TelemetryStore::channel(const QString &name)
+{
+    if (TelemetryChannel *existing = find(name))
+    {
+        return existing;
+    }
+    if (m_order.size() >= kMaxChannels)
+    {
+        return nullptr;
+    }
+
+    auto created = std::make_shared<TelemetryChannel>(name, m_capacityLog2);
+    m_channels.insert(name, created);
+    m_order.append(name);
+    return created.get();
+}
+
+TelemetryChannel *TelemetryStore::find(const QString &name) const
+{
+    auto it = m_channels.constFind(name);
+    return it != m_channels.constEnd() ? it.value().get() : nullptr;
+}
+
+void TelemetryStore::clear()
+{
+    m_channels.clear();
+    m_order.clear();
+    m_clock.restart();
+}
+
+qint64 TelemetryStore::lastTimeUs() const
+{
+    qint64 last = 0;
+    for (const auto &channel : m_channels)
+    {
+        if (!channel->isEmpty())
+        {
+            last = qMax(last, channel->lastTimeUs());
+        }
+    }
+    return last;
+}
+
+qint64 TelemetryStore::firstTimeUs() const
+{
+    qint64 first = std::numeric_limits<qint64>::max();
+    for (const auto &channel : m_channels)
+    {
+        if (!channel->isEmpty())
+        {
+            first = qMin(first, channel->firstTimeUs());
+        }
+    }
+    return first == std::numeric_limits<qint64>::max() ? 0 : first;
+}
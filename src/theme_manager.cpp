@@ -0,0 +1,63 @@
+#include "theme_manager.h"
+#include "log_categories.h"
+
+#include <QApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QDebug>
+
+ThemeManager& ThemeManager::instance()
+{
+    static ThemeManager manager;
+    return manager;
+}
+
+QStringList ThemeManager::availableThemes() const
+{
+    QStringList themes;
+    const QStringList files = QDir(":/themes").entryList({"*.qss"}, QDir::Files, QDir::Name);
+    for (const QString &file : files) {
+        themes << QFileInfo(file).completeBaseName();
+    }
+    return themes;
+}
+
+bool ThemeManager::applyTheme(const QString &name)
+{
+    if (name == current) {
+        return true;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const QString style = styleSheet(name);
+    if (style.isEmpty()) {
+        qCWarning(lcUi) << "[ThemeManager] 主题不存在:" << name;
+        return false;
+    }
+
+    qApp->setStyleSheet(style);
+    current = name;
+    qCDebug(lcUi) << "[ThemeManager] 已应用主题" << name << "耗时(ms):" << timer.elapsed();
+    return true;
+}
+
+QString ThemeManager::styleSheet(const QString &name)
+{
+    auto it = cache.constFind(name);
+    if (it != cache.constEnd()) {
+        return it.value();
+    }
+
+    QFile file(QString(":/themes/%1.qss").arg(name));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+
+    const QString style = QString::fromUtf8(file.readAll());
+    cache.insert(name, style);
+    return style;
+}
@@ -0,0 +1,407 @@
+#include "urc_matcher.h"
+#include "log_categories.h"
+
+#include <QDebug>
+#include <algorithm>
+#include <queue>
+
+UrcMatcher::UrcMatcher(QObject *parent)
+    : QObject(parent)
+{
+    m_line.reserve(kMaxLineLength);
+}
+
+int UrcMatcher::addLiteral(const QString &type, const QString &literal, bool anchored)
+{
+    if (literal.isEmpty())
+    {
+        return -1;
+    }
+
+    Pattern pattern;
+    pattern.type = type;
+    pattern.literal = literal.toUtf8();
+    pattern.anchored = anchored;
+    m_patterns.push_back(pattern);
+    m_dirty = true;
+    return static_cast<int>(m_patterns.size()) - 1;
+}
+
+int UrcMatcher::addRegex(const QString &type, const QString &regexPattern)
+{
+    Pattern pattern;
+    pattern.type = type;
+    pattern.isRegex = true;
+    pattern.regex = QRegularExpression(regexPattern);
+    if (!pattern.regex.isValid())
+    {
+        qCWarning(lcSerial) << "[UrcMatcher] 正则无效:" << regexPattern << pattern.regex.errorString();
+        return -1;
+    }
+    pattern.regex.optimize();
+    pattern.literal = literalPrefix(regexPattern);
+    // 没有 ^ 的正则可以在行内任意位置命中，前缀也不限定在行首
+    pattern.anchored = regexPattern.startsWith('^');
+    m_patterns.push_back(pattern);
+    m_dirty = true;
+    return static_cast<int>(m_patterns.size()) - 1;
+}
+
+void UrcMatcher::addStandardPatterns()
+{
+    addRegex("NetworkRegistration", "^\\+CREG: (\\d+)(?:,(.*))?$");
+    addRegex("NetworkRegistration", "^\\+CGREG: (\\d+)(?:,(.*))?$");
+    addRegex("NetworkRegistration", "^\\+CEREG: (\\d+)(?:,(.*))?$");
+    addLiteral("Ring", "RING");
+    addRegex("IncomingCall", "^\\+CRING: (.*)$");
+    addRegex("CallerId", "^\\+CLIP: \"([^\"]*)\"");
+    addRegex("NewMessage", "^\\+CMTI: \"([^\"]*)\",(\\d+)");
+    addRegex("MessageReceived", "^\\+CMT: (.*)$");
+    addRegex("SimStatus", "^\\+CPIN: (.*)$");
+    addRegex("Ussd", "^\\+CUSD: (\\d+)(?:,\"([^\"]*)\")?");
+    addRegex("SocketEvent", "^\\+QIURC: \"(\\w+)\"(?:,(.*))?$");
+    addRegex("FunctionalityChanged", "^\\+CFUN: (\\d+)");
+    addLiteral("NoCarrier", "NO CARRIER");
+    addLiteral("ModuleReady", "RDY");
+    addLiteral("PowerDown", "POWERED DOWN");
+}
+
+void UrcMatcher::clear()
+{
+    m_patterns.clear();
+    m_fallbackRegexes.clear();
+    m_dirty = true;
+    resetStream();
+}
+
+void UrcMatcher::resetStream()
+{
+    m_state = 0;
+    m_linePosition = 0;
+    m_line.clear();
+    m_candidates.clear();
+}
+
+QByteArray UrcMatcher::literalPrefix(const QString &pattern)
+{
+    static const QString metaCharacters = ".^$|?*+()[]{}\\";
+    static const QString quantifiers = "?*{";
+
+    // 顶层有分支（a|b）时，开头的字面量只属于第一个分支，不能作为整个正则的前缀
+    int depth = 0;
+    bool inClass = false;
+    for (int i = 0; i < pattern.size(); ++i)
+    {
+        const QChar c = pattern.at(i);
+        if (c == '\\')
+        {
+            ++i;
+        }
+        else if (inClass)
+        {
+            inClass = c != ']';
+        }
+        else if (c == '[')
+        {
+            inClass = true;
+        }
+        else if (c == '(')
+        {
+            ++depth;
+        }
+        else if (c == ')')
+        {
+            --depth;
+        }
+        else if (c == '|' && depth == 0)
+        {
+            return QByteArray();
+        }
+    }
+
+    QString prefix;
+    int i = pattern.startsWith('^') ? 1 : 0;
+    while (i < pattern.size())
+    {
+        QChar c = pattern.at(i);
+        int next = i + 1;
+        if (c == '\\')
+        {
+            // 只接受转义的标点（\+ \. 等），\d \w 之类是字符类
+            if (next >= pattern.size() || pattern.at(next).isLetterOrNumber())
+            {
+                break;
+            }
+            c = pattern.at(next);
+            next = i + 2;
+        }
+        else if (metaCharacters.contains(c))
+        {
+            break;
+        }
+
+        // 后面跟着量词时该字符是可选的，不能计入前缀
+        if (next < pattern.size() && quantifiers.contains(pattern.at(next)))
+        {
+            break;
+        }
+        prefix.append(c);
+        i = next;
+    }
+    return prefix.toUtf8();
+}
+
+void UrcMatcher::compile()
+{
+    m_dirty = false;
+    m_fallbackRegexes.clear();
+
+    // 字节等价类：模式中出现过的字节各占一类，其余字节共用第 0 类
+    m_byteClass.fill(0);
+    m_classCount = 1;
+    for (const Pattern &pattern : m_patterns)
+    {
+        for (char ch : pattern.literal)
+        {
+            const uchar byte = static_cast<uchar>(ch);
+            if (m_byteClass[byte] == 0)
+            {
+                m_byteClass[byte] = static_cast<quint16>(m_classCount++);
+            }
+        }
+    }
+
+    // 字典树
+    const int classes = m_classCount;
+    std::vector<qint32> trie(classes, -1);
+    std::vector<std::vector<int>> outputs(1);
+    for (int id = 0; id < static_cast<int>(m_patterns.size()); ++id)
+    {
+        const Pattern &pattern = m_patterns[id];
+        if (pattern.literal.isEmpty())
+        {
+            m_fallbackRegexes.push_back(id);
+            continue;
+        }
+
+        qint32 state = 0;
+        for (char ch : pattern.literal)
+        {
+            const int cls = m_byteClass[static_cast<uchar>(ch)];
+            qint32 &next = trie[static_cast<size_t>(state) * classes + cls];
+            if (next < 0)
+            {
+                next = static_cast<qint32>(outputs.size());
+                outputs.emplace_back();
+                trie.resize(trie.size() + classes, -1);
+            }
+            state = trie[static_cast<size_t>(state) * classes + cls];
+        }
+        outputs[state].push_back(id);
+    }
+
+    // 按广度优先计算失败链接，同时把字典树补全为完整转移表
+    const size_t stateCount = outputs.size();
+    m_delta.assign(stateCount * classes, 0);
+    std::vector<qint32> fail(stateCount, 0);
+    std::queue<qint32> pending;
+    for (int cls = 0; cls < classes; ++cls)
+    {
+        const qint32 child = trie[cls];
+        if (child > 0)
+        {
+            m_delta[cls] = child;
+            fail[child] = 0;
+            pending.push(child);
+        }
+    }
+    while (!pending.empty())
+    {
+        const qint32 state = pending.front();
+        pending.pop();
+        const std::vector<int> &inherited = outputs[fail[state]];
+        outputs[state].insert(outputs[state].end(), inherited.begin(), inherited.end());
+
+        for (int cls = 0; cls < classes; ++cls)
+        {
+            const size_t slot = static_cast<size_t>(state) * classes + cls;
+            const qint32 child = trie[slot];
+            const qint32 viaFail = m_delta[static_cast<size_t>(fail[state]) * classes + cls];
+            if (child > 0)
+            {
+                m_delta[slot] = child;
+                fail[child] = viaFail;
+                pending.push(child);
+            }
+            else
+            {
+                m_delta[slot] = viaFail;
+            }
+        }
+    }
+
+    m_outputBegin.assign(stateCount + 1, 0);
+    m_outputIds.clear();
+    for (size_t state = 0; state < stateCount; ++state)
+    {
+        m_outputBegin[state] = static_cast<qint32>(m_outputIds.size());
+        m_outputIds.insert(m_outputIds.end(), outputs[state].begin(), outputs[state].end());
+    }
+    m_outputBegin[stateCount] = static_cast<qint32>(m_outputIds.size());
+
+    resetStream();
+    qCDebug(lcSerial) << "[UrcMatcher] 编译完成 模式:" << m_patterns.size() << "状态:" << stateCount
+                      << "字节类:" << classes << "逐行正则:" << m_fallbackRegexes.size();
+}
+
+void UrcMatcher::feed(const QByteArray &data, qint64 timestampMs)
+{
+    if (m_dirty)
+    {
+        compile();
+    }
+    if (m_patterns.empty())
+    {
+        return;
+    }
+
+    const char *bytes = data.constData();
+    const qsizetype size = data.size();
+    const qint32 classes = m_classCount;
+    qsizetype lineStart = 0;
+
+    for (qsizetype i = 0; i < size; ++i)
+    {
+        const uchar byte = static_cast<uchar>(bytes[i]);
+        if (byte == '\n' || byte == '\r')
+        {
+            const qsizetype room = kMaxLineLength - m_line.size();
+            m_line.append(bytes + lineStart, qMin<qsizetype>(room, i - lineStart));
+            endLine(timestampMs);
+            lineStart = i + 1;
+            continue;
+        }
+
+        ++m_linePosition;
+        m_state = m_delta[static_cast<size_t>(m_state) * classes + m_byteClass[byte]];
+        const qint32 begin = m_outputBegin[m_state];
+        const qint32 end = m_outputBegin[m_state + 1];
+        for (qint32 k = begin; k < end; ++k)
+        {
+            const int id = m_outputIds[k];
+            const Pattern &pattern = m_patterns[id];
+            if (pattern.anchored && m_linePosition != pattern.literal.size())
+            {
+                continue;
+            }
+            if (std::find(m_candidates.begin(), m_candidates.end(), id) == m_candidates.end())
+            {
+                m_candidates.push_back(id);
+            }
+        }
+    }
+
+    const qsizetype room = kMaxLineLength - m_line.size();
+    m_line.append(bytes + lineStart, qMin<qsizetype>(room, size - lineStart));
+}
+
+bool UrcMatcher::matchLine(const QString &line, qint64 timestampMs)
+{
+    if (m_dirty)
+    {
+        compile();
+    }
+    if (m_patterns.empty() || line.isEmpty())
+    {
+        return false;
+    }
+
+    const QByteArray bytes = line.toUtf8();
+    const qint32 classes = m_classCount;
+    const quint64 before = m_matchCount;
+    std::vector<int> candidates;
+    qint32 state = 0;
+
+    for (qsizetype i = 0; i < bytes.size(); ++i)
+    {
+        state = m_delta[static_cast<size_t>(state) * classes + m_byteClass[static_cast<uchar>(bytes[i])]];
+        for (qint32 k = m_outputBegin[state]; k < m_outputBegin[state + 1]; ++k)
+        {
+            const int id = m_outputIds[k];
+            if (m_patterns[id].anchored && i + 1 != m_patterns[id].literal.size())
+            {
+                continue;
+            }
+            if (std::find(candidates.begin(), candidates.end(), id) == candidates.end())
+            {
+                candidates.push_back(id);
+            }
+        }
+    }
+
+    for (int id : candidates)
+    {
+        const Pattern &pattern = m_patterns[id];
+        if (!pattern.isRegex && pattern.anchored && bytes.size() != pattern.literal.size())
+        {
+            continue;
+        }
+        dispatch(id, line, timestampMs);
+    }
+    for (int id : m_fallbackRegexes)
+    {
+        dispatch(id, line, timestampMs);
+    }
+    return m_matchCount != before;
+}
+
+void UrcMatcher::endLine(qint64 timestampMs)
+{
+    if (m_linePosition > 0 && (!m_candidates.empty() || !m_fallbackRegexes.empty()))
+    {
+        const QString line = QString::fromUtf8(m_line);
+        for (int id : m_candidates)
+        {
+            // 锚定的字面量要求整行相同："RING" 不匹配 "RINGING"
+            const Pattern &pattern = m_patterns[id];
+            if (!pattern.isRegex && pattern.anchored && m_linePosition != pattern.literal.size())
+            {
+                continue;
+            }
+            dispatch(id, line, timestampMs);
+        }
+        for (int id : m_fallbackRegexes)
+        {
+            dispatch(id, line, timestampMs);
+        }
+    }
+
+    m_state = 0;
+    m_linePosition = 0;
+    m_line.clear();
+    m_candidates.clear();
+}
+
+void UrcMatcher::dispatch(int patternId, const QString &line, qint64 timestampMs)
+{
+    const Pattern &pattern = m_patterns[patternId];
+
+    UrcEvent event;
+    event.patternId = patternId;
+    event.type = pattern.type;
+    event.line = line;
+    event.timestampMs = timestampMs;
+
+    if (pattern.isRegex)
+    {
+        const QRegularExpressionMatch match = pattern.regex.match(line);
+        if (!match.hasMatch())
+        {
+            return;
+        }
+        event.captures = match.capturedTexts().mid(1);
+    }
+
+    ++m_matchCount;
+    emit urcMatched(event);
+}
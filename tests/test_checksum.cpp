@@ -0,0 +1,179 @@
+#include "checksum.h"
+
+#include <QtTest>
+
+namespace {
+
+const QByteArray kCheckInput("123456789");
+
+// 逐位计算的参考实现，与查表 / 硬件实现互相独立
+quint32 referenceReflected32(quint32 poly, const char *data, qsizetype size)
+{
+    quint32 crc = 0xFFFFFFFFu;
+    for (qsizetype i = 0; i < size; ++i)
+    {
+        crc ^= uchar(data[i]);
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ poly : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+quint16 referenceModbus(const char *data, qsizetype size)
+{
+    quint16 crc = 0xFFFF;
+    for (qsizetype i = 0; i < size; ++i)
+    {
+        crc ^= uchar(data[i]);
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 1) ? quint16((crc >> 1) ^ 0xA001) : quint16(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+quint16 referenceCcitt(const char *data, qsizetype size)
+{
+    quint16 crc = 0xFFFF;
+    for (qsizetype i = 0; i < size; ++i)
+    {
+        crc ^= quint16(uchar(data[i]) << 8);
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 0x8000) ? quint16((crc << 1) ^ 0x1021) : quint16(crc << 1);
+        }
+    }
+    return crc;
+}
+
+QByteArray pseudoRandomBytes(int size)
+{
+    QByteArray bytes(size, Qt::Uninitialized);
+    quint32 state = 0x12345678u;
+    for (int i = 0; i < size; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        bytes[i] = char(state >> 24);
+    }
+    return bytes;
+}
+
+} // namespace
+
+class TestChecksum : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void checkValues_data();
+    void checkValues();
+    void checkValuesUnaligned();
+    void chunkedContinuation();
+    void lengthsAndOffsets();
+    void hardwareMatchesSoftware();
+};
+
+void TestChecksum::checkValues_data()
+{
+    QTest::addColumn<int>("algorithm");
+    QTest::addColumn<quint32>("expected");
+
+    QTest::newRow("CRC8") << int(Checksum::Algorithm::Crc8) << quint32(0xF4);
+    QTest::newRow("CRC16-MODBUS") << int(Checksum::Algorithm::Crc16Modbus) << quint32(0x4B37);
+    QTest::newRow("CRC16-CCITT-FALSE") << int(Checksum::Algorithm::Crc16Ccitt) << quint32(0x29B1);
+    QTest::newRow("CRC32") << int(Checksum::Algorithm::Crc32) << quint32(0xCBF43926u);
+    QTest::newRow("CRC32C") << int(Checksum::Algorithm::Crc32C) << quint32(0xE3069283u);
+}
+
+void TestChecksum::checkValues()
+{
+    QFETCH(int, algorithm);
+    QFETCH(quint32, expected);
+
+    QCOMPARE(Checksum::compute(Checksum::Algorithm(algorithm), kCheckInput), expected);
+}
+
+void TestChecksum::checkValuesUnaligned()
+{
+    // 检验串放在缓冲区的各个起始偏移上：9 字节 = 一次 8 字节主循环 + 1 字节尾部
+    for (int offset = 0; offset < 8; ++offset)
+    {
+        QByteArray buffer(offset, 'x');
+        buffer += kCheckInput;
+        const char *data = buffer.constData() + offset;
+        const qsizetype size = kCheckInput.size();
+
+        QCOMPARE(Checksum::crc16Modbus(data, size), quint16(0x4B37));
+        QCOMPARE(Checksum::crc16Ccitt(data, size), quint16(0x29B1));
+        QCOMPARE(Checksum::crc32(data, size), quint32(0xCBF43926u));
+        QCOMPARE(Checksum::crc32c(data, size), quint32(0xE3069283u));
+        QCOMPARE(Checksum::crc32cSoftware(data, size), quint32(0xE3069283u));
+    }
+}
+
+void TestChecksum::chunkedContinuation()
+{
+    const char *data = kCheckInput.constData();
+    const qsizetype size = kCheckInput.size();
+    for (qsizetype split = 0; split <= size; ++split)
+    {
+        QCOMPARE(Checksum::crc16Modbus(data + split, size - split, Checksum::crc16Modbus(data, split)),
+                 quint16(0x4B37));
+        QCOMPARE(Checksum::crc16Ccitt(data + split, size - split, Checksum::crc16Ccitt(data, split)),
+                 quint16(0x29B1));
+        QCOMPARE(Checksum::crc32(data + split, size - split, Checksum::crc32(data, split)),
+                 quint32(0xCBF43926u));
+        QCOMPARE(Checksum::crc32c(data + split, size - split, Checksum::crc32c(data, split)),
+                 quint32(0xE3069283u));
+        QCOMPARE(Checksum::crc32cSoftware(data + split, size - split, Checksum::crc32cSoftware(data, split)),
+                 quint32(0xE3069283u));
+    }
+}
+
+void TestChecksum::lengthsAndOffsets()
+{
+    // 长度覆盖 0..71（主循环 0..8 次，尾部 0..7 字节）以及较长的块，起始偏移覆盖 0..7
+    const QByteArray buffer = pseudoRandomBytes(4096 + 8);
+    QList<int> lengths;
+    for (int length = 0; length < 72; ++length)
+    {
+        lengths.append(length);
+    }
+    lengths << 255 << 1021 << 4096;
+
+    for (int offset = 0; offset < 8; ++offset)
+    {
+        for (int length : std::as_const(lengths))
+        {
+            const char *data = buffer.constData() + offset;
+            QCOMPARE(Checksum::crc16Modbus(data, length), referenceModbus(data, length));
+            QCOMPARE(Checksum::crc16Ccitt(data, length), referenceCcitt(data, length));
+            QCOMPARE(Checksum::crc32(data, length), referenceReflected32(0xEDB88320u, data, length));
+            QCOMPARE(Checksum::crc32cSoftware(data, length), referenceReflected32(0x82F63B78u, data, length));
+        }
+    }
+}
+
+void TestChecksum::hardwareMatchesSoftware()
+{
+    if (!Checksum::hasHardwareCrc32c())
+    {
+        QSKIP("CPU 不支持硬件 CRC32C，crc32c() 即查表实现");
+    }
+
+    const QByteArray buffer = pseudoRandomBytes(4096 + 8);
+    for (int offset = 0; offset < 8; ++offset)
+    {
+        for (int length = 0; length <= 4096; length += (length < 72 ? 1 : 509))
+        {
+            const char *data = buffer.constData() + offset;
+            QCOMPARE(Checksum::crc32c(data, length), Checksum::crc32cSoftware(data, length));
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(TestChecksum)
+#include "test_checksum.moc"
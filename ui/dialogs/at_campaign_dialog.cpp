@@ -0,0 +1,267 @@
+#include "at_campaign_dialog.h"
+#include "serial_port_registry.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QFile>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QCloseEvent>
+#include <QDateTime>
+
+ATCampaignDialog::ATCampaignDialog(const ATScriptRunner::Script &script, const QString &busyPort, QWidget *parent)
+    : QDialog(parent)
+    , script(script)
+    , busyPort(busyPort)
+    , campaignRunner(new ATCampaignRunner(this))
+{
+    setWindowTitle(QString("AT 批量执行 - %1").arg(script.name.isEmpty() ? QString("未命名脚本") : script.name));
+    resize(900, 640);
+
+    setupUI();
+    updatePortList(SerialPortRegistry::instance().portNames());
+
+    // 插拔设备时实时更新可选串口（执行中列表锁定，不更新）
+    connect(&SerialPortRegistry::instance(), &SerialPortRegistry::portsChanged, this, [this]() {
+        if (!campaignRunner->isRunning()) {
+            updatePortList(SerialPortRegistry::instance().portNames());
+        }
+    });
+
+    connect(campaignRunner, &ATCampaignRunner::deviceCommandFinished, this, &ATCampaignDialog::onDeviceCommandFinished);
+    connect(campaignRunner, &ATCampaignRunner::deviceFinished, this, &ATCampaignDialog::onDeviceFinished);
+    connect(campaignRunner, &ATCampaignRunner::finished, this, &ATCampaignDialog::onCampaignFinished);
+}
+
+ATCampaignDialog::~ATCampaignDialog()
+{
+}
+
+void ATCampaignDialog::setupUI()
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    // 串口选择与参数
+    QHBoxLayout *topLayout = new QHBoxLayout();
+
+    QVBoxLayout *portLayout = new QVBoxLayout();
+    portLayout->addWidget(new QLabel(QString("选择串口（脚本 %1 条命令）:").arg(script.commands.size())));
+    portList = new QListWidget();
+    portList->setMaximumWidth(260);
+    portLayout->addWidget(portList);
+    topLayout->addLayout(portLayout);
+
+    QVBoxLayout *controlLayout = new QVBoxLayout();
+    QHBoxLayout *baudLayout = new QHBoxLayout();
+    baudLayout->addWidget(new QLabel("波特率:"));
+    baudRateCombo = new QComboBox();
+    baudRateCombo->setEditable(true);
+    baudRateCombo->addItems({"9600", "19200", "38400", "57600", "115200", "230400", "460800", "921600"});
+    baudRateCombo->setCurrentText("115200");
+    baudLayout->addWidget(baudRateCombo);
+    baudLayout->addStretch();
+    controlLayout->addLayout(baudLayout);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    refreshButton = new QPushButton("刷新串口");
+    startButton = new QPushButton("开始");
+    stopButton = new QPushButton("停止");
+    saveReportButton = new QPushButton("保存报告");
+    stopButton->setEnabled(false);
+    saveReportButton->setEnabled(false);
+    buttonLayout->addWidget(refreshButton);
+    buttonLayout->addWidget(startButton);
+    buttonLayout->addWidget(stopButton);
+    buttonLayout->addWidget(saveReportButton);
+    buttonLayout->addStretch();
+    controlLayout->addLayout(buttonLayout);
+
+    summaryLabel = new QLabel("就绪");
+    controlLayout->addWidget(summaryLabel);
+
+    deviceTable = new QTableWidget(0, ColumnCount);
+    deviceTable->setHorizontalHeaderLabels({"串口", "状态", "通过", "失败", "耗时 (ms)"});
+    deviceTable->horizontalHeader()->setStretchLastSection(true);
+    deviceTable->verticalHeader()->setVisible(false);
+    deviceTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    deviceTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    controlLayout->addWidget(deviceTable, 1);
+    topLayout->addLayout(controlLayout, 1);
+
+    mainLayout->addLayout(topLayout, 1);
+
+    // 报告
+    reportView = new QPlainTextEdit();
+    reportView->setReadOnly(true);
+    reportView->setFont(QFont("Consolas", 9));
+    reportView->setPlaceholderText("执行结束后在此显示报告");
+    mainLayout->addWidget(reportView, 1);
+
+    connect(refreshButton, &QPushButton::clicked, this, &ATCampaignDialog::onRefreshPortsClicked);
+    connect(startButton, &QPushButton::clicked, this, &ATCampaignDialog::onStartClicked);
+    connect(stopButton, &QPushButton::clicked, this, &ATCampaignDialog::onStopClicked);
+    connect(saveReportButton, &QPushButton::clicked, this, &ATCampaignDialog::onSaveReportClicked);
+}
+
+void ATCampaignDialog::onRefreshPortsClicked()
+{
+    updatePortList(SerialPortRegistry::instance().rescan());
+}
+
+void ATCampaignDialog::updatePortList(const QStringList &ports)
+{
+    QStringList checkedPorts;
+    for (int i = 0; i < portList->count(); ++i) {
+        if (portList->item(i)->checkState() == Qt::Checked) {
+            checkedPorts << portList->item(i)->text();
+        }
+    }
+
+    portList->clear();
+    for (const QString &portName : ports) {
+        QListWidgetItem *item = new QListWidgetItem(portName, portList);
+        if (portName == busyPort) {
+            // 主窗口占用的串口无法再次打开
+            item->setFlags(item->flags() & ~(Qt::ItemIsUserCheckable | Qt::ItemIsEnabled));
+            item->setToolTip("已在主窗口中打开");
+        } else {
+            item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+            item->setToolTip(SerialPortRegistry::instance().describe(portName));
+            item->setCheckState(checkedPorts.contains(portName) ? Qt::Checked : Qt::Unchecked);
+        }
+    }
+}
+
+void ATCampaignDialog::onStartClicked()
+{
+    QStringList ports;
+    for (int i = 0; i < portList->count(); ++i) {
+        if (portList->item(i)->checkState() == Qt::Checked) {
+            ports << portList->item(i)->text();
+        }
+    }
+    if (ports.isEmpty()) {
+        QMessageBox::information(this, "AT 批量执行", "请至少勾选一个串口");
+        return;
+    }
+
+    bool ok = false;
+    const qint32 baudRate = baudRateCombo->currentText().toInt(&ok);
+    if (!ok || baudRate <= 0) {
+        QMessageBox::warning(this, "AT 批量执行", "波特率无效");
+        return;
+    }
+
+    deviceTable->setRowCount(0);
+    deviceRows.clear();
+    deviceCounts.clear();
+    reportView->clear();
+    for (const QString &portName : ports) {
+        const int row = deviceTable->rowCount();
+        deviceTable->insertRow(row);
+        deviceTable->setItem(row, PortColumn, new QTableWidgetItem(portName));
+        deviceTable->setItem(row, StatusColumn, new QTableWidgetItem("运行中"));
+        deviceTable->setItem(row, PassedColumn, new QTableWidgetItem("0"));
+        deviceTable->setItem(row, FailedColumn, new QTableWidgetItem("0"));
+        deviceTable->setItem(row, TimeColumn, new QTableWidgetItem("-"));
+        deviceRows.insert(portName, row);
+    }
+
+    if (!campaignRunner->start(script, ports, baudRate)) {
+        summaryLabel->setText("无法开始批量执行");
+        return;
+    }
+    summaryLabel->setText(QString("正在 %1 个串口上执行...").arg(ports.size()));
+    setRunning(true);
+}
+
+void ATCampaignDialog::onStopClicked()
+{
+    campaignRunner->stop();
+    summaryLabel->setText("正在停止...");
+}
+
+void ATCampaignDialog::onSaveReportClicked()
+{
+    const QString defaultName = QString("at_campaign_%1.txt").arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"));
+    const QString filePath = QFileDialog::getSaveFileName(this, "保存报告", defaultName, "文本文件 (*.txt);;所有文件 (*)");
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QMessageBox::warning(this, "保存报告", QString("无法写入文件: %1").arg(file.errorString()));
+        return;
+    }
+    file.write(reportView->toPlainText().toUtf8());
+}
+
+void ATCampaignDialog::onDeviceCommandFinished(const QString &portName, const ATCommandResult &result)
+{
+    const int row = deviceRows.value(portName, -1);
+    if (row < 0) {
+        return;
+    }
+
+    QPair<int, int> &counts = deviceCounts[portName];
+    result.ok() ? ++counts.first : ++counts.second;
+    deviceTable->item(row, PassedColumn)->setText(QString::number(counts.first));
+    deviceTable->item(row, FailedColumn)->setText(QString::number(counts.second));
+}
+
+void ATCampaignDialog::onDeviceFinished(const ATCampaignDeviceReport &report)
+{
+    const int row = deviceRows.value(report.portName, -1);
+    if (row < 0) {
+        return;
+    }
+
+    QString status = report.ok() ? "PASS" : "FAIL";
+    if (!report.opened) {
+        status = "无法打开";
+    } else if (report.aborted) {
+        status += "（提前结束）";
+    }
+
+    QTableWidgetItem *statusItem = deviceTable->item(row, StatusColumn);
+    statusItem->setText(status);
+    statusItem->setForeground(report.ok() ? QColor("#4CAF50") : QColor("#F44336"));
+    statusItem->setToolTip(report.error);
+    deviceTable->item(row, PassedColumn)->setText(QString::number(report.passed));
+    deviceTable->item(row, FailedColumn)->setText(QString::number(report.failed));
+    deviceTable->item(row, TimeColumn)->setText(QString::number(report.wallMs));
+}
+
+void ATCampaignDialog::onCampaignFinished(const ATCampaignReport &report)
+{
+    setRunning(false);
+    reportView->setPlainText(report.toText());
+    saveReportButton->setEnabled(true);
+    summaryLabel->setText(QString("完成: %1/%2 台通过，总耗时 %3 ms")
+        .arg(report.passedDevices())
+        .arg(report.devices.size())
+        .arg(report.wallMs));
+}
+
+void ATCampaignDialog::setRunning(bool running)
+{
+    startButton->setEnabled(!running);
+    stopButton->setEnabled(running);
+    refreshButton->setEnabled(!running);
+    portList->setEnabled(!running);
+    baudRateCombo->setEnabled(!running);
+}
+
+void ATCampaignDialog::closeEvent(QCloseEvent *event)
+{
+    if (campaignRunner->isRunning()) {
+        if (QMessageBox::question(this, "AT 批量执行", "批量执行尚未结束，确定中止并关闭吗？") != QMessageBox::Yes) {
+            event->ignore();
+            return;
+        }
+        campaignRunner->stop();
+    }
+    QDialog::closeEvent(event);
+}
@@ -0,0 +1,303 @@
+#include "dissector_dialog.h"
+#include "dissector_host.h"
+
+#include <QAbstractTableModel>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QSplitter>
+#include <QHeaderView>
+#include <QScrollBar>
+#include <QPushButton>
+#include <QSettings>
+#include <QDateTime>
+#include <QColor>
+#include <deque>
+
+/**
+ * @brief 最近若干条解析记录的表格模型，超出容量时丢弃最旧的记录
+ */
+class DissectorRecordModel : public QAbstractTableModel {
+public:
+    enum Column { TimeColumn, DissectorColumn, SummaryColumn, ColumnCount };
+
+    struct Entry {
+        QString dissector;
+        DissectedRecord record;
+    };
+
+    static constexpr int kMaxRecords = 20000;
+
+    explicit DissectorRecordModel(QObject *parent = nullptr)
+        : QAbstractTableModel(parent)
+    {
+    }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : int(entries.size());
+    }
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : ColumnCount;
+    }
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const override
+    {
+        if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+            return QVariant();
+        }
+        switch (section) {
+            case TimeColumn:      return "时间";
+            case DissectorColumn: return "解析器";
+            case SummaryColumn:   return "摘要";
+            default:              return QVariant();
+        }
+    }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        if (!index.isValid() || index.row() >= int(entries.size())) {
+            return QVariant();
+        }
+        const Entry &entry = entries[size_t(index.row())];
+
+        if (role == Qt::ForegroundRole) {
+            return entry.record.error ? QVariant(QColor("#dc3545")) : QVariant();
+        }
+        if (role != Qt::DisplayRole) {
+            return QVariant();
+        }
+
+        switch (index.column()) {
+            case TimeColumn:
+                return QDateTime::fromMSecsSinceEpoch(entry.record.timestampMs).toString("hh:mm:ss.zzz");
+            case DissectorColumn:
+                return entry.dissector;
+            case SummaryColumn:
+                return entry.record.summary;
+            default:
+                return QVariant();
+        }
+    }
+
+    const Entry *entryAt(int row) const
+    {
+        return row >= 0 && row < int(entries.size()) ? &entries[size_t(row)] : nullptr;
+    }
+
+    void appendRecords(const QString &dissector, const QList<DissectedRecord> &batch)
+    {
+        if (batch.isEmpty()) {
+            return;
+        }
+
+        // 一批超过容量时只保留其尾部
+        const int incoming = qMin(int(batch.size()), kMaxRecords);
+        const int overflow = int(entries.size()) + incoming - kMaxRecords;
+        if (overflow > 0) {
+            beginRemoveRows(QModelIndex(), 0, overflow - 1);
+            entries.erase(entries.begin(), entries.begin() + overflow);
+            endRemoveRows();
+        }
+
+        const int first = int(entries.size());
+        beginInsertRows(QModelIndex(), first, first + incoming - 1);
+        for (int i = int(batch.size()) - incoming; i < batch.size(); ++i) {
+            entries.push_back(Entry{dissector, batch.at(i)});
+        }
+        endInsertRows();
+    }
+
+    void clear()
+    {
+        beginResetModel();
+        entries.clear();
+        endResetModel();
+    }
+
+private:
+    std::deque<Entry> entries;
+};
+
+DissectorDialog::DissectorDialog(QWidget *parent)
+    : QDialog(parent)
+    , host(new DissectorHost(this))
+    , model(new DissectorRecordModel(this))
+{
+    setWindowTitle("协议解析");
+    resize(1100, 650);
+
+    host->loadPlugins(DissectorHost::defaultPluginDirectory());
+
+    setupUI();
+    populateDissectors();
+    updateStats();
+
+    connect(host, &DissectorHost::recordsReady, this, &DissectorDialog::onRecordsReady);
+    connect(&statsTimer, &QTimer::timeout, this, &DissectorDialog::updateStats);
+    statsTimer.start(500);
+}
+
+DissectorDialog::~DissectorDialog()
+{
+}
+
+void DissectorDialog::setupUI()
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    QHBoxLayout *toolLayout = new QHBoxLayout();
+    pauseCheck = new QCheckBox("暂停显示");
+    pauseCheck->setToolTip("暂停时仍然解析和计数，只是不追加到表格");
+    toolLayout->addWidget(pauseCheck);
+    QPushButton *clearButton = new QPushButton("清空");
+    connect(clearButton, &QPushButton::clicked, this, &DissectorDialog::onClearClicked);
+    toolLayout->addWidget(clearButton);
+    toolLayout->addStretch();
+    pluginLabel = new QLabel();
+    toolLayout->addWidget(pluginLabel);
+    mainLayout->addLayout(toolLayout);
+
+    QSplitter *splitter = new QSplitter(Qt::Horizontal);
+
+    dissectorList = new QListWidget();
+    connect(dissectorList, &QListWidget::itemChanged, this, &DissectorDialog::onDissectorItemChanged);
+    splitter->addWidget(dissectorList);
+
+    recordView = new QTableView();
+    recordView->setModel(model);
+    recordView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    recordView->setSelectionMode(QAbstractItemView::SingleSelection);
+    recordView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    recordView->setWordWrap(false);
+    recordView->verticalHeader()->setVisible(false);
+    recordView->verticalHeader()->setDefaultSectionSize(22);
+    recordView->horizontalHeader()->setStretchLastSection(true);
+    recordView->setColumnWidth(DissectorRecordModel::TimeColumn, 100);
+    recordView->setColumnWidth(DissectorRecordModel::DissectorColumn, 110);
+    connect(recordView->selectionModel(), &QItemSelectionModel::currentRowChanged,
+            this, &DissectorDialog::onCurrentRecordChanged);
+    splitter->addWidget(recordView);
+
+    fieldTree = new QTreeWidget();
+    fieldTree->setHeaderLabels({"字段", "值", "偏移", "长度"});
+    fieldTree->setRootIsDecorated(false);
+    fieldTree->setColumnWidth(0, 120);
+    fieldTree->setColumnWidth(1, 140);
+    splitter->addWidget(fieldTree);
+
+    splitter->setStretchFactor(0, 0);
+    splitter->setStretchFactor(1, 3);
+    splitter->setStretchFactor(2, 2);
+    splitter->setSizes({180, 560, 360});
+    mainLayout->addWidget(splitter, 1);
+
+    statsLabel = new QLabel();
+    mainLayout->addWidget(statsLabel);
+}
+
+void DissectorDialog::populateDissectors()
+{
+    QSettings settings("SCOM-X", "SCOM-X");
+    const QStringList enabled = settings.value("dissectors/enabled").toStringList();
+
+    const QSignalBlocker blocker(dissectorList);
+    for (const QString &name : host->availableDissectors()) {
+        QListWidgetItem *item = new QListWidgetItem(name, dissectorList);
+        item->setToolTip(host->description(name));
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        const bool on = enabled.contains(name);
+        item->setCheckState(on ? Qt::Checked : Qt::Unchecked);
+        host->setEnabled(name, on);
+    }
+
+    const QStringList errors = host->loadErrors();
+    if (host->availableDissectors().isEmpty()) {
+        pluginLabel->setText(QString("未找到解析插件: %1").arg(DissectorHost::defaultPluginDirectory()));
+    } else {
+        pluginLabel->setText(QString("插件目录: %1").arg(DissectorHost::defaultPluginDirectory()));
+    }
+    if (!errors.isEmpty()) {
+        pluginLabel->setText(pluginLabel->text() + QString("（%1 个加载失败）").arg(errors.size()));
+        pluginLabel->setToolTip(errors.join('\n'));
+    }
+}
+
+void DissectorDialog::saveEnabled()
+{
+    QSettings settings("SCOM-X", "SCOM-X");
+    settings.setValue("dissectors/enabled", host->enabledDissectors());
+}
+
+void DissectorDialog::feed(const QByteArray &data)
+{
+    host->feed(data);
+}
+
+void DissectorDialog::resetStream()
+{
+    host->reset();
+}
+
+void DissectorDialog::onRecordsReady(const QString &dissector, const QList<DissectedRecord> &records)
+{
+    if (pauseCheck->isChecked()) {
+        return;
+    }
+
+    QScrollBar *scrollBar = recordView->verticalScrollBar();
+    const bool atBottom = scrollBar->value() >= scrollBar->maximum();
+    model->appendRecords(dissector, records);
+    if (atBottom) {
+        recordView->scrollToBottom();
+    }
+}
+
+void DissectorDialog::onDissectorItemChanged(QListWidgetItem *item)
+{
+    host->setEnabled(item->text(), item->checkState() == Qt::Checked);
+    saveEnabled();
+    updateStats();
+}
+
+void DissectorDialog::onCurrentRecordChanged()
+{
+    fieldTree->clear();
+    const DissectorRecordModel::Entry *entry = model->entryAt(recordView->currentIndex().row());
+    if (!entry) {
+        return;
+    }
+
+    for (const DissectorField &field : entry->record.fields) {
+        QTreeWidgetItem *item = new QTreeWidgetItem(fieldTree);
+        item->setText(0, field.name);
+        item->setText(1, field.value.toString());
+        if (field.offset >= 0) {
+            item->setText(2, QString::number(field.offset));
+            item->setText(3, QString::number(field.length));
+        }
+    }
+}
+
+void DissectorDialog::onClearClicked()
+{
+    model->clear();
+    fieldTree->clear();
+}
+
+void DissectorDialog::updateStats()
+{
+    QStringList parts;
+    for (const DissectorStats &stats : host->stats()) {
+        QString part = QString("%1: %2 条").arg(stats.name).arg(stats.records);
+        if (stats.queuedBytes > 0) {
+            part += QString(" 排队 %1 KB").arg(stats.queuedBytes / 1024);
+        }
+        if (stats.droppedChunks > 0) {
+            part += QString(" 丢弃 %1 块").arg(stats.droppedChunks);
+        }
+        parts << part;
+    }
+    statsLabel->setText(parts.isEmpty() ? QString("未启用解析器") : parts.join("    "));
+}
@@ -1,5 +1,9 @@
 #include "log_viewer_dialog.h"
-#include "operation_logger.h"
+#include "async_log_writer.h"
+#include "log_manager.h"
+#include "log_filter_bar.h"
+#include "log_segments.h"
+#include "log_file_view.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -12,32 +16,62 @@
 #include <QTextStream>
 #include <QApplication>
 #include <QTabWidget>
+#include <QFileInfo>
+#include <QScrollBar>
+#include <QShowEvent>
 
 LogViewerDialog::LogViewerDialog(QWidget *parent)
     : QDialog(parent)
 {
     // 设置日志文件路径
-    debugLogFilePath = QString("%1/.config/SCOM-X/debug.log").arg(QDir::homePath());
-    operationLogFilePath = QString("%1/.config/SCOM-X/operation.log").arg(QDir::homePath());
+    // 调试日志即统一日志管线写入的应用日志
+    debugTail.filePath = LogManager::instance().getLogFilePath();
+    operationTail.filePath = QString("%1/.config/SCOM-X/operation.log").arg(QDir::homePath());
 
     setWindowTitle("程序日志");
     setGeometry(200, 200, 1000, 700);
     
     setupUI();
+    debugTail.display = debugLogDisplay;
+    debugTail.filterBar = debugFilterBar;
+    debugTail.searchEngine = new LogSearchEngine(this);
+    operationTail.display = operationLogDisplay;
+    operationTail.filterBar = operationFilterBar;
+    operationTail.searchEngine = new LogSearchEngine(this);
+    connectSearchEngine(debugTail);
+    connectSearchEngine(operationTail);
     loadLogsFromFile();
     
-    // 连接操作日志信号
-    connect(&OperationLogger::instance(), &OperationLogger::logMessageAdded, 
-            this, &LogViewerDialog::onLogMessageAdded);
+    // 文件变化驱动的增量读取：只读新追加的字节，只过滤新行
+    connect(&fileWatcher, &QFileSystemWatcher::fileChanged, this, &LogViewerDialog::onLogFileChanged);
+    connect(&fileWatcher, &QFileSystemWatcher::directoryChanged, this, &LogViewerDialog::onLogFileChanged);
+    changeDebounceTimer.setSingleShot(true);
+    changeDebounceTimer.setInterval(100);
+    connect(&changeDebounceTimer, &QTimer::timeout, this, &LogViewerDialog::updateLogDisplay);
+    watchLogFiles();
     
-    // 设置自动刷新（每1秒检查一次日志更新）
+    // 兜底轮询：文件大小未变化时不做任何读取
     connect(&refreshTimer, &QTimer::timeout, this, &LogViewerDialog::updateLogDisplay);
-    refreshTimer.start(1000);
+    refreshTimer.start(2000);
+    
+    // 实时日志统计（来自 LogManager 原子计数，不读磁盘）
+    connect(&statsTimer, &QTimer::timeout, this, &LogViewerDialog::updateLogStats);
+    statsTimer.start(1000);
+    updateLogStats();
 }
 
 LogViewerDialog::~LogViewerDialog()
 {
     refreshTimer.stop();
+    changeDebounceTimer.stop();
+    statsTimer.stop();
+}
+
+void LogViewerDialog::showEvent(QShowEvent *event)
+{
+    QDialog::showEvent(event);
+    // 隐藏期间不读取文件，重新显示时补齐
+    updateLogDisplay();
 }
 
 void LogViewerDialog::setupUI()
@@ -74,6 +108,11 @@ void LogViewerDialog::setupUI()
     toolbarLayout->addWidget(clearButton);
     toolbarLayout->addWidget(exportButton);
 
+    largeFileButton = new QPushButton("大文件模式");
+    largeFileButton->setToolTip("后台建立行索引，只读取和渲染可见行，适合查看数百 MB 以上的日志");
+    connect(largeFileButton, &QPushButton::clicked, this, &LogViewerDialog::onLargeFileModeClicked);
+    toolbarLayout->addWidget(largeFileButton);
+
     mainLayout->addLayout(toolbarLayout);
 
     // 标签页用于显示不同类型的日志
@@ -86,14 +125,14 @@ void LogViewerDialog::setupUI()
     
     QHBoxLayout *debugSearchLayout = new QHBoxLayout();
     QLabel *debugSearchLabel = new QLabel("搜索调试日志:");
-    debugSearchLineEdit = new QLineEdit();
-    debugSearchLineEdit->setPlaceholderText("输入关键词...");
+    debugFilterBar = new LogFilterBar();
     debugSearchLayout->addWidget(debugSearchLabel);
-    debugSearchLayout->addWidget(debugSearchLineEdit);
+    debugSearchLayout->addWidget(debugFilterBar, 1);
     debugLogLayout->addLayout(debugSearchLayout);
     
     debugLogDisplay = new QPlainTextEdit();
     debugLogDisplay->setReadOnly(true);
+    debugLogDisplay->setMaximumBlockCount(kMaxDisplayLines);
     debugLogDisplay->setFont(QFont("Consolas", 10));
     debugLogDisplay->setStyleSheet(
         "QPlainTextEdit {"
@@ -104,8 +143,8 @@ void LogViewerDialog::setupUI()
     );
     debugLogLayout->addWidget(debugLogDisplay, 1);
     
-    connect(debugSearchLineEdit, &QLineEdit::textChanged, this, [this]() {
-        applySearchFilter();
+    connect(debugFilterBar, &LogFilterBar::queryChanged, this, [this]() {
+        applyTailFilter(debugTail);
     });
 
     tabWidget->addTab(debugLogTab, "调试日志");
@@ -117,12 +156,9 @@ void LogViewerDialog::setupUI()
     
     QHBoxLayout *operationSearchLayout = new QHBoxLayout();
     QLabel *operationSearchLabel = new QLabel("搜索操作日志:");
-    operationSearchLineEdit = new QLineEdit();
-    operationSearchLineEdit->setPlaceholderText("输入关键词...");
-    operationSearchLineEdit->setMaximumWidth(400);
+    operationFilterBar = new LogFilterBar();
     operationSearchLayout->addWidget(operationSearchLabel);
-    operationSearchLayout->addWidget(operationSearchLineEdit);
-    operationSearchLayout->addStretch();
+    operationSearchLayout->addWidget(operationFilterBar, 1);
     
     operationAutoScrollCheckBox = new QCheckBox("自动滚动");
     operationAutoScrollCheckBox->setChecked(true);
@@ -132,6 +168,7 @@ void LogViewerDialog::setupUI()
     
     operationLogDisplay = new QPlainTextEdit();
     operationLogDisplay->setReadOnly(true);
+    operationLogDisplay->setMaximumBlockCount(kMaxDisplayLines);
     operationLogDisplay->setFont(QFont("Consolas", 10));
     operationLogDisplay->setStyleSheet(
         "QPlainTextEdit {"
@@ -142,8 +179,8 @@ void LogViewerDialog::setupUI()
     );
     operationLogLayout->addWidget(operationLogDisplay, 1);
     
-    connect(operationSearchLineEdit, &QLineEdit::textChanged, this, [this]() {
-        applySearchFilter();
+    connect(operationFilterBar, &LogFilterBar::queryChanged, this, [this]() {
+        applyTailFilter(operationTail);
     });
 
     tabWidget->addTab(operationLogTab, "操作日志");
@@ -155,6 +192,8 @@ void LogViewerDialog::setupUI()
     statusLabel = new QLabel("就绪");
     statusLayout->addWidget(statusLabel);
     statusLayout->addStretch();
+    logStatsLabel = new QLabel();
+    statusLayout->addWidget(logStatsLabel);
     mainLayout->addLayout(statusLayout);
 
     // 关闭按钮
@@ -171,78 +210,307 @@ void LogViewerDialog::setupUI()
 
 void LogViewerDialog::loadLogsFromFile()
 {
-    // 加载调试日志
-    QFile debugFile(debugLogFilePath);
-    if (!debugFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        statusLabel->setText(QString("无法打开调试日志: %1").arg(debugLogFilePath));
-        return;
+    bool partialLoad = false;
+    for (LogTail *tail : {&debugTail, &operationTail}) {
+        resetTail(*tail);
+        tail->searchActive = false;
+
+        // 大文件只加载末尾，避免把整个文件塞进 QPlainTextEdit
+        const qint64 size = QFileInfo(tail->filePath).size();
+        if (size > kFullLoadLimit) {
+            tail->offset = size - kPartialLoadBytes;
+            tail->skipToLineStart = true;
+            partialLoad = true;
+        }
     }
 
-    QTextStream debugIn(&debugFile);
-    debugIn.setEncoding(QStringConverter::Utf8);
-    allDebugLogsContent = debugIn.readAll();
-    debugFile.close();
-
-    // 加载操作日志
-    QFile operationFile(operationLogFilePath);
-    if (operationFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream operationIn(&operationFile);
-        operationIn.setEncoding(QStringConverter::Utf8);
-        allOperationLogsContent = operationIn.readAll();
-        operationFile.close();
+    if (!readAppended(debugTail) && !QFileInfo::exists(debugTail.filePath)) {
+        statusLabel->setText(QString("无法打开调试日志: %1").arg(debugTail.filePath));
     }
+    readAppended(operationTail);
 
-    updateLogDisplay();
+    if (partialLoad) {
+        statusLabel->setText(QString("日志较大，仅显示最后 %1 MB，完整内容请使用大文件模式")
+                             .arg(kPartialLoadBytes / (1024 * 1024)));
+    }
+
+    // 有过滤条件时在后台重新搜索，而不是在 GUI 线程上逐行过滤整个文件
+    for (LogTail *tail : {&debugTail, &operationTail}) {
+        if (!tail->filterBar->query().isEmpty()) {
+            applyTailFilter(*tail);
+        }
+    }
+}
+
+void LogViewerDialog::watchLogFiles()
+{
+    // 文件被删除或重建后监视会失效，同时监视所在目录以便重新挂上
+    for (const LogTail *tail : {&debugTail, &operationTail}) {
+        const QFileInfo info(tail->filePath);
+        if (info.exists() && !fileWatcher.files().contains(tail->filePath)) {
+            fileWatcher.addPath(tail->filePath);
+        }
+        const QString dirPath = info.absolutePath();
+        if (QFileInfo::exists(dirPath) && !fileWatcher.directories().contains(dirPath)) {
+            fileWatcher.addPath(dirPath);
+        }
+    }
+}
+
+void LogViewerDialog::onLogFileChanged(const QString &path)
+{
+    Q_UNUSED(path);
+    if (!changeDebounceTimer.isActive()) {
+        changeDebounceTimer.start();
+    }
 }
 
 void LogViewerDialog::updateLogDisplay()
 {
-    applySearchFilter();
+    if (!isVisible()) {
+        return;
+    }
+
+    watchLogFiles();
+    readAppended(debugTail);
+    readAppended(operationTail);
 }
 
-void LogViewerDialog::applySearchFilter()
+void LogViewerDialog::updateLogStats()
+{
+    logStatsLabel->setText(LogManager::instance().getStats().summary());
+}
+
+void LogViewerDialog::resetTail(LogTail &tail)
 {
-    // 处理调试日志搜索
-    QString debugSearchText = debugSearchLineEdit->text();
+    tail.offset = 0;
+    tail.partialLine.clear();
+    tail.skipToLineStart = false;
+    tail.head.clear();
+    tail.content.clear();
+    tail.display->clear();
     
-    if (debugSearchText.isEmpty()) {
-        debugLogDisplay->setPlainText(allDebugLogsContent);
-    } else {
-        QStringList filteredLines;
-        const QStringList &lines = allDebugLogsContent.split('\n');
-        
-        for (const QString &line : lines) {
-            if (line.contains(debugSearchText, Qt::CaseInsensitive)) {
-                filteredLines.append(line);
+    // 文件从头开始，旧搜索的范围已失效；新行继续按当前条件过滤
+    tail.searchEngine->cancel();
+    tail.searchMatchCount = 0;
+    tail.heldLines.clear();
+}
+
+bool LogViewerDialog::readAppended(LogTail &tail)
+{
+    // 注意：此处不能输出日志，否则每次读取都会让应用日志再次变化
+    QFile file(tail.filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 size = file.size();
+    const QByteArray head = file.read(qMin<qint64>(kTailHeadLength, size));
+    const quint64 rotations = AsyncLogWriter::instance().rotationCount();
+
+    if (size < tail.offset || !head.startsWith(tail.head)) {
+        if (rotations != tail.rotationsSeen && tail.offset > 0) {
+            // 写入器轮转了文件（两次读取之间可能不止一次）：保留已显示内容，
+            // 补上正在跟踪的分段中尚未读取的尾部和之后的每个分段，再从新文件开头继续
+            const QStringList rotated = LogSegments::rotatedSegments(tail.filePath);
+            QList<QByteArray> newer;  // 比跟踪的分段新的分段，从旧到新
+            for (int i = int(rotated.size()) - 1; i >= 0; --i) {
+                QByteArray data = LogSegments::readAll(rotated.at(i));
+                if (data.startsWith(tail.head)) {
+                    consumeBytes(tail, data.mid(tail.offset));
+                    break;
+                }
+                newer.prepend(std::move(data));
+            }
+            // 找不到说明跟踪的分段已被清理；清理从最旧的开始，剩下的都比它新
+            for (QByteArray &data : newer) {
+                tail.partialLine.clear();
+                consumeBytes(tail, std::move(data));
             }
+            tail.offset = 0;
+            tail.partialLine.clear();
+            tail.head.clear();  // 下面改为记录新活动文件的开头
+        } else {
+            // 文件被截断或替换，从头重新读取
+            resetTail(tail);
         }
-        
-        debugLogDisplay->setPlainText(filteredLines.join('\n'));
+    }
+    tail.rotationsSeen = rotations;
+    if (tail.head.size() < kTailHeadLength) {
+        tail.head = head;
     }
 
-    // 处理操作日志搜索
-    QString operationSearchText = operationSearchLineEdit->text();
-    
-    if (operationSearchText.isEmpty()) {
-        operationLogDisplay->setPlainText(allOperationLogsContent);
-    } else {
+    if (size == tail.offset) {
+        return true;
+    }
+
+    if (!file.seek(tail.offset)) {
+        return false;
+    }
+    QByteArray chunk = file.read(size - tail.offset);
+    file.close();
+    tail.offset += chunk.size();
+
+    consumeBytes(tail, std::move(chunk));
+    return true;
+}
+
+void LogViewerDialog::consumeBytes(LogTail &tail, QByteArray chunk)
+{
+    if (tail.skipToLineStart) {
+        const int newline = chunk.indexOf('\n');
+        if (newline < 0) {
+            return;
+        }
+        chunk.remove(0, newline + 1);
+        tail.skipToLineStart = false;
+    }
+
+    // 只处理完整的行，最后不完整的部分留到下次拼接（也保证不会切断 UTF-8 字符）
+    if (!tail.partialLine.isEmpty()) {
+        chunk.prepend(tail.partialLine);
+        tail.partialLine.clear();
+    }
+    const int lastNewline = chunk.lastIndexOf('\n');
+    if (lastNewline < 0) {
+        tail.partialLine = chunk;
+        return;
+    }
+    tail.partialLine = chunk.mid(lastNewline + 1);
+    chunk.truncate(lastNewline + 1);
+
+    QString text = QString::fromUtf8(chunk);
+    text.remove('\r');
+    tail.content.append(text);
+    if (tail.content.size() > 2 * kRetainedChars) {
+        // 成批丢弃，避免每次追加都移动整个缓冲；从行首开始保留
+        const int newline = tail.content.indexOf('\n', tail.content.size() - kRetainedChars);
+        tail.content.remove(0, newline + 1);
+    }
+
+    // 只对新行应用过滤
+    QStringList newLines = text.split('\n');
+    newLines.removeLast();  // 末尾换行产生的空串
+    if (tail.searchActive) {
         QStringList filteredLines;
-        const QStringList &lines = allOperationLogsContent.split('\n');
-        
-        for (const QString &line : lines) {
-            if (line.contains(operationSearchText, Qt::CaseInsensitive)) {
+        for (const QString &line : std::as_const(newLines)) {
+            if (tail.matcher.matches(line)) {
                 filteredLines.append(line);
             }
         }
+        newLines.swap(filteredLines);
+        tail.searchMatchCount += newLines.size();
         
-        operationLogDisplay->setPlainText(filteredLines.join('\n'));
+        if (tail.searchEngine->isRunning()) {
+            // 等后台搜索结果全部到达后再追加，保持文件顺序
+            tail.heldLines.append(newLines);
+            return;
+        }
+    }
+
+    appendTailLines(tail, newLines);
+}
+
+void LogViewerDialog::appendTailLines(LogTail &tail, const QStringList &lines)
+{
+    if (lines.isEmpty()) {
+        return;
+    }
+
+    QScrollBar *scrollBar = tail.display->verticalScrollBar();
+    const bool atBottom = scrollBar->value() == scrollBar->maximum();
+    const int scrollValue = scrollBar->value();
+
+    tail.display->appendPlainText(lines.join('\n'));
+
+    if (atBottom || (tail.display == operationLogDisplay
+                     && operationAutoScrollCheckBox->isChecked())) {
+        scrollToEnd(tail.display);
+    } else {
+        // 用户正在查看历史内容，保持原位置不跳动
+        scrollBar->setValue(scrollValue);
+    }
+}
+
+void LogViewerDialog::connectSearchEngine(LogTail &tail)
+{
+    LogTail *tailPtr = &tail;
+    connect(tail.searchEngine, &LogSearchEngine::resultsReady, this,
+            [this, tailPtr](quint64 generation, const QStringList &lines) {
+        if (generation != tailPtr->searchGeneration) {
+            return;
+        }
+        tailPtr->searchMatchCount += lines.size();
+        appendTailLines(*tailPtr, lines);
+        statusLabel->setText(QString("搜索中... 已找到 %1 条").arg(tailPtr->searchMatchCount));
+    });
+    connect(tail.searchEngine, &LogSearchEngine::finished, this,
+            [this, tailPtr](quint64 generation, int matchCount, bool truncated) {
+        if (generation != tailPtr->searchGeneration) {
+            return;
+        }
+        Q_UNUSED(matchCount);
+        appendTailLines(*tailPtr, tailPtr->heldLines);
+        tailPtr->heldLines.clear();
+        statusLabel->setText(truncated
+            ? QString("找到 %1 条匹配（已达上限，请缩小搜索范围）").arg(tailPtr->searchMatchCount)
+            : QString("找到 %1 条匹配").arg(tailPtr->searchMatchCount));
+    });
+}
+
+void LogViewerDialog::scrollToEnd(QPlainTextEdit *display)
+{
+    QTextCursor cursor = display->textCursor();
+    cursor.movePosition(QTextCursor::End);
+    display->setTextCursor(cursor);
+}
+
+void LogViewerDialog::applyTailFilter(LogTail &tail)
+{
+    const LogSearchQuery query = tail.filterBar->query();
+
+    if (query.isEmpty()) {
+        tail.searchEngine->cancel();
+        tail.searchActive = false;
+        tail.heldLines.clear();
+        // 只在清除过滤时整体恢复一次；content 有上限，不随运行时间增长
+        tail.display->setPlainText(tail.content);
+        scrollToEnd(tail.display);
+        return;
+    }
+
+    tail.matcher = LogLineMatcher(query);
+    if (!tail.matcher.isValid()) {
+        tail.searchEngine->cancel();
+        statusLabel->setText(QString("正则表达式错误: %1").arg(tail.matcher.errorString()));
+        return;
+    }
+
+    // 在后台线程池中搜索已读取的部分，结果按文件顺序流式追加
+    tail.searchActive = true;
+    tail.searchMatchCount = 0;
+    tail.heldLines.clear();
+    tail.display->clear();
+    statusLabel->setText("搜索中...");
+
+    // 已轮转的分段（含压缩分段）完整搜索，活动文件只搜索到已读取的位置
+    QVector<LogSearchSource> sources;
+    for (const QString &segment : LogSegments::rotatedSegments(tail.filePath)) {
+        sources.append(LogSearchSource{segment, -1});
     }
+    sources.append(LogSearchSource{tail.filePath, tail.offset - tail.partialLine.size()});
+    tail.searchGeneration = tail.searchEngine->start(sources, query);
+}
+
+void LogViewerDialog::applySearchFilter()
+{
+    // 仅在搜索条件变化时整体重新过滤
+    applyTailFilter(debugTail);
+    applyTailFilter(operationTail);
 
     // 自动滚动到底部
     if (operationAutoScrollCheckBox && operationAutoScrollCheckBox->isChecked()) {
-        QTextCursor cursor = operationLogDisplay->textCursor();
-        cursor.movePosition(QTextCursor::End);
-        operationLogDisplay->setTextCursor(cursor);
+        scrollToEnd(operationLogDisplay);
     }
 }
 
@@ -274,21 +542,15 @@ void LogViewerDialog::onClearClicked()
     
     if (reply == QMessageBox::Yes) {
         // 清空调试日志
-        QFile debugFile(debugLogFilePath);
-        if (debugFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            debugFile.close();
-        }
+        AsyncLogWriter::instance().truncate(debugTail.filePath);
+        LogSegments::removeRotated(debugTail.filePath);
         
-        // 清空操作日志
-        QFile operationFile(operationLogFilePath);
-        if (operationFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            operationFile.close();
-        }
+        // 清空操作日志（写入器持有该文件，由它先落盘再截断）
+        AsyncLogWriter::instance().truncate(operationTail.filePath);
+        LogSegments::removeRotated(operationTail.filePath);
         
-        allDebugLogsContent.clear();
-        allOperationLogsContent.clear();
-        debugLogDisplay->clear();
-        operationLogDisplay->clear();
+        resetTail(debugTail);
+        resetTail(operationTail);
         statusLabel->setText("已清空日志");
     }
 }
@@ -312,9 +574,9 @@ void LogViewerDialog::onExportClicked()
             out.setEncoding(QStringConverter::Utf8);
             
             if (currentTab == 0) {
-                out << allDebugLogsContent;
+                out << debugTail.content;
             } else {
-                out << allOperationLogsContent;
+                out << operationTail.content;
             }
             
             file.close();
@@ -326,6 +588,52 @@ void LogViewerDialog::onExportClicked()
     }
 }
 
+void LogViewerDialog::onLargeFileModeClicked()
+{
+    const LogTail &tail = tabWidget->currentIndex() == 0 ? debugTail : operationTail;
+    AsyncLogWriter::instance().flush();
+
+    QDialog *dialog = new QDialog(this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->setWindowTitle(QString("大文件模式 - %1").arg(QFileInfo(tail.filePath).fileName()));
+    dialog->resize(1000, 700);
+
+    QVBoxLayout *layout = new QVBoxLayout(dialog);
+    LogFileView *view = new LogFileView(dialog);
+    layout->addWidget(view, 1);
+
+    QHBoxLayout *bottomLayout = new QHBoxLayout();
+    QLabel *infoLabel = new QLabel(dialog);
+    QCheckBox *followCheckBox = new QCheckBox("跟随末尾", dialog);
+    QPushButton *reloadButton = new QPushButton("刷新", dialog);
+    reloadButton->setMaximumWidth(80);
+    bottomLayout->addWidget(infoLabel, 1);
+    bottomLayout->addWidget(followCheckBox);
+    bottomLayout->addWidget(reloadButton);
+    layout->addLayout(bottomLayout);
+
+    connect(view, &LogFileView::indexProgress, infoLabel, [infoLabel](qint64 indexedBytes, qint64 totalBytes, qint64 lineCount) {
+        const int percent = totalBytes > 0 ? static_cast<int>(indexedBytes * 100 / totalBytes) : 100;
+        infoLabel->setText(QString("正在建立行索引... %1%，已索引 %2 行").arg(percent).arg(lineCount));
+    });
+    connect(view, &LogFileView::indexFinished, infoLabel, [infoLabel, view](qint64 lineCount) {
+        infoLabel->setText(QString("%1 行，%2 MB")
+                           .arg(lineCount)
+                           .arg(QString::number(view->fileSize() / (1024.0 * 1024.0), 'f', 1)));
+    });
+    connect(followCheckBox, &QCheckBox::toggled, view, &LogFileView::setFollowTail);
+    connect(reloadButton, &QPushButton::clicked, view, [view]() {
+        AsyncLogWriter::instance().flush();
+        view->reload();
+    });
+
+    // 活动日志仍在写入、可能被"清空"截断，不做内存映射
+    if (!view->openFile(tail.filePath, true)) {
+        infoLabel->setText(QString("无法打开 %1: %2").arg(tail.filePath, view->errorString()));
+    }
+    dialog->show();
+}
+
 void LogViewerDialog::onSearchChanged()
 {
     applySearchFilter();
@@ -340,20 +648,12 @@ void LogViewerDialog::onAutoScrollToggled(bool checked)
     }
 }
 
-void LogViewerDialog::onLogMessageAdded(const QString &message)
-{
-    allOperationLogsContent.append(message + "\n");
-    
-    if (tabWidget->currentIndex() == 1) {  // 如果当前在操作日志标签
-        addLogMessage(message);
-    }
-}
-
 void LogViewerDialog::clear()
 {
+    // 只清空显示，偏移保持不变，之后仍只显示新追加的内容
     debugLogDisplay->clear();
     operationLogDisplay->clear();
-    allDebugLogsContent.clear();
-    allOperationLogsContent.clear();
+    debugTail.content.clear();
+    operationTail.content.clear();
     statusLabel->setText("已清空日志");
 }
@@ -0,0 +1,248 @@
+#include "modbus_monitor_dialog.h"
+#include "modbus_rtu_decoder.h"
+
+#include <QAbstractTableModel>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QScrollBar>
+#include <QPushButton>
+#include <QDateTime>
+#include <QColor>
+#include <deque>
+
+/**
+ * @brief 最近若干帧的表格模型，超出容量时丢弃最旧的帧
+ */
+class ModbusFrameModel : public QAbstractTableModel {
+public:
+    enum Column { TimeColumn, SlaveColumn, FunctionColumn, KindColumn, LengthColumn, DetailColumn, ColumnCount };
+
+    static constexpr int kMaxFrames = 20000;
+
+    explicit ModbusFrameModel(QObject *parent = nullptr)
+        : QAbstractTableModel(parent)
+    {
+    }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : int(frames.size());
+    }
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : ColumnCount;
+    }
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const override
+    {
+        if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+            return QVariant();
+        }
+        switch (section) {
+            case TimeColumn:     return "时间";
+            case SlaveColumn:    return "从站";
+            case FunctionColumn: return "功能码";
+            case KindColumn:     return "类型";
+            case LengthColumn:   return "长度";
+            case DetailColumn:   return "解码";
+            default:             return QVariant();
+        }
+    }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        if (!index.isValid() || index.row() >= int(frames.size())) {
+            return QVariant();
+        }
+        const ModbusFrame &frame = frames[size_t(index.row())];
+
+        if (role == Qt::ForegroundRole) {
+            if (!frame.crcOk) {
+                return QColor("#dc3545");
+            }
+            if (frame.kind == ModbusFrame::Kind::Exception) {
+                return QColor("#fd7e14");
+            }
+            return QVariant();
+        }
+        if (role == Qt::ToolTipRole) {
+            return QString::fromLatin1(frame.bytes.toHex(' ').toUpper());
+        }
+        if (role != Qt::DisplayRole) {
+            return QVariant();
+        }
+
+        switch (index.column()) {
+            case TimeColumn:
+                return QDateTime::fromMSecsSinceEpoch(frame.timestampMs).toString("hh:mm:ss.zzz");
+            case SlaveColumn:
+                return frame.bytes.size() >= 1 ? QVariant(frame.slave) : QVariant();
+            case FunctionColumn:
+                return frame.bytes.size() >= 2 ? QString("%1").arg(frame.function, 2, 16, QChar('0')).toUpper() : QString();
+            case KindColumn:
+                return frame.crcOk ? ModbusRtu::kindName(frame.kind) : QString("CRC 错误");
+            case LengthColumn:
+                return int(frame.bytes.size());
+            case DetailColumn:
+                return frame.describe();
+            default:
+                return QVariant();
+        }
+    }
+
+    void appendFrames(const QVector<ModbusFrame> &batch)
+    {
+        if (batch.isEmpty()) {
+            return;
+        }
+
+        // 一批超过容量时只保留其尾部
+        const int incoming = qMin(int(batch.size()), kMaxFrames);
+        const int overflow = int(frames.size()) + incoming - kMaxFrames;
+        if (overflow > 0) {
+            beginRemoveRows(QModelIndex(), 0, overflow - 1);
+            frames.erase(frames.begin(), frames.begin() + overflow);
+            endRemoveRows();
+        }
+
+        const int first = int(frames.size());
+        beginInsertRows(QModelIndex(), first, first + incoming - 1);
+        for (int i = int(batch.size()) - incoming; i < batch.size(); ++i) {
+            frames.push_back(batch.at(i));
+        }
+        endInsertRows();
+    }
+
+    void clear()
+    {
+        beginResetModel();
+        frames.clear();
+        endResetModel();
+    }
+
+private:
+    std::deque<ModbusFrame> frames;
+};
+
+ModbusMonitorDialog::ModbusMonitorDialog(QWidget *parent)
+    : QDialog(parent)
+    , decoder(new ModbusRtuDecoder(this))
+    , model(new ModbusFrameModel(this))
+{
+    setWindowTitle("Modbus RTU 监视");
+    resize(1000, 600);
+
+    setupUI();
+    updateStats();
+
+    connect(decoder, &ModbusRtuDecoder::framesDecoded, this, &ModbusMonitorDialog::onFramesDecoded);
+}
+
+ModbusMonitorDialog::~ModbusMonitorDialog()
+{
+}
+
+void ModbusMonitorDialog::setupUI()
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    QHBoxLayout *toolLayout = new QHBoxLayout();
+    pauseCheck = new QCheckBox("暂停显示");
+    pauseCheck->setToolTip("暂停时仍然解码和计数，只是不追加到表格");
+    toolLayout->addWidget(pauseCheck);
+    errorsOnlyCheck = new QCheckBox("只显示错误与异常");
+    toolLayout->addWidget(errorsOnlyCheck);
+    QPushButton *clearButton = new QPushButton("清空");
+    connect(clearButton, &QPushButton::clicked, this, &ModbusMonitorDialog::onClearClicked);
+    toolLayout->addWidget(clearButton);
+    toolLayout->addStretch();
+    timingLabel = new QLabel();
+    toolLayout->addWidget(timingLabel);
+    mainLayout->addLayout(toolLayout);
+
+    frameView = new QTableView();
+    frameView->setModel(model);
+    frameView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    frameView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    frameView->setWordWrap(false);
+    frameView->verticalHeader()->setVisible(false);
+    frameView->verticalHeader()->setDefaultSectionSize(22);
+    frameView->horizontalHeader()->setStretchLastSection(true);
+    frameView->setColumnWidth(ModbusFrameModel::TimeColumn, 100);
+    frameView->setColumnWidth(ModbusFrameModel::SlaveColumn, 50);
+    frameView->setColumnWidth(ModbusFrameModel::FunctionColumn, 60);
+    frameView->setColumnWidth(ModbusFrameModel::KindColumn, 70);
+    frameView->setColumnWidth(ModbusFrameModel::LengthColumn, 50);
+    mainLayout->addWidget(frameView, 1);
+
+    statsLabel = new QLabel();
+    mainLayout->addWidget(statsLabel);
+}
+
+void ModbusMonitorDialog::setLineParameters(qint32 baudRate,
+                                            QSerialPort::DataBits dataBits,
+                                            QSerialPort::Parity parity,
+                                            QSerialPort::StopBits stopBits)
+{
+    decoder->setLineParameters(baudRate, dataBits, parity, stopBits);
+    timingLabel->setText(QString("%1 bps  t3.5 = %2 µs").arg(baudRate).arg(decoder->silentIntervalUs()));
+}
+
+void ModbusMonitorDialog::feed(const QByteArray &data)
+{
+    decoder->feed(data);
+}
+
+void ModbusMonitorDialog::resetStream()
+{
+    decoder->reset();
+}
+
+void ModbusMonitorDialog::onFramesDecoded(const QVector<ModbusFrame> &frames)
+{
+    QVector<ModbusFrame> shown;
+    const bool errorsOnly = errorsOnlyCheck->isChecked();
+    for (const ModbusFrame &frame : frames) {
+        ++frameCount;
+        const bool problem = !frame.crcOk || frame.kind == ModbusFrame::Kind::Exception;
+        if (!frame.crcOk) {
+            ++crcErrorCount;
+        } else if (frame.kind == ModbusFrame::Kind::Exception) {
+            ++exceptionCount;
+        }
+        if (!errorsOnly || problem) {
+            shown.append(frame);
+        }
+    }
+    updateStats();
+
+    if (pauseCheck->isChecked() || shown.isEmpty()) {
+        return;
+    }
+
+    QScrollBar *scrollBar = frameView->verticalScrollBar();
+    const bool atBottom = scrollBar->value() >= scrollBar->maximum();
+    model->appendFrames(shown);
+    if (atBottom) {
+        frameView->scrollToBottom();
+    }
+}
+
+void ModbusMonitorDialog::onClearClicked()
+{
+    model->clear();
+    frameCount = 0;
+    crcErrorCount = 0;
+    exceptionCount = 0;
+    updateStats();
+}
+
+void ModbusMonitorDialog::updateStats()
+{
+    statsLabel->setText(QString("帧: %1  CRC 错误: %2  异常响应: %3")
+        .arg(frameCount)
+        .arg(crcErrorCount)
+        .arg(exceptionCount));
+}
@@ -0,0 +1,238 @@
+#include "modbus_poller_dialog.h"
+#include "modbus_poller.h"
+#include "serial_port.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QSplitter>
+#include <QHeaderView>
+#include <QSettings>
+#include <QColor>
+
+namespace {
+
+enum PointColumn { NameColumn, SlaveColumn, FunctionColumn, AddressColumn, ValueColumn, AgeColumn, LatencyColumn, ErrorColumn, ColumnCount };
+
+const char *kExamplePoints =
+    "# 名称 从站 功能码 地址 [数量] 周期ms\n"
+    "voltage  1 3 0x0000 2 100\n"
+    "current  1 3 0x0002 2 100\n"
+    "status   1 1 0 16 500\n"
+    "serial   2 4 100 4 5000\n";
+
+} // namespace
+
+ModbusPollerDialog::ModbusPollerDialog(SerialPort *serialPort, QWidget *parent)
+    : QDialog(parent)
+    , poller(new ModbusPoller(serialPort, this))
+{
+    setWindowTitle("Modbus 轮询");
+    resize(1000, 620);
+
+    setupUI();
+
+    QSettings settings("SCOM-X", "SCOM-X");
+    pointsEdit->setPlainText(settings.value("modbusPoller/points", kExamplePoints).toString());
+    timeoutSpin->setValue(settings.value("modbusPoller/timeoutMs", 200).toInt());
+    delaySpin->setValue(settings.value("modbusPoller/interFrameDelayMs", 5).toInt());
+    applyPoints();
+
+    connect(poller, &ModbusPoller::runningChanged, this, &ModbusPollerDialog::onRunningChanged);
+    connect(&refreshTimer, &QTimer::timeout, this, &ModbusPollerDialog::refreshTable);
+    refreshTimer.start(kRefreshIntervalMs);
+}
+
+ModbusPollerDialog::~ModbusPollerDialog()
+{
+}
+
+void ModbusPollerDialog::setupUI()
+{
+    QHBoxLayout *mainLayout = new QHBoxLayout(this);
+    QSplitter *splitter = new QSplitter(Qt::Horizontal);
+
+    // 左侧：轮询点定义与总线参数
+    QWidget *sidePanel = new QWidget();
+    QVBoxLayout *sideLayout = new QVBoxLayout(sidePanel);
+    sideLayout->setContentsMargins(0, 0, 0, 0);
+
+    sideLayout->addWidget(new QLabel("轮询点（每行 名称 从站 功能码 地址 [数量] 周期ms）:"));
+    pointsEdit = new QPlainTextEdit();
+    pointsEdit->setLineWrapMode(QPlainTextEdit::NoWrap);
+    sideLayout->addWidget(pointsEdit, 1);
+
+    errorLabel = new QLabel();
+    errorLabel->setWordWrap(true);
+    errorLabel->setStyleSheet("color: #dc3545;");
+    sideLayout->addWidget(errorLabel);
+
+    QFormLayout *formLayout = new QFormLayout();
+    timeoutSpin = new QSpinBox();
+    timeoutSpin->setRange(10, 5000);
+    timeoutSpin->setSuffix(" ms");
+    formLayout->addRow("响应超时:", timeoutSpin);
+    delaySpin = new QSpinBox();
+    delaySpin->setRange(0, 1000);
+    delaySpin->setSuffix(" ms");
+    delaySpin->setToolTip("收到响应后到发送下一请求的最短间隔；小于当前串口参数下的 t3.5 时按 t3.5");
+    formLayout->addRow("帧间延迟:", delaySpin);
+    sideLayout->addLayout(formLayout);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    QPushButton *applyButton = new QPushButton("应用");
+    connect(applyButton, &QPushButton::clicked, this, &ModbusPollerDialog::onApplyClicked);
+    buttonLayout->addWidget(applyButton);
+    startStopButton = new QPushButton("开始轮询");
+    connect(startStopButton, &QPushButton::clicked, this, &ModbusPollerDialog::onStartStopClicked);
+    buttonLayout->addWidget(startStopButton);
+    sideLayout->addLayout(buttonLayout);
+
+    planLabel = new QLabel();
+    planLabel->setWordWrap(true);
+    sideLayout->addWidget(planLabel);
+
+    splitter->addWidget(sidePanel);
+
+    // 右侧：各点的值与状态
+    QWidget *tablePanel = new QWidget();
+    QVBoxLayout *tableLayout = new QVBoxLayout(tablePanel);
+    tableLayout->setContentsMargins(0, 0, 0, 0);
+
+    pointTable = new QTableWidget(0, ColumnCount);
+    pointTable->setHorizontalHeaderLabels({"名称", "从站", "功能码", "地址", "值", "更新于", "延迟", "错误"});
+    pointTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    pointTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    pointTable->verticalHeader()->setVisible(false);
+    pointTable->verticalHeader()->setDefaultSectionSize(22);
+    pointTable->horizontalHeader()->setSectionResizeMode(ValueColumn, QHeaderView::Stretch);
+    tableLayout->addWidget(pointTable, 1);
+
+    statsLabel = new QLabel();
+    tableLayout->addWidget(statsLabel);
+
+    splitter->addWidget(tablePanel);
+    splitter->setStretchFactor(0, 0);
+    splitter->setStretchFactor(1, 1);
+    splitter->setSizes({320, 680});
+
+    mainLayout->addWidget(splitter);
+}
+
+bool ModbusPollerDialog::applyPoints()
+{
+    QVector<ModbusPollPoint> points;
+    QString error;
+    if (!ModbusPoller::parsePoints(pointsEdit->toPlainText(), &points, &error)) {
+        errorLabel->setText(error);
+        return false;
+    }
+    errorLabel->clear();
+
+    poller->setResponseTimeoutMs(timeoutSpin->value());
+    poller->setInterFrameDelayMs(delaySpin->value());
+    poller->setPoints(points);
+    rebuildTable();
+
+    // 合并结果：每个请求覆盖的地址范围与周期
+    QStringList requests;
+    for (const ModbusPollBlock &block : poller->blocks()) {
+        requests << QString("从站 %1 FC%2 %3+%4 @%5ms")
+            .arg(block.slave).arg(block.function).arg(block.address).arg(block.count).arg(block.periodMs);
+    }
+    planLabel->setText(QString("%1 个点合并为 %2 个请求").arg(points.size()).arg(poller->blocks().size()));
+    planLabel->setToolTip(requests.join('\n'));
+
+    QSettings settings("SCOM-X", "SCOM-X");
+    settings.setValue("modbusPoller/points", pointsEdit->toPlainText());
+    settings.setValue("modbusPoller/timeoutMs", timeoutSpin->value());
+    settings.setValue("modbusPoller/interFrameDelayMs", delaySpin->value());
+    return true;
+}
+
+void ModbusPollerDialog::rebuildTable()
+{
+    const QVector<ModbusPollPoint> &points = poller->points();
+    pointTable->setRowCount(points.size());
+    for (int row = 0; row < points.size(); ++row) {
+        const ModbusPollPoint &point = points.at(row);
+        pointTable->setItem(row, NameColumn, new QTableWidgetItem(point.name));
+        pointTable->setItem(row, SlaveColumn, new QTableWidgetItem(QString::number(point.slave)));
+        pointTable->setItem(row, FunctionColumn, new QTableWidgetItem(QString::number(point.function)));
+        pointTable->setItem(row, AddressColumn, new QTableWidgetItem(
+            point.count > 1 ? QString("%1+%2").arg(point.address).arg(point.count) : QString::number(point.address)));
+        for (int column = ValueColumn; column < ColumnCount; ++column) {
+            pointTable->setItem(row, column, new QTableWidgetItem());
+        }
+    }
+    lastRequestCount = 0;
+    lastRefreshMs = poller->nowMs();
+    refreshTable();
+}
+
+void ModbusPollerDialog::onApplyClicked()
+{
+    const bool wasRunning = poller->isRunning();
+    if (applyPoints() && wasRunning) {
+        poller->start();
+    }
+}
+
+void ModbusPollerDialog::onStartStopClicked()
+{
+    if (poller->isRunning()) {
+        poller->stop();
+        return;
+    }
+    if (applyPoints()) {
+        poller->start();
+        if (!poller->isRunning()) {
+            errorLabel->setText("无法开始：串口未连接或没有轮询点");
+        }
+    }
+}
+
+void ModbusPollerDialog::onRunningChanged(bool running)
+{
+    startStopButton->setText(running ? "停止轮询" : "开始轮询");
+    pointsEdit->setReadOnly(running);
+}
+
+void ModbusPollerDialog::refreshTable()
+{
+    if (!isVisible()) {
+        return;
+    }
+
+    const qint64 now = poller->nowMs();
+    const QVector<ModbusPollPoint> &points = poller->points();
+    for (int row = 0; row < points.size() && row < pointTable->rowCount(); ++row) {
+        const ModbusPollPoint &point = points.at(row);
+
+        QStringList values;
+        for (quint16 value : point.values) {
+            values << QString::number(value);
+        }
+        pointTable->item(row, ValueColumn)->setText(values.join(' '));
+        pointTable->item(row, AgeColumn)->setText(point.updatedMs < 0 ? QString("-") : QString("%1 ms 前").arg(now - point.updatedMs));
+        pointTable->item(row, LatencyColumn)->setText(point.latencyMs < 0 ? QString("-") : QString::number(point.latencyMs, 'f', 1) + " ms");
+        pointTable->item(row, ErrorColumn)->setText(QString::number(point.errors));
+
+        // 过期的点标红
+        const QColor color = poller->isRunning() && poller->isStale(point) ? QColor("#dc3545") : QColor();
+        for (int column = 0; column < ColumnCount; ++column) {
+            pointTable->item(row, column)->setForeground(color.isValid() ? QBrush(color) : QBrush());
+        }
+    }
+
+    // 请求速率按刷新间隔估算
+    const qint64 elapsed = qMax<qint64>(1, now - lastRefreshMs);
+    const double rate = (poller->requestCount() - lastRequestCount) * 1000.0 / elapsed;
+    lastRequestCount = poller->requestCount();
+    lastRefreshMs = now;
+    statsLabel->setText(QString("请求: %1 (%2/s)  超时: %3  错误: %4")
+        .arg(poller->requestCount())
+        .arg(rate, 0, 'f', 1)
+        .arg(poller->timeoutCount())
+        .arg(poller->errorCount()));
+}
@@ -0,0 +1,209 @@
+#include "receive_search_dialog.h"
+#include "receive_hex_view.h"
+#include "receive_store.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QShortcut>
+#include <QDateTime>
+
+ReceiveSearchDialog::ReceiveSearchDialog(const ReceiveStore *store, QWidget *parent)
+    : QDialog(parent)
+    , store(store)
+    , engine(new ReceiveSearchEngine(this))
+{
+    setWindowTitle("搜索接收数据");
+    resize(900, 600);
+
+    setupUI();
+    updateMatchLabel();
+
+    connect(engine, &ReceiveSearchEngine::resultsReady, this, &ReceiveSearchDialog::onResultsReady);
+    connect(engine, &ReceiveSearchEngine::finished, this, &ReceiveSearchDialog::onSearchFinished);
+
+    // 视图跟随新数据扩展滚动范围；窗口隐藏时不刷新
+    connect(&refreshTimer, &QTimer::timeout, this, [this]() {
+        if (isVisible()) {
+            hexView->refresh();
+        }
+    });
+    refreshTimer.start(500);
+}
+
+ReceiveSearchDialog::~ReceiveSearchDialog()
+{
+}
+
+void ReceiveSearchDialog::setupUI()
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    QHBoxLayout *searchLayout = new QHBoxLayout();
+    modeComboBox = new QComboBox();
+    modeComboBox->addItem("文本", int(ReceiveSearchQuery::Mode::Text));
+    modeComboBox->addItem("HEX", int(ReceiveSearchQuery::Mode::Hex));
+    modeComboBox->addItem("正则", int(ReceiveSearchQuery::Mode::Regex));
+    searchLayout->addWidget(modeComboBox);
+
+    patternEdit = new QLineEdit();
+    patternEdit->setClearButtonEnabled(true);
+    searchLayout->addWidget(patternEdit, 1);
+    connect(modeComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this]() {
+        const auto mode = ReceiveSearchQuery::Mode(modeComboBox->currentData().toInt());
+        patternEdit->setPlaceholderText(mode == ReceiveSearchQuery::Mode::Hex ? "AA 55 ?? 01（?? 匹配任意字节）"
+                                        : mode == ReceiveSearchQuery::Mode::Regex ? "正则表达式，按字节匹配"
+                                                                                  : "文本");
+        caseCheck->setEnabled(mode != ReceiveSearchQuery::Mode::Hex);
+    });
+
+    caseCheck = new QCheckBox("区分大小写");
+    searchLayout->addWidget(caseCheck);
+
+    searchButton = new QPushButton("查找");
+    searchButton->setDefault(true);
+    connect(searchButton, &QPushButton::clicked, this, &ReceiveSearchDialog::onSearchClicked);
+    searchLayout->addWidget(searchButton);
+
+    previousButton = new QPushButton("上一个");
+    previousButton->setToolTip("Shift+F3");
+    connect(previousButton, &QPushButton::clicked, this, &ReceiveSearchDialog::onPreviousClicked);
+    searchLayout->addWidget(previousButton);
+
+    nextButton = new QPushButton("下一个");
+    nextButton->setToolTip("F3");
+    connect(nextButton, &QPushButton::clicked, this, &ReceiveSearchDialog::onNextClicked);
+    searchLayout->addWidget(nextButton);
+    mainLayout->addLayout(searchLayout);
+
+    QShortcut *nextShortcut = new QShortcut(QKeySequence(Qt::Key_F3), this);
+    connect(nextShortcut, &QShortcut::activated, this, &ReceiveSearchDialog::onNextClicked);
+    QShortcut *previousShortcut = new QShortcut(QKeySequence(Qt::SHIFT | Qt::Key_F3), this);
+    connect(previousShortcut, &QShortcut::activated, this, &ReceiveSearchDialog::onPreviousClicked);
+
+    hexView = new ReceiveHexView(store);
+    hexView->setMatches(&matches);
+    mainLayout->addWidget(hexView, 1);
+
+    QHBoxLayout *statusLayout = new QHBoxLayout();
+    matchLabel = new QLabel();
+    statusLayout->addWidget(matchLabel);
+    statusLayout->addStretch();
+    statusLabel = new QLabel();
+    statusLayout->addWidget(statusLabel);
+    mainLayout->addLayout(statusLayout);
+
+    modeComboBox->setCurrentIndex(0);
+    patternEdit->setPlaceholderText("文本");
+}
+
+void ReceiveSearchDialog::resetResults()
+{
+    engine->cancel();
+    matches.clear();
+    currentIndex = -1;
+    hexView->setMatches(&matches);
+    hexView->refresh();
+    statusLabel->clear();
+    updateMatchLabel();
+}
+
+void ReceiveSearchDialog::onSearchClicked()
+{
+    ReceiveSearchQuery query;
+    query.mode = ReceiveSearchQuery::Mode(modeComboBox->currentData().toInt());
+    query.pattern = patternEdit->text();
+    query.caseSensitive = caseCheck->isChecked();
+
+    matches.clear();
+    currentIndex = -1;
+    hexView->setMatches(&matches);
+    hexView->refresh();
+
+    QString error;
+    generation = engine->start(store->snapshot(), query, &error);
+    if (generation == 0) {
+        statusLabel->setText("模式无效: " + error);
+        updateMatchLabel();
+        return;
+    }
+    statusLabel->setText(QString("正在搜索 %1 MB...").arg(double(store->size()) / (1024 * 1024), 0, 'f', 1));
+    updateMatchLabel();
+}
+
+void ReceiveSearchDialog::onResultsReady(quint64 resultGeneration, const QVector<ReceiveMatch> &results)
+{
+    if (resultGeneration != generation) {
+        return;
+    }
+    matches += results;
+    if (currentIndex < 0 && !matches.isEmpty()) {
+        goToMatch(0);
+    } else {
+        hexView->viewport()->update();
+        updateMatchLabel();
+    }
+}
+
+void ReceiveSearchDialog::onSearchFinished(quint64 resultGeneration, int matchCount, bool truncated, qint64 elapsedMs)
+{
+    if (resultGeneration != generation) {
+        return;
+    }
+    QString text = QString("%1 个匹配，用时 %2 ms").arg(matchCount).arg(elapsedMs);
+    if (truncated) {
+        text += "（已达上限，只显示前面的结果）";
+    }
+    statusLabel->setText(text);
+    updateMatchLabel();
+}
+
+void ReceiveSearchDialog::onNextClicked()
+{
+    if (matches.isEmpty()) {
+        return;
+    }
+    goToMatch(currentIndex + 1 < matches.size() ? currentIndex + 1 : 0);
+}
+
+void ReceiveSearchDialog::onPreviousClicked()
+{
+    if (matches.isEmpty()) {
+        return;
+    }
+    goToMatch(currentIndex > 0 ? currentIndex - 1 : int(matches.size()) - 1);
+}
+
+void ReceiveSearchDialog::goToMatch(int index)
+{
+    currentIndex = index;
+    hexView->setCurrentMatch(index);
+    hexView->scrollToOffset(matches.at(index).offset);
+    updateMatchLabel();
+}
+
+void ReceiveSearchDialog::updateMatchLabel()
+{
+    previousButton->setEnabled(!matches.isEmpty());
+    nextButton->setEnabled(!matches.isEmpty());
+
+    if (currentIndex < 0 || currentIndex >= matches.size()) {
+        matchLabel->setText(QString("已存储 %1 字节").arg(store->size()));
+        return;
+    }
+
+    const ReceiveMatch &match = matches.at(currentIndex);
+    QString text = QString("第 %1 / %2 个  偏移 0x%3  长度 %4")
+        .arg(currentIndex + 1)
+        .arg(matches.size())
+        .arg(match.offset, 0, 16)
+        .arg(match.length);
+    if (match.offset < store->firstOffset()) {
+        text += "  （数据已超出存储容量被丢弃）";
+    } else {
+        const qint64 time = store->timeAt(match.offset);
+        if (time >= 0) {
+            text += "  接收于 " + QDateTime::fromMSecsSinceEpoch(time).toString("yyyy-MM-dd hh:mm:ss.zzz");
+        }
+    }
+    matchLabel->setText(text);
+}
@@ -0,0 +1,170 @@
+#include "telemetry_dialog.h"
+#include "telemetry_store.h"
+#include "telemetry_extractor.h"
+#include "telemetry_plot_widget.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QSplitter>
+#include <QSettings>
+#include <QPixmap>
+
+TelemetryDialog::TelemetryDialog(QWidget *parent)
+    : QDialog(parent)
+    , store(std::make_unique<TelemetryStore>())
+{
+    setWindowTitle("遥测曲线");
+    resize(1000, 600);
+
+    extractor = new TelemetryExtractor(store.get(), this);
+    setupUI();
+    plotWidget->setStore(store.get());
+
+    // 恢复上次使用的提取规则
+    QSettings settings("SCOM-X", "SCOM-X");
+    const QString rules = settings.value("telemetry/rules").toString();
+    rulesEdit->setPlainText(rules);
+    QString error;
+    if (!extractor->setRules(rules, &error)) {
+        rulesStatusLabel->setText(error);
+    }
+
+    connect(extractor, &TelemetryExtractor::channelAdded, this, &TelemetryDialog::onChannelAdded);
+    connect(&statsTimer, &QTimer::timeout, this, &TelemetryDialog::updateStats);
+    statsTimer.start(500);
+}
+
+TelemetryDialog::~TelemetryDialog()
+{
+}
+
+void TelemetryDialog::setupUI()
+{
+    QHBoxLayout *mainLayout = new QHBoxLayout(this);
+    QSplitter *splitter = new QSplitter(Qt::Horizontal);
+
+    // 左侧：通道与提取规则
+    QWidget *sidePanel = new QWidget();
+    QVBoxLayout *sideLayout = new QVBoxLayout(sidePanel);
+    sideLayout->setContentsMargins(0, 0, 0, 0);
+
+    sideLayout->addWidget(new QLabel("通道:"));
+    channelList = new QListWidget();
+    sideLayout->addWidget(channelList, 1);
+
+    sideLayout->addWidget(new QLabel("提取规则（每行 通道名=正则，留空自动识别 key=value）:"));
+    rulesEdit = new QPlainTextEdit();
+    rulesEdit->setPlaceholderText("temp=T:\\s*(-?\\d+\\.?\\d*)\nrssi=\\+CSQ:\\s*(\\d+)");
+    rulesEdit->setMaximumHeight(120);
+    sideLayout->addWidget(rulesEdit);
+
+    rulesStatusLabel = new QLabel();
+    rulesStatusLabel->setWordWrap(true);
+    rulesStatusLabel->setStyleSheet("color: #dc3545;");
+    sideLayout->addWidget(rulesStatusLabel);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    QPushButton *applyButton = new QPushButton("应用规则");
+    connect(applyButton, &QPushButton::clicked, this, &TelemetryDialog::onApplyRulesClicked);
+    buttonLayout->addWidget(applyButton);
+    QPushButton *clearButton = new QPushButton("清空数据");
+    connect(clearButton, &QPushButton::clicked, this, &TelemetryDialog::onClearClicked);
+    buttonLayout->addWidget(clearButton);
+    sideLayout->addLayout(buttonLayout);
+
+    splitter->addWidget(sidePanel);
+
+    // 右侧：曲线与视图控制
+    QWidget *plotPanel = new QWidget();
+    QVBoxLayout *plotLayout = new QVBoxLayout(plotPanel);
+    plotLayout->setContentsMargins(0, 0, 0, 0);
+
+    plotWidget = new TelemetryPlotWidget();
+    plotLayout->addWidget(plotWidget, 1);
+
+    QHBoxLayout *viewLayout = new QHBoxLayout();
+    followButton = new QPushButton("实时跟随");
+    followButton->setCheckable(true);
+    followButton->setChecked(true);
+    connect(followButton, &QPushButton::toggled, plotWidget, &TelemetryPlotWidget::setFollowLive);
+    connect(plotWidget, &TelemetryPlotWidget::followLiveChanged, followButton, &QPushButton::setChecked);
+    viewLayout->addWidget(followButton);
+    QPushButton *fitButton = new QPushButton("显示全部");
+    connect(fitButton, &QPushButton::clicked, plotWidget, &TelemetryPlotWidget::fitAll);
+    viewLayout->addWidget(fitButton);
+    viewLayout->addWidget(new QLabel("滚轮缩放，拖动平移，双击回到实时"));
+    viewLayout->addStretch();
+    statsLabel = new QLabel();
+    viewLayout->addWidget(statsLabel);
+    plotLayout->addLayout(viewLayout);
+
+    splitter->addWidget(plotPanel);
+    splitter->setStretchFactor(0, 0);
+    splitter->setStretchFactor(1, 1);
+    splitter->setSizes({240, 760});
+
+    mainLayout->addWidget(splitter);
+
+    connect(channelList, &QListWidget::itemChanged, this, &TelemetryDialog::onChannelItemChanged);
+}
+
+void TelemetryDialog::feed(const QByteArray &data)
+{
+    extractor->feed(data);
+    plotWidget->markDirty();
+}
+
+void TelemetryDialog::resetStream()
+{
+    extractor->resetStream();
+}
+
+void TelemetryDialog::onApplyRulesClicked()
+{
+    const QString rules = rulesEdit->toPlainText();
+    QString error;
+    if (!extractor->setRules(rules, &error)) {
+        rulesStatusLabel->setText(error);
+        return;
+    }
+    rulesStatusLabel->clear();
+
+    QSettings settings("SCOM-X", "SCOM-X");
+    settings.setValue("telemetry/rules", rules);
+}
+
+void TelemetryDialog::onClearClicked()
+{
+    store->clear();
+    extractor->resetStream();
+    channelList->clear();
+    plotWidget->setFollowLive(true);
+    plotWidget->markDirty();
+    updateStats();
+}
+
+void TelemetryDialog::onChannelAdded(const QString &name)
+{
+    QPixmap swatch(12, 12);
+    swatch.fill(plotWidget->channelColor(name));
+
+    QListWidgetItem *item = new QListWidgetItem(QIcon(swatch), name);
+    item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+    item->setCheckState(Qt::Checked);
+    channelList->addItem(item);
+}
+
+void TelemetryDialog::onChannelItemChanged(QListWidgetItem *item)
+{
+    plotWidget->setChannelVisible(item->text(), item->checkState() == Qt::Checked);
+}
+
+void TelemetryDialog::updateStats()
+{
+    if (!isVisible()) {
+        return;
+    }
+    statsLabel->setText(QString("通道: %1  样本: %2")
+        .arg(store->channelNames().size())
+        .arg(extractor->sampleCount()));
+}
@@ -1,13 +1,29 @@
 #include "main_window.h"
 #include "ui_main_window.h"
 #include "serial_port.h"
+#include "serial_port_registry.h"
 #include "config_manager.h"
 #include "preferences_dialog.h"
 #include "at_command_page.h"
 #include "log_page.h"
 #include "receive_data_page.h"
 #include "log_viewer_dialog.h"
+#include "telemetry_dialog.h"
+#include "modbus_monitor_dialog.h"
+#include "modbus_poller_dialog.h"
+#include "dissector_dialog.h"
+#include "receive_search_dialog.h"
+#include "receive_store.h"
 #include "operation_logger.h"
+#include "command_history_index.h"
+#include "log_categories.h"
+#include "log_manager.h"
+#include "async_log_writer.h"
+#include "urc_matcher.h"
+#include "checksum_verifier.h"
+#include "startup_loader.h"
+#include "lazy_page.h"
+#include "theme_manager.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -16,6 +32,7 @@
 #include <QLabel>
 #include <QApplication>
 #include <QSettings>
+#include <QDateTime>
 #include <QMessageBox>
 #include <QFile>
 #include <QDebug>
@@ -30,119 +47,226 @@
 #include <QMenu>
 #include <QMenuBar>
 #include <QAction>
+#include <QActionGroup>
 #include <QIntValidator>
 #include <QSpacerItem>
 #include <QDialog>
 #include <QKeyEvent>
 #include <QTextCursor>
+#include <QCompleter>
+#include <QStringListModel>
+#include <QAbstractItemView>
+#include <QSignalBlocker>
+#include <QTimer>
+#include <QElapsedTimer>
 
-// 外部声明日志函数
-extern void debugLog(const QString &msg);
+namespace {
+
+constexpr int kHistoryDropdownItems = 50;    // 下拉框显示的最近命令数
+constexpr int kHistorySaveDelayMs = 2000;    // 发送命令后延迟写入历史文件，连续发送只写一次
+constexpr int kHistoryCompletionLimit = 20;  // 补全弹窗的候选数
+constexpr int kPagePrefetchDelayMs = 300;    // 窗口显示后多久开始空闲预取页面
+constexpr int kCommandRowsInitial = 20;      // 首帧前同步构建的快捷指令行数
+constexpr int kCommandRowBatch = 25;         // 其余行每个事件循环空档构建的行数
+
+} // namespace
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent), ui(std::make_unique<Ui::MainWindow>()), 
-      configManager(std::make_unique<ConfigManager>()), serialPort(std::make_unique<SerialPort>())
+      configManager(std::make_unique<ConfigManager>()),
+      historyIndex(std::make_unique<CommandHistoryIndex>()),
+      serialPort(std::make_unique<SerialPort>())
 {
-    debugLog("[MainWindow] 1. 初始化配置管理器...");
-    // 初始化配置管理器
-    configManager->initialize();
-    debugLog("[MainWindow] 1. OK - 配置管理器初始化完成");
-
-    debugLog("[MainWindow] 2. setupUi...");
+    // 配置、串口列表和历史记录由 StartupLoader 在后台加载，
+    // 窗口先以默认值构建并显示，加载完成后在 applyStartup() 中应用
+    qCDebug(lcUi) << "[MainWindow] 1. setupUi...";
     // 从 .ui 文件生成的 UI 代码（由 Qt 自动生成）
     ui->setupUi(this);
-    debugLog("[MainWindow] 2. OK - setupUi 完成");
+    qCDebug(lcUi) << "[MainWindow] 1. OK - setupUi 完成";
 
-    debugLog("[MainWindow] 3. applyStyles...");
-    // 应用样式
-    applyStyles();
-    debugLog("[MainWindow] 3. OK - 样式应用完成");
+    // 全局样式表已在 main() 中通过 ThemeManager 应用，这里不再重复设置
 
-    debugLog("[MainWindow] 4. setupDynamicUI...");
+    qCDebug(lcUi) << "[MainWindow] 2. setupDynamicUI...";
     // 构建动态 UI（快捷指令表格等）
     setupDynamicUI();
-    debugLog("[MainWindow] 4. OK - 动态UI完成");
+    qCDebug(lcUi) << "[MainWindow] 2. OK - 动态UI完成";
 
-    debugLog("[MainWindow] 5. connectSignals...");
+    qCDebug(lcUi) << "[MainWindow] 3. connectSignals...";
     // 连接信号槽
     connectSignals();
-    debugLog("[MainWindow] 5. OK - 信号槽连接完成");
-    
-    debugLog("[MainWindow] 6. 创建 AT Command 页面...");
-    // 创建 AT Command 页面（但暂时隐藏）
-    try {
-        atCommandPage = std::make_unique<ATCommandPage>(configManager.get(), this);
-        atCommandPage->hide();
-        debugLog("[MainWindow] 6. OK - AT Command 页面创建完成");
-    } catch (const std::exception &e) {
-        debugLog(QString("[MainWindow] 6. FAILED - AT Command 页面创建失败: %1").arg(e.what()));
-    }
-    
-    debugLog("[MainWindow] 7. 创建 Log 页面...");
-    // 创建 Log 页面
-    try {
-        logPage = std::make_unique<LogPage>(this);
-        logPage->hide();
-        debugLog("[MainWindow] 7. OK - Log 页面创建完成");
-    } catch (const std::exception &e) {
-        debugLog(QString("[MainWindow] 7. FAILED - Log 页面创建失败: %1").arg(e.what()));
-    }
-    
-    debugLog("[MainWindow] 8. 创建 Receive Data 页面...");
-    // 创建 Receive Data 页面
-    try {
-        receiveDataPage = std::make_unique<ReceiveDataPage>(
-            ui->receiveArea,
-            ui->terminalInput,
-            ui->terminalHexMode,
-            ui->lineEndComboBox,
-            this
-        );
-        receiveDataPage->hide();
-        debugLog("[MainWindow] 8. OK - Receive Data 页面创建完成");
-    } catch (const std::exception &e) {
-        debugLog(QString("[MainWindow] 8. FAILED - Receive Data 页面创建失败: %1").arg(e.what()));
-    }
-
-    debugLog("[MainWindow] 9. 加载设置...");
-    // 加载之前保存的设置
-    loadSettings();
-    debugLog("[MainWindow] 9. OK - 设置加载完成");
+    qCDebug(lcUi) << "[MainWindow] 3. OK - 信号槽连接完成";
+    
+    qCDebug(lcUi) << "[MainWindow] 4. 注册按需构建的页面...";
+    // 次要页面首次使用时才构建，主窗口显示后在空闲时预取 AT Command 页面
+    setupLazyPages();
+    qCDebug(lcUi) << "[MainWindow] 4. OK - 页面工厂注册完成";
 
-    debugLog("[MainWindow] 10. 初始化状态栏...");
+    qCDebug(lcUi) << "[MainWindow] 5. 初始化状态栏...";
     // 初始化状态栏
     QLabel *bytesReceivedLabel = new QLabel("Rec: 0 Bytes", this);
     QLabel *bytesSentLabel = new QLabel("Sent: 0 Bytes", this);
 
     statusBar()->addPermanentWidget(bytesReceivedLabel);
     statusBar()->addPermanentWidget(bytesSentLabel);
+    urcStatusLabel = new QLabel("URC: 0", this);
+    statusBar()->addPermanentWidget(urcStatusLabel);
+    checksumStatusLabel = new QLabel(this);
+    checksumStatusLabel->hide();
+    statusBar()->addPermanentWidget(checksumStatusLabel);
 
     // 保存指针供后续使用（作为成员变量或直接使用）
     bytesReceived = 0;
     bytesSent = 0;
-    debugLog("[MainWindow] 10. OK - 状态栏初始化完成");
+    qCDebug(lcUi) << "[MainWindow] 5. OK - 状态栏初始化完成";
     
-    debugLog("[MainWindow] 11. 初始化日志查看器...");
+    qCDebug(lcUi) << "[MainWindow] 6. 初始化日志查看器...";
     // 初始化日志查看器（但不显示）
     logViewerDialog = nullptr;
-    debugLog("[MainWindow] 11. OK - 日志查看器初始化完成");
+    qCDebug(lcUi) << "[MainWindow] 6. OK - 日志查看器初始化完成";
     
-    debugLog("[MainWindow] 12. 初始化操作日志器...");
+    qCDebug(lcUi) << "[MainWindow] 7. 初始化操作日志器...";
     // 初始化操作日志器
     OperationLogger::instance().initialize();
     OperationLogger::instance().logInfo("应用启动成功");
-    debugLog("[MainWindow] 12. OK - 操作日志器初始化完成");
+    qCDebug(lcUi) << "[MainWindow] 7. OK - 操作日志器初始化完成";
     
-    debugLog("[MainWindow] ========== 构造函数完成 ==========");
+    qCDebug(lcUi) << "[MainWindow] ========== 构造函数完成 ==========";
 }
 
 MainWindow::~MainWindow() {
-    // 保存配置
-    if (configManager) {
+    // 保存配置（启动加载尚未完成时内存中只有默认值，不能覆盖配置文件）
+    if (configManager && configReady) {
         configManager->saveConfig();
     }
 }
 
+void MainWindow::setupLazyPages()
+{
+    atCommandPage.setFactory([this]() -> std::unique_ptr<ATCommandPage> {
+        try {
+            auto page = std::make_unique<ATCommandPage>(configManager.get(), this);
+            page->setSerialPort(serialPort.get());
+            page->hide();
+            qCDebug(lcUi) << "[MainWindow] AT Command 页面创建完成";
+            return page;
+        } catch (const std::exception &e) {
+            qCWarning(lcUi).noquote() << QString("[MainWindow] AT Command 页面创建失败: %1").arg(e.what());
+            return nullptr;
+        }
+    });
+
+    logPage.setFactory([this]() -> std::unique_ptr<LogPage> {
+        try {
+            auto page = std::make_unique<LogPage>(this);
+            page->hide();
+            qCDebug(lcUi) << "[MainWindow] Log 页面创建完成";
+            return page;
+        } catch (const std::exception &e) {
+            qCWarning(lcUi).noquote() << QString("[MainWindow] Log 页面创建失败: %1").arg(e.what());
+            return nullptr;
+        }
+    });
+
+    receiveDataPage.setFactory([this]() -> std::unique_ptr<ReceiveDataPage> {
+        try {
+            auto page = std::make_unique<ReceiveDataPage>(
+                ui->receiveArea,
+                ui->terminalInput,
+                ui->terminalHexMode,
+                ui->lineEndComboBox,
+                this
+            );
+            page->hide();
+            connectReceiveDataPage(page.get());
+            qCDebug(lcUi) << "[MainWindow] Receive Data 页面创建完成";
+            return page;
+        } catch (const std::exception &e) {
+            qCWarning(lcUi).noquote() << QString("[MainWindow] Receive Data 页面创建失败: %1").arg(e.what());
+            return nullptr;
+        }
+    });
+}
+
+void MainWindow::schedulePagePrefetch()
+{
+    // 等首帧绘制和启动期的排队事件处理完，再在空闲时构建最常用的页面
+    QTimer::singleShot(kPagePrefetchDelayMs, this, [this]() {
+        if (!atCommandPage) {
+            QElapsedTimer timer;
+            timer.start();
+            atCommandPage.get();
+            qCDebug(lcUi) << "[MainWindow] 空闲预取 AT Command 页面耗时(ms):" << timer.elapsed();
+        }
+    });
+}
+
+void MainWindow::attachStartup(StartupLoader *loader)
+{
+    if (!loader) {
+        return;
+    }
+    if (loader->isFinished()) {
+        applyStartup(loader);
+        return;
+    }
+    connect(loader, &StartupLoader::finished, this, [this, loader]() {
+        applyStartup(loader);
+    }, Qt::SingleShotConnection);
+}
+
+void MainWindow::applyStartup(StartupLoader *loader)
+{
+    const qint64 startMs = loader->elapsed();
+
+    // 采用后台加载的配置；ATCommandPage 等持有的 ConfigManager 指针保持不变
+    if (std::unique_ptr<ConfigManager> loaded = loader->takeConfig()) {
+        *configManager = std::move(*loaded);
+    } else {
+        configManager->initialize();
+    }
+    configReady = true;
+    applyLogSettings();
+    applyTheme(configManager->getTheme());
+
+    if (std::unique_ptr<CommandHistoryIndex> loadedHistory = loader->takeHistory()) {
+        historyIndex = std::move(loadedHistory);
+        refreshTerminalHistoryItems();
+        qCDebug(lcUi) << "[MainWindow] Loaded" << historyIndex->size() << "terminal history items";
+    } else {
+        loadTerminalHistory();
+    }
+
+    // 使用启动时扫描的串口列表，避免在 GUI 线程再枚举一次
+    updatePortList(loader->ports());
+    loadSettings();
+    scheduleCommandRowBuild();
+    schedulePagePrefetch();
+
+    loader->recordStage("应用配置", startMs);
+    loader->logSummary();
+}
+
+void MainWindow::applyLogSettings()
+{
+    LogManager::instance().setMinimumLevel(LogManager::levelFromString(configManager->getLogLevel()));
+    AsyncLogWriter::RotationPolicy rotationPolicy;
+    rotationPolicy.maxFileSize = qint64(configManager->getLogMaxFileSizeMB()) * 1024 * 1024;
+    rotationPolicy.maxAgeSecs = qint64(configManager->getLogMaxAgeDays()) * 24 * 3600;
+    rotationPolicy.retention = configManager->getLogRetention();
+    AsyncLogWriter::instance().setRotationPolicy(rotationPolicy);
+
+    OperationLogger::instance().setFlushInterval(configManager->getLogFlushInterval());
+    OperationLogger::DataAuditPolicy auditPolicy;
+    auditPolicy.enabled = configManager->getDataAuditEnabled();
+    auditPolicy.tx.sampleEvery = configManager->getDataAuditSampleEvery(true);
+    auditPolicy.tx.maxRecordsPerSec = configManager->getDataAuditMaxRecordsPerSec(true);
+    auditPolicy.rx.sampleEvery = configManager->getDataAuditSampleEvery(false);
+    auditPolicy.rx.maxRecordsPerSec = configManager->getDataAuditMaxRecordsPerSec(false);
+    auditPolicy.previewBytes = configManager->getDataAuditPreviewBytes();
+    auditPolicy.summaryIntervalMs = configManager->getDataAuditSummaryIntervalMs();
+    OperationLogger::instance().setDataAuditPolicy(auditPolicy);
+}
+
 void MainWindow::setupDynamicUI()
 {
     // 配置端口下拉框
@@ -170,10 +294,25 @@ void MainWindow::setupDynamicUI()
     ui->terminalInput->setMaximumHeight(30);
     ui->terminalPrompt->setObjectName("terminalPrompt");
     ui->terminalHexMode->setCheckState(Qt::Unchecked);
+
+    // 历史补全：候选由 CommandHistoryIndex 计算，补全器本身不再过滤
+    historyCompletionModel = new QStringListModel(this);
+    historyCompleter = new QCompleter(historyCompletionModel, this);
+    historyCompleter->setCaseSensitivity(Qt::CaseInsensitive);
+    historyCompleter->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    historyCompleter->setMaxVisibleItems(10);
+    ui->terminalInput->setCompleter(historyCompleter);
+    historySaveTimer.setSingleShot(true);
+    historySaveTimer.setInterval(kHistorySaveDelayMs);
+    connect(&historySaveTimer, &QTimer::timeout, this, &MainWindow::saveTerminalHistory);
     
     // 配置行尾符下拉框（默认选择 0D0A - CRLF）
     ui->lineEndComboBox->setCurrentIndex(0);
     ui->lineEndComboBox->setMaximumWidth(120);
+
+    // 校验下拉框（默认不追加）
+    ui->checksumComboBox->addItems(Checksum::names());
+    ui->checksumComboBox->setMaximumWidth(140);
     
     // 配置快捷指令表
     ui->commandTableLayout->setSpacing(5);
@@ -182,14 +321,75 @@ void MainWindow::setupDynamicUI()
     // 建立快捷指令行（从行1开始，行0是表头）
     rebuildCommandTable(currentCommandRows);
     
-    // 加载终端命令历史
-    loadTerminalHistory();
-    
     // 添加日志查看器菜单项
     QMenu *viewMenu = menuBar()->addMenu(tr("View(&V)"));
     QAction *logViewerAction = viewMenu->addAction(tr("EXE Log(&L)"));
     logViewerAction->setShortcut(Qt::CTRL | Qt::SHIFT | Qt::Key_L);
     connect(logViewerAction, &QAction::triggered, this, &MainWindow::onShowLogViewer);
+    QAction *telemetryAction = viewMenu->addAction(tr("Telemetry Plot(&P)"));
+    telemetryAction->setShortcut(Qt::CTRL | Qt::SHIFT | Qt::Key_P);
+    connect(telemetryAction, &QAction::triggered, this, &MainWindow::onShowTelemetry);
+    QAction *modbusAction = viewMenu->addAction(tr("Modbus Monitor(&M)"));
+    modbusAction->setShortcut(Qt::CTRL | Qt::SHIFT | Qt::Key_M);
+    connect(modbusAction, &QAction::triggered, this, &MainWindow::onShowModbusMonitor);
+    QAction *modbusPollerAction = viewMenu->addAction(tr("Modbus Poller(&O)"));
+    modbusPollerAction->setShortcut(Qt::CTRL | Qt::SHIFT | Qt::Key_O);
+    connect(modbusPollerAction, &QAction::triggered, this, &MainWindow::onShowModbusPoller);
+    QAction *dissectorAction = viewMenu->addAction(tr("Dissectors(&D)"));
+    dissectorAction->setShortcut(Qt::CTRL | Qt::SHIFT | Qt::Key_D);
+    connect(dissectorAction, &QAction::triggered, this, &MainWindow::onShowDissectors);
+    QAction *receiveSearchAction = viewMenu->addAction(tr("Search Received Data(&F)"));
+    receiveSearchAction->setShortcut(Qt::CTRL | Qt::SHIFT | Qt::Key_F);
+    connect(receiveSearchAction, &QAction::triggered, this, &MainWindow::onShowReceiveSearch);
+
+    // 主题菜单：切换时使用 ThemeManager 缓存的已展开样式表
+    QMenu *themeMenu = viewMenu->addMenu(tr("Theme(&T)"));
+    themeActions = new QActionGroup(this);
+    themeActions->setExclusive(true);
+    for (const QString &theme : ThemeManager::instance().availableThemes()) {
+        QAction *action = themeMenu->addAction(theme);
+        action->setCheckable(true);
+        action->setData(theme);
+        action->setChecked(theme == ThemeManager::instance().currentTheme());
+        themeActions->addAction(action);
+    }
+    connect(themeActions, &QActionGroup::triggered, this, [this](QAction *action) {
+        applyTheme(action->data().toString());
+    });
+}
+
+void MainWindow::applyChecksum(const QString &name)
+{
+    const Checksum::Algorithm algorithm = Checksum::fromName(name);
+    if (serialPort) {
+        serialPort->setTxChecksum(algorithm);
+    }
+    if (checksumVerifier) {
+        checksumVerifier->setAlgorithm(algorithm);
+    }
+
+    checksumStatusLabel->setVisible(algorithm != Checksum::Algorithm::None);
+    checksumStatusLabel->setText(QString("%1: 0 OK / 0 ERR").arg(name));
+    checksumStatusLabel->setToolTip(QString());
+    if (configReady) {
+        configManager->setChecksum(name);
+    }
+
+    qCInfo(lcSerial).noquote() << QString("[MainWindow] 校验算法: %1").arg(name);
+}
+
+void MainWindow::applyTheme(const QString &theme)
+{
+    if (!ThemeManager::instance().applyTheme(theme)) {
+        return;
+    }
+    for (QAction *action : themeActions->actions()) {
+        action->setChecked(action->data().toString() == theme);
+    }
+    if (configReady && configManager->getTheme() != theme) {
+        configManager->setTheme(theme);
+        configManager->saveConfig();
+    }
 }
 
 void MainWindow::connectSignals()
@@ -213,11 +413,17 @@ void MainWindow::connectSignals()
     // 连接日志查看器菜单（如果菜单中存在日志查看器选项）
     // 我们稍后会添加这个菜单项
 
+    // 串口热插拔时实时更新下拉框
+    connect(&SerialPortRegistry::instance(), &SerialPortRegistry::portsChanged,
+            this, &MainWindow::onPortsChanged);
+
     // 连接设置变化
     connect(ui->portComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &MainWindow::onSettingChanged);
     connect(ui->baudRateSpinBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &MainWindow::onSettingChanged);
+    connect(ui->checksumComboBox, &QComboBox::currentTextChanged,
+            this, &MainWindow::applyChecksum);
 
     // 连接终端输入框的 Return 键 - QComboBox 需要连接内部 lineEdit 的信号
     connect(ui->terminalInput->lineEdit(), &QLineEdit::returnPressed, this, [this]() {
@@ -260,6 +466,10 @@ void MainWindow::connectSignals()
         // ui->terminalInput->lineEdit()->clear();
     });
 
+    // 输入时即时查询历史索引
+    connect(ui->terminalInput->lineEdit(), &QLineEdit::textEdited,
+            this, &MainWindow::updateHistoryCompletions);
+
     // 连接串口信号
     if (serialPort)
     {
@@ -283,6 +493,52 @@ void MainWindow::connectSignals()
                     // 更新状态栏
                     statusBar()->showMessage(QString("发送: %1 字节").arg(bytesSent)); });
 
+        // 原始接收数据存入接收存储（供搜索），并经过 URC 匹配器识别模组的主动上报；
+        // 遥测、Modbus 与协议解析窗口打开过时同时提取数值、解码帧
+        receiveStore = std::make_unique<ReceiveStore>();
+        urcMatcher = std::make_unique<UrcMatcher>();
+        urcMatcher->addStandardPatterns();
+        connect(serialPort.get(), &SerialPort::rawDataReceived, this, [this](const QByteArray &data) {
+            const qint64 now = QDateTime::currentMSecsSinceEpoch();
+            receiveStore->append(data, now);
+            urcMatcher->feed(data, now);
+            if (telemetryDialog) {
+                telemetryDialog->feed(data);
+            }
+            if (modbusMonitorDialog) {
+                modbusMonitorDialog->feed(data);
+            }
+            if (dissectorDialog) {
+                dissectorDialog->feed(data);
+            }
+        });
+        connect(urcMatcher.get(), &UrcMatcher::urcMatched, this, [this](const UrcEvent &event) {
+            qCInfo(lcSerial).noquote() << QString("[URC] %1: %2").arg(event.type, event.line);
+            if (urcStatusLabel) {
+                urcStatusLabel->setText(QString("URC: %1").arg(urcMatcher->matchCount()));
+                urcStatusLabel->setToolTip(QString("%1  %2\n%3")
+                    .arg(QDateTime::fromMSecsSinceEpoch(event.timestampMs).toString("hh:mm:ss.zzz"))
+                    .arg(event.type)
+                    .arg(event.line));
+            }
+        });
+
+        // 启用校验时按空闲间隔分帧校验接收数据
+        checksumVerifier = std::make_unique<ChecksumVerifier>();
+        connect(serialPort.get(), &SerialPort::rawDataReceived,
+                checksumVerifier.get(), &ChecksumVerifier::feed);
+        connect(checksumVerifier.get(), &ChecksumVerifier::frameVerified, this, [this](const QByteArray &frame, bool ok) {
+            checksumStatusLabel->setText(QString("%1: %2 OK / %3 ERR")
+                .arg(Checksum::name(checksumVerifier->algorithm()))
+                .arg(checksumVerifier->okCount())
+                .arg(checksumVerifier->errorCount()));
+            if (!ok) {
+                const QString hex = SerialPort::byteArrayToHexString(frame.left(64));
+                qCWarning(lcSerial).noquote() << QString("[Checksum] 校验错误 (%1 字节): %2").arg(frame.size()).arg(hex);
+                checksumStatusLabel->setToolTip(QString("最近一次错误帧:\n%1").arg(hex));
+            }
+        });
+
         connect(serialPort.get(), &SerialPort::connectionStatusChanged,
                 this, &MainWindow::onConnectionStatusChanged);
 
@@ -292,71 +548,52 @@ void MainWindow::connectSignals()
 
     // 连接表头复选框的全选/取消全选
     connect(ui->headerCheck, &QCheckBox::toggled, this, &MainWindow::onHeaderCheckBoxToggled);
-    
+}
+
+void MainWindow::connectReceiveDataPage(ReceiveDataPage *page)
+{
     // 连接 ReceiveDataPage 的命令发送信号
-    if (receiveDataPage) {
-        connect(receiveDataPage.get(), &ReceiveDataPage::terminalCommandEntered, this, [this](const QString &command) {
-            if (command.isEmpty()) {
-                return;
-            }
-            
-            // 获取行尾符
-            QString lineEnd = getLineEndSuffix();
-            
-            // 显示输入命令到主窗口的接收区域
-            ui->receiveArea->insertPlainText("> " + command + "\n");
-            
-            // 滚动到底部
-            QTextCursor cursor = ui->receiveArea->textCursor();
-            cursor.movePosition(QTextCursor::End);
-            ui->receiveArea->setTextCursor(cursor);
+    connect(page, &ReceiveDataPage::terminalCommandEntered, this, [this, page](const QString &command) {
+        if (command.isEmpty()) {
+            return;
+        }
+        
+        // 获取行尾符
+        QString lineEnd = getLineEndSuffix();
+        
+        // 显示输入命令到主窗口的接收区域
+        ui->receiveArea->insertPlainText("> " + command + "\n");
+        
+        // 滚动到底部
+        QTextCursor cursor = ui->receiveArea->textCursor();
+        cursor.movePosition(QTextCursor::End);
+        ui->receiveArea->setTextCursor(cursor);
+        
+        // 发送到串口
+        if (serialPort && serialPort->isOpen()) {
+            // 拼接完整的发送数据（命令 + 行尾符）
+            QString fullCommand = command + lineEnd;
             
-            // 发送到串口
-            if (serialPort && serialPort->isOpen()) {
-                // 拼接完整的发送数据（命令 + 行尾符）
-                QString fullCommand = command + lineEnd;
-                
-                if (ui->terminalHexMode->isChecked()) {
-                    serialPort->write(fullCommand, SerialPort::DataFormat::HEX);
-                } else {
-                    serialPort->write(fullCommand, SerialPort::DataFormat::ASCII);
-                }
-                bytesSent += fullCommand.length();
-                statusBar()->showMessage(QString("发送: %1 字节").arg(bytesSent));
+            if (ui->terminalHexMode->isChecked()) {
+                serialPort->write(fullCommand, SerialPort::DataFormat::HEX);
             } else {
-                ui->receiveArea->insertPlainText("[错误] 串口未连接\n");
-            }
-            
-            // 将命令添加到历史记录
-            addTerminalHistory(command);
-            
-            // 同步清空两个页面的输入框
-            ui->terminalInput->lineEdit()->clear();
-            if (receiveDataPage && receiveDataPage->getTerminalInput()) {
-                receiveDataPage->getTerminalInput()->lineEdit()->clear();
+                serialPort->write(fullCommand, SerialPort::DataFormat::ASCII);
             }
-        });
-    }
-}
-
-void MainWindow::applyStyles()
-{
-    QFile styleFile(":/ui/style.qss");
-    if (styleFile.open(QFile::ReadOnly))
-    {
-        QString style = QLatin1String(styleFile.readAll());
-        qApp->setStyleSheet(style);
-        styleFile.close();
-        qDebug() << "✓ 样式文件加载成功，文件大小:" << style.size() << "字符";
-    }
-    else
-    {
-        qDebug() << "✗ 无法加载样式文件: :/ui/style.qss";
-        qDebug() << "可用资源:";
-        // 列出可用资源进行调试
-        QDir dir(":/ui");
-        qDebug() << dir.entryList();
-    }
+            bytesSent += fullCommand.length();
+            statusBar()->showMessage(QString("发送: %1 字节").arg(bytesSent));
+        } else {
+            ui->receiveArea->insertPlainText("[错误] 串口未连接\n");
+        }
+        
+        // 将命令添加到历史记录
+        addTerminalHistory(command);
+        
+        // 同步清空两个页面的输入框
+        ui->terminalInput->lineEdit()->clear();
+        if (page->getTerminalInput()) {
+            page->getTerminalInput()->lineEdit()->clear();
+        }
+    });
 }
 
 void MainWindow::onConnectClicked()
@@ -399,19 +636,71 @@ void MainWindow::onConnectClicked()
 void MainWindow::onClearReceiveArea()
 {
     ui->receiveArea->clear();
+    if (receiveStore) {
+        receiveStore->clear();
+    }
+    if (receiveSearchDialog) {
+        receiveSearchDialog->resetResults();
+    }
     bytesReceived = 0;
     statusBar()->showMessage("接收: 0 字节");
 }
 
 void MainWindow::onRefreshPorts()
 {
+    // 手动刷新强制重新枚举；平时列表由 SerialPortRegistry 随热插拔更新
+    updatePortList(SerialPortRegistry::instance().rescan());
+}
+
+void MainWindow::onPortsChanged(const QStringList &added, const QStringList &removed)
+{
+    updatePortList(SerialPortRegistry::instance().portNames());
+
+    QStringList changes;
+    if (!added.isEmpty()) {
+        changes << QString("插入 %1").arg(added.join(", "));
+    }
+    if (!removed.isEmpty()) {
+        changes << QString("移除 %1").arg(removed.join(", "));
+    }
+    statusBar()->showMessage(QString("串口%1").arg(changes.join("，")), 5000);
+}
+
+void MainWindow::updatePortList(const QStringList &ports)
+{
+    // 保留当前选择；列表变化不触发 onSettingChanged
+    const QString current = ui->portComboBox->currentText();
+    const QSignalBlocker blocker(ui->portComboBox);
     ui->portComboBox->clear();
-    QStringList ports = SerialPort::scanAvailablePorts();
-    ui->portComboBox->addItems(ports);
+    for (const QString &port : ports) {
+        ui->portComboBox->addItem(port);
+        ui->portComboBox->setItemData(ui->portComboBox->count() - 1,
+                                      SerialPortRegistry::instance().describe(port), Qt::ToolTipRole);
+    }
+    const int index = ui->portComboBox->findText(current);
+    if (index >= 0) {
+        ui->portComboBox->setCurrentIndex(index);
+    }
 }
 
 void MainWindow::onConnectionStatusChanged(bool connected)
 {
+    if (urcMatcher) {
+        urcMatcher->resetStream();
+    }
+    if (telemetryDialog) {
+        telemetryDialog->resetStream();
+    }
+    if (checksumVerifier) {
+        checksumVerifier->resetStream();
+    }
+    if (modbusMonitorDialog) {
+        modbusMonitorDialog->resetStream();
+        configureModbusMonitor();
+    }
+    if (dissectorDialog) {
+        dissectorDialog->resetStream();
+    }
     updateConnectionStatus(connected);
 }
 
@@ -457,6 +746,10 @@ void MainWindow::updateConnectionStatus(bool connected)
 void MainWindow::closeEvent(QCloseEvent *event)
 {
     saveSettings();
+    if (historySaveTimer.isActive()) {
+        historySaveTimer.stop();
+        saveTerminalHistory();
+    }
     if (serialPort && serialPort->isOpen())
     {
         serialPort->close();
@@ -468,17 +761,15 @@ void MainWindow::loadSettings()
 {
     // 从配置管理器加载设置
     if (!configManager) {
-        qWarning() << "[MainWindow] ConfigManager not initialized";
+        qCWarning(lcUi) << "[MainWindow] ConfigManager not initialized";
         return;
     }
 
-    // 刷新获取最新的可用串口列表
-    onRefreshPorts();
-
-    // 加载其他设置
+    // 串口列表由启动阶段扫描填入，这里只恢复其他设置
     ui->baudRateSpinBox->setCurrentText(QString::number(configManager->getBaudRate()));
     ui->terminalHexMode->setChecked(configManager->getHexMode());
     ui->lineEndComboBox->setCurrentIndex(configManager->getLineEndIndex());
+    ui->checksumComboBox->setCurrentText(configManager->getChecksum());
 
     // 加载快捷指令行数设置
     currentCommandRows = configManager->getCommandRows();
@@ -486,10 +777,19 @@ void MainWindow::loadSettings()
         currentCommandRows = 1;
     if (currentCommandRows > maxCommandRows)
         currentCommandRows = maxCommandRows;
+    targetCommandRows = qMax(targetCommandRows, currentCommandRows);
+
+    // 已构建的行立即恢复，其余行在追加时恢复
+    restoreCommandRows(0, (int)commandInputs.size());
 
+    qCDebug(lcUi) << "[MainWindow] Settings loaded from ConfigManager";
+}
+
+void MainWindow::restoreCommandRows(int first, int last)
+{
     // 加载快捷指令数据（从 QSettings 作为备用）
     QSettings qsettings("SCOM-X", "SCOM-X");
-    for (int i = 0; i < (int)commandInputs.size(); ++i)
+    for (int i = first; i < last; ++i)
     {
         QString data = qsettings.value(QString("command_%1_data").arg(i), "").toString();
         if (!data.isEmpty())
@@ -500,15 +800,16 @@ void MainWindow::loadSettings()
             commandIntervals[i]->setText(qsettings.value(QString("command_%1_interval").arg(i), "0").toString());
         }
     }
-
-    qDebug() << "[MainWindow] Settings loaded from ConfigManager";
 }
 
 void MainWindow::saveSettings()
 {
     // 保存到 ConfigManager
+    if (!configReady) {
+        return;  // 配置尚未加载，构建 UI 时的控件变化不应写回
+    }
     if (!configManager) {
-        qWarning() << "[MainWindow] ConfigManager not available for saving";
+        qCWarning(lcUi) << "[MainWindow] ConfigManager not available for saving";
         return;
     }
 
@@ -517,6 +818,7 @@ void MainWindow::saveSettings()
     configManager->setBaudRate(ui->baudRateSpinBox->currentText().toInt());
     configManager->setHexMode(ui->terminalHexMode->isChecked());
     configManager->setLineEndIndex(ui->lineEndComboBox->currentIndex());
+    configManager->setChecksum(ui->checksumComboBox->currentText());
     configManager->setCommandRows(currentCommandRows);
 
     // 同时保存快捷指令到 QSettings（作为备用）
@@ -534,7 +836,7 @@ void MainWindow::saveSettings()
     settings.sync();
     configManager->saveConfig();
 
-    qDebug() << "[MainWindow] Settings saved to ConfigManager and QSettings (serial port not saved)";
+    qCDebug(lcUi) << "[MainWindow] Settings saved to ConfigManager and QSettings (serial port not saved)";
 }
 
 void MainWindow::onQuickCommandButtonClicked(int index)
@@ -628,8 +930,29 @@ void MainWindow::rebuildCommandTable(int rowCount)
     commandEndCheckboxes.clear();
     commandIntervals.clear();
 
-    // 创建新的快捷指令行
-    for (int i = 0; i < rowCount; ++i)
+    // 首批行同步构建，其余行在配置就绪后于空闲时分批追加
+    targetCommandRows = rowCount;
+    appendCommandRows(qMin(rowCount, kCommandRowsInitial));
+    if (configReady) {
+        scheduleCommandRowBuild();
+    }
+}
+
+void MainWindow::appendCommandRows(int count)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    // 伸缩项始终位于最后一行之后
+    if (commandTableSpacer) {
+        ui->commandTableLayout->removeItem(commandTableSpacer);
+        delete commandTableSpacer;
+        commandTableSpacer = nullptr;
+    }
+
+    const int first = (int)commandInputs.size();
+    for (int i = first; i < first + count; ++i)
     {
         // 复选框（行选择）
         QCheckBox *checkbox = new QCheckBox();
@@ -712,8 +1035,28 @@ void MainWindow::rebuildCommandTable(int rowCount)
     }
 
     // 添加伸缩项
-    ui->commandTableLayout->addItem(new QSpacerItem(20, 40, QSizePolicy::Minimum, QSizePolicy::Expanding),
-                                    rowCount + 1, 0, 1, 6);
+    const int rowCount = (int)commandInputs.size();
+    commandTableSpacer = new QSpacerItem(20, 40, QSizePolicy::Minimum, QSizePolicy::Expanding);
+    ui->commandTableLayout->addItem(commandTableSpacer, rowCount + 1, 0, 1, 6);
+
+    if (configReady) {
+        restoreCommandRows(first, rowCount);
+    }
+}
+
+void MainWindow::scheduleCommandRowBuild()
+{
+    if (commandRowBuildScheduled || (int)commandInputs.size() >= targetCommandRows) {
+        return;
+    }
+    commandRowBuildScheduled = true;
+
+    // 零间隔定时器在处理完已排队的事件后触发，每次只构建一批，界面保持响应
+    QTimer::singleShot(0, this, [this]() {
+        commandRowBuildScheduled = false;
+        appendCommandRows(qMin(kCommandRowBatch, targetCommandRows - (int)commandInputs.size()));
+        scheduleCommandRowBuild();
+    });
 }
 
 QString MainWindow::getLineEndSuffix() const
@@ -738,19 +1081,15 @@ void MainWindow::loadTerminalHistory()
         return;
     }
     
-    QStringList history = configManager->getTerminalHistory();
-    
-    // 清空现有项目（如果有）
-    ui->terminalInput->clear();
+    QStringList history;
+    QList<int> counts;
+    configManager->readTerminalHistory(&history, &counts);
+    historyIndex->load(history, counts);
     
-    // 添加历史记录到下拉框
-    for (const QString &cmd : history) {
-        if (!cmd.isEmpty()) {
-            ui->terminalInput->addItem(cmd);
-        }
-    }
+    // 下拉框只显示最近的命令，完整历史通过补全查询
+    refreshTerminalHistoryItems();
     
-    qDebug() << "[MainWindow] Loaded" << history.size() << "terminal history items";
+    qCDebug(lcUi) << "[MainWindow] Loaded" << historyIndex->size() << "terminal history items";
 }
 
 void MainWindow::addTerminalHistory(const QString &command)
@@ -759,31 +1098,59 @@ void MainWindow::addTerminalHistory(const QString &command)
         return;
     }
     
-    // 检查是否已存在此命令
-    int existingIndex = ui->terminalInput->findText(command);
-    if (existingIndex >= 0) {
-        // 如果已存在，将其移到最前面
-        ui->terminalInput->removeItem(existingIndex);
-    }
-    
-    // 添加到开头
-    ui->terminalInput->insertItem(0, command);
+    // 由索引负责去重和排序，无需在下拉框中线性查找
+    historyIndex->record(command);
+    refreshTerminalHistoryItems();
     ui->terminalInput->setCurrentIndex(0);
     
-    // 限制历史记录数量（最多保存 50 条）
-    while (ui->terminalInput->count() > 50) {
-        ui->terminalInput->removeItem(ui->terminalInput->count() - 1);
+    if (configReady) {
+        historySaveTimer.start();
     }
     
-    // 保存历史记录到配置
-    QStringList history;
-    for (int i = 0; i < ui->terminalInput->count(); ++i) {
-        history.append(ui->terminalInput->itemText(i));
+    qCDebug(lcUi) << "[MainWindow] Added terminal history:" << command;
+}
+
+void MainWindow::saveTerminalHistory()
+{
+    if (!configReady || !configManager) {
+        return;
     }
-    configManager->setTerminalHistory(history);
-    configManager->saveConfig();
+
+    // 完整保存索引中的全部条目，重启后历史容量不缩水
+    const QStringList history = historyIndex->mostRecent(historyIndex->size());
+    QList<int> counts;
+    counts.reserve(history.size());
+    for (const QString &cmd : history) {
+        counts.append(historyIndex->countOf(cmd));
+    }
+    configManager->writeTerminalHistory(history, counts);
+}
+
+void MainWindow::refreshTerminalHistoryItems()
+{
+    ui->terminalInput->blockSignals(true);
+    ui->terminalInput->clear();
+    ui->terminalInput->addItems(historyIndex->mostRecent(kHistoryDropdownItems));
+    ui->terminalInput->blockSignals(false);
+}
+
+void MainWindow::updateHistoryCompletions(const QString &text)
+{
+    QStringList candidates;
+    if (!text.isEmpty()) {
+        const auto matches = historyIndex->search(text, kHistoryCompletionLimit);
+        candidates.reserve(matches.size());
+        for (const auto &match : matches) {
+            candidates.append(match.command);
+        }
+    }
+    historyCompletionModel->setStringList(candidates);
     
-    qDebug() << "[MainWindow] Added terminal history:" << command;
+    if (candidates.isEmpty()) {
+        historyCompleter->popup()->hide();
+    } else {
+        historyCompleter->complete();
+    }
 }
 
 void MainWindow::onHeaderCheckBoxToggled(bool checked)
@@ -798,7 +1165,7 @@ void MainWindow::onHeaderCheckBoxToggled(bool checked)
         }
     }
     
-    qDebug() << "[MainWindow] Header checkbox" << (checked ? "checked - 全选" : "unchecked - 取消全选");
+    qCDebug(lcUi) << "[MainWindow] Header checkbox" << (checked ? "checked - 全选" : "unchecked - 取消全选");
 }
 
 void MainWindow::onSwitchToMain()
@@ -810,14 +1177,14 @@ void MainWindow::onSwitchToMain()
     ui->commandScrollArea->setVisible(true);
     
     // Hide AT Command page
-    if (atCommandPage) {
-        atCommandPage->setVisible(false);
+    if (ATCommandPage *page = atCommandPage.peek()) {
+        page->setVisible(false);
     }
     
     // Update window title
     setWindowTitle("SCOM-X");
     
-    debugLog("[MainWindow] Switched to Main window");
+    qCDebug(lcUi) << "[MainWindow] Switched to Main window";
     OperationLogger::instance().logPageSwitch("主页面");
 }
 
@@ -829,23 +1196,23 @@ void MainWindow::onSwitchToATCommand()
     ui->receivedDataGroupBox->setVisible(false);
     ui->commandScrollArea->setVisible(false);
     
-    // Show AT Command page as a child widget with proper geometry
-    if (atCommandPage) {
-        atCommandPage->setParent(centralWidget());
+    // Show AT Command page as a child widget with proper geometry（首次切换时构建）
+    if (ATCommandPage *page = atCommandPage.get()) {
+        page->setParent(centralWidget());
         
         // 计算正确的几何大小：从菜单栏下方到状态栏上方
         QRect contentRect = centralWidget()->rect();
-        atCommandPage->setGeometry(contentRect);
+        page->setGeometry(contentRect);
         
-        atCommandPage->setVisible(true);
-        atCommandPage->raise();
-        atCommandPage->setFocus();
+        page->setVisible(true);
+        page->raise();
+        page->setFocus();
     }
     
     // Update window title
     setWindowTitle("SCOM-X - AT Command");
     
-    debugLog("[MainWindow] Switched to AT Command window");
+    qCDebug(lcUi) << "[MainWindow] Switched to AT Command window";
     OperationLogger::instance().logPageSwitch("AT 命令页面");
 }
 
@@ -853,8 +1220,8 @@ void MainWindow::onSwitchToATCommand()
 void MainWindow::onSwitchToLog()
 {
     // Hide AT Command page
-    if (atCommandPage) {
-        atCommandPage->setVisible(false);
+    if (ATCommandPage *page = atCommandPage.peek()) {
+        page->setVisible(false);
     }
     
     // Hide AT Command specific components
@@ -868,15 +1235,15 @@ void MainWindow::onSwitchToLog()
     // Update window title
     setWindowTitle("SCOM-X - Log");
     
-    debugLog("[MainWindow] Switched to Log window");
+    qCDebug(lcUi) << "[MainWindow] Switched to Log window";
     OperationLogger::instance().logPageSwitch("日志页面");
 }
 
 void MainWindow::onSwitchToReceiveData()
 {
     // Hide AT Command page
-    if (atCommandPage) {
-        atCommandPage->setVisible(false);
+    if (ATCommandPage *page = atCommandPage.peek()) {
+        page->setVisible(false);
     }
     
     // Hide main components
@@ -885,20 +1252,20 @@ void MainWindow::onSwitchToReceiveData()
     ui->commandScrollArea->setVisible(false);
     
     // Show Receive Data page with proper geometry
-    if (receiveDataPage) {
-        receiveDataPage->setParent(centralWidget());
+    if (ReceiveDataPage *page = receiveDataPage.get()) {
+        page->setParent(centralWidget());
         QRect contentRect = centralWidget()->rect();
-        receiveDataPage->setGeometry(contentRect);
+        page->setGeometry(contentRect);
         
-        receiveDataPage->setVisible(true);
-        receiveDataPage->raise();
-        receiveDataPage->setFocus();
+        page->setVisible(true);
+        page->raise();
+        page->setFocus();
     }
     
     // Update window title
     setWindowTitle("SCOM-X - Receive Data");
     
-    debugLog("[MainWindow] Switched to Receive Data window");
+    qCDebug(lcUi) << "[MainWindow] Switched to Receive Data window";
     OperationLogger::instance().logPageSwitch("数据接收页面");
 }
 
@@ -914,7 +1281,89 @@ void MainWindow::onShowLogViewer()
     logViewerDialog->raise();
     logViewerDialog->activateWindow();
     
-    debugLog("[MainWindow] Opened Log Viewer");
+    qCDebug(lcUi) << "[MainWindow] Opened Log Viewer";
+}
+
+void MainWindow::onShowTelemetry()
+{
+    // 首次打开时创建，之后即使关闭窗口也继续记录
+    if (!telemetryDialog) {
+        telemetryDialog = new TelemetryDialog(this);
+    }
+
+    telemetryDialog->show();
+    telemetryDialog->raise();
+    telemetryDialog->activateWindow();
+
+    qCDebug(lcUi) << "[MainWindow] Opened Telemetry Plot";
+}
+
+void MainWindow::onShowModbusMonitor()
+{
+    // 首次打开时创建，之后即使关闭窗口也继续解码
+    if (!modbusMonitorDialog) {
+        modbusMonitorDialog = new ModbusMonitorDialog(this);
+        configureModbusMonitor();
+    }
+
+    modbusMonitorDialog->show();
+    modbusMonitorDialog->raise();
+    modbusMonitorDialog->activateWindow();
+
+    qCDebug(lcUi) << "[MainWindow] Opened Modbus Monitor";
+}
+
+void MainWindow::onShowModbusPoller()
+{
+    if (!modbusPollerDialog) {
+        modbusPollerDialog = new ModbusPollerDialog(serialPort.get(), this);
+    }
+
+    modbusPollerDialog->show();
+    modbusPollerDialog->raise();
+    modbusPollerDialog->activateWindow();
+
+    qCDebug(lcUi) << "[MainWindow] Opened Modbus Poller";
+}
+
+void MainWindow::onShowDissectors()
+{
+    if (!dissectorDialog) {
+        dissectorDialog = new DissectorDialog(this);
+    }
+
+    dissectorDialog->show();
+    dissectorDialog->raise();
+    dissectorDialog->activateWindow();
+
+    qCDebug(lcUi) << "[MainWindow] Opened Dissectors";
+}
+
+void MainWindow::onShowReceiveSearch()
+{
+    if (!receiveStore) {
+        return;
+    }
+    if (!receiveSearchDialog) {
+        receiveSearchDialog = new ReceiveSearchDialog(receiveStore.get(), this);
+    }
+
+    receiveSearchDialog->show();
+    receiveSearchDialog->raise();
+    receiveSearchDialog->activateWindow();
+
+    qCDebug(lcUi) << "[MainWindow] Opened Receive Search";
+}
+
+void MainWindow::configureModbusMonitor()
+{
+    if (!modbusMonitorDialog || !serialPort || !serialPort->isOpen()) {
+        return;
+    }
+    modbusMonitorDialog->setLineParameters(serialPort->baudRate(),
+                                           serialPort->dataBits(),
+                                           serialPort->parity(),
+                                           serialPort->stopBits());
 }
 
 
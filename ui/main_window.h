@@ -5,9 +5,12 @@
 #include <QCheckBox>
 #include <QPushButton>
 #include <QComboBox>
+#include <QTimer>
 #include <memory>
 #include <vector>
 
+#include "lazy_page.h"
+
 class SerialPort;
 class ConfigManager;
 class PreferencesDialog;
@@ -15,6 +18,21 @@ class ATCommandPage;
 class LogPage;
 class ReceiveDataPage;
 class LogViewerDialog;
+class TelemetryDialog;
+class ModbusMonitorDialog;
+class ModbusPollerDialog;
+class DissectorDialog;
+class ReceiveSearchDialog;
+class ReceiveStore;
+class CommandHistoryIndex;
+class UrcMatcher;
+class ChecksumVerifier;
+class StartupLoader;
+class QLabel;
+class QSpacerItem;
+class QCompleter;
+class QStringListModel;
+class QActionGroup;
 
 // 前向声明 UI 类（由 Qt 自动生成）
 namespace Ui {
@@ -37,6 +55,11 @@ public:
     explicit MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+    /**
+     * @brief 接收后台启动阶段的结果（已完成则立即应用，否则完成后应用）
+     */
+    void attachStartup(StartupLoader *loader);
+
 protected:
     void closeEvent(QCloseEvent *event) override;
 
@@ -45,6 +68,7 @@ private slots:
     void onConnectClicked();
     void onClearReceiveArea();
     void onRefreshPorts();
+    void onPortsChanged(const QStringList &added, const QStringList &removed);
     
     // 窗口切换槽
     void onSwitchToMain();
@@ -64,6 +88,11 @@ private slots:
     void onAboutAction();
     void onPreferencesClicked();
     void onShowLogViewer();  // 显示日志查看器
+    void onShowTelemetry();  // 显示遥测曲线
+    void onShowModbusMonitor();  // 显示 Modbus RTU 监视
+    void onShowModbusPoller();  // 显示 Modbus 轮询
+    void onShowDissectors();  // 显示协议解析插件
+    void onShowReceiveSearch();  // 显示接收数据搜索
     
     // 串口信号处理
     void onConnectionStatusChanged(bool connected);
@@ -76,13 +105,27 @@ private:
     void setupDynamicUI();
     void connectSignals();
     void rebuildCommandTable(int rowCount);
-    void applyStyles();
+    void appendCommandRows(int count);  // 在表尾追加快捷指令行
+    void scheduleCommandRowBuild();  // 空闲时分批构建剩余的快捷指令行
+    void restoreCommandRows(int first, int last);  // 从 QSettings 恢复 [first, last) 行的内容
+    void setupLazyPages();
+    void schedulePagePrefetch();
+    void connectReceiveDataPage(ReceiveDataPage *page);
+    void applyTheme(const QString &theme);  // 应用主题并同步菜单与配置
+    void applyChecksum(const QString &name);  // HEX 发送追加校验与接收帧校验
+    void configureModbusMonitor();  // 按当前串口参数设置 Modbus 分帧时间
+    void applyStartup(StartupLoader *loader);
+    void applyLogSettings();  // 日志级别、轮转与数据审计策略
     void loadSettings();
     void saveSettings();
     void updateConnectionStatus(bool connected);
+    void updatePortList(const QStringList &ports);  // 刷新串口下拉框（保留当前选择）
     QString getLineEndSuffix() const;  // 获取行尾符
     void loadTerminalHistory();  // 加载终端历史记录
     void addTerminalHistory(const QString &command);  // 添加终端历史记录
+    void saveTerminalHistory();  // 写入终端历史文件（由 historySaveTimer 合并触发，关闭时立即写入）
+    void refreshTerminalHistoryItems();  // 用最近历史刷新下拉框
+    void updateHistoryCompletions(const QString &text);  // 输入时更新补全候选
     void onHeaderCheckBoxToggled(bool checked);  // 全选/取消全选
 
     // UI 类指针（由 Qt 自动生成的 ui_main_window.h）
@@ -90,22 +133,44 @@ private:
 
     // 配置管理器
     std::unique_ptr<ConfigManager> configManager;
+    bool configReady = false;  // 启动加载完成前不写回配置
     
     // 首选项对话框
     std::unique_ptr<PreferencesDialog> preferencesDialog;
     
-    // AT Command 页面
-    std::unique_ptr<ATCommandPage> atCommandPage;
+    // AT Command 页面（首次使用或空闲预取时构建）
+    LazyPage<ATCommandPage> atCommandPage;
     
-    // Log 页面
-    std::unique_ptr<LogPage> logPage;
+    // Log 页面（首次使用时构建）
+    LazyPage<LogPage> logPage;
     
-    // Receive Data 页面
-    std::unique_ptr<ReceiveDataPage> receiveDataPage;
+    // Receive Data 页面（首次使用时构建）
+    LazyPage<ReceiveDataPage> receiveDataPage;
 
     // 日志查看器对话框
     LogViewerDialog *logViewerDialog;
 
+    // 遥测曲线对话框（首次打开后持续记录接收数据）
+    TelemetryDialog *telemetryDialog = nullptr;
+
+    // Modbus RTU 监视对话框（首次打开后持续解码接收数据）
+    ModbusMonitorDialog *modbusMonitorDialog = nullptr;
+
+    // Modbus 主站轮询对话框（关闭窗口不停止轮询）
+    ModbusPollerDialog *modbusPollerDialog = nullptr;
+
+    // 协议解析插件对话框（首次打开后持续解析接收数据）
+    DissectorDialog *dissectorDialog = nullptr;
+
+    // 接收数据搜索对话框
+    ReceiveSearchDialog *receiveSearchDialog = nullptr;
+
+    // 终端历史索引与补全
+    std::unique_ptr<CommandHistoryIndex> historyIndex;
+    QCompleter *historyCompleter = nullptr;
+    QStringListModel *historyCompletionModel = nullptr;
+    QTimer historySaveTimer;
+
     // 动态创建的快捷指令组件（不在 UI 文件中定义）
     std::vector<QCheckBox*> commandCheckboxes;
     std::vector<QPushButton*> commandButtons;
@@ -117,6 +182,12 @@ private:
     // 快捷指令行数设置
     int currentCommandRows = 100;   // 当前行数
     int maxCommandRows = 300;       // 最大行数
+    int targetCommandRows = 0;      // 需要构建的行数（超出首批的部分在空闲时追加）
+    bool commandRowBuildScheduled = false;
+    QSpacerItem *commandTableSpacer = nullptr;
+
+    // 主题菜单
+    QActionGroup *themeActions = nullptr;
 
     // 统计数据
     int bytesReceived = 0;
@@ -124,6 +195,17 @@ private:
 
     // 串口对象
     std::unique_ptr<SerialPort> serialPort;
+
+    // 接收数据流上的 URC 匹配
+    std::unique_ptr<UrcMatcher> urcMatcher;
+
+    // 原始接收数据存储，供接收数据搜索使用
+    std::unique_ptr<ReceiveStore> receiveStore;
+    QLabel *urcStatusLabel = nullptr;
+
+    // 接收数据的分帧校验（与发送端追加的算法相同）
+    std::unique_ptr<ChecksumVerifier> checksumVerifier;
+    QLabel *checksumStatusLabel = nullptr;
 };
 
 #endif // SCOM_UI_MAIN_WINDOW_H
@@ -1,6 +1,10 @@
 #include "at_command_page.h"
+#include "log_categories.h"
 #include "ui_at_command_page.h"
 #include "config_manager.h"
+#include "serial_port.h"
+#include "at_script_runner.h"
+#include "at_campaign_dialog.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -20,6 +24,16 @@
 #include <QMouseEvent>
 #include <QComboBox>
 #include <QTextEdit>
+#include <QFileInfo>
+#include <QTimer>
+#include <QPointer>
+#include <QThreadPool>
+#include <QCoreApplication>
+#include <QJsonParseError>
+#include <QTextBlock>
+#include <QTextDocument>
+#include <QFileSystemWatcher>
+#include <QDateTime>
 
 // ClickableLineEdit implementation
 ClickableLineEdit::ClickableLineEdit(QWidget *parent)
@@ -54,7 +68,7 @@ ATCommandPage::ATCommandPage(ConfigManager *configManager, QWidget *parent)
         loadATCommandFile(0);
     }
     
-    qDebug() << "[ATCommandPage] Initialized";
+    qCDebug(lcUi) << "[ATCommandPage] Initialized";
 }
 
 ATCommandPage::~ATCommandPage()
@@ -169,6 +183,19 @@ void ATCommandPage::initializePathSelector()
     // ========== 命令编辑器 ==========
     mainLayout->addWidget(ui->commandTextEdit, 1);
 
+    // ========== 脚本执行结果 ==========
+    QLabel *runOutputLabel = new QLabel("执行结果");
+    runOutputLabel->setStyleSheet("font-weight: bold; color: #333333;");
+    mainLayout->addWidget(runOutputLabel);
+
+    runOutput = new QPlainTextEdit();
+    runOutput->setReadOnly(true);
+    runOutput->setMaximumBlockCount(5000);
+    runOutput->setMaximumHeight(160);
+    runOutput->setFont(QFont("Consolas", 9));
+    runOutput->setPlaceholderText("点击 \"运行\" 在已打开的串口上执行当前脚本");
+    mainLayout->addWidget(runOutput);
+
     // 分隔线
     QFrame *line3 = new QFrame();
     line3->setFrameShape(QFrame::HLine);
@@ -208,8 +235,25 @@ void ATCommandPage::initializePathSelector()
     buttonLayout->addWidget(importButton);
     buttonLayout->addWidget(exportButton);
     buttonLayout->addWidget(formatButton);
+    runButton = new QPushButton("▶ 运行");
+    runButton->setMinimumWidth(80);
+    runButton->setMaximumHeight(32);
+    
+    stopButton = new QPushButton("■ 停止");
+    stopButton->setMinimumWidth(80);
+    stopButton->setMaximumHeight(32);
+    stopButton->setEnabled(false);
+    
+    QPushButton *campaignButton = new QPushButton("▶▶ 批量");
+    campaignButton->setMinimumWidth(80);
+    campaignButton->setMaximumHeight(32);
+    campaignButton->setToolTip("在多个串口上并发执行当前脚本");
+    
     buttonLayout->addWidget(validateButton);
     buttonLayout->addStretch();
+    buttonLayout->addWidget(runButton);
+    buttonLayout->addWidget(stopButton);
+    buttonLayout->addWidget(campaignButton);
     
     mainLayout->addLayout(buttonLayout);
 
@@ -217,19 +261,19 @@ void ATCommandPage::initializePathSelector()
     QHBoxLayout *statusLayout = new QHBoxLayout();
     statusLayout->setSpacing(10);
     
-    QLabel *statusIconLabel = new QLabel("●");
+    statusIconLabel = new QLabel("●");
     statusIconLabel->setStyleSheet("color: #4CAF50; font-size: 14pt;");
     statusLayout->addWidget(statusIconLabel);
     
-    QLabel *statusLabel = new QLabel("就绪");
+    statusLabel = new QLabel("就绪");
     statusLabel->setStyleSheet("color: #333333; font-weight: bold;");
     statusLayout->addWidget(statusLabel);
     
     statusLayout->addStretch();
     
-    QLabel *sizeLabel = new QLabel("行数: 0");
-    sizeLabel->setStyleSheet("color: #666666;");
-    statusLayout->addWidget(sizeLabel);
+    lineCountLabel = new QLabel("行数: 0");
+    lineCountLabel->setStyleSheet("color: #666666;");
+    statusLayout->addWidget(lineCountLabel);
     
     mainLayout->addLayout(statusLayout);
 
@@ -258,41 +302,26 @@ void ATCommandPage::initializePathSelector()
     });
     
     connect(loadButton, &QPushButton::clicked, this, [this]() {
+        // 有未保存的编辑时"加载"表示放弃编辑，否则只在文件变化时重新读取
+        SlotCache &cache = slotCache[currentPathIndex];
+        if (cache.document && cache.document->isModified()) {
+            cache.stale = true;
+        }
         loadATCommandFile(currentPathIndex);
     });
     
     connect(saveButton, &QPushButton::clicked, this, &ATCommandPage::onSaveClicked);
     connect(importButton, &QPushButton::clicked, this, &ATCommandPage::onImportClicked);
+    connect(runButton, &QPushButton::clicked, this, &ATCommandPage::onRunClicked);
+    connect(stopButton, &QPushButton::clicked, this, &ATCommandPage::onStopClicked);
+    connect(campaignButton, &QPushButton::clicked, this, &ATCommandPage::onCampaignClicked);
     
-    connect(formatButton, &QPushButton::clicked, this, [this, statusLabel, statusIconLabel]() {
-        // JSON 格式化
-        QString text = ui->commandTextEdit->toPlainText();
-        QJsonDocument doc = QJsonDocument::fromJson(text.toUtf8());
-        if (doc.isNull()) {
-            statusLabel->setText("JSON 格式错误");
-            statusIconLabel->setStyleSheet("color: #F44336; font-size: 14pt;");  // 红色
-        } else {
-            ui->commandTextEdit->setPlainText(QString::fromUtf8(doc.toJson()));
-            statusLabel->setText("格式化完成");
-            statusIconLabel->setStyleSheet("color: #4CAF50; font-size: 14pt;");  // 绿色
-        }
+    connect(formatButton, &QPushButton::clicked, this, [this]() {
+        startValidation(true);
     });
     
-    connect(validateButton, &QPushButton::clicked, this, [this, statusLabel, statusIconLabel]() {
-        QString text = ui->commandTextEdit->toPlainText();
-        QJsonDocument doc = QJsonDocument::fromJson(text.toUtf8());
-        if (doc.isNull()) {
-            statusLabel->setText("JSON 格式错误");
-            statusIconLabel->setStyleSheet("color: #F44336; font-size: 14pt;");  // 红色
-        } else {
-            statusLabel->setText("JSON 格式正确");
-            statusIconLabel->setStyleSheet("color: #4CAF50; font-size: 14pt;");  // 绿色
-        }
-    });
-    
-    connect(ui->commandTextEdit, &QTextEdit::textChanged, this, [this, sizeLabel]() {
-        int lineCount = ui->commandTextEdit->document()->blockCount();
-        sizeLabel->setText(QString("行数: %1").arg(lineCount));
+    connect(validateButton, &QPushButton::clicked, this, [this]() {
+        startValidation(false);
     });
 }
 
@@ -300,7 +329,19 @@ void ATCommandPage::setupConnections()
 {
     connect(ui->commandTextEdit, &QTextEdit::textChanged, this, &ATCommandPage::onTextChanged);
     
-    qDebug() << "[ATCommandPage] Connections established";
+    // 监视各配置槽的文件，外部修改时使对应缓存失效
+    fileWatcher = new QFileSystemWatcher(this);
+    connect(fileWatcher, &QFileSystemWatcher::fileChanged, this, &ATCommandPage::onWatchedFileChanged);
+    
+    // 停止输入一段时间后在后台线程解析校验
+    validateTimer = new QTimer(this);
+    validateTimer->setSingleShot(true);
+    validateTimer->setInterval(kValidateDelayMs);
+    connect(validateTimer, &QTimer::timeout, this, [this]() {
+        startValidation(false);
+    });
+    
+    qCDebug(lcUi) << "[ATCommandPage] Connections established";
 }
 
 void ATCommandPage::loadATCommandFile(int pathIndex)
@@ -310,42 +351,156 @@ void ATCommandPage::loadATCommandFile(int pathIndex)
     }
     
     currentPathIndex = pathIndex;
+    SlotCache &cache = slotCache[pathIndex];
+    if (!cache.document) {
+        cache.document = new QTextDocument(this);
+        cache.document->setDefaultFont(ui->commandTextEdit->font());
+    }
     
-    QString filePath = pathConfigs[pathIndex];
-    if (filePath.isEmpty()) {
-        ui->commandTextEdit->clear();
-        updateFileStatus();
-        return;
+    const QString filePath = pathConfigs[pathIndex];
+    if (cache.filePath != filePath || cache.stale) {
+        readSlotFile(pathIndex);
+    } else if (!filePath.isEmpty() && !cache.document->isModified()) {
+        // 文件监视可能漏报（如网络路径），切换时再用一次 stat 兜底
+        const QFileInfo info(filePath);
+        if (info.lastModified() != cache.lastModified || info.size() != cache.fileSize) {
+            readSlotFile(pathIndex);
+        }
     }
     
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "[ATCommandPage] Failed to open file:" << filePath;
-        updateFileStatus();
-        return;
+    showSlotDocument(pathIndex);
+}
+
+void ATCommandPage::readSlotFile(int slot)
+{
+    SlotCache &cache = slotCache[slot];
+    const QString filePath = pathConfigs[slot];
+    
+    if (cache.filePath != filePath) {
+        const QString previousPath = cache.filePath;
+        cache.filePath = filePath;
+        unwatchIfUnused(previousPath);
     }
+    cache.stale = false;
+    cache.script.reset();
+    cache.lastModified = QDateTime();
+    cache.fileSize = -1;
     
-    QByteArray fileContent = file.readAll();
-    file.close();
+    QString content;
+    if (!filePath.isEmpty()) {
+        QFile file(filePath);
+        if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            content = QString::fromUtf8(file.readAll());
+            file.close();
+            qCDebug(lcUi) << "[ATCommandPage] Loaded AT command file:" << filePath;
+        } else {
+            qCWarning(lcUi) << "[ATCommandPage] Failed to open file:" << filePath;
+        }
+        
+        const QFileInfo info(filePath);
+        if (info.exists()) {
+            cache.lastModified = info.lastModified();
+            cache.fileSize = info.size();
+            if (!fileWatcher->files().contains(filePath)) {
+                fileWatcher->addPath(filePath);
+            }
+        }
+    }
     
-    ui->commandTextEdit->setPlainText(QString::fromUtf8(fileContent));
-    textModified = false;
+    cache.document->setPlainText(content);
+    cache.document->setModified(false);
+}
+
+void ATCommandPage::showSlotDocument(int slot)
+{
+    QTextDocument *document = slotCache[slot].document;
+    if (ui->commandTextEdit->document() != document) {
+        disconnect(blockCountConnection);
+        ui->commandTextEdit->setDocument(document);
+        // 行数由文档在编辑时增量维护，只在块数变化时更新标签
+        blockCountConnection = connect(document, &QTextDocument::blockCountChanged, this, [this](int lineCount) {
+            lineCountLabel->setText(QString("行数: %1").arg(lineCount));
+        });
+    }
+    lineCountLabel->setText(QString("行数: %1").arg(document->blockCount()));
+    
+    ui->commandTextEdit->setExtraSelections({});
+    textModified = document->isModified();
     updateFileStatus();
     
-    qDebug() << "[ATCommandPage] Loaded AT command file:" << filePath;
+    ++validateGeneration;
+    startValidation(false);
+}
+
+void ATCommandPage::unwatchIfUnused(const QString &filePath)
+{
+    if (filePath.isEmpty() || !fileWatcher) {
+        return;
+    }
+    for (const SlotCache &cache : slotCache) {
+        if (cache.filePath == filePath) {
+            return;
+        }
+    }
+    fileWatcher->removePath(filePath);
+}
+
+void ATCommandPage::onWatchedFileChanged(const QString &filePath)
+{
+    const QFileInfo info(filePath);
+    // 保存时先删除再重命名的编辑器会让监视失效，文件重新出现后补上
+    if (info.exists() && !fileWatcher->files().contains(filePath)) {
+        fileWatcher->addPath(filePath);
+    }
+    
+    for (int slot = 0; slot < static_cast<int>(slotCache.size()); ++slot) {
+        SlotCache &cache = slotCache[slot];
+        if (!cache.document || cache.filePath != filePath) {
+            continue;
+        }
+        // 本页面自己保存引起的通知
+        if (info.exists() && info.lastModified() == cache.lastModified && info.size() == cache.fileSize) {
+            continue;
+        }
+        
+        if (cache.document->isModified()) {
+            // 不覆盖未保存的编辑
+            if (slot == currentPathIndex) {
+                showStatus("文件已在外部修改（当前有未保存的编辑）", false);
+            }
+        } else if (slot == currentPathIndex) {
+            readSlotFile(slot);
+            showSlotDocument(slot);
+            showStatus("文件已在外部更新，已重新加载", true);
+        } else {
+            cache.stale = true;
+        }
+    }
+}
+
+std::shared_ptr<const ATScriptRunner::Script> ATCommandPage::cachedScript(int slot) const
+{
+    if (slot < 0 || slot >= static_cast<int>(slotCache.size())) {
+        return nullptr;
+    }
+    const SlotCache &cache = slotCache[slot];
+    if (!cache.document || !cache.script || cache.scriptRevision != cache.document->revision()) {
+        return nullptr;
+    }
+    return cache.script;
 }
 
 void ATCommandPage::saveATCommandFile()
 {
     QString filePath = getATCommandFilePath();
     if (filePath.isEmpty()) {
-        qWarning() << "[ATCommandPage] No file path selected";
+        qCWarning(lcUi) << "[ATCommandPage] No file path selected";
         return;
     }
     
     QFile file(filePath);
     if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qWarning() << "[ATCommandPage] Failed to save file:" << filePath;
+        qCWarning(lcUi) << "[ATCommandPage] Failed to save file:" << filePath;
         return;
     }
     
@@ -353,10 +508,24 @@ void ATCommandPage::saveATCommandFile()
     file.write(content.toUtf8());
     file.close();
     
+    // 记录保存后的文件状态，自己的写入不会被当作外部修改
+    SlotCache &cache = slotCache[currentPathIndex];
+    if (cache.document) {
+        cache.document->setModified(false);
+        cache.filePath = filePath;
+        cache.stale = false;
+        const QFileInfo info(filePath);
+        cache.lastModified = info.lastModified();
+        cache.fileSize = info.size();
+        if (!fileWatcher->files().contains(filePath)) {
+            fileWatcher->addPath(filePath);
+        }
+    }
+    
     textModified = false;
     updateFileStatus();
     
-    qDebug() << "[ATCommandPage] Saved AT command file:" << filePath;
+    qCDebug(lcUi) << "[ATCommandPage] Saved AT command file:" << filePath;
 }
 
 void ATCommandPage::onSaveClicked()
@@ -394,7 +563,7 @@ void ATCommandPage::onRadioButtonToggled(int index, bool checked)
         }
         
         loadATCommandFile(index);
-        qDebug() << "[ATCommandPage] Switched to path" << (index + 1);
+        qCDebug(lcUi) << "[ATCommandPage] Switched to path" << (index + 1);
     }
 }
 
@@ -418,6 +587,134 @@ void ATCommandPage::onTextChanged()
 {
     textModified = true;
     updateFileStatus();
+    
+    // 使进行中的校验结果作废，并重新计时
+    ++validateGeneration;
+    if (validateTimer) {
+        validateTimer->start();
+    }
+}
+
+ATCommandPage::ValidationResult ATCommandPage::validateText(const QString &text, bool format)
+{
+    ValidationResult result;
+    if (text.trimmed().isEmpty()) {
+        result.ok = true;
+        result.message = "就绪";
+        return result;
+    }
+    const QByteArray utf8 = text.toUtf8();
+    
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(utf8, &parseError);
+    if (doc.isNull()) {
+        // 错误偏移是 UTF-8 字节偏移，换算成行号和字符列
+        const int offset = qBound(0, parseError.offset, static_cast<int>(utf8.size()));
+        const int lineStart = offset > 0 ? static_cast<int>(utf8.lastIndexOf('\n', offset - 1)) + 1 : 0;
+        result.line = static_cast<int>(utf8.left(offset).count('\n'));
+        result.column = static_cast<int>(QString::fromUtf8(utf8.constData() + lineStart, offset - lineStart).size());
+        result.message = QString("JSON 格式错误 (第 %1 行, 第 %2 列): %3")
+            .arg(result.line + 1)
+            .arg(result.column + 1)
+            .arg(parseError.errorString());
+        return result;
+    }
+    
+    result.ok = true;
+    auto script = std::make_shared<ATScriptRunner::Script>();
+    QString scriptError;
+    if (ATScriptRunner::parse(doc, script.get(), &scriptError)) {
+        result.message = QString("JSON 格式正确 · %1 条命令").arg(script->commands.size());
+        result.script = script;
+    } else {
+        result.message = QString("JSON 格式正确（不可执行: %1）").arg(scriptError);
+    }
+    if (format) {
+        result.formatted = QString::fromUtf8(doc.toJson());
+    }
+    return result;
+}
+
+void ATCommandPage::startValidation(bool format)
+{
+    if (validateTimer) {
+        validateTimer->stop();
+    }
+    
+    const quint64 generation = validateGeneration;
+    const int slot = currentPathIndex;
+    const int revision = ui->commandTextEdit->document()->revision();
+    const QString text = ui->commandTextEdit->toPlainText();
+    if (!format && validationValid && slot == lastValidatedSlot && text == lastValidatedText) {
+        // 内容没变（如撤销回原样），直接沿用上次结果
+        return;
+    }
+    
+    if (format) {
+        showStatus("正在格式化...", true);
+    }
+    
+    QPointer<ATCommandPage> self(this);
+    QThreadPool::globalInstance()->start([self, text, generation, slot, revision, format]() {
+        const ValidationResult result = validateText(text, format);
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [self, text, generation, slot, revision, format, result]() {
+            if (self) {
+                self->onValidationFinished(generation, slot, revision, text, format, result);
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+void ATCommandPage::onValidationFinished(quint64 generation, int slot, int revision, const QString &text,
+                                         bool format, const ValidationResult &result)
+{
+    // 解析期间文本又被修改，等待下一轮
+    if (generation != validateGeneration) {
+        return;
+    }
+    
+    if (format && result.ok) {
+        ui->commandTextEdit->setPlainText(result.formatted);
+        showStatus("格式化完成", true);
+        return;
+    }
+    
+    lastValidatedText = text;
+    lastValidatedSlot = slot;
+    validationValid = true;
+    
+    // 解析结果随文档缓存，运行脚本时直接复用
+    if (slot >= 0 && slot < static_cast<int>(slotCache.size())) {
+        slotCache[slot].script = result.script;
+        slotCache[slot].scriptRevision = revision;
+    }
+    showStatus(result.message, result.ok);
+    
+    QList<QTextEdit::ExtraSelection> selections;
+    if (!result.ok && result.line >= 0) {
+        QTextBlock block = ui->commandTextEdit->document()->findBlockByNumber(result.line);
+        if (block.isValid()) {
+            // 整行浅红底色 + 出错位置波浪下划线
+            QTextEdit::ExtraSelection lineSelection;
+            lineSelection.format.setBackground(QColor(244, 67, 54, 40));
+            lineSelection.format.setProperty(QTextFormat::FullWidthSelection, true);
+            lineSelection.cursor = QTextCursor(block);
+            selections.append(lineSelection);
+            
+            QTextEdit::ExtraSelection errorSelection;
+            errorSelection.format.setUnderlineStyle(QTextCharFormat::WaveUnderline);
+            errorSelection.format.setUnderlineColor(QColor("#F44336"));
+            errorSelection.cursor = QTextCursor(block);
+            errorSelection.cursor.movePosition(QTextCursor::Right, QTextCursor::MoveAnchor,
+                                               qMin(result.column, qMax(0, block.length() - 2)));
+            errorSelection.cursor.movePosition(QTextCursor::EndOfBlock, QTextCursor::KeepAnchor);
+            if (!errorSelection.cursor.hasSelection()) {
+                errorSelection.cursor.movePosition(QTextCursor::Left, QTextCursor::KeepAnchor);
+            }
+            selections.append(errorSelection);
+        }
+    }
+    ui->commandTextEdit->setExtraSelections(selections);
 }
 
 void ATCommandPage::selectJsonFile(QLineEdit *pathInput)
@@ -448,6 +745,133 @@ void ATCommandPage::updateFileStatus()
     // This function is kept for compatibility but does nothing
 }
 
+void ATCommandPage::setSerialPort(SerialPort *port)
+{
+    if (scriptRunner) {
+        scriptRunner->stop();
+        delete scriptRunner;
+        scriptRunner = nullptr;
+    }
+    serialPort = port;
+    if (!serialPort) {
+        return;
+    }
+    
+    scriptRunner = new ATScriptRunner(serialPort, this);
+    
+    connect(scriptRunner, &ATScriptRunner::commandSent, this, [this](int index, const QString &command, int attempt) {
+        QString line = QString("→ [%1] %2").arg(index + 1).arg(command);
+        if (attempt > 1) {
+            line += QString("  (第 %1 次)").arg(attempt);
+        }
+        appendRunOutput(line);
+    });
+    
+    connect(scriptRunner, &ATScriptRunner::commandFinished, this, [this](const ATCommandResult &result) {
+        QString line = QString("← [%1] %2  %3 ms")
+            .arg(result.index + 1)
+            .arg(ATCommandResult::statusName(result.status))
+            .arg(result.latencyMs);
+        if (!result.response.isEmpty()) {
+            line += "  | " + result.response.join(" / ");
+        }
+        if (!result.ok() && !result.finalResult.isEmpty()) {
+            line += "  | " + result.finalResult;
+        }
+        appendRunOutput(line);
+    });
+    
+    connect(scriptRunner, &ATScriptRunner::variableCaptured, this, [this](const QString &name, const QString &value) {
+        appendRunOutput(QString("    ${%1} = %2").arg(name, value));
+    });
+    
+    connect(scriptRunner, &ATScriptRunner::finished, this, [this](int passed, int failed, bool aborted) {
+        runButton->setEnabled(true);
+        stopButton->setEnabled(false);
+        
+        QString summary = QString("执行结束: 通过 %1, 失败 %2").arg(passed).arg(failed);
+        if (aborted) {
+            summary += " (提前结束)";
+        }
+        appendRunOutput(summary);
+        showStatus(summary, failed == 0 && !aborted);
+    });
+}
+
+void ATCommandPage::onRunClicked()
+{
+    if (!scriptRunner || !serialPort || !serialPort->isOpen()) {
+        showStatus("串口未打开", false);
+        return;
+    }
+    
+    // 优先复用后台校验时解析好的脚本
+    ATScriptRunner::Script script;
+    QString error;
+    if (const auto cached = cachedScript(currentPathIndex)) {
+        script = *cached;
+    } else if (!ATScriptRunner::parse(ui->commandTextEdit->toPlainText().toUtf8(), &script, &error)) {
+        showStatus(error, false);
+        return;
+    }
+    if (script.name.isEmpty()) {
+        script.name = QFileInfo(getATCommandFilePath()).fileName();
+    }
+    
+    runOutput->clear();
+    if (!scriptRunner->start(script)) {
+        showStatus("脚本无法启动", false);
+        return;
+    }
+    
+    runButton->setEnabled(false);
+    stopButton->setEnabled(true);
+    showStatus(QString("正在执行 %1 条命令...").arg(script.commands.size()), true);
+}
+
+void ATCommandPage::onCampaignClicked()
+{
+    ATScriptRunner::Script script;
+    QString error;
+    if (const auto cached = cachedScript(currentPathIndex)) {
+        script = *cached;
+    } else if (!ATScriptRunner::parse(ui->commandTextEdit->toPlainText().toUtf8(), &script, &error)) {
+        showStatus(error, false);
+        return;
+    }
+    if (script.name.isEmpty()) {
+        script.name = QFileInfo(getATCommandFilePath()).fileName();
+    }
+    
+    const QString busyPort = serialPort && serialPort->isOpen() ? serialPort->portName() : QString();
+    ATCampaignDialog *dialog = new ATCampaignDialog(script, busyPort, this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->show();
+}
+
+void ATCommandPage::onStopClicked()
+{
+    if (scriptRunner) {
+        scriptRunner->stop();
+    }
+}
+
+void ATCommandPage::showStatus(const QString &text, bool ok)
+{
+    if (!statusLabel || !statusIconLabel) {
+        return;
+    }
+    statusLabel->setText(text);
+    statusIconLabel->setStyleSheet(ok ? "color: #4CAF50; font-size: 14pt;" : "color: #F44336; font-size: 14pt;");
+}
+
+void ATCommandPage::appendRunOutput(const QString &line)
+{
+    if (runOutput) {
+        runOutput->appendPlainText(line);
+    }
+}
+
 void ATCommandPage::setPathRadioButtonChecked(int index)
 {
     if (index >= 0 && index < static_cast<int>(pathRadioButtons.size())) {
@@ -1,5 +1,8 @@
 #include "log_page.h"
 #include "log_manager.h"
+#include "log_filter_bar.h"
+#include "async_log_writer.h"
+#include "log_segments.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -7,12 +10,18 @@
 #include <QMessageBox>
 #include <QFileDialog>
 #include <QStandardPaths>
+#include <QFileInfo>
 
 LogPage::LogPage(QWidget *parent)
     : QWidget(parent)
 {
+    searchEngine = new LogSearchEngine(this);
+    
     setupUI();
     connectSignals();
+    
+    // 每秒刷新统计，并从内存环形缓冲追加新日志
+    statsTimer.start(1000);
 }
 
 LogPage::~LogPage()
@@ -27,9 +36,8 @@ void LogPage::setupUI()
     
     // 搜索工具栏
     QHBoxLayout *searchLayout = new QHBoxLayout();
-    searchLineEdit = new QLineEdit(this);
-    searchLineEdit->setPlaceholderText("搜索日志...");
-    searchLineEdit->setMaximumWidth(300);
+    filterBar = new LogFilterBar(this);
+    filterBar->setPlaceholderText("搜索日志...");
     
     refreshButton = new QPushButton("刷新", this);
     refreshButton->setMaximumWidth(80);
@@ -41,9 +49,9 @@ void LogPage::setupUI()
     exportButton->setMaximumWidth(80);
     
     statsLabel = new QLabel("已加载 0 条日志", this);
+    liveStatsLabel = new QLabel(this);
     
-    searchLayout->addWidget(searchLineEdit);
-    searchLayout->addStretch();
+    searchLayout->addWidget(filterBar, 1);
     searchLayout->addWidget(refreshButton);
     searchLayout->addWidget(clearButton);
     searchLayout->addWidget(exportButton);
@@ -53,11 +61,16 @@ void LogPage::setupUI()
     // 日志显示区域
     logDisplay = new QPlainTextEdit(this);
     logDisplay->setReadOnly(true);
+    logDisplay->setMaximumBlockCount(kMaxDisplayLines);
     logDisplay->setFont(QFont("Consolas", 10));
     mainLayout->addWidget(logDisplay);
     
     // 状态栏
-    mainLayout->addWidget(statsLabel);
+    QHBoxLayout *statusLayout = new QHBoxLayout();
+    statusLayout->addWidget(statsLabel);
+    statusLayout->addStretch();
+    statusLayout->addWidget(liveStatsLabel);
+    mainLayout->addLayout(statusLayout);
     
     setLayout(mainLayout);
 }
@@ -67,17 +80,27 @@ void LogPage::connectSignals()
     connect(refreshButton, &QPushButton::clicked, this, &LogPage::onRefreshButtonClicked);
     connect(clearButton, &QPushButton::clicked, this, &LogPage::onClearLogsButtonClicked);
     connect(exportButton, &QPushButton::clicked, this, &LogPage::onExportButtonClicked);
-    connect(searchLineEdit, &QLineEdit::textChanged, this, &LogPage::onSearchTextChanged);
+    connect(filterBar, &LogFilterBar::queryChanged, this, &LogPage::onSearchQueryChanged);
+    connect(searchEngine, &LogSearchEngine::resultsReady, this, &LogPage::onSearchResults);
+    connect(searchEngine, &LogSearchEngine::finished, this, &LogPage::onSearchFinished);
+    connect(&statsTimer, &QTimer::timeout, this, &LogPage::onStatsTimerTimeout);
 }
 
 void LogPage::refreshLogs()
 {
-    fullLogContent = LogManager::instance().getLastLogs(10000);
+    const QString content = LogManager::instance().getLastLogs(kMaxLoadedLines);
+    LogManager::instance().getRecentEntries(0, 0, &lastSequence);
+    
+    logLines = content.isEmpty() ? QStringList() : content.split('\n');
     
-    logDisplay->setPlainText(fullLogContent);
+    if (searchActive) {
+        // 有过滤条件时重新在整个文件上搜索
+        onSearchQueryChanged();
+        return;
+    }
     
-    int lineCount = fullLogContent.split("\n").size();
-    statsLabel->setText(QString("已加载 %1 条日志").arg(lineCount));
+    logDisplay->setPlainText(content);
+    statsLabel->setText(QString("已加载 %1 条日志").arg(logLines.size()));
     
     // 滚动到底部
     logDisplay->moveCursor(logDisplay->textCursor().MoveOperation::End);
@@ -92,7 +115,7 @@ void LogPage::onClearLogsButtonClicked()
 {
     if (QMessageBox::question(this, "确认清空", "确定要清空所有日志吗？", QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes) {
         logDisplay->clear();
-        fullLogContent.clear();
+        logLines.clear();
         statsLabel->setText("已加载 0 条日志");
     }
 }
@@ -117,21 +140,115 @@ void LogPage::onExportButtonClicked()
     }
 }
 
-void LogPage::onSearchTextChanged(const QString &text)
+void LogPage::onSearchQueryChanged()
+{
+    const LogSearchQuery query = filterBar->query();
+    
+    if (query.isEmpty()) {
+        searchEngine->cancel();
+        searchActive = false;
+        entriesDuringSearch.clear();
+        logDisplay->setPlainText(logLines.join('\n'));
+        logDisplay->moveCursor(QTextCursor::End);
+        statsLabel->setText(QString("已加载 %1 条日志").arg(logLines.size()));
+        return;
+    }
+    
+    activeMatcher = LogLineMatcher(query);
+    if (!activeMatcher.isValid()) {
+        searchEngine->cancel();
+        statsLabel->setText(QString("正则表达式错误: %1").arg(activeMatcher.errorString()));
+        return;
+    }
+    
+    // 先落盘再确定搜索范围，之后到达的新行由环形缓冲追加，不重复也不遗漏
+    AsyncLogWriter::instance().flush();
+    const QString logFilePath = LogManager::instance().getLogFilePath();
+    LogManager::instance().getRecentEntries(0, 0, &lastSequence);
+    
+    searchActive = true;
+    searchMatchCount = 0;
+    entriesDuringSearch.clear();
+    logDisplay->clear();
+    statsLabel->setText("搜索中...");
+    // 搜索范围覆盖已轮转（含压缩）的分段
+    QVector<LogSearchSource> sources;
+    for (const QString &segment : LogSegments::rotatedSegments(logFilePath)) {
+        sources.append(LogSearchSource{segment, -1});
+    }
+    sources.append(LogSearchSource{logFilePath, QFileInfo(logFilePath).size()});
+    searchGeneration = searchEngine->start(sources, query);
+}
+
+void LogPage::onSearchResults(quint64 generation, const QStringList &lines)
 {
-    if (text.isEmpty()) {
-        logDisplay->setPlainText(fullLogContent);
+    if (generation != searchGeneration) {
         return;
     }
     
-    QStringList lines = fullLogContent.split("\n", Qt::KeepEmptyParts);
-    QStringList filteredLines;
+    logDisplay->appendPlainText(lines.join('\n'));
+    searchMatchCount += lines.size();
+    statsLabel->setText(QString("搜索中... 已找到 %1 条").arg(searchMatchCount));
+}
+
+void LogPage::onSearchFinished(quint64 generation, int matchCount, bool truncated)
+{
+    if (generation != searchGeneration) {
+        return;
+    }
     
-    for (const QString &line : lines) {
-        if (line.contains(text, Qt::CaseInsensitive)) {
-            filteredLines.append(line);
+    for (const QString &entry : std::as_const(entriesDuringSearch)) {
+        if (activeMatcher.matches(entry)) {
+            logDisplay->appendPlainText(entry);
+            ++matchCount;
         }
     }
+    entriesDuringSearch.clear();
+    searchMatchCount = matchCount;
     
-    logDisplay->setPlainText(filteredLines.join("\n"));
+    statsLabel->setText(truncated
+        ? QString("找到 %1 条匹配（已达上限，请缩小搜索范围）").arg(matchCount)
+        : QString("找到 %1 条匹配").arg(matchCount));
+}
+
+void LogPage::onStatsTimerTimeout()
+{
+    const LogManager::LogStats stats = LogManager::instance().getStats();
+    liveStatsLabel->setText(stats.summary());
+    
+    // 页面未显示或尚未加载过时不追加，下次 refreshLogs 会重新读取
+    if (!isVisible() || lastSequence == 0) {
+        return;
+    }
+    
+    const QStringList newEntries = LogManager::instance().getRecentEntries(-1, lastSequence, &lastSequence);
+    if (newEntries.isEmpty()) {
+        return;
+    }
+    
+    logLines.append(newEntries);
+    if (logLines.size() > kMaxLoadedLines) {
+        logLines.erase(logLines.begin(), logLines.end() - kMaxLoadedLines);
+    }
+    
+    if (!searchActive) {
+        statsLabel->setText(QString("已加载 %1 条日志").arg(logLines.size()));
+        logDisplay->appendPlainText(newEntries.join("\n"));
+        return;
+    }
+    
+    if (searchEngine->isRunning()) {
+        // 等搜索结果全部到达后再追加，保持时间顺序
+        entriesDuringSearch.append(newEntries);
+        return;
+    }
+    
+    // 只把符合当前搜索条件的新行追加到视图
+    for (const QString &entry : newEntries) {
+        if (activeMatcher.matches(entry)) {
+            logDisplay->appendPlainText(entry);
+            ++searchMatchCount;
+        }
+    }
+    statsLabel->setText(QString("找到 %1 条匹配").arg(searchMatchCount));
 }
@@ -1,4 +1,5 @@
 #include "receive_data_page.h"
+#include "log_categories.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -85,7 +86,7 @@ void ReceiveDataPage::setupUI()
 void ReceiveDataPage::connectSignals()
 {
     if (!receiveArea || !terminalInput) {
-        qWarning() << "[ReceiveDataPage] Failed to connect signals: null pointer";
+        qCWarning(lcUi) << "[ReceiveDataPage] Failed to connect signals: null pointer";
         return;
     }
     
@@ -99,7 +100,7 @@ void ReceiveDataPage::connectSignals()
         });
     }
     
-    qDebug() << "[ReceiveDataPage] Page initialized";
+    qCDebug(lcUi) << "[ReceiveDataPage] Page initialized";
 }
 
 void ReceiveDataPage::syncReceiveAreaFromMain(const QString &text)
@@ -0,0 +1,412 @@
+#include "log_file_view.h"
+#include "log_search.h"
+
+#include <QFileInfo>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QScrollBar>
+#include <QThread>
+#include <climits>
+#include <cstring>
+
+namespace {
+
+constexpr qint64 kReadBlock = 1024 * 1024;        // 建索引时每次读取的字节数
+constexpr qint64 kReportBytes = 16 * 1024 * 1024; // 每索引这么多字节向界面报告一次
+constexpr int kHeadLength = 64;
+constexpr int kTextMargin = 6;
+
+} // namespace
+
+LogFileView::LogFileView(QWidget *parent)
+    : QAbstractScrollArea(parent)
+{
+    setFont(QFont("Consolas", 10));
+    viewport()->setAutoFillBackground(false);
+    verticalScrollBar()->setSingleStep(1);
+    horizontalScrollBar()->setSingleStep(20);
+}
+
+LogFileView::~LogFileView()
+{
+    closeFile();
+}
+
+bool LogFileView::openFile(const QString &filePath, bool liveFile)
+{
+    closeFile();
+
+    path = filePath;
+    live = liveFile;
+    file.setFileName(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        lastError = file.errorString();
+        return false;
+    }
+    if (!mapFile()) {
+        file.close();
+        return false;
+    }
+
+    fileHead = file.read(qMin<qint64>(kHeadLength, fileBytes));
+    sparseOffsets.assign(1, 0);
+    completeLines = 0;
+    indexedEnd = 0;
+    maxLineWidth = 0;
+
+    startIndexing();
+    updateScrollBars();
+    viewport()->update();
+    return true;
+}
+
+void LogFileView::closeFile()
+{
+    stopIndexing();
+    unmapFile();
+    if (file.isOpen()) {
+        file.close();
+    }
+    sparseOffsets.clear();
+    completeLines = 0;
+    indexedEnd = 0;
+    fileHead.clear();
+    liveWindow.clear();
+    updateScrollBars();
+    viewport()->update();
+}
+
+void LogFileView::reload()
+{
+    if (path.isEmpty()) {
+        return;
+    }
+
+    QFile probe(path);
+    if (!probe.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    const qint64 newSize = probe.size();
+    const QByteArray head = probe.read(kHeadLength);
+    probe.close();
+
+    if (newSize < fileBytes || !head.startsWith(fileHead)) {
+        // 文件被截断、轮转或替换
+        openFile(path, live);
+        return;
+    }
+    if (newSize == fileBytes) {
+        return;
+    }
+
+    // 只重新映射，索引从上次的完整行之后继续
+    stopIndexing();
+    unmapFile();
+    liveWindow.clear();
+    if (!mapFile()) {
+        updateScrollBars();
+        viewport()->update();
+        return;
+    }
+    if (fileHead.size() < kHeadLength) {
+        fileHead = head;
+    }
+    startIndexing();
+    updateScrollBars();
+    viewport()->update();
+}
+
+qint64 LogFileView::lineCount() const
+{
+    // 索引完成后，末尾没有换行符的半行也显示出来
+    const bool trailingLine = !indexing && fileBytes > indexedEnd;
+    return completeLines + (trailingLine ? 1 : 0);
+}
+
+void LogFileView::scrollToLine(qint64 line)
+{
+    verticalScrollBar()->setValue(static_cast<int>(qBound<qint64>(0, line, INT_MAX)));
+}
+
+void LogFileView::setFollowTail(bool follow)
+{
+    followTail = follow;
+    if (followTail) {
+        verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+    }
+}
+
+bool LogFileView::mapFile()
+{
+    fileBytes = file.size();
+    if (fileBytes == 0 || live) {
+        mapped = nullptr;
+        return true;
+    }
+
+    mapped = file.map(0, fileBytes);
+    if (!mapped) {
+        lastError = file.errorString();
+        fileBytes = 0;
+        return false;
+    }
+    return true;
+}
+
+void LogFileView::unmapFile()
+{
+    if (mapped) {
+        file.unmap(const_cast<uchar *>(mapped));
+        mapped = nullptr;
+    }
+    fileBytes = 0;
+}
+
+void LogFileView::startIndexing()
+{
+    if (indexedEnd >= fileBytes) {
+        indexing = false;
+        emit indexFinished(lineCount());
+        return;
+    }
+
+    const QString filePath = path;
+    const qint64 from = indexedEnd;
+    const qint64 startLine = completeLines;
+    const qint64 end = fileBytes;
+    const quint64 generation = ++indexGeneration;
+    auto cancelled = std::make_shared<std::atomic<bool>>(false);
+    indexCancelled = cancelled;
+    indexing = true;
+
+    // 索引线程用普通读取而不是映射，扫描过的页面不会计入本进程常驻内存
+    indexThread.reset(QThread::create([this, filePath, from, startLine, end, cancelled, generation]() {
+        std::vector<qint64> sparse;
+        qint64 lines = startLine;
+        qint64 lastLineEnd = from;
+
+        auto post = [&](bool done) {
+            QMetaObject::invokeMethod(this, [this, generation, sparse, lines, lastLineEnd, done]() {
+                onIndexBatch(generation, sparse, lines, lastLineEnd, done);
+            }, Qt::QueuedConnection);
+            sparse.clear();
+        };
+
+        QFile source(filePath);
+        if (!source.open(QIODevice::ReadOnly) || !source.seek(from)) {
+            post(true);
+            return;
+        }
+
+        qint64 position = from;
+        qint64 nextReport = from + kReportBytes;
+        while (position < end && !cancelled->load(std::memory_order_relaxed)) {
+            const QByteArray block = source.read(qMin(kReadBlock, end - position));
+            if (block.isEmpty()) {
+                break;
+            }
+
+            const char *data = block.constData();
+            const char *blockEnd = data + block.size();
+            const char *cursor = data;
+            while (cursor < blockEnd) {
+                const char *newline = static_cast<const char *>(
+                    std::memchr(cursor, '\n', static_cast<size_t>(blockEnd - cursor)));
+                if (!newline) {
+                    break;
+                }
+                ++lines;
+                lastLineEnd = position + (newline - data) + 1;
+                if (lines % kSparseStep == 0) {
+                    sparse.push_back(lastLineEnd);
+                }
+                cursor = newline + 1;
+            }
+
+            position += block.size();
+            if (position >= nextReport) {
+                post(false);
+                nextReport = position + kReportBytes;
+            }
+        }
+
+        if (!cancelled->load(std::memory_order_relaxed)) {
+            post(true);
+        }
+    }));
+    indexThread->setObjectName("LogFileViewIndex");
+    indexThread->start(QThread::LowPriority);
+}
+
+void LogFileView::stopIndexing()
+{
+    if (indexCancelled) {
+        indexCancelled->store(true, std::memory_order_relaxed);
+    }
+    if (indexThread) {
+        indexThread->wait();
+        indexThread.reset();
+    }
+    // 使尚未送达的批次失效，索引从已应用的位置继续
+    ++indexGeneration;
+    indexing = false;
+}
+
+void LogFileView::onIndexBatch(quint64 generation, const std::vector<qint64> &sparse,
+                               qint64 lines, qint64 lastLineEnd, bool done)
+{
+    if (generation != indexGeneration) {
+        return;
+    }
+
+    sparseOffsets.insert(sparseOffsets.end(), sparse.begin(), sparse.end());
+    completeLines = lines;
+    indexedEnd = lastLineEnd;
+    if (done) {
+        indexing = false;
+    }
+
+    const bool atBottom = verticalScrollBar()->value() == verticalScrollBar()->maximum();
+    updateScrollBars();
+    if (followTail && atBottom) {
+        verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+    }
+    viewport()->update();
+
+    emit indexProgress(indexedEnd, fileBytes, completeLines);
+    if (done) {
+        emit indexFinished(lineCount());
+    }
+}
+
+const char *LogFileView::window(qint64 from, qint64 *available)
+{
+    if (mapped) {
+        *available = fileBytes - from;
+        return reinterpret_cast<const char *>(mapped) + from;
+    }
+
+    // live 文件：窗口不超过上次 reload 时的大小；之后被截断时读到的字节变少，不会越界
+    const qint64 wanted = qMin(kLiveWindowBytes, fileBytes - from);
+    const qint64 cachedEnd = liveWindowStart + liveWindow.size();
+    if (liveWindow.isEmpty() || from < liveWindowStart || from + wanted > cachedEnd) {
+        liveWindow.clear();
+        liveWindowStart = from;
+        if (file.seek(from)) {
+            liveWindow = file.read(wanted);
+        }
+    }
+    *available = liveWindowStart + liveWindow.size() - from;
+    return liveWindow.constData() + (from - liveWindowStart);
+}
+
+void LogFileView::updateScrollBars()
+{
+    const int lineHeight = qMax(1, fontMetrics().height());
+    const int visibleLines = qMax(1, viewport()->height() / lineHeight);
+    const qint64 lines = lineCount();
+
+    verticalScrollBar()->setPageStep(visibleLines);
+    // QScrollBar 范围为 int，超过 21 亿行的部分无法滚动到（单文件实际不会达到）
+    verticalScrollBar()->setRange(0, static_cast<int>(qBound<qint64>(0, lines - visibleLines, INT_MAX)));
+
+    horizontalScrollBar()->setPageStep(viewport()->width());
+    horizontalScrollBar()->setRange(0, qMax(0, maxLineWidth - viewport()->width()));
+}
+
+void LogFileView::resizeEvent(QResizeEvent *event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBars();
+}
+
+void LogFileView::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(viewport());
+    painter.fillRect(viewport()->rect(), QColor("#1e1e1e"));
+    painter.setFont(font());
+
+    const qint64 lines = lineCount();
+    if (lines == 0) {
+        painter.setPen(QColor("#808080"));
+        painter.drawText(viewport()->rect(), Qt::AlignCenter,
+                         path.isEmpty() ? QString() : (indexing ? "正在建立索引..." : "文件为空"));
+        return;
+    }
+
+    const QFontMetrics metrics = fontMetrics();
+    const int lineHeight = qMax(1, metrics.height());
+    const int gutterWidth = metrics.horizontalAdvance(QString::number(lines)) + 2 * kTextMargin;
+    const int textX = gutterWidth + kTextMargin - horizontalScrollBar()->value();
+    const int visibleLines = viewport()->height() / lineHeight + 1;
+    const qint64 firstLine = verticalScrollBar()->value();
+
+    // 从首个可见行所在的稀疏索引点开始取数据，偏移均相对于该点
+    const qint64 block = firstLine / kSparseStep;
+    qint64 available = 0;
+    const char *data = block < static_cast<qint64>(sparseOffsets.size())
+        ? window(sparseOffsets[static_cast<size_t>(block)], &available)
+        : nullptr;
+    auto lineEnd = [&](qint64 start) {
+        const void *newline = std::memchr(data + start, '\n', static_cast<size_t>(available - start));
+        return newline ? static_cast<const char *>(newline) - data : available;
+    };
+
+    qint64 offset = data && available > 0 ? 0 : -1;
+    for (qint64 skip = firstLine % kSparseStep; skip > 0 && offset >= 0; --skip) {
+        const qint64 end = lineEnd(offset);
+        offset = end < available ? end + 1 : -1;
+    }
+    if (offset >= available) {
+        offset = -1;
+    }
+    int widest = maxLineWidth;
+
+    painter.save();
+    painter.setClipRect(QRect(gutterWidth, 0, viewport()->width() - gutterWidth, viewport()->height()));
+    for (int i = 0; i < visibleLines && offset >= 0 && firstLine + i < lines; ++i) {
+        const qint64 end = lineEnd(offset);
+        int length = static_cast<int>(qMin<qint64>(end - offset, kMaxLineBytes));
+        const char *text = data + offset;
+        if (length > 0 && text[length - 1] == '\r') {
+            --length;
+        }
+
+        // 按级别着色（WARN 橙色，ERROR/FATAL 红色）
+        QColor color("#d4d4d4");
+        const char *timestamp = nullptr;
+        int severity = 0;
+        if (LogLineMatcher::parseHeader(text, length, &timestamp, &severity)) {
+            if (severity >= 3) {
+                color = QColor("#f48771");
+            } else if (severity == 2) {
+                color = QColor("#cca700");
+            }
+        }
+
+        const QString line = QString::fromUtf8(text, length);
+        painter.setPen(color);
+        const int y = i * lineHeight;
+        painter.drawText(textX, y + metrics.ascent(), line);
+        widest = qMax(widest, metrics.horizontalAdvance(line) + gutterWidth + 2 * kTextMargin);
+
+        offset = end + 1 < available ? end + 1 : -1;
+    }
+    painter.restore();
+
+    // 行号栏
+    painter.fillRect(QRect(0, 0, gutterWidth, viewport()->height()), QColor("#252526"));
+    painter.setPen(QColor("#858585"));
+    for (int i = 0; i < visibleLines && firstLine + i < lines; ++i) {
+        painter.drawText(QRect(0, i * lineHeight, gutterWidth - kTextMargin, lineHeight),
+                         Qt::AlignRight | Qt::AlignVCenter, QString::number(firstLine + i + 1));
+    }
+
+    if (widest != maxLineWidth) {
+        // 横向范围随显示过的最长行增长，不为此扫描整个文件
+        maxLineWidth = widest;
+        horizontalScrollBar()->setRange(0, qMax(0, maxLineWidth - viewport()->width()));
+    }
+}
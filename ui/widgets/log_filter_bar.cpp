@@ -0,0 +1,95 @@
+#include "log_filter_bar.h"
+
+#include <QHBoxLayout>
+#include <QLabel>
+
+LogFilterBar::LogFilterBar(QWidget *parent)
+    : QWidget(parent)
+{
+    QHBoxLayout *layout = new QHBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    searchLineEdit = new QLineEdit(this);
+    searchLineEdit->setPlaceholderText("输入关键词...");
+    searchLineEdit->setClearButtonEnabled(true);
+    searchLineEdit->setMinimumWidth(200);
+
+    regexCheckBox = new QCheckBox("正则", this);
+
+    levelComboBox = new QComboBox(this);
+    levelComboBox->addItem("全部级别", 0);
+    levelComboBox->addItem("INFO 及以上", 1);
+    levelComboBox->addItem("WARN 及以上", 2);
+    levelComboBox->addItem("ERROR 及以上", 3);
+
+    timeRangeCheckBox = new QCheckBox("时间范围", this);
+
+    QDateTime now = QDateTime::currentDateTime();
+    now = now.addMSecs(-now.time().msec());
+    fromDateTimeEdit = new QDateTimeEdit(now.addSecs(-3600), this);
+    fromDateTimeEdit->setDisplayFormat("yyyy-MM-dd hh:mm:ss");
+    fromDateTimeEdit->setCalendarPopup(true);
+    fromDateTimeEdit->setEnabled(false);
+
+    toDateTimeEdit = new QDateTimeEdit(now, this);
+    toDateTimeEdit->setDisplayFormat("yyyy-MM-dd hh:mm:ss");
+    toDateTimeEdit->setCalendarPopup(true);
+    toDateTimeEdit->setEnabled(false);
+
+    layout->addWidget(searchLineEdit, 1);
+    layout->addWidget(regexCheckBox);
+    layout->addWidget(levelComboBox);
+    layout->addWidget(timeRangeCheckBox);
+    layout->addWidget(fromDateTimeEdit);
+    layout->addWidget(new QLabel("至", this));
+    layout->addWidget(toDateTimeEdit);
+
+    // 连续输入时只在停顿后发起一次搜索（进行中的搜索由引擎取消）
+    debounceTimer.setSingleShot(true);
+    debounceTimer.setInterval(150);
+    connect(&debounceTimer, &QTimer::timeout, this, &LogFilterBar::queryChanged);
+
+    connect(searchLineEdit, &QLineEdit::textChanged, this, &LogFilterBar::scheduleQueryChanged);
+    connect(regexCheckBox, &QCheckBox::toggled, this, &LogFilterBar::scheduleQueryChanged);
+    connect(levelComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &LogFilterBar::scheduleQueryChanged);
+    connect(timeRangeCheckBox, &QCheckBox::toggled, this, [this](bool checked) {
+        fromDateTimeEdit->setEnabled(checked);
+        toDateTimeEdit->setEnabled(checked);
+        scheduleQueryChanged();
+    });
+    connect(fromDateTimeEdit, &QDateTimeEdit::dateTimeChanged, this, [this]() {
+        if (timeRangeCheckBox->isChecked()) {
+            scheduleQueryChanged();
+        }
+    });
+    connect(toDateTimeEdit, &QDateTimeEdit::dateTimeChanged, this, [this]() {
+        if (timeRangeCheckBox->isChecked()) {
+            scheduleQueryChanged();
+        }
+    });
+}
+
+LogSearchQuery LogFilterBar::query() const
+{
+    LogSearchQuery query;
+    query.text = searchLineEdit->text();
+    query.useRegex = regexCheckBox->isChecked();
+    query.minSeverity = levelComboBox->currentData().toInt();
+    if (timeRangeCheckBox->isChecked()) {
+        query.from = fromDateTimeEdit->dateTime();
+        // 编辑框精度到秒，结束时间包含该秒内的全部日志
+        query.to = toDateTimeEdit->dateTime().addMSecs(999);
+    }
+    return query;
+}
+
+void LogFilterBar::setPlaceholderText(const QString &text)
+{
+    searchLineEdit->setPlaceholderText(text);
+}
+
+void LogFilterBar::scheduleQueryChanged()
+{
+    debounceTimer.start();
+}
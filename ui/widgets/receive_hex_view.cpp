@@ -0,0 +1,185 @@
+#include "receive_hex_view.h"
+#include "receive_store.h"
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QScrollBar>
+#include <algorithm>
+#include <climits>
+
+namespace {
+
+constexpr int kTextMargin = 6;
+
+} // namespace
+
+ReceiveHexView::ReceiveHexView(const ReceiveStore *store, QWidget *parent)
+    : QAbstractScrollArea(parent)
+    , store(store)
+{
+    setFont(QFont("Consolas", 10));
+    viewport()->setAutoFillBackground(false);
+    verticalScrollBar()->setSingleStep(1);
+    horizontalScrollBar()->setSingleStep(20);
+
+    connect(verticalScrollBar(), &QScrollBar::valueChanged, this, [this](int value) {
+        topRow = firstRow() + value;
+    });
+    updateScrollBars();
+}
+
+void ReceiveHexView::setMatches(const QVector<ReceiveMatch> *list)
+{
+    matches = list;
+    currentMatch = -1;
+    viewport()->update();
+}
+
+void ReceiveHexView::setCurrentMatch(int index)
+{
+    currentMatch = index;
+    viewport()->update();
+}
+
+void ReceiveHexView::scrollToOffset(qint64 offset)
+{
+    // 目标行放在可见区域上方三分之一处，前后文都能看到
+    const int lineHeight = qMax(1, fontMetrics().height());
+    const int visibleRows = qMax(1, viewport()->height() / lineHeight);
+    const qint64 row = offset / kBytesPerRow - visibleRows / 3;
+    verticalScrollBar()->setValue(int(qBound<qint64>(0, row - firstRow(), INT_MAX)));
+    viewport()->update();
+}
+
+void ReceiveHexView::refresh()
+{
+    const qint64 keep = topRow;
+    const bool atBottom = verticalScrollBar()->value() >= verticalScrollBar()->maximum();
+    updateScrollBars();
+    if (!atBottom) {
+        verticalScrollBar()->setValue(int(qBound<qint64>(0, keep - firstRow(), INT_MAX)));
+    }
+    viewport()->update();
+}
+
+qint64 ReceiveHexView::firstRow() const
+{
+    return store->firstOffset() / kBytesPerRow;
+}
+
+qint64 ReceiveHexView::rowCount() const
+{
+    if (store->size() == 0) {
+        return 0;
+    }
+    return (store->endOffset() + kBytesPerRow - 1) / kBytesPerRow - firstRow();
+}
+
+void ReceiveHexView::updateScrollBars()
+{
+    const int lineHeight = qMax(1, fontMetrics().height());
+    const int visibleRows = qMax(1, viewport()->height() / lineHeight);
+    const QFontMetrics metrics = fontMetrics();
+    const int contentWidth = metrics.horizontalAdvance(QString(12 + kBytesPerRow * 3 + 2 + kBytesPerRow, QChar('0')))
+                             + 4 * kTextMargin;
+
+    verticalScrollBar()->setPageStep(visibleRows);
+    // 1 GB 为 6700 万行，在 QScrollBar 的 int 范围内
+    verticalScrollBar()->setRange(0, int(qBound<qint64>(0, rowCount() - visibleRows, INT_MAX)));
+    horizontalScrollBar()->setPageStep(viewport()->width());
+    horizontalScrollBar()->setRange(0, qMax(0, contentWidth - viewport()->width()));
+}
+
+void ReceiveHexView::resizeEvent(QResizeEvent *event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBars();
+}
+
+void ReceiveHexView::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(viewport());
+    painter.fillRect(viewport()->rect(), QColor("#1e1e1e"));
+    painter.setFont(font());
+
+    if (rowCount() == 0) {
+        painter.setPen(QColor("#808080"));
+        painter.drawText(viewport()->rect(), Qt::AlignCenter, "尚未接收数据");
+        return;
+    }
+
+    const QFontMetrics metrics = fontMetrics();
+    const int lineHeight = qMax(1, metrics.height());
+    const int charWidth = qMax(1, metrics.horizontalAdvance(QChar('0')));
+    const int visibleRows = viewport()->height() / lineHeight + 1;
+    const int x0 = kTextMargin - horizontalScrollBar()->value();
+    const int hexX = x0 + 12 * charWidth;
+    const int asciiX = hexX + (kBytesPerRow * 3 + 2) * charWidth;
+
+    const qint64 row0 = firstRow() + verticalScrollBar()->value();
+    const qint64 viewStart = qMax(row0 * kBytesPerRow, store->firstOffset());
+    const qint64 viewEnd = qMin((row0 + visibleRows) * kBytesPerRow, store->endOffset());
+    const QByteArray bytes = store->read(viewStart, viewEnd - viewStart);
+
+    auto cellRect = [&](qint64 offset, int x, int cellChars, int width) {
+        const qint64 row = offset / kBytesPerRow - row0;
+        const int column = int(offset % kBytesPerRow);
+        return QRect(x + column * cellChars * charWidth, int(row) * lineHeight, width * charWidth, lineHeight);
+    };
+
+    // ---- 可见范围内的匹配：二分定位，再向前找跨入可见范围的长匹配 ----
+    if (matches && !matches->isEmpty()) {
+        auto first = std::lower_bound(matches->cbegin(), matches->cend(), viewStart,
+                                      [](const ReceiveMatch &match, qint64 value) { return match.offset < value; });
+        for (int back = 0; back < kMaxBacktrack && first != matches->cbegin(); ++back) {
+            const ReceiveMatch &previous = *(first - 1);
+            if (previous.offset + previous.length <= viewStart) {
+                break;
+            }
+            --first;
+        }
+
+        for (auto it = first; it != matches->cend() && it->offset < viewEnd; ++it) {
+            const bool current = int(it - matches->cbegin()) == currentMatch;
+            const QColor color = current ? QColor("#d18616") : QColor("#515c6a");
+            const qint64 from = qMax(it->offset, viewStart);
+            const qint64 to = qMin(it->offset + it->length, viewEnd);
+            for (qint64 offset = from; offset < to; ++offset) {
+                painter.fillRect(cellRect(offset, hexX, 3, 2), color);
+                painter.fillRect(cellRect(offset, asciiX, 1, 1), color);
+            }
+        }
+    }
+
+    // ---- 偏移 / 十六进制 / ASCII ----
+    static const char kHexDigits[] = "0123456789ABCDEF";
+    for (int i = 0; i < visibleRows; ++i) {
+        const qint64 rowOffset = (row0 + i) * kBytesPerRow;
+        if (rowOffset >= viewEnd) {
+            break;
+        }
+        const int y = i * lineHeight + metrics.ascent();
+
+        painter.setPen(QColor("#858585"));
+        painter.drawText(x0, y, QString("%1").arg(rowOffset, 10, 16, QChar('0')).toUpper());
+
+        QString hex(kBytesPerRow * 3, QChar(' '));
+        QString ascii(kBytesPerRow, QChar(' '));
+        for (int column = 0; column < kBytesPerRow; ++column) {
+            const qint64 offset = rowOffset + column;
+            if (offset < viewStart || offset >= viewEnd) {
+                continue;
+            }
+            const uchar byte = uchar(bytes.at(offset - viewStart));
+            hex[column * 3] = QChar(kHexDigits[byte >> 4]);
+            hex[column * 3 + 1] = QChar(kHexDigits[byte & 0x0F]);
+            ascii[column] = (byte >= 0x20 && byte < 0x7F) ? QChar(byte) : QChar('.');
+        }
+        painter.setPen(QColor("#d4d4d4"));
+        painter.drawText(hexX, y, hex);
+        painter.setPen(QColor("#9cdcfe"));
+        painter.drawText(asciiX, y, ascii);
+    }
+}
@@ -0,0 +1,331 @@
+#include "telemetry_plot_widget.h"
+#include "telemetry_store.h"
+
+#include <QPainter>
+#include <QPainterPath>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <QtMath>
+
+namespace {
+
+constexpr int kLeftMargin = 64;
+constexpr int kRightMargin = 12;
+constexpr int kTopMargin = 8;
+constexpr int kBottomMargin = 22;
+constexpr int kGridLines = 5;
+
+const QColor kChannelColors[] = {
+    QColor("#2196F3"), QColor("#F44336"), QColor("#4CAF50"), QColor("#FF9800"),
+    QColor("#9C27B0"), QColor("#00BCD4"), QColor("#795548"), QColor("#E91E63"),
+};
+
+QString formatTime(qint64 timeUs)
+{
+    const double seconds = timeUs / 1e6;
+    if (seconds >= 3600) {
+        return QString("%1:%2:%3")
+            .arg(qint64(seconds) / 3600)
+            .arg(qint64(seconds) / 60 % 60, 2, 10, QChar('0'))
+            .arg(qint64(seconds) % 60, 2, 10, QChar('0'));
+    }
+    return QString::number(seconds, 'f', seconds < 10 ? 3 : 1) + " s";
+}
+
+} // namespace
+
+TelemetryPlotWidget::TelemetryPlotWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    setMinimumSize(320, 200);
+    setMouseTracking(false);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    // 跟随模式下每帧都重绘；暂停时只在数据或视图变化后重绘
+    connect(&refreshTimer, &QTimer::timeout, this, [this]() {
+        if (isVisible() && (dirty || followLive)) {
+            dirty = false;
+            update();
+        }
+    });
+    refreshTimer.start(kRefreshIntervalMs);
+}
+
+void TelemetryPlotWidget::setStore(TelemetryStore *newStore)
+{
+    store = newStore;
+    update();
+}
+
+void TelemetryPlotWidget::setChannelVisible(const QString &name, bool visible)
+{
+    if (visible) {
+        hiddenChannels.remove(name);
+    } else {
+        hiddenChannels.insert(name);
+    }
+    update();
+}
+
+QColor TelemetryPlotWidget::channelColor(const QString &name)
+{
+    auto it = colors.constFind(name);
+    if (it != colors.constEnd()) {
+        return it.value();
+    }
+    const int count = int(sizeof(kChannelColors) / sizeof(kChannelColors[0]));
+    const QColor color = kChannelColors[colors.size() % count];
+    colors.insert(name, color);
+    return color;
+}
+
+void TelemetryPlotWidget::setFollowLive(bool follow)
+{
+    if (followLive == follow) {
+        return;
+    }
+    if (!follow) {
+        endUs = viewEnd();
+    }
+    followLive = follow;
+    update();
+    emit followLiveChanged(follow);
+}
+
+void TelemetryPlotWidget::fitAll()
+{
+    if (!store) {
+        return;
+    }
+    const qint64 first = store->firstTimeUs();
+    const qint64 last = store->lastTimeUs();
+    setFollowLive(false);
+    spanUs = qMax(kMinSpanUs, last - first);
+    endUs = first + spanUs;
+    update();
+}
+
+QRect TelemetryPlotWidget::plotRect() const
+{
+    return rect().adjusted(kLeftMargin, kTopMargin, -kRightMargin, -kBottomMargin);
+}
+
+qint64 TelemetryPlotWidget::viewEnd() const
+{
+    if (!followLive) {
+        return endUs;
+    }
+    return store ? qMax(spanUs, store->lastTimeUs()) : spanUs;
+}
+
+void TelemetryPlotWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor("#ffffff"));
+
+    const QRect area = plotRect();
+    if (area.width() <= 0 || area.height() <= 0) {
+        return;
+    }
+    painter.setPen(QColor("#dee2e6"));
+    painter.drawRect(area.adjusted(0, 0, -1, -1));
+
+    const QStringList names = store ? store->channelNames() : QStringList();
+    if (names.isEmpty()) {
+        painter.setPen(QColor("#6c757d"));
+        painter.drawText(area, Qt::AlignCenter, "等待数据，例如 \"temp=41.2 v=3.31\"");
+        return;
+    }
+
+    const qint64 t1 = viewEnd();
+    const qint64 t0 = t1 - spanUs;
+    const int columns = area.width();
+
+    // 先抽取所有可见通道，得到统一的纵轴范围
+    QList<QPair<QString, TelemetryChannel::Extract>> extracts;
+    float low = 0;
+    float high = 0;
+    bool haveRange = false;
+    bool decimated = false;
+    for (const QString &name : names) {
+        if (hiddenChannels.contains(name)) {
+            continue;
+        }
+        const TelemetryChannel *channel = store->find(name);
+        if (!channel) {
+            continue;
+        }
+        TelemetryChannel::Extract extract;
+        channel->extract(t0, t1, columns, &extract);
+        if (!extract.empty) {
+            low = haveRange ? qMin(low, extract.min) : extract.min;
+            high = haveRange ? qMax(high, extract.max) : extract.max;
+            haveRange = true;
+        }
+        decimated = decimated || !extract.raw;
+        extracts.append({name, std::move(extract)});
+    }
+    if (!haveRange) {
+        low = 0;
+        high = 1;
+    } else if (qFuzzyCompare(low, high)) {
+        low -= 1;
+        high += 1;
+    } else {
+        const float padding = (high - low) * 0.05f;
+        low -= padding;
+        high += padding;
+    }
+
+    auto mapX = [&](qint64 timeUs) {
+        return area.left() + double(timeUs - t0) * area.width() / double(spanUs);
+    };
+    auto mapY = [&](float value) {
+        return area.bottom() - double(value - low) * area.height() / double(high - low);
+    };
+
+    // 网格与坐标
+    painter.setFont(font());
+    const QFontMetrics metrics = fontMetrics();
+    for (int i = 0; i <= kGridLines; ++i) {
+        const int y = area.top() + area.height() * i / kGridLines;
+        const int x = area.left() + area.width() * i / kGridLines;
+        painter.setPen(QColor("#f1f3f5"));
+        painter.drawLine(area.left(), y, area.right(), y);
+        painter.drawLine(x, area.top(), x, area.bottom());
+
+        painter.setPen(QColor("#6c757d"));
+        const float value = high - (high - low) * i / kGridLines;
+        painter.drawText(QRect(0, y - metrics.height() / 2, kLeftMargin - 6, metrics.height()),
+                         Qt::AlignRight | Qt::AlignVCenter, QString::number(value, 'g', 5));
+        const QString timeText = formatTime(t0 + spanUs * i / kGridLines);
+        const int textWidth = metrics.horizontalAdvance(timeText);
+        painter.drawText(qBound(0, x - textWidth / 2, width() - textWidth),
+                         area.bottom() + metrics.ascent() + 4, timeText);
+    }
+
+    // 曲线
+    painter.save();
+    painter.setClipRect(area);
+    for (const auto &entry : std::as_const(extracts)) {
+        const TelemetryChannel::Extract &extract = entry.second;
+        painter.setPen(QPen(channelColor(entry.first), 1));
+        if (extract.raw) {
+            painter.setRenderHint(QPainter::Antialiasing, true);
+            QPolygonF line;
+            line.reserve(extract.rawTimes.size());
+            for (int i = 0; i < extract.rawTimes.size(); ++i) {
+                line << QPointF(mapX(extract.rawTimes.at(i)), mapY(extract.rawValues.at(i)));
+            }
+            painter.drawPolyline(line);
+        } else {
+            // 每列一条竖线，相邻列交替连接 min/max，连续区间合成一条折线
+            painter.setRenderHint(QPainter::Antialiasing, false);
+            QPolygonF line;
+            line.reserve(extract.columns.size() * 2);
+            for (int column = 0; column < extract.columns.size(); ++column) {
+                const TelemetryChannel::Column &value = extract.columns.at(column);
+                if (!value.valid) {
+                    continue;
+                }
+                const double x = area.left() + column + 0.5;
+                if (column % 2 == 0) {
+                    line << QPointF(x, mapY(value.min)) << QPointF(x, mapY(value.max));
+                } else {
+                    line << QPointF(x, mapY(value.max)) << QPointF(x, mapY(value.min));
+                }
+            }
+            painter.drawPolyline(line);
+        }
+    }
+    painter.restore();
+
+    // 图例：通道名与最新值
+    int legendX = area.left() + 8;
+    const int legendY = area.top() + metrics.ascent() + 4;
+    for (const QString &name : names) {
+        const TelemetryChannel *channel = store->find(name);
+        if (!channel || hiddenChannels.contains(name)) {
+            continue;
+        }
+        const QString text = QString("%1 = %2").arg(name).arg(channel->lastValue(), 0, 'g', 6);
+        painter.fillRect(legendX, legendY - metrics.ascent() + 3, 10, 3, channelColor(name));
+        painter.setPen(QColor("#212529"));
+        painter.drawText(legendX + 14, legendY, text);
+        legendX += 14 + metrics.horizontalAdvance(text) + 16;
+    }
+
+    painter.setPen(QColor("#adb5bd"));
+    const QString mode = QString("%1 | %2 | 跨度 %3")
+        .arg(followLive ? "实时" : "暂停")
+        .arg(decimated ? "min/max 抽取" : "原始点")
+        .arg(formatTime(spanUs));
+    painter.drawText(area.adjusted(0, 0, -6, -4), Qt::AlignRight | Qt::AlignBottom, mode);
+}
+
+void TelemetryPlotWidget::wheelEvent(QWheelEvent *event)
+{
+    const QRect area = plotRect();
+    if (area.width() <= 0) {
+        return;
+    }
+
+    const double steps = event->angleDelta().y() / 120.0;
+    const double factor = qPow(1.25, -steps);
+    const qint64 end = viewEnd();
+    const double anchor = qBound(0.0, (event->position().x() - area.left()) / area.width(), 1.0);
+    const qint64 anchorUs = end - spanUs + qint64(anchor * spanUs);
+
+    const qint64 maxSpan = store ? qMax<qint64>(kDefaultSpanUs, store->lastTimeUs() - store->firstTimeUs()) * 2
+                                 : kDefaultSpanUs;
+    spanUs = qBound<qint64>(kMinSpanUs, qint64(spanUs * factor), maxSpan);
+
+    // 跟随时保持右端对齐最新数据，否则以光标处的时间为缩放中心
+    if (!followLive) {
+        endUs = anchorUs + qint64((1.0 - anchor) * spanUs);
+    }
+    update();
+    event->accept();
+}
+
+void TelemetryPlotWidget::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        dragging = true;
+        dragStartX = int(event->position().x());
+        dragStartEndUs = viewEnd();
+    }
+    QWidget::mousePressEvent(event);
+}
+
+void TelemetryPlotWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    const QRect area = plotRect();
+    if (!dragging || area.width() <= 0) {
+        return;
+    }
+    const int dx = int(event->position().x()) - dragStartX;
+    if (followLive && qAbs(dx) < 3) {
+        return;
+    }
+    setFollowLive(false);
+    endUs = dragStartEndUs - qint64(double(dx) * spanUs / area.width());
+    update();
+}
+
+void TelemetryPlotWidget::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        dragging = false;
+    }
+    QWidget::mouseReleaseEvent(event);
+}
+
+void TelemetryPlotWidget::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    Q_UNUSED(event);
+    spanUs = kDefaultSpanUs;
+    setFollowLive(true);
+}